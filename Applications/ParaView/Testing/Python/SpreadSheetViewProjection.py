@@ -0,0 +1,43 @@
+#/usr/bin/env python
+from paraview.simple import *
+
+# This test checks that the ColumnProjection option of the spreadsheet view
+# only removes the hidden columns.
+
+def read_rows(view):
+    obj = view.GetClientSideObject()
+    names = [obj.GetColumnName(i) for i in range(obj.GetNumberOfColumns())]
+    values = {}
+    for name in names:
+        values[name] = [obj.GetValueByName(row, name).ToString() \
+                        for row in range(obj.GetNumberOfRows())]
+    return names, values
+
+Sphere(ThetaResolution=32, PhiResolution=32)
+Elevation()
+
+v = CreateView("SpreadSheetView")
+v.BlockSize = 50
+Show()
+v.HiddenColumnLabels = ["Normals"]
+Render()
+
+# hidden columns are delivered but not shown by default.
+assert v.ColumnProjection == 0
+names, reference = read_rows(v)
+print(names)
+assert any(name.startswith("Normals") for name in names)
+
+v.ColumnProjection = 1
+Render()
+projected_names, projected = read_rows(v)
+print(projected_names)
+assert not any(name.startswith("Normals") for name in projected_names)
+assert "Elevation" in projected_names and "Point ID" in projected_names
+for name in projected_names:
+    assert projected[name] == reference[name], name
+
+v.ColumnProjection = 0
+Render()
+assert read_rows(v)[0] == names
+
@@ -0,0 +1,91 @@
+from paraview import servermanager
+from paraview import simple as smp
+
+# Checks that the images a client receives from a remote rendering server with
+# DeltaFrames on match the images of a view without it: after a change to a
+# small region of the image, when a loss-less image follows a lossy one, and
+# after the view is resized. The client must never patch a stale last image or
+# one of a different size.
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+def getHost(url):
+   return url.split(':')[1][2:]
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def createView(deltaFrames, size):
+    view = smp.CreateRenderView()
+    view.RemoteRenderThreshold = 0
+    view.ImageReductionFactor = 1
+    view.OrientationAxesVisibility = 0
+    view.DeltaFrames = deltaFrames
+    view.ViewSize = size
+    return view
+
+
+def setCamera(view):
+    view.CameraPosition = [0, 0, 10]
+    view.CameraFocalPoint = [0, 0, 0]
+    view.CameraViewUp = [0, 1, 0]
+    view.CameraViewAngle = 30
+
+
+def compare(step, view, reference):
+    image = view.CaptureWindow(1)
+    expected = reference.CaptureWindow(1)
+    assert image.GetDimensions() == expected.GetDimensions(), step
+    values = image.GetPointData().GetScalars()
+    expectedValues = expected.GetPointData().GetScalars()
+    assert values.GetNumberOfValues() == expectedValues.GetNumberOfValues(), step
+    for i in range(values.GetNumberOfValues()):
+        if values.GetValue(i) != expectedValues.GetValue(i):
+            raise RuntimeError("%s: images differ at value %d" % (step, i))
+    print ("%s: %s images match" % (step, image.GetDimensions()))
+
+
+def runTest():
+    options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+    url = options.GetServerURL()
+    smp.Connect(getHost(url), getPort(url))
+
+    views = [createView(1, [300, 300]), createView(0, [300, 300])]
+
+    # a sphere in the middle and a small cone in a corner of the image.
+    sphere = smp.Sphere()
+    cone = smp.Cone(Center=[1.4, 1.4, 0], Radius=0.1, Height=0.3)
+    coneDisplays = []
+    for view in views:
+        smp.Show(sphere, view)
+        coneDisplays.append(smp.Show(cone, view))
+        setCamera(view)
+
+    def changeCone(color):
+        for display in coneDisplays:
+            display.DiffuseColor = color
+
+    compare("first image", views[0], views[1])
+
+    changeCone([1, 0, 0])
+    compare("small change", views[0], views[1])
+
+    # a lossy interactive image, then loss-less ones.
+    views[0].CompressorConfig = 'vtkSquirtCompressor 0 3'
+    changeCone([0, 1, 0])
+    views[0].SMProxy.InteractiveRender()
+    compare("loss-less after lossy", views[0], views[1])
+    changeCone([0, 0, 1])
+    compare("small change after lossy", views[0], views[1])
+
+    for view in views:
+        view.ViewSize = [280, 230]
+        setCamera(view)
+    compare("resize", views[0], views[1])
+    changeCone([1, 1, 0])
+    compare("small change after resize", views[0], views[1])
+
+    smp.Disconnect()
+    print ("Test Passed")
+runTest()
@@ -0,0 +1,57 @@
+from paraview import servermanager
+import paraview.simple as smp
+
+# Checks that, with lazy plugin loading (PV_PLUGIN_LAZY_LOAD), the simple
+# module provides functions for the proxies of plugins that are not loaded
+# yet in builtin sessions, and that calling one of them loads the plugin and
+# creates the proxy.
+
+
+def getPluginIndex(info, name):
+    for cc in range(info.GetNumberOfPlugins()):
+        if info.GetPluginName(cc) == name:
+            return cc
+    raise RuntimeError("Plugin '%s' not found" % name)
+
+
+def isLoaded(name):
+    info = plm.GetLocalInformation()
+    return info.GetPluginLoaded(getPluginIndex(info, name))
+
+
+plm = servermanager.vtkSMProxyManager.GetProxyManager().GetPluginManager()
+tracker = servermanager.vtkPVPluginTracker.GetInstance()
+assert tracker.GetLazyLoadPlugins()
+
+info = plm.GetLocalInformation()
+filename = info.GetPluginFileName(getPluginIndex(info, "Moments"))
+assert not isLoaded("Moments")
+
+# an auto-loaded plugin with a proxy index is deferred.
+tracker.LoadPluginConfigurationXMLFromString(
+    '<Plugins><Plugin name="Moments" filename="%s" auto_load="1">'
+    '<Proxy group="filters" name="MomentVectors" label="Moment Vectors"/>'
+    '<Proxy group="filters" name="MomentGlyphs" label="Moment Glyphs"/>'
+    '</Plugin></Plugins>' % filename)
+assert not isLoaded("Moments")
+assert tracker.GetNumberOfDeferredProxies() == 2
+
+# the functions of a new session include the proxies of the deferred plugin,
+# without loading it.
+smp.ResetSession()
+assert not "MomentVectors" in servermanager.ActiveConnection.Modules.filters.__dict__
+assert hasattr(smp.MomentVectors, "DeferredProxy")
+assert hasattr(smp.MomentGlyphs, "DeferredProxy")
+assert not isLoaded("Moments")
+
+# the first call loads the plugin and replaces the functions.
+vectors = smp.MomentVectors()
+assert vectors.GetXMLName() == "MomentVectors"
+assert isLoaded("Moments")
+assert tracker.GetNumberOfDeferredProxies() == 0
+assert not hasattr(smp.MomentVectors, "DeferredProxy")
+assert not hasattr(smp.MomentGlyphs, "DeferredProxy")
+
+glyphs = smp.MomentGlyphs(Input=vectors)
+assert glyphs.GetXMLName() == "MomentGlyphs"
+assert glyphs.Input.GetXMLName() == "MomentVectors"
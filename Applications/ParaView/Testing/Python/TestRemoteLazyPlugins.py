@@ -0,0 +1,59 @@
+from paraview import servermanager
+import paraview.simple as smp
+
+# Checks that a client connected to a server with lazy plugin loading
+# (PV_PLUGIN_LAZY_LOAD) gets the proxy definitions of the plugins the server
+# deferred.
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def getPluginIndex(info, name):
+    for cc in range(info.GetNumberOfPlugins()):
+        if info.GetPluginName(cc) == name:
+            return cc
+    raise RuntimeError("Plugin '%s' not found" % name)
+
+
+def runTest():
+
+    options = servermanager.vtkProcessModule.GetProcessModule().GetOptions()
+    url = options.GetServerURL()
+
+    smp.Connect(getHost(url), getPort(url))
+
+    session = servermanager.ActiveConnection.Session
+    plm = servermanager.vtkSMProxyManager.GetProxyManager().GetPluginManager()
+    pdm = session.GetSessionProxyManager().GetProxyDefinitionManager()
+
+    info = plm.GetRemoteInformation(session)
+    index = getPluginIndex(info, "Moments")
+    assert not info.GetPluginLoaded(index)
+    assert not pdm.HasDefinition("filters", "MomentVectors")
+
+    # an auto-loaded plugin with a proxy index is deferred by the server.
+    plm.LoadPluginConfigurationXMLFromString(
+        '<Plugins><Plugin name="Moments" filename="%s" auto_load="1">'
+        '<Proxy group="filters" name="MomentVectors"/></Plugin></Plugins>' %
+        info.GetPluginFileName(index), session, True)
+
+    # the client received the definitions of the deferred plugin.
+    assert pdm.HasDefinition("filters", "MomentVectors")
+    info = plm.GetRemoteInformation(session)
+    assert info.GetPluginLoaded(getPluginIndex(info, "Moments"))
+
+    assert session.GetSessionProxyManager().NewProxy("filters", "MomentVectors")
+
+    smp.Disconnect()
+
+
+runTest()
@@ -286,7 +286,9 @@ paraview_plugin_build(
   * `PLUGINS_FILE_NAME`: The name of the XML plugin file to generate for the
     built plugins. This file will be placed under
     `<LIBRARY_DESTINATION>/<LIBRARY_SUBDIRECTORY>`. It will be installed with
-    the `plugin` component.
+    the `plugin` component. Plugins which only provide server manager XML
+    definitions list the `(group, name)` of their proxies in this file so that
+    they may be loaded lazily (see `vtkPVPluginTracker::SetLazyLoadPlugins`).
 #]==]
 function (paraview_plugin_build)
   cmake_parse_arguments(_paraview_build
@@ -555,8 +557,18 @@ void ${_paraview_build_target_safe}_initialize()
       if (_paraview_build_plugin IN_LIST _paraview_build_AUTOLOAD)
         set(_paraview_build_autoload 1)
       endif ()
-      string(APPEND _paraview_build_xml_content
-        "  <Plugin name=\"${_paraview_build_plugin}\" auto_load=\"${_paraview_build_autoload}\"/>\n")
+      get_property(_paraview_build_proxy_index
+        TARGET    "${_paraview_build_plugin}"
+        PROPERTY  "_paraview_plugin_proxy_index")
+      if (_paraview_build_proxy_index)
+        string(APPEND _paraview_build_xml_content
+          "  <Plugin name=\"${_paraview_build_plugin}\" auto_load=\"${_paraview_build_autoload}\">\n"
+          "${_paraview_build_proxy_index}"
+          "  </Plugin>\n")
+      else ()
+        string(APPEND _paraview_build_xml_content
+          "  <Plugin name=\"${_paraview_build_plugin}\" auto_load=\"${_paraview_build_autoload}\"/>\n")
+      endif ()
     endforeach ()
     string(APPEND _paraview_build_xml_content
       "</Plugins>\n")
@@ -825,6 +837,72 @@ paraview_add_plugin(<name>
   * `FORCE_STATIC`: (Defaults to `OFF`) If set, the plugin will be built
     statically so that it can be embedded into an application.
 #]==]
+
+# Scans server manager XML files for the top-level proxy definitions in each
+# proxy group and sets `output` to a list of `<Proxy group="" name=""/>`
+# elements, with the `label` of the proxy when it has one. The output is empty
+# if any of the files extends existing definitions since those must be applied
+# as soon as possible.
+function (_paraview_add_plugin_proxy_index output)
+  set(_paraview_proxy_index "")
+  foreach (_paraview_proxy_index_xml IN LISTS ARGN)
+    file(READ "${_paraview_proxy_index_xml}" _paraview_proxy_index_contents)
+    if (_paraview_proxy_index_contents MATCHES "<Extension[ \t\r\n>]")
+      set("${output}" "" PARENT_SCOPE)
+      return ()
+    endif ()
+    # Semicolons and brackets would interfere with list handling below.
+    string(REGEX REPLACE "[][;]" " " _paraview_proxy_index_contents "${_paraview_proxy_index_contents}")
+    # Drop comments.
+    string(REPLACE "<!--" ";<!--" _paraview_proxy_index_contents "${_paraview_proxy_index_contents}")
+    string(REPLACE "-->" "-->;" _paraview_proxy_index_contents "${_paraview_proxy_index_contents}")
+    set(_paraview_proxy_index_stripped "")
+    foreach (_paraview_proxy_index_chunk IN LISTS _paraview_proxy_index_contents)
+      if (NOT _paraview_proxy_index_chunk MATCHES "^<!--")
+        string(APPEND _paraview_proxy_index_stripped "${_paraview_proxy_index_chunk}")
+      endif ()
+    endforeach ()
+    string(REGEX MATCHALL "<ProxyGroup([ \t\r\n][^>]*)?>|</ProxyGroup>|<[A-Za-z0-9_]*Proxy([ \t\r\n][^>]*)?>|</[A-Za-z0-9_]*Proxy>"
+      _paraview_proxy_index_tags "${_paraview_proxy_index_stripped}")
+
+    set(_paraview_proxy_index_group "")
+    set(_paraview_proxy_index_depth 0)
+    foreach (_paraview_proxy_index_tag IN LISTS _paraview_proxy_index_tags)
+      if (_paraview_proxy_index_tag MATCHES "^<ProxyGroup[ \t\r\n>]")
+        set(_paraview_proxy_index_group "")
+        if (_paraview_proxy_index_tag MATCHES "[ \t\r\n]name=\"([^\"]*)\"")
+          set(_paraview_proxy_index_group "${CMAKE_MATCH_1}")
+        endif ()
+        set(_paraview_proxy_index_depth 0)
+      elseif (_paraview_proxy_index_tag STREQUAL "</ProxyGroup>")
+        set(_paraview_proxy_index_group "")
+      elseif (_paraview_proxy_index_tag MATCHES "^</")
+        math(EXPR _paraview_proxy_index_depth "${_paraview_proxy_index_depth} - 1")
+      else ()
+        # Only proxies directly under a proxy group are definitions; nested
+        # ones are sub-proxies or domain entries.
+        if (_paraview_proxy_index_depth EQUAL 0 AND
+            _paraview_proxy_index_group AND
+            _paraview_proxy_index_tag MATCHES "[ \t\r\n]name=\"([^\"]*)\"")
+          set(_paraview_proxy_index_name "${CMAKE_MATCH_1}")
+          # The label names the Python function creating the proxy.
+          set(_paraview_proxy_index_label "")
+          if (_paraview_proxy_index_tag MATCHES "[ \t\r\n]label=\"([^\"]*)\"")
+            set(_paraview_proxy_index_label " label=\"${CMAKE_MATCH_1}\"")
+          endif ()
+          string(APPEND _paraview_proxy_index
+            "    <Proxy group=\"${_paraview_proxy_index_group}\""
+            " name=\"${_paraview_proxy_index_name}\"${_paraview_proxy_index_label}/>\n")
+        endif ()
+        if (NOT _paraview_proxy_index_tag MATCHES "/>$")
+          math(EXPR _paraview_proxy_index_depth "${_paraview_proxy_index_depth} + 1")
+        endif ()
+      endif ()
+    endforeach ()
+  endforeach ()
+  set("${output}" "${_paraview_proxy_index}" PARENT_SCOPE)
+endfunction ()
+
 function (paraview_add_plugin name)
   if (NOT name STREQUAL _paraview_build_plugin)
     message(FATAL_ERROR
@@ -1302,6 +1380,23 @@ function (paraview_add_plugin name)
     PROPERTY
       PREFIX "")
 
+  # Plugins which only provide proxies may be loaded on demand. Anything with
+  # client-side components, Python modules, a EULA, or dependencies on other
+  # plugins is always loaded eagerly.
+  if (_paraview_add_plugin_with_xml AND
+      NOT _paraview_add_plugin_with_ui AND
+      NOT _paraview_add_plugin_with_resources AND
+      NOT _paraview_add_plugin_with_python AND
+      NOT _paraview_add_plugin_EULA AND
+      NOT _paraview_add_plugin_REQUIRED_PLUGINS)
+    _paraview_add_plugin_proxy_index(_paraview_add_plugin_proxy_index
+      ${_paraview_add_plugin_module_xmls}
+      ${_paraview_add_plugin_xmls})
+    set_property(TARGET "${_paraview_build_plugin}"
+      PROPERTY
+        "_paraview_plugin_proxy_index" "${_paraview_add_plugin_proxy_index}")
+  endif ()
+
   set(_paraview_add_plugin_destination
     "${_paraview_build_plugin_destination}/${_paraview_build_plugin}")
   install(
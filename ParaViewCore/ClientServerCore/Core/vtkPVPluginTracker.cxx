@@ -51,6 +51,15 @@
 namespace
 {
 
+// Entry of the proxy index of a plugin. Label is empty when the proxy
+// definition has no label.
+struct vtkProxyIndexEntry
+{
+  std::string Group;
+  std::string Name;
+  std::string Label;
+};
+
 class vtkItem
 {
 public:
@@ -58,10 +67,27 @@ public:
   std::string PluginName;
   vtkPVPlugin* Plugin;
   bool AutoLoad;
+  // Set when loading of an auto_load plugin was deferred (LazyLoadPlugins).
+  bool LoadDeferred;
+  // proxies provided by the plugin, if published.
+  std::vector<vtkProxyIndexEntry> ProxyIndex;
   vtkItem()
   {
     this->Plugin = NULL;
     this->AutoLoad = false;
+    this->LoadDeferred = false;
+  }
+
+  bool ProvidesProxy(const char* group, const char* name) const
+  {
+    for (const auto& proxy : this->ProxyIndex)
+    {
+      if (proxy.Group == group && proxy.Name == name)
+      {
+        return true;
+      }
+    }
+    return false;
   }
 };
 
@@ -235,6 +261,23 @@ public:
     }
     return this->end();
   }
+
+  // Returns the index-th proxy listed by plugins whose load is still deferred.
+  const vtkProxyIndexEntry* GetDeferredProxy(unsigned int index) const
+  {
+    for (const_iterator iter = this->begin(); iter != this->end(); ++iter)
+    {
+      if (iter->LoadDeferred && iter->Plugin == NULL)
+      {
+        if (index < iter->ProxyIndex.size())
+        {
+          return &iter->ProxyIndex[index];
+        }
+        index -= static_cast<unsigned int>(iter->ProxyIndex.size());
+      }
+    }
+    return NULL;
+  }
 };
 
 vtkStandardNewMacro(vtkPVPluginTracker);
@@ -242,6 +285,7 @@ vtkStandardNewMacro(vtkPVPluginTracker);
 vtkPVPluginTracker::vtkPVPluginTracker()
 {
   this->PluginsList = new vtkPluginsList();
+  this->LazyLoadPlugins = vtksys::SystemTools::GetEnv("PV_PLUGIN_LAZY_LOAD") != nullptr;
   if (vtksys::SystemTools::GetEnv("PV_PLUGIN_DEBUG") != nullptr)
   {
     vtkWarningMacro("`PV_PLUGIN_DEBUG` environment variable has been deprecated. "
@@ -274,6 +318,7 @@ vtkPVPluginTracker* vtkPVPluginTracker::GetInstance()
 void vtkPVPluginTracker::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LazyLoadPlugins: " << this->LazyLoadPlugins << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -437,18 +482,145 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLHinted(
       }
       vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "found `%s`", plugin_filename.c_str());
       unsigned int index = this->RegisterAvailablePlugin(plugin_filename.c_str());
-      if ((auto_load || forceLoad) && !this->GetPluginLoaded(index))
+
+      // Collect the (group, name, label) index of proxies provided by the plugin.
+      vtkItem& item = (*this->PluginsList)[index];
+      item.ProxyIndex.clear();
+      for (unsigned int kk = 0; kk < child->GetNumberOfNestedElements(); kk++)
+      {
+        vtkPVXMLElement* proxy = child->GetNestedElement(kk);
+        if (proxy->GetName() && strcmp(proxy->GetName(), "Proxy") == 0 &&
+          proxy->GetAttribute("group") && proxy->GetAttribute("name"))
+        {
+          vtkProxyIndexEntry entry;
+          entry.Group = proxy->GetAttribute("group");
+          entry.Name = proxy->GetAttribute("name");
+          entry.Label = proxy->GetAttributeOrEmpty("label");
+          item.ProxyIndex.push_back(entry);
+        }
+      }
+      item.AutoLoad = (auto_load != 0);
+
+      if (auto_load && !forceLoad && this->LazyLoadPlugins && !item.ProxyIndex.empty() &&
+        !this->GetPluginLoaded(index))
+      {
+        vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(),
+          "deferring load of `%s` until one of its %d proxies is requested.", name.c_str(),
+          static_cast<int>(item.ProxyIndex.size()));
+        item.LoadDeferred = true;
+      }
+      else if ((auto_load || forceLoad) && !this->GetPluginLoaded(index))
       {
         // load the plugin.
         vtkPVPluginLoader* loader = vtkPVPluginLoader::New();
         loader->LoadPlugin(plugin_filename.c_str());
         loader->Delete();
       }
-      (*this->PluginsList)[index].AutoLoad = (auto_load != 0);
     }
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::LoadPluginForProxy(const char* group, const char* name)
+{
+  if (!group || !name)
+  {
+    return false;
+  }
+
+  for (unsigned int cc = 0; cc < this->GetNumberOfPlugins(); cc++)
+  {
+    vtkItem& item = (*this->PluginsList)[cc];
+    if (item.LoadDeferred && item.Plugin == NULL && item.ProvidesProxy(group, name))
+    {
+      vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "loading deferred plugin `%s` for (%s, %s).",
+        item.PluginName.c_str(), group, name);
+
+      // Clear the flag before loading since handlers of the plugin's
+      // registration may request other proxies. Copy the filename since
+      // loading may grow the plugins list.
+      item.LoadDeferred = false;
+      const std::string filename = item.FileName;
+      vtkPVPluginLoader* loader = vtkPVPluginLoader::New();
+      bool loaded = loader->LoadPlugin(filename.c_str());
+      loader->Delete();
+      return loaded;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPluginTracker::LoadDeferredPlugins()
+{
+  std::vector<std::string> filenames;
+  for (auto& item : *this->PluginsList)
+  {
+    if (item.LoadDeferred && item.Plugin == NULL)
+    {
+      item.LoadDeferred = false;
+      filenames.push_back(item.FileName);
+    }
+  }
+
+  for (const auto& filename : filenames)
+  {
+    vtkPVPluginLoader* loader = vtkPVPluginLoader::New();
+    loader->LoadPlugin(filename.c_str());
+    loader->Delete();
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkPVPluginTracker::GetNumberOfDeferredProxies()
+{
+  unsigned int count = 0;
+  for (const auto& item : *this->PluginsList)
+  {
+    if (item.LoadDeferred && item.Plugin == NULL)
+    {
+      count += static_cast<unsigned int>(item.ProxyIndex.size());
+    }
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVPluginTracker::GetDeferredProxyGroup(unsigned int index)
+{
+  const vtkProxyIndexEntry* entry = this->PluginsList->GetDeferredProxy(index);
+  if (!entry)
+  {
+    vtkWarningMacro("Invalid index: " << index);
+    return NULL;
+  }
+  return entry->Group.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVPluginTracker::GetDeferredProxyName(unsigned int index)
+{
+  const vtkProxyIndexEntry* entry = this->PluginsList->GetDeferredProxy(index);
+  if (!entry)
+  {
+    vtkWarningMacro("Invalid index: " << index);
+    return NULL;
+  }
+  return entry->Name.c_str();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVPluginTracker::GetDeferredProxyLabel(unsigned int index)
+{
+  const vtkProxyIndexEntry* entry = this->PluginsList->GetDeferredProxy(index);
+  if (!entry)
+  {
+    vtkWarningMacro("Invalid index: " << index);
+    return NULL;
+  }
+  return entry->Label.empty() ? entry->Name.c_str() : entry->Label.c_str();
+}
+
 //----------------------------------------------------------------------------
 unsigned int vtkPVPluginTracker::GetNumberOfPlugins()
 {
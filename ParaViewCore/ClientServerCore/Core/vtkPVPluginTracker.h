@@ -80,6 +80,10 @@ public:
    * <Plugins>
    * <Plugin name="[plugin name]" filename="[optional file name]" auto_load="[bool]" />
    * ...
+   * <Plugin name="[plugin name]" auto_load="[bool]">
+   *   <Proxy group="[proxy group]" name="[proxy name]" label="[optional proxy label]" />
+   *   ...
+   * </Plugin>
    * </Plugins>
    * @endcode
    * This method will process the XML, locate the plugin shared library and
@@ -88,6 +92,10 @@ public:
    * filename is also optional, if not provided this method will look in
    * different place to find the plugin, eg. paraview lib dir. It will NOT look
    * in PV_PLUGIN_PATH.
+   * The nested `Proxy` elements, generated at build time, are an index of the
+   * proxy definitions provided by the plugin. When LazyLoadPlugins is true,
+   * auto_load plugins with such an index are not loaded right away; see
+   * LoadPluginForProxy().
    */
   void LoadPluginConfigurationXMLs(const char* appname);
   void LoadPluginConfigurationXML(const char* filename, bool forceLoad = false);
@@ -118,6 +126,48 @@ public:
   bool GetPluginAutoLoad(unsigned int index);
   //@}
 
+  //@{
+  /**
+   * When set to true, auto_load plugins that publish a proxy index in the
+   * plugin configuration xml are only registered as available when the
+   * configuration xml is processed. The shared library is loaded (and its
+   * proxy definitions parsed) the first time one of the indexed proxies is
+   * requested through LoadPluginForProxy(). Proxies from such deferred plugins
+   * are not reported by proxy definition iterators until the plugin is loaded;
+   * see GetNumberOfDeferredProxies().
+   * Default is false, unless the `PV_PLUGIN_LAZY_LOAD` environment variable is
+   * set. This must be set before the plugin configuration xmls are loaded.
+   */
+  vtkSetMacro(LazyLoadPlugins, bool);
+  vtkGetMacro(LazyLoadPlugins, bool);
+  vtkBooleanMacro(LazyLoadPlugins, bool);
+  //@}
+
+  /**
+   * Loads the deferred auto_load plugin, if any, whose proxy index lists the
+   * (group, name) proxy. Returns true if a plugin was loaded.
+   */
+  bool LoadPluginForProxy(const char* group, const char* name);
+
+  /**
+   * Loads all auto_load plugins that were deferred because of
+   * LazyLoadPlugins.
+   */
+  void LoadDeferredPlugins();
+
+  //@{
+  /**
+   * Provides access to the proxy index of the deferred plugins that are not
+   * loaded yet, e.g. to create Python functions for their proxies before they
+   * are loaded. GetDeferredProxyLabel() returns the proxy name when the index
+   * does not provide a label.
+   */
+  unsigned int GetNumberOfDeferredProxies();
+  const char* GetDeferredProxyGroup(unsigned int index);
+  const char* GetDeferredProxyName(unsigned int index);
+  const char* GetDeferredProxyLabel(unsigned int index);
+  //@}
+
   /**
    * Sets the function used to load static plugins.
    */
@@ -142,6 +192,8 @@ private:
   class vtkPluginsList;
   vtkPluginsList* PluginsList;
 
+  bool LazyLoadPlugins;
+
   void LoadPluginConfigurationXMLConf(std::string const& exe_dir, std::string const& conf);
   void LoadPluginConfigurationXMLHinted(vtkPVXMLElement*, const char* hint, bool forceLoad);
 };
@@ -19,6 +19,8 @@
 #include "vtkDataObject.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVEventTracer.h"
+#include "vtkProcessModule.h"
 #include "vtkQuadricClustering.h"
 #include "vtkTimerLog.h"
 
@@ -33,6 +35,7 @@ vtkPVTimerInformation::vtkPVTimerInformation()
   this->NumberOfLogs = 0;
   this->Logs = NULL;
   this->LogThreshold = 0;
+  this->ChromeTrace = false;
 }
 
 //----------------------------------------------------------------------------
@@ -60,15 +63,35 @@ vtkPVTimerInformation::~vtkPVTimerInformation()
 //----------------------------------------------------------------------------
 void vtkPVTimerInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 828793 << this->LogThreshold;
+  // The original parameters layout is kept when Chrome trace events are not
+  // requested so that peers without ChromeTrace support still understand it.
+  if (this->ChromeTrace)
+  {
+    str << 828794 << this->LogThreshold << 1;
+  }
+  else
+  {
+    str << 828793 << this->LogThreshold;
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkPVTimerInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
-  str >> magic_number >> this->LogThreshold;
-  if (magic_number != 828793)
+  str >> magic_number;
+  this->ChromeTrace = false;
+  if (magic_number == 828793)
+  {
+    str >> this->LogThreshold;
+  }
+  else if (magic_number == 828794)
+  {
+    int chromeTrace;
+    str >> this->LogThreshold >> chromeTrace;
+    this->ChromeTrace = chromeTrace != 0;
+  }
+  else
   {
     vtkErrorMacro("Magic number mismatch.");
   }
@@ -135,6 +158,44 @@ void vtkPVTimerInformation::Reallocate(int num)
 // This ignores the object, and gets the log from the timer.
 void vtkPVTimerInformation::CopyFromObject(vtkObject*)
 {
+  if (this->ChromeTrace)
+  {
+    int pid = 0;
+    std::ostringstream name;
+    vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+    if (pm)
+    {
+      pid = pm->GetPartitionId();
+      switch (pm->GetProcessType())
+      {
+        case vtkProcessModule::PROCESS_CLIENT:
+          name << "client";
+          break;
+        case vtkProcessModule::PROCESS_SERVER:
+          name << "server";
+          break;
+        case vtkProcessModule::PROCESS_DATA_SERVER:
+          name << "dataserver";
+          break;
+        case vtkProcessModule::PROCESS_RENDER_SERVER:
+          name << "renderserver";
+          break;
+        case vtkProcessModule::PROCESS_BATCH:
+          name << "batch";
+          break;
+        default:
+          name << "process";
+          break;
+      }
+    }
+    name << " " << pid;
+
+    std::ostringstream events;
+    vtkPVEventTracer::ExportChromeTraceEvents(events, pid, name.str().c_str());
+    this->InsertLog(0, events.str().c_str());
+    return;
+  }
+
   int length;
   float threshold = this->LogThreshold;
 
@@ -278,6 +339,7 @@ void vtkPVTimerInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 
+  os << indent << "ChromeTrace: " << this->ChromeTrace << endl;
   os << indent << "NumberOfLogs: " << this->NumberOfLogs << endl;
   int idx;
   for (idx = 0; idx < this->NumberOfLogs; ++idx)
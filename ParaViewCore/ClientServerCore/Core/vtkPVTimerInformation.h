@@ -17,6 +17,9 @@
  * @brief   Holds timer log for all processes.
  *
  * I am using this information object to gather timer logs from all processes.
+ * When ChromeTrace is set, the events recorded by vtkPVEventTracer are
+ * gathered instead, as Chrome trace event JSON (see
+ * vtkPVEventTracer::ExportChromeTraceEvents()).
 */
 
 #ifndef vtkPVTimerInformation_h
@@ -41,6 +44,18 @@ public:
   vtkGetMacro(LogThreshold, double);
   //@}
 
+  //@{
+  /**
+   * When set, each log holds the comma separated Chrome trace events recorded
+   * by vtkPVEventTracer on that process, using the partition id as the process
+   * id, instead of the vtkTimerLog dump. This must be set before calling
+   * GatherInformation(). Default is false.
+   */
+  vtkSetMacro(ChromeTrace, bool);
+  vtkGetMacro(ChromeTrace, bool);
+  vtkBooleanMacro(ChromeTrace, bool);
+  //@}
+
   //@{
   /**
    * Access to the logs.
@@ -89,6 +104,7 @@ protected:
   void InsertLog(int id, const char* log);
 
   double LogThreshold;
+  bool ChromeTrace;
   int NumberOfLogs;
   char** Logs;
 
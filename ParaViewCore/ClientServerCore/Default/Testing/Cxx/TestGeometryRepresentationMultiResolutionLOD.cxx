@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestGeometryRepresentationMultiResolutionLOD.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the LOD levels that vtkGeometryRepresentation builds concurrently
+// when UseMultiResolutionLOD is on: rebuilding them gives the same levels
+// every time, finer resolutions keep more points and the input, whose points
+// and arrays are not shared with the levels, is left untouched.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+class vtkTestLODRepresentation : public vtkGeometryRepresentation
+{
+public:
+  static vtkTestLODRepresentation* New();
+  vtkTypeMacro(vtkTestLODRepresentation, vtkGeometryRepresentation);
+
+  using vtkGeometryRepresentation::GetMultiResolutionLOD;
+};
+vtkStandardNewMacro(vtkTestLODRepresentation);
+
+const int NumberOfLevels = 5;
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int kk = 0; kk < a->GetNumberOfComponents(); ++kk)
+    {
+      if (a->GetComponent(cc, kk) != b->GetComponent(cc, kk))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = a->GetArray(cc);
+    if (array && !SameArray(array, b->GetArray(array->GetName())))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  return a && b && a->GetNumberOfPoints() == b->GetNumberOfPoints() &&
+    a->GetNumberOfCells() == b->GetNumberOfCells() &&
+    SameArray(a->GetPoints() ? a->GetPoints()->GetData() : nullptr,
+      b->GetPoints() ? b->GetPoints()->GetData() : nullptr) &&
+    SameArray(a->GetVerts()->GetData(), b->GetVerts()->GetData()) &&
+    SameArray(a->GetLines()->GetData(), b->GetLines()->GetData()) &&
+    SameArray(a->GetPolys()->GetData(), b->GetPolys()->GetData()) &&
+    SameArray(a->GetStrips()->GetData(), b->GetStrips()->GetData()) &&
+    SameAttributes(a->GetPointData(), b->GetPointData()) &&
+    SameAttributes(a->GetCellData(), b->GetCellData());
+}
+
+// Calls `functor` on the pairs of leaves of two data objects with the same
+// structure.
+template <typename Functor>
+bool ForEachLeaf(vtkDataObject* a, vtkDataObject* b, Functor functor)
+{
+  auto cda = vtkCompositeDataSet::SafeDownCast(a);
+  auto cdb = vtkCompositeDataSet::SafeDownCast(b);
+  if (!cda || !cdb)
+  {
+    return !cda && !cdb && functor(vtkPolyData::SafeDownCast(a), vtkPolyData::SafeDownCast(b));
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cda->NewIterator());
+  int numLeaves = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++numLeaves)
+  {
+    if (!functor(vtkPolyData::SafeDownCast(iter->GetCurrentDataObject()),
+          vtkPolyData::SafeDownCast(cdb->GetDataSet(iter))))
+    {
+      return false;
+    }
+  }
+  return numLeaves > 0;
+}
+
+bool DoesNotShareArrays(vtkPolyData* input, vtkPolyData* lod)
+{
+  if (!input || !lod)
+  {
+    return false;
+  }
+  if (input->GetPoints() && lod->GetPoints() &&
+    input->GetPoints()->GetData() == lod->GetPoints()->GetData())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < input->GetPointData()->GetNumberOfArrays(); ++cc)
+  {
+    for (int kk = 0; kk < lod->GetPointData()->GetNumberOfArrays(); ++kk)
+    {
+      if (input->GetPointData()->GetAbstractArray(cc) ==
+        lod->GetPointData()->GetAbstractArray(kk))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+vtkIdType GetNumberOfPoints(vtkDataObject* data)
+{
+  vtkIdType numPoints = 0;
+  ForEachLeaf(data, data, [&numPoints](vtkPolyData* pd, vtkPolyData*) {
+    numPoints += pd ? pd->GetNumberOfPoints() : 0;
+    return true;
+  });
+  return numPoints;
+}
+
+bool TestLevels(vtkDataObject* input)
+{
+  vtkSmartPointer<vtkDataObject> original;
+  original.TakeReference(input->NewInstance());
+  original->DeepCopy(input);
+
+  vtkNew<vtkTestLODRepresentation> repr;
+  std::vector<vtkSmartPointer<vtkDataObject> > reference(NumberOfLevels);
+  for (int level = 0; level < NumberOfLevels; ++level)
+  {
+    vtkDataObject* lod =
+      repr->GetMultiResolutionLOD(input, static_cast<double>(level) / (NumberOfLevels - 1));
+    TASSERT(lod != nullptr && GetNumberOfPoints(lod) > 0);
+    TASSERT(ForEachLeaf(input, lod, DoesNotShareArrays));
+    reference[level].TakeReference(lod->NewInstance());
+    reference[level]->DeepCopy(lod);
+  }
+  for (int level = 1; level < NumberOfLevels; ++level)
+  {
+    TASSERT(GetNumberOfPoints(reference[level - 1]) <= GetNumberOfPoints(reference[level]));
+  }
+
+  // Rebuild the levels several times; they must not depend on how the
+  // decimators were scheduled.
+  for (int iteration = 0; iteration < 10; ++iteration)
+  {
+    input->Modified();
+    for (int level = NumberOfLevels - 1; level >= 0; --level)
+    {
+      vtkDataObject* lod =
+        repr->GetMultiResolutionLOD(input, static_cast<double>(level) / (NumberOfLevels - 1));
+      TASSERT(ForEachLeaf(lod, reference[level], SamePolyData));
+    }
+  }
+
+  TASSERT(ForEachLeaf(input, original, SamePolyData));
+  return true;
+}
+}
+
+int TestGeometryRepresentationMultiResolutionLOD(int, char* [])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(128);
+  sphere->SetPhiResolution(128);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->Update();
+  vtkSmartPointer<vtkPolyData> pd = vtkPolyData::SafeDownCast(elevation->GetOutput());
+
+  vtkNew<vtkSphereSource> sphere2;
+  sphere2->SetCenter(2, 0, 0);
+  sphere2->SetThetaResolution(64);
+  sphere2->SetPhiResolution(96);
+  sphere2->Update();
+
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, pd);
+  mb->SetBlock(1, sphere2->GetOutput());
+
+  if (!TestLevels(pd) || !TestLevels(mb))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVEventTracer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPVEventTracer.h"
+#include "vtkPVTimerInformation.h"
+
+#include "vtk_jsoncpp.h"
+
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+const int NumberOfThreads = 4;
+const int EventsPerThread = 500;
+
+bool ParseTrace(const std::string& events, Json::Value& root)
+{
+  std::istringstream json("[" + events + "]");
+  Json::CharReaderBuilder builder;
+  builder["collectComments"] = false;
+  return parseFromStream(builder, json, &root, nullptr) && root.isArray();
+}
+
+bool TestParametersStream()
+{
+  // Without ChromeTrace, the parameters use the original layout so that
+  // older peers can read them.
+  vtkNew<vtkPVTimerInformation> info;
+  info->SetLogThreshold(0.5);
+  vtkMultiProcessStream legacy;
+  info->CopyParametersToStream(legacy);
+  int magic;
+  double threshold;
+  legacy >> magic >> threshold;
+  TASSERT(magic == 828793 && threshold == 0.5 && legacy.Empty());
+
+  vtkMultiProcessStream stream;
+  info->ChromeTraceOn();
+  info->CopyParametersToStream(stream);
+  vtkNew<vtkPVTimerInformation> copy;
+  copy->CopyParametersFromStream(stream);
+  TASSERT(copy->GetChromeTrace() && copy->GetLogThreshold() == 0.5);
+
+  vtkMultiProcessStream old;
+  old << 828793 << 0.25;
+  copy->CopyParametersFromStream(old);
+  TASSERT(!copy->GetChromeTrace() && copy->GetLogThreshold() == 0.25);
+  return true;
+}
+
+bool TestConcurrentExport()
+{
+  vtkPVEventTracer::SetBufferCapacity(2 * EventsPerThread);
+  vtkPVEventTracer::SetEnabled(true);
+  vtkPVEventTracer::Reset();
+
+  // Export repeatedly while the threads are recording; every intermediate
+  // export must be valid JSON made of complete events.
+  std::atomic<int> running(NumberOfThreads);
+  std::vector<std::thread> threads;
+  for (int tt = 0; tt < NumberOfThreads; ++tt)
+  {
+    threads.emplace_back([tt, &running]() {
+      const std::string name = "event-" + std::to_string(tt);
+      for (int cc = 0; cc < EventsPerThread; ++cc)
+      {
+        vtkPVEventTracerScope scope(name.c_str(), "test");
+      }
+      --running;
+    });
+  }
+  bool valid = true;
+  while (running > 0)
+  {
+    std::ostringstream events;
+    vtkPVEventTracer::ExportChromeTraceEvents(events, 3, nullptr);
+    Json::Value root;
+    valid = valid && (events.str().empty() || ParseTrace(events.str(), root));
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  TASSERT(valid);
+  TASSERT(vtkPVEventTracer::GetNumberOfEvents() == NumberOfThreads * EventsPerThread);
+
+  std::ostringstream events;
+  vtkPVEventTracer::ExportChromeTraceEvents(events, 3, "test process");
+  Json::Value root;
+  TASSERT(ParseTrace(events.str(), root));
+  TASSERT(static_cast<int>(root.size()) == NumberOfThreads * EventsPerThread + 1);
+
+  const Json::Value& metadata = root[0];
+  TASSERT(metadata["ph"].asString() == "M" && metadata["name"].asString() == "process_name");
+  TASSERT(metadata["pid"].asInt() == 3);
+  TASSERT(metadata["args"]["name"].asString() == "test process");
+
+  std::map<std::string, int> counts;
+  std::map<std::string, int> tids;
+  for (Json::ArrayIndex cc = 1; cc < root.size(); ++cc)
+  {
+    const Json::Value& event = root[cc];
+    TASSERT(event["ph"].asString() == "X" && event["cat"].asString() == "test");
+    TASSERT(event["pid"].asInt() == 3);
+    TASSERT(event["ts"].asDouble() > 0 && event["dur"].asDouble() >= 0);
+    const std::string name = event["name"].asString();
+    // all events of a thread share the same timeline row.
+    TASSERT(tids.insert(std::make_pair(name, event["tid"].asInt())).first->second ==
+      event["tid"].asInt());
+    ++counts[name];
+  }
+  TASSERT(static_cast<int>(counts.size()) == NumberOfThreads);
+  for (const auto& count : counts)
+  {
+    TASSERT(count.second == EventsPerThread);
+  }
+
+  // The timer information gathers the same events when ChromeTrace is set.
+  vtkNew<vtkPVTimerInformation> info;
+  info->ChromeTraceOn();
+  info->CopyFromObject(nullptr);
+  TASSERT(info->GetNumberOfLogs() == 1 && ParseTrace(info->GetLog(0), root));
+  TASSERT(static_cast<int>(root.size()) == NumberOfThreads * EventsPerThread + 1);
+
+  vtkPVEventTracer::Reset();
+  TASSERT(vtkPVEventTracer::GetNumberOfEvents() == 0);
+  vtkPVEventTracer::SetEnabled(false);
+  {
+    vtkPVEventTracerScope scope("disabled", "test");
+  }
+  TASSERT(vtkPVEventTracer::GetNumberOfEvents() == 0);
+  return true;
+}
+}
+
+int TestPVEventTracer(int, char* [])
+{
+  if (!TestParametersStream() || !TestConcurrentExport())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,350 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVProminentValuesInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the distinct values gathered by vtkPVProminentValuesInformation:
+// numeric arrays scanned directly give the same values as arrays going
+// through vtkAbstractArray::GetProminentComponentValues(), -0 and 0 as well
+// as all NaNs are single values, MaxDiscreteValues is a cutoff unless Force
+// is set, and the information of all processes, with integer values on some
+// of them and floating point values on others, is gathered through
+// CopyToStream() and CopyFromStream() on the root.
+
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkVariantArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+typedef std::vector<std::vector<double> > TupleList;
+
+vtkSmartPointer<vtkPVProminentValuesInformation> NewInformation(int numComps, bool force)
+{
+  auto info = vtkSmartPointer<vtkPVProminentValuesInformation>::New();
+  info->SetFieldName("values");
+  info->SetFieldAssociation("POINTS");
+  info->SetNumberOfComponents(numComps);
+  info->SetFraction(0.);
+  info->SetUncertainty(0.);
+  info->SetForce(force);
+  return info;
+}
+
+vtkSmartPointer<vtkPVProminentValuesInformation> GetInformation(
+  vtkAbstractArray* array, bool force = false)
+{
+  auto info = NewInformation(array->GetNumberOfComponents(), force);
+  info->CopyDistinctValuesFromObject(array);
+  return info;
+}
+
+// Sorted distinct values of a component (or tuples when component is -1).
+TupleList GetValues(vtkPVProminentValuesInformation* info, int component)
+{
+  TupleList values;
+  vtkAbstractArray* array = info->GetProminentComponentValues(component);
+  if (!array)
+  {
+    return values;
+  }
+  vtkVariantArray* variants = vtkVariantArray::SafeDownCast(array);
+  const int numComps = array->GetNumberOfComponents();
+  for (vtkIdType t = 0; variants && t < array->GetNumberOfTuples(); ++t)
+  {
+    std::vector<double> tuple(numComps);
+    for (int c = 0; c < numComps; ++c)
+    {
+      tuple[c] = variants->GetValue(t * numComps + c).ToDouble();
+    }
+    values.push_back(tuple);
+  }
+  array->Delete();
+  return values;
+}
+
+bool SameValues(const TupleList& a, const TupleList& b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (size_t t = 0; t < a.size(); ++t)
+  {
+    if (a[t].size() != b[t].size())
+    {
+      return false;
+    }
+    for (size_t c = 0; c < a[t].size(); ++c)
+    {
+      // NaN is a value like any other here.
+      if (a[t][c] != b[t][c] && (a[t][c] == a[t][c] || b[t][c] == b[t][c]))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameInformation(vtkPVProminentValuesInformation* a, vtkPVProminentValuesInformation* b)
+{
+  TASSERT(a->GetNumberOfComponents() == b->GetNumberOfComponents());
+  TASSERT(a->GetValid() == b->GetValid());
+  const int numComps = a->GetNumberOfComponents();
+  for (int c = (numComps > 1 ? -1 : 0); c < numComps; ++c)
+  {
+    TASSERT(!GetValues(a, c).empty());
+    TASSERT(SameValues(GetValues(a, c), GetValues(b, c)));
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkPVProminentValuesInformation> RoundTrip(vtkPVProminentValuesInformation* info)
+{
+  vtkClientServerStream css;
+  info->CopyToStream(&css);
+  auto copy = vtkSmartPointer<vtkPVProminentValuesInformation>::New();
+  copy->CopyFromStream(&css);
+  return copy;
+}
+
+// Typed scan of standard layout arrays against the vtkVariant based scan of
+// arrays with another layout or type.
+bool TestTypedAndVariant()
+{
+  vtkNew<vtkDoubleArray> typed;
+  vtkNew<vtkSOADataArrayTemplate<double> > soa;
+  typed->SetNumberOfComponents(3);
+  soa->SetNumberOfComponents(3);
+  typed->SetNumberOfTuples(1000);
+  soa->SetNumberOfTuples(1000);
+  for (vtkIdType t = 0; t < 1000; ++t)
+  {
+    const double tuple[3] = { static_cast<double>(t % 3), 0.5 * (t % 5), (t % 2) - 1. };
+    typed->SetTypedTuple(t, tuple);
+    soa->SetTypedTuple(t, tuple);
+  }
+  TASSERT(SameInformation(GetInformation(typed), GetInformation(soa)));
+  TASSERT(GetValues(GetInformation(typed), -1).size() == 30);
+  TASSERT(GetValues(GetInformation(typed), 1).size() == 5);
+
+  vtkNew<vtkIntArray> ints;
+  vtkNew<vtkVariantArray> variants;
+  for (int t = 0; t < 1000; ++t)
+  {
+    ints->InsertNextValue((t * 7) % 11 - 5);
+    variants->InsertNextValue(vtkVariant((t * 7) % 11 - 5));
+  }
+  TASSERT(SameInformation(GetInformation(ints), GetInformation(variants)));
+  TASSERT(GetValues(GetInformation(ints), 0).size() == 11);
+  TASSERT(GetValues(GetInformation(ints), 0).front()[0] == -5.);
+
+  // the typed values keep their type through the stream.
+  TASSERT(SameInformation(GetInformation(ints), RoundTrip(GetInformation(ints))));
+  TASSERT(SameInformation(GetInformation(typed), RoundTrip(GetInformation(typed))));
+  return true;
+}
+
+bool TestZerosAndNaNs()
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double values[] = { 1., nan, -0., 0., -nan, 1., std::nan("1"), -0. };
+  vtkNew<vtkDoubleArray> doubles;
+  vtkNew<vtkFloatArray> floats;
+  for (double value : values)
+  {
+    doubles->InsertNextValue(value);
+    floats->InsertNextValue(static_cast<float>(value));
+  }
+  for (vtkDataArray* array : { static_cast<vtkDataArray*>(doubles.Get()), floats.Get() })
+  {
+    auto info = GetInformation(array);
+    TASSERT(info->GetValid());
+    const TupleList distincts = GetValues(info, 0);
+    // NaN comes after all the numbers.
+    TASSERT(distincts.size() == 3);
+    TASSERT(distincts[0][0] == 0. && !std::signbit(distincts[0][0]));
+    TASSERT(distincts[1][0] == 1.);
+    TASSERT(distincts[2][0] != distincts[2][0]);
+
+    // and stays a single value when sent and merged.
+    auto copy = RoundTrip(info);
+    TASSERT(SameInformation(info, copy));
+    copy->AddInformation(info);
+    TASSERT(SameInformation(info, copy));
+  }
+
+  vtkNew<vtkDoubleArray> tuples;
+  tuples->SetNumberOfComponents(2);
+  const double tuple0[2] = { -0., nan };
+  const double tuple1[2] = { 0., -nan };
+  tuples->InsertNextTuple(tuple0);
+  tuples->InsertNextTuple(tuple1);
+  TASSERT(GetValues(GetInformation(tuples), -1).size() == 1);
+  return true;
+}
+
+bool TestMaxDiscreteValues()
+{
+  vtkNew<vtkIntArray> ints;
+  vtkNew<vtkVariantArray> variants;
+  for (int t = 0; t < 400; ++t)
+  {
+    ints->InsertNextValue(t % 40);
+    variants->InsertNextValue(vtkVariant(t % 40));
+  }
+  for (vtkAbstractArray* array : { static_cast<vtkAbstractArray*>(ints.Get()), variants.Get() })
+  {
+    auto info = GetInformation(array);
+    TASSERT(!info->GetValid());
+    TASSERT(GetValues(info, 0).empty());
+    TASSERT(!RoundTrip(info)->GetValid());
+
+    info = GetInformation(array, true);
+    TASSERT(info->GetValid());
+    TASSERT(GetValues(info, 0).size() == 40);
+    TASSERT(SameInformation(info, RoundTrip(info)));
+
+    array->SetMaxDiscreteValues(50);
+    info = GetInformation(array);
+    TASSERT(info->GetValid());
+    TASSERT(GetValues(info, 0).size() == 40);
+    // the cutoff is restored after a forced scan.
+    GetInformation(array, true);
+    TASSERT(array->GetMaxDiscreteValues() == 50);
+    array->SetMaxDiscreteValues(vtkAbstractArray::MAX_DISCRETE_VALUES);
+  }
+
+  // exactly MaxDiscreteValues values are kept.
+  ints->SetMaxDiscreteValues(39);
+  TASSERT(!GetInformation(ints)->GetValid());
+  ints->SetMaxDiscreteValues(40);
+  TASSERT(GetInformation(ints)->GetValid());
+  return true;
+}
+
+// Integer values on even processes, floating point values on odd ones. The
+// first component overlaps between processes, the second one is the process
+// id.
+vtkSmartPointer<vtkDataArray> NewProcessArray(int rank)
+{
+  vtkSmartPointer<vtkDataArray> array;
+  if (rank % 2 == 0)
+  {
+    array = vtkSmartPointer<vtkIntArray>::New();
+  }
+  else
+  {
+    array = vtkSmartPointer<vtkDoubleArray>::New();
+  }
+  array->SetName("values");
+  array->SetNumberOfComponents(2);
+  for (int t = 0; t < 100; ++t)
+  {
+    const double value = rank % 2 == 0 ? (t % 4) + rank : 0.5 * (t % 4) + rank;
+    array->InsertNextTuple2(value, rank);
+  }
+  return array;
+}
+
+bool TestGather(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkClientServerStream css;
+  GetInformation(NewProcessArray(rank))->CopyToStream(&css);
+  const unsigned char* data;
+  size_t length;
+  css.GetData(&data, &length);
+
+  vtkIdType localLength = static_cast<vtkIdType>(length);
+  std::vector<vtkIdType> lengths(numProcs);
+  controller->Gather(&localLength, lengths.data(), 1, 0);
+  std::vector<vtkIdType> offsets(numProcs, 0);
+  for (int cc = 1; cc < numProcs; ++cc)
+  {
+    offsets[cc] = offsets[cc - 1] + lengths[cc - 1];
+  }
+  std::vector<unsigned char> buffer(
+    rank == 0 ? static_cast<size_t>(offsets[numProcs - 1] + lengths[numProcs - 1]) : 1);
+  controller->GatherV(data, buffer.data(), localLength, lengths.data(), offsets.data(), 0);
+  if (rank != 0)
+  {
+    return true;
+  }
+
+  auto gathered = NewInformation(2, false);
+  vtkNew<vtkDoubleArray> all;
+  all->SetNumberOfComponents(2);
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    vtkClientServerStream received;
+    received.SetData(buffer.data() + offsets[cc], lengths[cc]);
+    auto info = vtkSmartPointer<vtkPVProminentValuesInformation>::New();
+    info->CopyFromStream(&received);
+    TASSERT(SameInformation(info, GetInformation(NewProcessArray(cc))));
+    gathered->AddInformation(info);
+
+    vtkSmartPointer<vtkDataArray> array = NewProcessArray(cc);
+    for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+    {
+      all->InsertNextTuple(array->GetTuple(t));
+    }
+  }
+
+  // the gathered values, of mixed types, are the values of all processes.
+  auto expected = GetInformation(all);
+  TASSERT(SameInformation(gathered, expected));
+  TASSERT(SameInformation(RoundTrip(gathered), expected));
+  TASSERT(static_cast<int>(GetValues(gathered, 1).size()) == numProcs);
+  return true;
+}
+}
+
+int TestPVProminentValuesInformation(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int valid = TestTypedAndVariant() && TestZerosAndNaNs() && TestMaxDiscreteValues() &&
+      TestGather(controller)
+    ? 1
+    : 0;
+  int allValid = 0;
+  controller->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -28,6 +28,11 @@
  * valid Python variable, it has to be accessed through a dictionary called
  * arrays (i.e. arrays['array_name']). The points can be accessed using the
  * points variable.
+ *
+ * For composite datasets, the expression is normally evaluated on
+ * composite arrays, i.e. block by block. When BatchCompositeArrays is
+ * enabled, the arrays used by the expression are instead concatenated across
+ * blocks so that the expression is evaluated once on contiguous arrays.
 */
 
 #ifndef vtkPythonCalculator_h
@@ -53,6 +58,22 @@ public:
   vtkGetMacro(ArrayAssociation, int);
   //@}
 
+  //@{
+  /**
+   * When set and the first input is a composite dataset, the arrays
+   * referenced by the expression are concatenated across all blocks into
+   * contiguous arrays, the expression is evaluated once and the result is
+   * split back into per-block arrays referring to the same buffer. Expressions
+   * that cannot be evaluated that way (e.g. ones that need the dataset of
+   * each block, or produce results not matching the number of tuples) are
+   * evaluated block by block as when this flag is off. Time spent in each
+   * stage is recorded in the vtkTimerLog. Default is false.
+   */
+  vtkSetMacro(BatchCompositeArrays, bool);
+  vtkGetMacro(BatchCompositeArrays, bool);
+  vtkBooleanMacro(BatchCompositeArrays, bool);
+  //@}
+
   //@{
   /**
    * Set the text of the python expression to execute. This expression
@@ -96,6 +117,7 @@ protected:
   char* Expression;
   char* ArrayName;
   int ArrayAssociation;
+  bool BatchCompositeArrays;
 
 private:
   vtkPythonCalculator(const vtkPythonCalculator&) = delete;
@@ -18,9 +18,11 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
 #include "vtkCommand.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkCompositePolyDataMapper2.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkInformation.h"
@@ -40,9 +42,12 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVUpdateSuppressor.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
+#include "vtkSMPTools.h"
 #include "vtkScalarsToColors.h"
 #include "vtkSelection.h"
 #include "vtkSelectionConverter.h"
@@ -105,6 +110,85 @@ protected:
 };
 vtkStandardNewMacro(vtkGeometryRepresentationMultiBlockMaker);
 
+namespace
+{
+// Number of LOD resolutions, evenly spaced in [0, 1], built by
+// vtkGeometryRepresentation::GetMultiResolutionLOD().
+const int VTK_NUMBER_OF_LOD_LEVELS = 5;
+
+// Computes the state the decimators would otherwise update lazily on the
+// data shared by all LOD levels: the bounds of the points and the size of the
+// cell arrays, which the decimators squeeze. The levels then only read it.
+void vtkPrepareLODInput(vtkDataObject* data)
+{
+  if (auto pd = vtkPolyData::SafeDownCast(data))
+  {
+    double bounds[6];
+    pd->GetBounds(bounds);
+    if (pd->GetPoints())
+    {
+      pd->GetPoints()->GetBounds(bounds);
+    }
+    pd->GetVerts()->Squeeze();
+    pd->GetLines()->Squeeze();
+    pd->GetPolys()->Squeeze();
+    pd->GetStrips()->Squeeze();
+  }
+  else if (auto cd = vtkCompositeDataSet::SafeDownCast(data))
+  {
+    vtkCompositeDataIterator* iter = cd->NewIterator();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkPrepareLODInput(iter->GetCurrentDataObject());
+    }
+    iter->Delete();
+  }
+}
+
+// Returns a shallow copy of `data`, prepared with vtkPrepareLODInput(). Points,
+// connectivity and attributes are shared, but every polydata gets its own cell
+// arrays since traversing a vtkCellArray is not thread safe.
+vtkDataObject* vtkNewLODInput(vtkDataObject* data)
+{
+  if (auto pd = vtkPolyData::SafeDownCast(data))
+  {
+    vtkPolyData* clone = vtkPolyData::New();
+    clone->ShallowCopy(pd);
+    vtkCellArray* cells[4] = { pd->GetVerts(), pd->GetLines(), pd->GetPolys(), pd->GetStrips() };
+    vtkNew<vtkCellArray> cloneCells[4];
+    for (int cc = 0; cc < 4; ++cc)
+    {
+      cloneCells[cc]->SetCells(cells[cc]->GetNumberOfCells(), cells[cc]->GetData());
+    }
+    clone->DeleteCells();
+    clone->SetVerts(cloneCells[0]);
+    clone->SetLines(cloneCells[1]);
+    clone->SetPolys(cloneCells[2]);
+    clone->SetStrips(cloneCells[3]);
+    return clone;
+  }
+
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(data))
+  {
+    vtkCompositeDataSet* clone = cd->NewInstance();
+    clone->CopyStructure(cd);
+    vtkCompositeDataIterator* iter = cd->NewIterator();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDataObject* leaf = vtkNewLODInput(iter->GetCurrentDataObject());
+      clone->SetDataSet(iter, leaf);
+      leaf->Delete();
+    }
+    iter->Delete();
+    return clone;
+  }
+
+  vtkDataObject* clone = data->NewInstance();
+  clone->ShallowCopy(data);
+  return clone;
+}
+}
+
 //*****************************************************************************
 
 vtkStandardNewMacro(vtkGeometryRepresentation);
@@ -344,6 +428,18 @@ int vtkGeometryRepresentation::ProcessViewRequest(
         // the rendering node as and when needed.
         vtkPVView::SetPieceLOD(inInfo, this, this->LODOutlineFilter->GetOutputDataObject(0));
       }
+      else if (inInfo->Has(vtkPVRenderView::USE_MULTIRESOLUTION_LOD()))
+      {
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
+        vtkDataObject* lod = this->GetMultiResolutionLOD(data, factor);
+
+        // the view ignores new LOD geometry unless the data changed, so force
+        // it when switching to another level.
+        vtkPVView::SetPieceLOD(inInfo, this, lod, 0, 0, lod != this->LODLevelsLastPiece);
+        this->LODLevelsLastPiece = lod;
+      }
       else
       {
         if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
@@ -354,6 +450,8 @@ int vtkGeometryRepresentation::ProcessViewRequest(
           this->Decimator->SetLODFactor(factor);
         }
 
+        this->LODLevels.clear();
+        this->LODLevelsLastPiece = nullptr;
         this->Decimator->SetInputDataObject(data);
         this->Decimator->Update();
 
@@ -425,6 +523,49 @@ int vtkGeometryRepresentation::RequestUpdateExtent(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkDataObject* vtkGeometryRepresentation::GetMultiResolutionLOD(vtkDataObject* data, double factor)
+{
+  if (this->LODLevelsSource != data || this->LODLevelsTime != data->GetMTime() ||
+    this->LODLevels.empty())
+  {
+    // Every level gets its own shallow copy of the input and its own decimator
+    // so that they can execute concurrently; only Update() is called from the
+    // worker threads.
+    vtkPrepareLODInput(data);
+    std::vector<vtkSmartPointer<vtkDataObject> > inputs(VTK_NUMBER_OF_LOD_LEVELS);
+    std::vector<vtkSmartPointer<vtkGeometryRepresentation_detail::DecimationFilterType> >
+      decimators(VTK_NUMBER_OF_LOD_LEVELS);
+    for (int level = 0; level < VTK_NUMBER_OF_LOD_LEVELS; ++level)
+    {
+      inputs[level].TakeReference(vtkNewLODInput(data));
+      decimators[level] =
+        vtkSmartPointer<vtkGeometryRepresentation_detail::DecimationFilterType>::New();
+      decimators[level]->SetLODFactor(static_cast<double>(level) / (VTK_NUMBER_OF_LOD_LEVELS - 1));
+      decimators[level]->SetInputDataObject(inputs[level]);
+    }
+
+    vtkSMPTools::For(0, VTK_NUMBER_OF_LOD_LEVELS, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType level = begin; level < end; ++level)
+      {
+        decimators[level]->Update();
+      }
+    });
+
+    this->LODLevels.resize(VTK_NUMBER_OF_LOD_LEVELS);
+    for (int level = 0; level < VTK_NUMBER_OF_LOD_LEVELS; ++level)
+    {
+      this->LODLevels[level] = decimators[level]->GetOutputDataObject(0);
+    }
+    this->LODLevelsSource = data;
+    this->LODLevelsTime = data->GetMTime();
+  }
+
+  const int level =
+    vtkMath::Round(vtkMath::ClampValue(factor, 0., 1.) * (VTK_NUMBER_OF_LOD_LEVELS - 1));
+  return this->LODLevels[level];
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
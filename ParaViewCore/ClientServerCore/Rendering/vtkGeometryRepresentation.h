@@ -29,10 +29,12 @@
 #define vtkGeometryRepresentation_h
 #include <array>         // needed for array
 #include <unordered_map> // needed for unordered_map
+#include <vector>        // needed for vector
 
 #include "vtkPVClientServerCoreRenderingModule.h" // needed for exports
 #include "vtkPVDataRepresentation.h"
-#include "vtkProperty.h" // needed for VTK_POINTS etc.
+#include "vtkProperty.h"     // needed for VTK_POINTS etc.
+#include "vtkSmartPointer.h" // needed for vtkSmartPointer
 
 class vtkCallbackCommand;
 class vtkCompositeDataDisplayAttributes;
@@ -397,6 +399,14 @@ protected:
    */
   virtual bool NeedsOrderedCompositing();
 
+  /**
+   * Returns the decimated geometry for the level closest to the LOD
+   * resolution `factor`. All levels are decimated at once, in parallel, the
+   * first time this is called for a given `data` and reused until it is
+   * modified. Used when vtkPVRenderView::USE_MULTIRESOLUTION_LOD() is set.
+   */
+  vtkDataObject* GetMultiResolutionLOD(vtkDataObject* data, double factor);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
@@ -434,6 +444,11 @@ protected:
   std::unordered_map<unsigned int, double> BlockOpacities;
   std::unordered_map<unsigned int, std::array<double, 3> > BlockColors;
 
+  std::vector<vtkSmartPointer<vtkDataObject> > LODLevels;
+  vtkDataObject* LODLevelsSource = nullptr;
+  vtkMTimeType LODLevelsTime = 0;
+  vtkDataObject* LODLevelsLastPiece = nullptr;
+
 private:
   vtkGeometryRepresentation(const vtkGeometryRepresentation&) = delete;
   void operator=(const vtkGeometryRepresentation&) = delete;
@@ -37,6 +37,7 @@
 #include "vtkOutlineFilter.h"
 #include "vtkOverlappingAMR.h"
 #include "vtkPVConfig.h"
+#include "vtkPVEventTracer.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
@@ -592,6 +593,7 @@ int vtkMPIMoveData::RequestData(
 // We will marshal more than once, but that is OK.
 void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* output, int n)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::DataServerAllToN", "data movement");
   vtkMultiProcessController* controller = this->Controller;
   int m;
 
@@ -637,6 +639,7 @@ void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* outpu
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* output)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::DataServerGatherAll", "data movement");
   int numProcs = this->Controller->GetNumberOfProcesses();
 
   if (numProcs <= 1)
@@ -703,6 +706,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject* output)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::DataServerGatherToZero", "data movement");
   int numProcs = this->Controller->GetNumberOfProcesses();
   if (numProcs == 1)
   {
@@ -793,6 +797,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::DataServerSendToRenderServer", "data movement");
   vtkSocketCommunicator* com = this->MPIMToNSocketConnection->GetSocketCommunicator();
 
   if (com == 0)
@@ -817,6 +822,8 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
 {
+  vtkPVEventTracerScope traceScope(
+    "vtkMPIMoveData::RenderServerReceiveFromDataServer", "data movement");
   vtkSocketCommunicator* com = this->MPIMToNSocketConnection->GetSocketCommunicator();
 
   if (com == 0)
@@ -850,6 +857,8 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
 {
+  vtkPVEventTracerScope traceScope(
+    "vtkMPIMoveData::DataServerZeroSendToRenderServerZero", "data movement");
   int myId = this->Controller->GetLocalProcessId();
 
   if (myId == 0)
@@ -879,6 +888,8 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* data)
 {
+  vtkPVEventTracerScope traceScope(
+    "vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero", "data movement");
   int myId = this->Controller->GetLocalProcessId();
 
   if (myId == 0)
@@ -917,6 +928,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::DataServerSendToClient", "data movement");
   if (this->ClientDataServerSocketController == NULL)
   {
     return;
@@ -942,6 +954,7 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::ClientReceiveFromDataServer", "data movement");
   vtkCommunicator* com = 0;
   com = this->ClientDataServerSocketController->GetCommunicator();
   if (com == 0)
@@ -973,6 +986,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
 {
+  vtkPVEventTracerScope traceScope("vtkMPIMoveData::RenderServerZeroBroadcast", "data movement");
   (void)data; // shut up warning
   int numProcs = this->Controller->GetNumberOfProcesses();
   if (numProcs <= 1)
@@ -20,6 +20,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkPVConfig.h"
+#include "vtkPVEventTracer.h"
 #include "vtkSquirtCompressor.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
@@ -27,9 +28,65 @@
 #include "vtkNvPipeCompressor.h"
 #endif
 
+#include <algorithm>
 #include <assert.h>
+#include <cstring>
 #include <sstream>
 
+namespace
+{
+// Size, in pixels, of the square tiles compared and sent in delta frames.
+const int vtkPVCSSRTileSize = 64;
+
+// header[0] value identifying a delta frame. 0 is used for invalid images and
+// 1 for full images.
+const int vtkPVCSSRDeltaFrame = 2;
+
+//----------------------------------------------------------------------------
+// Copies the tiles flagged in `bitmap` between `image` and `strip`, in which
+// they are stacked on top of each other. Partial tiles along the right and top
+// edges of the image only fill part of their slot in the strip.
+void vtkPVCSSRCopyTiles(unsigned char* image, unsigned char* strip, int width, int height,
+  int numComps, const unsigned char* bitmap, bool toStrip)
+{
+  const int tileSize = vtkPVCSSRTileSize;
+  const int numTilesX = (width + tileSize - 1) / tileSize;
+  const int numTilesY = (height + tileSize - 1) / tileSize;
+  const size_t stripRowSize = static_cast<size_t>(tileSize) * numComps;
+  const size_t imageRowSize = static_cast<size_t>(width) * numComps;
+  size_t stripTile = 0;
+  for (int ty = 0; ty < numTilesY; ++ty)
+  {
+    for (int tx = 0; tx < numTilesX; ++tx)
+    {
+      const int tile = ty * numTilesX + tx;
+      if ((bitmap[tile / 8] & (1 << (tile % 8))) == 0)
+      {
+        continue;
+      }
+      const int x0 = tx * tileSize;
+      const int y0 = ty * tileSize;
+      const size_t rowSize = static_cast<size_t>(std::min(tileSize, width - x0)) * numComps;
+      const int numRows = std::min(tileSize, height - y0);
+      for (int row = 0; row < numRows; ++row)
+      {
+        unsigned char* imagePtr = image + (y0 + row) * imageRowSize + x0 * numComps;
+        unsigned char* stripPtr = strip + (stripTile * tileSize + row) * stripRowSize;
+        if (toStrip)
+        {
+          memcpy(stripPtr, imagePtr, rowSize);
+        }
+        else
+        {
+          memcpy(imagePtr, stripPtr, rowSize);
+        }
+      }
+      ++stripTile;
+    }
+  }
+}
+}
+
 vtkStandardNewMacro(vtkPVClientServerSynchronizedRenderers);
 vtkCxxSetObjectMacro(vtkPVClientServerSynchronizedRenderers, Compressor, vtkImageCompressor);
 //----------------------------------------------------------------------------
@@ -37,7 +94,11 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(NULL)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , DeltaFrames(false)
+  , LastFrame(vtkUnsignedCharArray::New())
+  , LastFrameLossy(false)
 {
+  this->LastFrameSize[0] = this->LastFrameSize[1] = 0;
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
 
@@ -45,11 +106,40 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
 vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers()
 {
   this->SetCompressor(NULL);
+  this->LastFrame->Delete();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVClientServerSynchronizedRenderers::CanSendDeltaFrame(vtkRawImage& image)
+{
+  // vtkNvPipeCompressor encodes images as a video stream and cannot compress
+  // independent tiles.
+  return this->DeltaFrames && image.IsValid() && this->LastFrameSize[0] == image.GetWidth() &&
+    this->LastFrameSize[1] == image.GetHeight() &&
+    this->LastFrame->GetNumberOfComponents() == image.GetRawPtr()->GetNumberOfComponents() &&
+    !(this->LossLessCompression && this->LastFrameLossy) &&
+    !(this->Compressor && this->Compressor->IsA("vtkNvPipeCompressor"));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::UpdateLastFrame(vtkRawImage& image)
+{
+  if (!this->DeltaFrames || !image.IsValid())
+  {
+    this->LastFrame->Initialize();
+    this->LastFrameSize[0] = this->LastFrameSize[1] = 0;
+    return;
+  }
+  this->LastFrame->DeepCopy(image.GetRawPtr());
+  this->LastFrameSize[0] = image.GetWidth();
+  this->LastFrameSize[1] = image.GetHeight();
 }
 
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 {
+  vtkPVEventTracerScope traceScope(
+    "vtkPVClientServerSynchronizedRenderers::MasterEndRender", "compositing");
   // receive image from slave.
   assert(this->ParallelController->IsA("vtkSocketController") ||
     this->ParallelController->IsA("vtkCompositeMultiProcessController"));
@@ -58,7 +148,53 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 
   int header[4];
   this->ParallelController->Receive(header, 4, 1, 0x023430);
-  if (header[0] > 0)
+  if (header[0] == vtkPVCSSRDeltaFrame)
+  {
+    // only the tiles flagged in the bitmap changed since the last image.
+    const int numTiles = header[3];
+    const int numComps = this->LastFrame->GetNumberOfComponents();
+    vtkUnsignedCharArray* bitmap = vtkUnsignedCharArray::New();
+    this->ParallelController->Receive(bitmap, 1, 0x023430);
+    vtkUnsignedCharArray* strip = vtkUnsignedCharArray::New();
+    if (numTiles > 0)
+    {
+      strip->SetNumberOfComponents(numComps);
+      strip->SetNumberOfTuples(
+        static_cast<vtkIdType>(vtkPVCSSRTileSize) * vtkPVCSSRTileSize * numTiles);
+      if (this->Compressor)
+      {
+        vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
+        this->ParallelController->Receive(data, 1, 0x023430);
+        this->Compressor->SetImageResolution(vtkPVCSSRTileSize, vtkPVCSSRTileSize * numTiles);
+        this->Decompress(data, strip);
+        data->Delete();
+      }
+      else
+      {
+        this->ParallelController->Receive(strip, 1, 0x023430);
+      }
+    }
+
+    if (this->LastFrameSize[0] != header[1] || this->LastFrameSize[1] != header[2])
+    {
+      vtkErrorMacro("Received a delta frame without a matching previous image.");
+    }
+    else
+    {
+      if (numTiles > 0)
+      {
+        vtkPVCSSRCopyTiles(this->LastFrame->GetPointer(0), strip->GetPointer(0), header[1],
+          header[2], numComps, bitmap->GetPointer(0), false);
+      }
+      rawImage.Resize(header[1], header[2], numComps);
+      memcpy(rawImage.GetRawPtr()->GetPointer(0), this->LastFrame->GetPointer(0),
+        static_cast<size_t>(this->LastFrame->GetDataSize()));
+      rawImage.MarkValid();
+    }
+    strip->Delete();
+    bitmap->Delete();
+  }
+  else if (header[0] > 0)
   {
     rawImage.Resize(header[1], header[2], header[3]);
     if (this->Compressor)
@@ -74,12 +210,15 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
       this->ParallelController->Receive(rawImage.GetRawPtr(), 1, 0x023430);
     }
     rawImage.MarkValid();
+    this->UpdateLastFrame(rawImage);
   }
 }
 
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
 {
+  vtkPVEventTracerScope traceScope(
+    "vtkPVClientServerSynchronizedRenderers::SlaveEndRender", "compositing");
   assert(this->ParallelController->IsA("vtkSocketController") ||
     this->ParallelController->IsA("vtkCompositeMultiProcessController"));
 
@@ -91,6 +230,77 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
   header[2] = rawImage.GetHeight();
   header[3] = rawImage.IsValid() ? rawImage.GetRawPtr()->GetNumberOfComponents() : 0;
 
+  const bool lossy = this->Compressor != nullptr && !this->LossLessCompression;
+  if (this->CanSendDeltaFrame(rawImage))
+  {
+    // Compare the image with the last one sent, tile by tile.
+    const int tileSize = vtkPVCSSRTileSize;
+    const int numComps = header[3];
+    const int numTilesX = (header[1] + tileSize - 1) / tileSize;
+    const int numTilesY = (header[2] + tileSize - 1) / tileSize;
+    const size_t imageRowSize = static_cast<size_t>(header[1]) * numComps;
+    const unsigned char* current = rawImage.GetRawPtr()->GetPointer(0);
+    const unsigned char* last = this->LastFrame->GetPointer(0);
+
+    vtkUnsignedCharArray* bitmap = vtkUnsignedCharArray::New();
+    bitmap->SetNumberOfTuples((numTilesX * numTilesY + 7) / 8);
+    bitmap->FillComponent(0, 0);
+    int numDirtyTiles = 0;
+    for (int ty = 0; ty < numTilesY; ++ty)
+    {
+      for (int tx = 0; tx < numTilesX; ++tx)
+      {
+        const int x0 = tx * tileSize;
+        const int y0 = ty * tileSize;
+        const size_t rowSize = static_cast<size_t>(std::min(tileSize, header[1] - x0)) * numComps;
+        const int yEnd = std::min(y0 + tileSize, header[2]);
+        for (int y = y0; y < yEnd; ++y)
+        {
+          const size_t offset = y * imageRowSize + x0 * numComps;
+          if (memcmp(current + offset, last + offset, rowSize) != 0)
+          {
+            const int tile = ty * numTilesX + tx;
+            bitmap->GetPointer(0)[tile / 8] |= static_cast<unsigned char>(1 << (tile % 8));
+            ++numDirtyTiles;
+            break;
+          }
+        }
+      }
+    }
+
+    // When most of the image changed, sending it whole is cheaper.
+    if (2 * numDirtyTiles <= numTilesX * numTilesY)
+    {
+      header[0] = vtkPVCSSRDeltaFrame;
+      header[3] = numDirtyTiles;
+      this->ParallelController->Send(header, 4, 1, 0x023430);
+      this->ParallelController->Send(bitmap, 1, 0x023430);
+      if (numDirtyTiles > 0)
+      {
+        vtkUnsignedCharArray* strip = vtkUnsignedCharArray::New();
+        strip->SetNumberOfComponents(numComps);
+        strip->SetNumberOfTuples(static_cast<vtkIdType>(tileSize) * tileSize * numDirtyTiles);
+        vtkPVCSSRCopyTiles(rawImage.GetRawPtr()->GetPointer(0), strip->GetPointer(0), header[1],
+          header[2], numComps, bitmap->GetPointer(0), true);
+        if (this->Compressor)
+        {
+          this->Compressor->SetImageResolution(tileSize, tileSize * numDirtyTiles);
+          this->ParallelController->Send(this->Compress(strip), 1, 0x023430);
+        }
+        else
+        {
+          this->ParallelController->Send(strip, 1, 0x023430);
+        }
+        strip->Delete();
+        this->LastFrameLossy = this->LastFrameLossy || lossy;
+      }
+      bitmap->Delete();
+      this->UpdateLastFrame(rawImage);
+      return;
+    }
+    bitmap->Delete();
+  }
+
   // send the image to the client.
   this->ParallelController->Send(header, 4, 1, 0x023430);
 
@@ -105,7 +315,9 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
     {
       this->ParallelController->Send(rawImage.GetRawPtr(), 1, 0x023430);
     }
+    this->LastFrameLossy = lossy;
   }
+  this->UpdateLastFrame(rawImage);
 }
 
 //----------------------------------------------------------------------------
@@ -217,4 +429,5 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
 void vtkPVClientServerSynchronizedRenderers::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeltaFrames: " << this->DeltaFrames << endl;
 }
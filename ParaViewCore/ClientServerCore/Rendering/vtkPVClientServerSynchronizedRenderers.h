@@ -52,6 +52,22 @@ public:
   vtkSetMacro(NVPipeSupport, bool);
   vtkGetMacro(NVPipeSupport, bool);
 
+  //@{
+  /**
+   * When set to true, the server compares each rendered image with the last
+   * one sent to the client in tiles of 64x64 pixels and only sends the tiles
+   * that changed, along with a bitmap identifying them. The client patches its
+   * copy of the last image with the received tiles. A full image is sent when
+   * the image size changes, when most tiles changed or when a loss-less image
+   * is needed and the last images were compressed lossily. This must be set
+   * identically on the client and the server and is not used with
+   * vtkNvPipeCompressor. Default is false.
+   */
+  vtkSetMacro(DeltaFrames, bool);
+  vtkGetMacro(DeltaFrames, bool);
+  vtkBooleanMacro(DeltaFrames, bool);
+  //@}
+
   /**
    * Set and configure a compressor from it's own configuration stream. This
    * is used by ParaView to configure the compressor from application wide
@@ -77,9 +93,26 @@ protected:
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
+  /**
+   * Returns true if the image can be sent as a set of changed tiles, i.e. if
+   * the last image sent has the same size and can be patched.
+   */
+  bool CanSendDeltaFrame(vtkRawImage& image);
+
+  /**
+   * Keeps a copy of the image last sent or received, used as the reference
+   * for the next delta frame.
+   */
+  void UpdateLastFrame(vtkRawImage& image);
+
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  bool DeltaFrames;
+
+  vtkUnsignedCharArray* LastFrame;
+  int LastFrameSize[2];
+  bool LastFrameLossy;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
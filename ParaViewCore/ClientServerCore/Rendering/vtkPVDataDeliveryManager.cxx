@@ -103,14 +103,14 @@ int vtkPVDataDeliveryManager::GetNumberOfPorts(vtkPVDataRepresentation* repr)
 
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataObject* data,
-  bool low_res, unsigned long trueSize, int port)
+  bool low_res, unsigned long trueSize, int port, bool force)
 {
   vtkInternals::vtkItem* item =
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/true);
   if (item)
   {
     const auto cacheKey = this->GetCacheKey(repr);
-    if (item->GetDataObject(cacheKey) == nullptr ||
+    if (force || item->GetDataObject(cacheKey) == nullptr ||
       repr->GetPipelineDataTime() > item->GetTimeStamp())
     {
       vtkLogF(
@@ -83,9 +83,12 @@ public:
    * method to register the geometry type they are rendering. Every
    * representation that requires delivering of any geometry must register with
    * the vtkPVDataDeliveryManager and never manage the delivery on its own.
+   *
+   * The data is ignored if the representation was not updated since the
+   * last call, unless `force` is true.
    */
   void SetPiece(vtkPVDataRepresentation* repr, vtkDataObject* data, bool low_res,
-    unsigned long trueSize = 0, int port = 0);
+    unsigned long trueSize = 0, int port = 0, bool force = false);
   //@}
 
   //@{
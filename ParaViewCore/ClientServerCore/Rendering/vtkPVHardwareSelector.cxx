@@ -15,17 +15,28 @@
 #include "vtkPVHardwareSelector.h"
 
 #include "vtkCamera.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVRenderViewSettings.h"
 #include "vtkProcessModule.h"
 #include "vtkRenderer.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
 #include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 //#define vtkPVHardwareSelectorDEBUG
 #ifdef vtkPVHardwareSelectorDEBUG
@@ -36,6 +47,58 @@
 #include <sstream>
 #endif
 
+namespace
+{
+// Identifies the selection node a pixel contributes to.
+struct vtkPVSelectionNodeKey
+{
+  int ProcessID;
+  vtkProp* Prop;
+  int PropID;
+  unsigned int CompositeID;
+
+  bool operator<(const vtkPVSelectionNodeKey& other) const
+  {
+    return std::tie(this->ProcessID, this->Prop, this->PropID, this->CompositeID) <
+      std::tie(other.ProcessID, other.Prop, other.PropID, other.CompositeID);
+  }
+  bool operator!=(const vtkPVSelectionNodeKey& other) const
+  {
+    return (*this < other) || (other < *this);
+  }
+};
+
+// Selected ids for a node, stored as inclusive runs of consecutive ids. Since
+// neighboring pixels mostly hit the same or consecutive ids, this is much
+// cheaper than inserting every pixel in a std::set.
+struct vtkPVSelectionNodeRuns
+{
+  std::vector<std::pair<vtkIdType, vtkIdType> > Runs;
+  vtkIdType PixelCount = 0;
+
+  void Add(vtkIdType id)
+  {
+    ++this->PixelCount;
+    if (!this->Runs.empty())
+    {
+      auto& last = this->Runs.back();
+      if (id >= last.first && id <= last.second)
+      {
+        return;
+      }
+      if (id == last.second + 1)
+      {
+        last.second = id;
+        return;
+      }
+    }
+    this->Runs.push_back(std::make_pair(id, id));
+  }
+};
+
+typedef std::map<vtkPVSelectionNodeKey, vtkPVSelectionNodeRuns> vtkPVSelectionRunsMap;
+}
+
 class vtkPVHardwareSelector::vtkInternals
 {
 public:
@@ -43,6 +106,13 @@ public:
   PropMapType PropMap;
 
   vtkWeakPointer<vtkPVRenderView> View;
+
+  // Last selection generated when ParallelSelection is enabled, together with
+  // what it was generated from.
+  vtkSmartPointer<vtkSelection> CachedSelection;
+  unsigned int CachedRegion[4] = { 0, 0, 0, 0 };
+  int CachedFieldAssociation = -1;
+  vtkMTimeType CachedCaptureTime = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -54,6 +124,7 @@ vtkPVHardwareSelector::vtkPVHardwareSelector()
   this->SetUseProcessIdFromData(true);
   this->ProcessID = 0;
   this->UniqueId = 0;
+  this->ParallelSelection = false;
   this->Internals = new vtkInternals();
 }
 
@@ -120,7 +191,9 @@ vtkSelection* vtkPVHardwareSelector::Select(int region[4])
     return NULL;
   }
 
-  vtkSelection* sel = this->GenerateSelection(region[0], region[1], region[2], region[3]);
+  vtkSelection* sel = this->ParallelSelection
+    ? this->GenerateSelectionInParallel(region[0], region[1], region[2], region[3])
+    : this->GenerateSelection(region[0], region[1], region[2], region[3]);
   if (sel->GetNumberOfNodes() == 0 &&
     this->FieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS && region[0] == region[2] &&
     region[1] == region[3] && vtkPVRenderViewSettings::GetInstance()->GetPointPickingRadius() > 0)
@@ -141,6 +214,121 @@ vtkSelection* vtkPVHardwareSelector::Select(int region[4])
   return sel;
 }
 
+//----------------------------------------------------------------------------
+vtkSelection* vtkPVHardwareSelector::GenerateSelectionInParallel(
+  unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2)
+{
+  // Normalize the region like vtkHardwareSelector::GenerateSelection() does, so
+  // that a rubber band dragged in any direction selects the same pixels.
+  if (x1 > x2)
+  {
+    std::swap(x1, x2);
+  }
+  if (y1 > y2)
+  {
+    std::swap(y1, y2);
+  }
+
+  auto& internals = *this->Internals;
+  if (internals.CachedSelection && internals.CachedCaptureTime == this->CaptureTime.GetMTime() &&
+    internals.CachedFieldAssociation == this->FieldAssociation && internals.CachedRegion[0] == x1 &&
+    internals.CachedRegion[1] == y1 && internals.CachedRegion[2] == x2 &&
+    internals.CachedRegion[3] == y2)
+  {
+    vtkSelection* sel = vtkSelection::New();
+    sel->DeepCopy(internals.CachedSelection);
+    return sel;
+  }
+
+  // Scan rows in parallel. The captured buffers are only read here.
+  vtkSMPThreadLocal<vtkPVSelectionRunsMap> localRuns;
+  const vtkIdType numRows = static_cast<vtkIdType>(y2 - y1) + 1;
+  vtkSMPTools::For(0, numRows, [&](vtkIdType begin, vtkIdType end) {
+    vtkPVSelectionRunsMap& runsMap = localRuns.Local();
+    vtkPVSelectionNodeRuns* current = nullptr;
+    vtkPVSelectionNodeKey currentKey = { -1, nullptr, -1, 0 };
+    for (vtkIdType row = begin; row < end; ++row)
+    {
+      for (unsigned int xx = x1; xx <= x2; ++xx)
+      {
+        unsigned int pos[2] = { xx, y1 + static_cast<unsigned int>(row) };
+        unsigned int out_pos[2];
+        vtkHardwareSelector::PixelInformation info = this->GetPixelInformation(pos, 0, out_pos);
+        if (!info.Valid)
+        {
+          continue;
+        }
+        vtkPVSelectionNodeKey key = { info.ProcessID, info.Prop, info.PropID, info.CompositeID };
+        if (current == nullptr || key != currentKey)
+        {
+          current = &runsMap[key];
+          currentKey = key;
+        }
+        current->Add(info.AttributeID);
+      }
+    }
+  });
+
+  vtkPVSelectionRunsMap merged;
+  for (auto iter = localRuns.begin(); iter != localRuns.end(); ++iter)
+  {
+    for (auto& item : *iter)
+    {
+      vtkPVSelectionNodeRuns& runs = merged[item.first];
+      runs.PixelCount += item.second.PixelCount;
+      runs.Runs.insert(runs.Runs.end(), item.second.Runs.begin(), item.second.Runs.end());
+    }
+  }
+
+  vtkSelection* sel = vtkSelection::New();
+  for (auto& item : merged)
+  {
+    // sort the runs and expand them into the sorted, unique ids.
+    auto& runs = item.second.Runs;
+    std::sort(runs.begin(), runs.end());
+    vtkNew<vtkIdTypeArray> ids;
+    ids->SetName("SelectedIds");
+    ids->SetNumberOfComponents(1);
+    ids->Allocate(static_cast<vtkIdType>(runs.size()));
+    vtkIdType next = VTK_ID_MIN;
+    for (const auto& run : runs)
+    {
+      for (vtkIdType id = std::max(run.first, next); id <= run.second; ++id)
+      {
+        ids->InsertNextValue(id);
+      }
+      next = std::max(next, run.second + 1);
+    }
+
+    const vtkPVSelectionNodeKey& key = item.first;
+    vtkNew<vtkSelectionNode> child;
+    child->SetContentType(vtkSelectionNode::INDICES);
+    child->SetFieldType(
+      vtkSelectionNode::ConvertAttributeTypeToSelectionField(this->FieldAssociation));
+    vtkInformation* properties = child->GetProperties();
+    properties->Set(vtkSelectionNode::PROP_ID(), key.PropID);
+    properties->Set(vtkSelectionNode::PROP(), key.Prop);
+    properties->Set(vtkSelectionNode::PIXEL_COUNT(), static_cast<int>(item.second.PixelCount));
+    if (key.ProcessID >= 0)
+    {
+      properties->Set(vtkSelectionNode::PROCESS_ID(), key.ProcessID);
+    }
+    properties->Set(vtkSelectionNode::COMPOSITE_INDEX(), static_cast<int>(key.CompositeID));
+    child->SetSelectionList(ids);
+    sel->AddNode(child);
+  }
+
+  internals.CachedSelection = vtkSmartPointer<vtkSelection>::New();
+  internals.CachedSelection->DeepCopy(sel);
+  internals.CachedCaptureTime = this->CaptureTime.GetMTime();
+  internals.CachedFieldAssociation = this->FieldAssociation;
+  internals.CachedRegion[0] = x1;
+  internals.CachedRegion[1] = y1;
+  internals.CachedRegion[2] = x2;
+  internals.CachedRegion[3] = y2;
+  return sel;
+}
+
 //----------------------------------------------------------------------------
 vtkSelection* vtkPVHardwareSelector::PolygonSelect(int* polygonPoints, vtkIdType count)
 {
@@ -180,6 +368,7 @@ int vtkPVHardwareSelector::GetPropID(int vtkNotUsed(idx), vtkProp* prop)
 void vtkPVHardwareSelector::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ParallelSelection: " << this->ParallelSelection << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -23,6 +23,10 @@
  * This class does not know, however, when the cached buffers are invalid.
  * External logic must explicitly calls InvalidateCachedSelection() to ensure
  * that the cache is not reused.
+ *
+ * When ParallelSelection is enabled, the captured buffers are also converted
+ * into a selection using multiple threads and the last generated selection is
+ * reused as long as the buffers have not been recaptured.
 */
 
 #ifndef vtkPVHardwareSelector_h
@@ -63,6 +67,21 @@ public:
    */
   virtual bool NeedToRenderForSelection();
 
+  //@{
+  /**
+   * When enabled, Select() scans the captured buffers using vtkSMPTools,
+   * collecting the selected ids of each prop as runs of consecutive ids
+   * instead of inserting every pixel in a set. The result of the last Select()
+   * is also kept and returned again when the same region is selected before
+   * the buffers are recaptured, as happens for repeated or hover selections.
+   * The generated selection is the same as the one generated otherwise.
+   * Default is false.
+   */
+  vtkSetMacro(ParallelSelection, bool);
+  vtkGetMacro(ParallelSelection, bool);
+  vtkBooleanMacro(ParallelSelection, bool);
+  //@}
+
   /**
    * Called to invalidate the cache.
    */
@@ -102,8 +121,16 @@ protected:
 
   void SavePixelBuffer(int passNo) override;
 
+  /**
+   * Multithreaded equivalent of GenerateSelection() used when
+   * ParallelSelection is enabled.
+   */
+  vtkSelection* GenerateSelectionInParallel(
+    unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2);
+
   vtkTimeStamp CaptureTime;
   int UniqueId;
+  bool ParallelSelection;
 
 private:
   vtkPVHardwareSelector(const vtkPVHardwareSelector&) = delete;
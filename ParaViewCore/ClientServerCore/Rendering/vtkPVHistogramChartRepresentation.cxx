@@ -125,6 +125,22 @@ bool vtkPVHistogramChartRepresentation::GetUseCustomBinRanges()
   return this->ExtractHistogram->GetUseCustomBinRanges();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVHistogramChartRepresentation::SetParallelBinning(bool b)
+{
+  if (this->ExtractHistogram->GetParallelBinning() != b)
+  {
+    this->ExtractHistogram->SetParallelBinning(b);
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVHistogramChartRepresentation::GetParallelBinning()
+{
+  return this->ExtractHistogram->GetParallelBinning();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVHistogramChartRepresentation::SetCustomBinRanges(double min, double max)
 {
@@ -85,6 +85,15 @@ public:
   bool GetUseCustomBinRanges();
   //@}
 
+  //@{
+  /**
+   * When set to true, the histogram is computed using multiple threads and
+   * bin counts are cached. See vtkExtractHistogram::SetParallelBinning.
+   */
+  void SetParallelBinning(bool);
+  bool GetParallelBinning();
+  //@}
+
   /**
    * Sets the color for the histograms.
    */
@@ -34,12 +34,20 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
+#include "vtkVariantCast.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <map>
 #include <set>
 #include <sstream>
@@ -49,7 +57,280 @@
 
 namespace
 {
-typedef std::map<int, std::set<std::vector<vtkVariant> > > vtkInternalDistinctValuesBase;
+// NaN does not compare with anything, which would break the ordering of the
+// sets of tuples: it is placed after all the other values instead.
+struct vtkDistinctTupleLess
+{
+  static bool IsNaN(const vtkVariant& value)
+  {
+    if (!value.IsFloat() && !value.IsDouble())
+    {
+      return false;
+    }
+    const double v = value.ToDouble();
+    return v != v;
+  }
+
+  static bool ValueLess(const vtkVariant& a, const vtkVariant& b)
+  {
+    const bool aIsNaN = IsNaN(a);
+    const bool bIsNaN = IsNaN(b);
+    if (aIsNaN || bIsNaN)
+    {
+      return !aIsNaN;
+    }
+    return a < b;
+  }
+
+  bool operator()(const std::vector<vtkVariant>& a, const std::vector<vtkVariant>& b) const
+  {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), &ValueLess);
+  }
+};
+
+typedef std::set<std::vector<vtkVariant>, vtkDistinctTupleLess> vtkDistinctTuples;
+typedef std::map<int, vtkDistinctTuples> vtkInternalDistinctValuesBase;
+
+// -0 and 0, as well as all NaNs, are the same value.
+template <typename T>
+T vtkCanonicalValue(T value)
+{
+  return value;
+}
+template <>
+float vtkCanonicalValue(float value)
+{
+  return value == 0.f ? 0.f : (value != value ? std::numeric_limits<float>::quiet_NaN() : value);
+}
+template <>
+double vtkCanonicalValue(double value)
+{
+  return value == 0. ? 0. : (value != value ? std::numeric_limits<double>::quiet_NaN() : value);
+}
+
+// Open addressing (linear probing) hash set of fixed-width tuples. Used to
+// collect the distinct values of numeric arrays without going through
+// vtkVariant, so that memory is proportional to the number of distinct
+// values rather than to the number of tuples.
+template <typename T>
+class vtkDistinctTupleSet
+{
+public:
+  vtkDistinctTupleSet(int width = 1)
+    : Width(width)
+    , Scratch(width)
+    , Slots(16, -1)
+  {
+  }
+
+  vtkIdType GetNumberOfTuples() const
+  {
+    return static_cast<vtkIdType>(this->Values.size() / this->Width);
+  }
+  const T* GetTuple(vtkIdType idx) const { return &this->Values[idx * this->Width]; }
+
+  void Insert(const T* tuple)
+  {
+    for (int cc = 0; cc < this->Width; ++cc)
+    {
+      this->Scratch[cc] = vtkCanonicalValue(tuple[cc]);
+    }
+    size_t slot = this->Find(this->Scratch.data());
+    if (this->Slots[slot] >= 0)
+    {
+      return;
+    }
+    this->Slots[slot] = this->GetNumberOfTuples();
+    this->Values.insert(this->Values.end(), this->Scratch.begin(), this->Scratch.end());
+    if (2 * this->Values.size() > this->Slots.size() * this->Width)
+    {
+      this->Grow();
+    }
+  }
+
+private:
+  size_t Hash(const T* tuple) const
+  {
+    size_t hash = 0;
+    for (int cc = 0; cc < this->Width; ++cc)
+    {
+      hash = hash * 31 + std::hash<T>()(tuple[cc]);
+    }
+    // spread the bits since the table size is a power of 2.
+    return hash ^ (hash >> 16);
+  }
+
+  size_t Find(const T* tuple) const
+  {
+    const size_t mask = this->Slots.size() - 1;
+    size_t slot = this->Hash(tuple) & mask;
+    while (this->Slots[slot] >= 0 &&
+      memcmp(this->GetTuple(this->Slots[slot]), tuple, this->Width * sizeof(T)) != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void Grow()
+  {
+    this->Slots.assign(2 * this->Slots.size(), -1);
+    const vtkIdType numTuples = this->GetNumberOfTuples();
+    for (vtkIdType idx = 0; idx < numTuples; ++idx)
+    {
+      this->Slots[this->Find(this->GetTuple(idx))] = idx;
+    }
+  }
+
+  int Width;
+  std::vector<T> Scratch;
+  std::vector<T> Values;
+  std::vector<vtkIdType> Slots;
+};
+
+// Adds the distinct values of a component (or of whole tuples when
+// component is negative) of a numeric array to `distincts`. Tuples are
+// processed in parallel, each thread filling its own set. Returns false,
+// leaving `distincts` untouched, as soon as more than `maxValues` distinct
+// values are found.
+template <typename T>
+bool vtkAddDistinctValues(const T* data, vtkIdType numTuples, int numComps, int component,
+  vtkIdType maxValues, vtkDistinctTuples& distincts)
+{
+  const int width = component < 0 ? numComps : 1;
+  const int offset = component < 0 ? 0 : component;
+  std::atomic<bool> tooManyValues(false);
+  vtkDistinctTupleSet<T> exemplar(width);
+  vtkSMPThreadLocal<vtkDistinctTupleSet<T> > localSets(exemplar);
+  vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+    vtkDistinctTupleSet<T>& localSet = localSets.Local();
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      localSet.Insert(data + t * numComps + offset);
+      if (localSet.GetNumberOfTuples() > maxValues || ((t & 0xfff) == 0 && tooManyValues))
+      {
+        tooManyValues = true;
+        return;
+      }
+    }
+  });
+  if (tooManyValues)
+  {
+    return false;
+  }
+
+  vtkDistinctTupleSet<T> merged(width);
+  for (auto& localSet : localSets)
+  {
+    const vtkIdType numDistinct = localSet.GetNumberOfTuples();
+    for (vtkIdType idx = 0; idx < numDistinct; ++idx)
+    {
+      merged.Insert(localSet.GetTuple(idx));
+    }
+    if (merged.GetNumberOfTuples() > maxValues)
+    {
+      return false;
+    }
+  }
+
+  std::vector<vtkVariant> tuple(width);
+  const vtkIdType numDistinct = merged.GetNumberOfTuples();
+  for (vtkIdType idx = 0; idx < numDistinct; ++idx)
+  {
+    const T* values = merged.GetTuple(idx);
+    for (int cc = 0; cc < width; ++cc)
+    {
+      tuple[cc] = vtkVariant(values[cc]);
+    }
+    distincts.insert(tuple);
+  }
+  return true;
+}
+
+// Returns the type shared by all values of `distincts` if it is a numeric
+// type that can be sent as a binary array, VTK_VARIANT otherwise.
+int vtkGetDistinctValuesType(const vtkDistinctTuples& distincts)
+{
+  int type = VTK_VOID;
+  for (const auto& tuple : distincts)
+  {
+    for (const auto& value : tuple)
+    {
+      if (type == VTK_VOID)
+      {
+        type = value.GetType();
+      }
+      if (value.GetType() != type)
+      {
+        return VTK_VARIANT;
+      }
+    }
+  }
+  switch (type)
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_LONG_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+      return type;
+    default:
+      return VTK_VARIANT;
+  }
+}
+
+// Sorted tuples are sent as a single array of values.
+template <typename T>
+void vtkInsertDistinctValues(
+  vtkClientServerStream* css, const vtkDistinctTuples& distincts)
+{
+  std::vector<T> values;
+  for (const auto& tuple : distincts)
+  {
+    for (const auto& value : tuple)
+    {
+      values.push_back(vtkVariantCast<T>(value));
+    }
+  }
+  *css << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()));
+}
+
+template <typename T>
+bool vtkExtractDistinctValues(const vtkClientServerStream* css, int pos, unsigned numTuples,
+  int tupleSize, vtkDistinctTuples& distincts)
+{
+  vtkTypeUInt32 length = 0;
+  if (!css->GetArgumentLength(0, pos, &length) ||
+    length != static_cast<vtkTypeUInt32>(numTuples * tupleSize))
+  {
+    return false;
+  }
+  std::vector<T> values(length);
+  if (length > 0 && !css->GetArgument(0, pos, values.data(), length))
+  {
+    return false;
+  }
+  std::vector<vtkVariant> tuple(tupleSize);
+  for (unsigned j = 0; j < numTuples; ++j)
+  {
+    for (int k = 0; k < tupleSize; ++k)
+    {
+      tuple[k] = vtkVariant(values[j * tupleSize + k]);
+    }
+    // values are sorted, hence each insertion hinted at the end takes
+    // amortized constant time and extracting the set is linear.
+    distincts.insert(distincts.end(), tuple);
+  }
+  return true;
+}
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
@@ -334,12 +615,39 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
   int nc = this->GetNumberOfComponents();
   vtkNew<vtkVariantArray> cvalues;
   std::vector<vtkVariant> tuple;
+
+  // Numeric arrays are scanned directly, in parallel.
+  vtkDataArray* da = vtkDataArray::SafeDownCast(array);
+  const bool typed = da && da->HasStandardMemoryLayout() && da->GetNumberOfComponents() == nc;
+  const vtkIdType maxValues =
+    this->Force ? VTK_ID_MAX : static_cast<vtkIdType>(array->GetMaxDiscreteValues());
+
   // bool tooManyValues;
   for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
   {
     int tupleSize = c < 0 ? nc : 1;
     tuple.resize(tupleSize);
-    std::set<std::vector<vtkVariant> >& compDistincts((*this->DistinctValues)[c]);
+    vtkDistinctTuples& compDistincts((*this->DistinctValues)[c]);
+    if (typed)
+    {
+      int found = -1;
+      switch (da->GetDataType())
+      {
+        vtkTemplateMacro(
+          found = vtkAddDistinctValues(static_cast<VTK_TT*>(da->GetVoidPointer(0)),
+                    da->GetNumberOfTuples(), nc, c, maxValues, compDistincts)
+            ? 1
+            : 0);
+      }
+      if (found >= 0)
+      {
+        // as with vtkAbstractArray::GetProminentComponentValues(), no values
+        // means that the information is invalid.
+        this->Valid = found == 1 && !compDistincts.empty();
+        continue;
+      }
+    }
+
     cvalues->Initialize();
     unsigned int maxDiscreteValues = array->GetMaxDiscreteValues();
     if (this->Force)
@@ -428,9 +736,14 @@ void vtkPVProminentValuesInformation::CopyToStream(vtkClientServerStream* css)
     for (cit = this->DistinctValues->begin(); cit != this->DistinctValues->end(); ++cit)
     {
       unsigned nuv = static_cast<unsigned>(cit->second.size());
-      *css << cit->first << nuv;
+      const int valueType = vtkGetDistinctValuesType(cit->second);
+      *css << cit->first << nuv << valueType;
+      switch (valueType)
+      {
+        vtkTemplateMacro(vtkInsertDistinctValues<VTK_TT>(css, cit->second));
+      }
       vtkInternalDistinctValues::mapped_type::iterator eit;
-      for (eit = cit->second.begin(); eit != cit->second.end(); ++eit)
+      for (eit = cit->second.begin(); valueType == VTK_VARIANT && eit != cit->second.end(); ++eit)
       {
         std::vector<vtkVariant>::const_iterator vit;
         for (vit = eit->begin(); vit != eit->end(); ++vit)
@@ -534,7 +847,28 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
         vtkErrorMacro("Error decoding the number of unique values for component " << i);
         return;
       }
+      int valueType;
+      if (!css->GetArgument(0, pos++, &valueType))
+      {
+        vtkErrorMacro("Error decoding the value type for component " << i);
+        return;
+      }
       int tupleSize = (component < 0 ? this->NumberOfComponents : 1);
+      if (valueType != VTK_VARIANT)
+      {
+        bool extracted = false;
+        switch (valueType)
+        {
+          vtkTemplateMacro(extracted = vtkExtractDistinctValues<VTK_TT>(
+                             css, pos++, nuv, tupleSize, (*this->DistinctValues)[component]));
+        }
+        if (!extracted)
+        {
+          vtkErrorMacro("Error decoding the unique values for component " << i);
+          return;
+        }
+        continue;
+      }
       std::vector<vtkVariant> tuple;
       tuple.resize(tupleSize);
       for (unsigned j = 0; j < nuv; ++j)
@@ -590,23 +924,23 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
     return;
   }
 
-  for (int i = 0; i <= this->NumberOfComponents; ++i)
+  // Iterate over the components of info, including the whole tuples (-1).
+  vtkInternalDistinctValues::iterator bit;
+  for (bit = info->DistinctValues->begin(); bit != info->DistinctValues->end(); ++bit)
   {
-    vtkInternalDistinctValues::iterator bit = info->DistinctValues->find(i);
+    const int i = bit->first;
     vtkInternalDistinctValues::mapped_type::iterator
       eit; // iterator over entries of component [ab]it->second.
     bool tooManyValues = false;
-    if (bit != info->DistinctValues->end())
-    { // Add info's values to our list of unique keys
-      for (eit = bit->second.begin(); eit != bit->second.end(); ++eit)
+    // Add info's values to our list of unique keys
+    for (eit = bit->second.begin(); eit != bit->second.end(); ++eit)
+    {
+      if ((*this->DistinctValues)[i].insert(*eit).second &&
+        ((*this->DistinctValues)[i].size() > vtkAbstractArray::MAX_DISCRETE_VALUES &&
+            !this->Force))
       {
-        if ((*this->DistinctValues)[i].insert(*eit).second &&
-          ((*this->DistinctValues)[i].size() > vtkAbstractArray::MAX_DISCRETE_VALUES &&
-              !this->Force))
-        {
-          tooManyValues = true;
-          break;
-        }
+        tooManyValues = true;
+        break;
       }
     }
 
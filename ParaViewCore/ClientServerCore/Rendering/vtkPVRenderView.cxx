@@ -65,6 +65,7 @@
 #include "vtkPVMaterialLibrary.h"
 #include "vtkPVOptions.h"
 #include "vtkPVRenderViewDataDeliveryManager.h"
+#include "vtkPVRenderViewSettings.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVSession.h"
 #include "vtkPVStreamingMacros.h"
@@ -311,6 +312,7 @@ void vtkUpdateTrackballZoomManipulators(
 vtkStandardNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
+vtkInformationKeyMacro(vtkPVRenderView, USE_MULTIRESOLUTION_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
@@ -361,6 +363,8 @@ vtkPVRenderView::vtkPVRenderView()
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
   this->UseOutlineForLODRendering = false;
+  this->UseMultiResolutionLOD = false;
+  this->UseIncrementalRedistribution = false;
   this->UseLightKit = false;
   this->Interactor = 0;
   this->InteractorStyle = 0;
@@ -831,6 +835,8 @@ bool vtkPVRenderView::PrepareSelect(int fieldAssociation)
 
   this->Selector->SetRenderer(this->GetRenderer());
   this->Selector->SetFieldAssociation(fieldAssociation);
+  this->Selector->SetParallelSelection(
+    vtkPVRenderViewSettings::GetInstance()->GetParallelSelection());
   return true;
 }
 
@@ -1308,6 +1314,10 @@ void vtkPVRenderView::UpdateLOD()
   {
     this->RequestInformation->Set(USE_OUTLINE_FOR_LOD(), 1);
   }
+  if (this->UseMultiResolutionLOD)
+  {
+    this->RequestInformation->Set(USE_MULTIRESOLUTION_LOD(), 1);
+  }
 
   // reset flags that representations set in REQUEST_UPDATE_LOD() pass.
   this->DistributedRenderingRequiredLOD = false;
@@ -1477,6 +1487,7 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
         "Using ordered compositing w/ data redistribution, if needed");
       // not using a custom (bounds-based ordering) i.e. we use in path (i). Let
       // the delivery manager redistrbute data as it deems necessary.
+      deliveryManager->SetUseIncrementalRedistribution(this->UseIncrementalRedistribution);
       deliveryManager->RedistributeDataForOrderedCompositing(use_lod_rendering);
       this->PartitionOrdering->SetImplementation(deliveryManager->GetKdTree());
 
@@ -2227,6 +2238,8 @@ void vtkPVRenderView::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "UseLightKit: " << this->UseLightKit << endl;
   os << indent << "SuppressRendering: " << this->SuppressRendering << endl;
+  os << indent << "UseMultiResolutionLOD: " << this->UseMultiResolutionLOD << endl;
+  os << indent << "UseIncrementalRedistribution: " << this->UseIncrementalRedistribution << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -2235,6 +2248,12 @@ void vtkPVRenderView::ConfigureCompressor(const char* configuration)
   this->SynchronizedRenderers->ConfigureCompressor(configuration);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetDeltaFrames(bool val)
+{
+  this->SynchronizedRenderers->SetDeltaFrames(val);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::InvalidateCachedSelection()
 {
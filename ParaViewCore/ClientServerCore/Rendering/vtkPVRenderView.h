@@ -271,6 +271,21 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   //@}
 
+  //@{
+  /**
+   * When set to true, representations that support it build decimated
+   * geometry for a fixed set of LOD resolutions at once, the first time LOD is
+   * needed for the current data, and then pick the level closest to
+   * LODResolution. Changing the LODResolution then no longer requires
+   * decimating the data again. The levels are built concurrently from shallow
+   * copies of the data. Default is false.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(UseMultiResolutionLOD, bool);
+  vtkGetMacro(UseMultiResolutionLOD, bool);
+  vtkBooleanMacro(UseMultiResolutionLOD, bool);
+  //@}
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -281,6 +296,14 @@ public:
    */
   void ConfigureCompressor(const char* configuration);
 
+  /**
+   * When set to true, only the tiles of rendered images that changed since
+   * the last render are sent from the server to the client.
+   * See vtkPVClientServerSynchronizedRenderers::SetDeltaFrames() for details.
+   * \note CallOnAllProcesses
+   */
+  void SetDeltaFrames(bool);
+
   /**
    * Resets the clipping range. One does not need to call this directly ever. It
    * is called periodically by the vtkRenderer to reset the camera range.
@@ -318,6 +341,12 @@ public:
    */
   static vtkInformationIntegerKey* USE_OUTLINE_FOR_LOD();
 
+  /**
+   * Indicates, in REQUEST_UPDATE_LOD() pass, that the LOD geometry may be
+   * picked from precomputed resolution levels.
+   */
+  static vtkInformationIntegerKey* USE_MULTIRESOLUTION_LOD();
+
   /**
    * Representation can publish this key in their REQUEST_INFORMATION()
    * pass to indicate that the representation needs to disable
@@ -730,6 +759,21 @@ public:
    */
   bool GetUseOrderedCompositing();
 
+  //@{
+  /**
+   * When set to true, data redistributed for ordered compositing is updated
+   * incrementally. The kd-tree is only regenerated when the points or cells
+   * of the redistributable data change, and when only point or cell arrays
+   * changed (e.g. animating a field on a static mesh), just the modified
+   * arrays are sent to the ranks holding the redistributed cells instead of
+   * redistributing the whole dataset. Default is false.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(UseIncrementalRedistribution, bool);
+  vtkGetMacro(UseIncrementalRedistribution, bool);
+  vtkBooleanMacro(UseIncrementalRedistribution, bool);
+  //@}
+
   /**
    * Returns true when the compositor should not use the empty
    * images optimization.
@@ -1116,6 +1160,7 @@ protected:
 
   bool UseInteractiveRenderingForScreenshots;
   bool NeedsOrderedCompositing;
+  bool UseIncrementalRedistribution;
   bool RenderEmptyImages;
 
   bool UseFXAA;
@@ -1127,6 +1172,7 @@ protected:
   bool UsedLODForLastRender;
   bool UseLODForInteractiveRender;
   bool UseOutlineForLODRendering;
+  bool UseMultiResolutionLOD;
   bool UseDistributedRenderingForRender;
   bool UseDistributedRenderingForLODRender;
 
@@ -15,6 +15,8 @@
 #include "vtkPVRenderViewDataDeliveryManager.h"
 #include "vtkPVDataDeliveryManagerInternals.h"
 
+#include "vtkCommunicator.h"
+#include "vtkDataSet.h"
 #include "vtkExtentTranslator.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -38,6 +40,7 @@
 #include <numeric>
 #include <queue>
 #include <sstream>
+#include <tuple>
 #include <utility>
 
 namespace
@@ -87,16 +90,38 @@ vtkInformationKeyMacro(vtkPVRVDMKeys, EXTENT_TRANSLATOR, ObjectBase);
 
 } // end of namespace
 
+//*****************************************************************************
+// Redistributors kept for incremental redistribution, keyed by representation
+// id, port and low-res flag.
+class vtkPVRenderViewDataDeliveryManager::vtkRedistributorsMap
+  : public std::map<std::tuple<unsigned int, int, bool>,
+      vtkSmartPointer<vtkOrderedCompositeDistributor> >
+{
+};
+
+//*****************************************************************************
+// Geometry hashes of the redistributable data used to build the kd-tree, along
+// with the geometry stamps they were computed for, keyed by representation id
+// and port.
+class vtkPVRenderViewDataDeliveryManager::vtkGeometryHashesMap
+  : public std::map<std::pair<unsigned int, int>, std::pair<vtkTypeUInt64, vtkTypeUInt64> >
+{
+};
+
 //*****************************************************************************
 vtkStandardNewMacro(vtkPVRenderViewDataDeliveryManager);
 //----------------------------------------------------------------------------
 vtkPVRenderViewDataDeliveryManager::vtkPVRenderViewDataDeliveryManager()
 {
+  this->Redistributors = new vtkRedistributorsMap();
+  this->GeometryHashes = new vtkGeometryHashesMap();
 }
 
 //----------------------------------------------------------------------------
 vtkPVRenderViewDataDeliveryManager::~vtkPVRenderViewDataDeliveryManager()
 {
+  delete this->Redistributors;
+  delete this->GeometryHashes;
 }
 
 //----------------------------------------------------------------------------
@@ -206,6 +231,7 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
     // something significant changed.
     std::ostringstream token_stream;
     vtkNew<vtkKdTreeManager> cutsGenerator;
+    vtkGeometryHashesMap geometryHashes;
     for (auto iter = this->Internals->ItemsMap.begin(); iter != this->Internals->ItemsMap.end();
          ++iter)
     {
@@ -235,10 +261,28 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
             vtkExtentTranslator::SafeDownCast(info->Get(vtkPVRVDMKeys::EXTENT_TRANSLATOR())),
             whole_extents, origin, spacing);
         }
+        else if (info->Has(vtkPVRVDMKeys::IS_REDISTRIBUTABLE()) &&
+          info->Get(vtkPVRVDMKeys::IS_REDISTRIBUTABLE()) == 1 &&
+          this->UseIncrementalRedistribution)
+        {
+          // the kd-tree only depends on the points, hence changes to point or
+          // cell arrays need not regenerate it. The geometry is only hashed
+          // when the arrays holding it were replaced or modified.
+          auto dobj = item.GetDeliveredDataObject(mode, cacheKey);
+          const vtkTypeUInt64 stamp = vtkOrderedCompositeDistributor::ComputeGeometryStamp(dobj);
+          auto previous = this->GeometryHashes->find(iter->first);
+          const vtkTypeUInt64 hash =
+            previous != this->GeometryHashes->end() && previous->second.first == stamp
+            ? previous->second.second
+            : vtkOrderedCompositeDistributor::ComputeGeometryHash(dobj);
+          geometryHashes[iter->first] = std::make_pair(stamp, hash);
+          token_stream << ";b" << iter->first.first << "=" << hash;
+          cutsGenerator->AddDataObject(dobj);
+        }
         else if (info->Has(vtkPVRVDMKeys::IS_REDISTRIBUTABLE()) &&
           info->Get(vtkPVRVDMKeys::IS_REDISTRIBUTABLE()) == 1)
         {
-          token_stream << "b" << iter->first.first << "=" << item.GetTimeStamp(cacheKey) << ","
+          token_stream << ";b" << iter->first.first << "=" << item.GetTimeStamp(cacheKey) << ","
                        << item.GetDeliveryTimeStamp(mode, cacheKey);
           // cout << "redistribute: ";
           // cout << this->GetRepresentation(iter->first.first)->GetLogName() << "("
@@ -250,7 +294,17 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
       }
     }
 
-    if (this->LastCutsGeneratorToken != token_stream.str())
+    this->GeometryHashes->swap(geometryHashes);
+
+    // generating the kd-tree is collective: regenerate it on all ranks as
+    // soon as the local data changed on any of them.
+    int changed = this->LastCutsGeneratorToken != token_stream.str() ? 1 : 0;
+    if (auto controller = vtkMultiProcessController::GetGlobalController())
+    {
+      int localChanged = changed;
+      controller->AllReduce(&localChanged, &changed, 1, vtkCommunicator::MAX_OP);
+    }
+    if (changed)
     {
       vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "regenerate kd-tree");
       cutsGenerator->GenerateKdTree();
@@ -269,6 +323,22 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
     return;
   }
 
+  // drop redistributors for representations that are gone, or all of them
+  // if they are no longer needed.
+  for (auto riter = this->Redistributors->begin(); riter != this->Redistributors->end();)
+  {
+    const auto key = std::make_pair(std::get<0>(riter->first), std::get<1>(riter->first));
+    if (!this->UseIncrementalRedistribution ||
+      this->Internals->ItemsMap.find(key) == this->Internals->ItemsMap.end())
+    {
+      riter = this->Redistributors->erase(riter);
+    }
+    else
+    {
+      ++riter;
+    }
+  }
+
   bool anything_moved = false;
   vtkInternals::ItemsMapType::iterator iter;
   for (iter = this->Internals->ItemsMap.begin(); iter != this->Internals->ItemsMap.end(); ++iter)
@@ -317,7 +387,24 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
       {
         item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, nullptr);
         vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "redistribute: %s", debugName.c_str());
-        vtkNew<vtkOrderedCompositeDistributor> redistributor;
+        // composite datasets are always redistributed from scratch.
+        const bool incremental =
+          this->UseIncrementalRedistribution && vtkDataSet::SafeDownCast(deliveredDataObject);
+        vtkSmartPointer<vtkOrderedCompositeDistributor> redistributor;
+        if (incremental)
+        {
+          auto& cached = (*this->Redistributors)[std::make_tuple(id, iter->first.second, low_res)];
+          if (cached == nullptr)
+          {
+            cached = vtkSmartPointer<vtkOrderedCompositeDistributor>::New();
+            cached->SetIncremental(true);
+          }
+          redistributor = cached;
+        }
+        else
+        {
+          redistributor = vtkSmartPointer<vtkOrderedCompositeDistributor>::New();
+        }
         redistributor->SetController(vtkMultiProcessController::GetGlobalController());
         redistributor->SetInputData(deliveredDataObject);
         redistributor->SetPKdTree(this->KdTree);
@@ -326,8 +413,14 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
             ? info->Get(vtkPVRVDMKeys::REDISTRIBUTION_MODE())
             : vtkOrderedCompositeDistributor::SPLIT_BOUNDARY_CELLS);
         redistributor->Update();
-        item.SetDeliveredDataObject(
-          REDISTRIBUTED_DATA_KEY, cacheKey, redistributor->GetOutputDataObject(0));
+        vtkSmartPointer<vtkDataObject> redistributed = redistributor->GetOutputDataObject(0);
+        if (incremental)
+        {
+          // the redistributor is reused, hence its output will change.
+          redistributed.TakeReference(redistributed->NewInstance());
+          redistributed->ShallowCopy(redistributor->GetOutputDataObject(0));
+        }
+        item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, redistributed);
         anything_moved = true;
       }
     }
@@ -358,6 +451,7 @@ void vtkPVRenderViewDataDeliveryManager::ClearRedistributedData(bool low_res)
     vtkInternals::vtkItem& item = low_res ? iter->second.second : iter->second.first;
     item.SetDeliveredDataObject(REDISTRIBUTED_DATA_KEY, cacheKey, nullptr);
   }
+  this->Redistributors->clear();
 }
 
 //----------------------------------------------------------------------------
@@ -554,4 +648,5 @@ void vtkPVRenderViewDataDeliveryManager::MoveData(
 void vtkPVRenderViewDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseIncrementalRedistribution: " << this->UseIncrementalRedistribution << endl;
 }
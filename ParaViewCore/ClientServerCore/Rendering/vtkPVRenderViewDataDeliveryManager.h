@@ -112,6 +112,17 @@ public:
    */
   void ClearRedistributedData(bool use_load);
 
+  //@{
+  /**
+   * When set to true, RedistributeDataForOrderedCompositing() only regenerates
+   * the kd-tree when the points or cells of redistributable data changed, and
+   * reuses the previous redistribution of each representation to move just
+   * the modified point and cell arrays. Default is false.
+   */
+  vtkSetMacro(UseIncrementalRedistribution, bool);
+  vtkGetMacro(UseIncrementalRedistribution, bool);
+  //@}
+
   /**
    * Pass the structured-meta-data for determining rendering order for ordered
    * compositing.
@@ -178,10 +189,16 @@ protected:
   vtkTimeStamp RedistributionTimeStamp;
   std::string LastCutsGeneratorToken;
   bool UseRedistributedDataAsDeliveredData = false;
+  bool UseIncrementalRedistribution = false;
 
 private:
   vtkPVRenderViewDataDeliveryManager(const vtkPVRenderViewDataDeliveryManager&) = delete;
   void operator=(const vtkPVRenderViewDataDeliveryManager&) = delete;
+
+  class vtkRedistributorsMap;
+  vtkRedistributorsMap* Redistributors;
+  class vtkGeometryHashesMap;
+  vtkGeometryHashesMap* GeometryHashes;
 };
 
 #endif
@@ -102,6 +102,17 @@ public:
   vtkGetMacro(DisableIceT, bool);
   //@}
 
+  //@{
+  /**
+   * When set, hardware selections on the render view are converted from the
+   * captured buffers using multiple threads and repeated selections of the
+   * same region reuse the previous result.
+   * See vtkPVHardwareSelector::SetParallelSelection().
+   */
+  vtkSetMacro(ParallelSelection, bool);
+  vtkGetMacro(ParallelSelection, bool);
+  //@}
+
 protected:
   vtkPVRenderViewSettings();
   ~vtkPVRenderViewSettings() override;
@@ -110,6 +121,7 @@ protected:
   vtkIdType OutlineThreshold;
   int PointPickingRadius;
   bool DisableIceT;
+  bool ParallelSelection;
 
 private:
   vtkPVRenderViewSettings(const vtkPVRenderViewSettings&) = delete;
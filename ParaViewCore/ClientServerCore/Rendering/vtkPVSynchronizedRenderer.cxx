@@ -253,6 +253,21 @@ void vtkPVSynchronizedRenderer::ConfigureCompressor(const char* configuration)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetDeltaFrames(bool val)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetDeltaFrames(val);
+  }
+  else
+  {
+    vtkDebugMacro("Not in client-server mode.");
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::SetImageProcessingPass(vtkImageProcessingPass* pass)
 {
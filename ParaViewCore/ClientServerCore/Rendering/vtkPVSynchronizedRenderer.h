@@ -137,6 +137,12 @@ public:
   void SetLossLessCompression(bool);
   //@}
 
+  /**
+   * Enable/Disable sending only the changed tiles of rendered images from the
+   * server to the client. See vtkPVClientServerSynchronizedRenderers::SetDeltaFrames().
+   */
+  void SetDeltaFrames(bool);
+
   /**
    * Activates or de-activated the use of Depth Buffer in an ImageProcessingPass
    */
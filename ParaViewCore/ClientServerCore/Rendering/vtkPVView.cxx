@@ -951,11 +951,11 @@ vtkDataObject* vtkPVView::GetDeliveredPiece(
 
 //-----------------------------------------------------------------------------
 void vtkPVView::SetPieceLOD(vtkInformation* info, vtkPVDataRepresentation* repr,
-  vtkDataObject* data, unsigned long trueSize, int port)
+  vtkDataObject* data, unsigned long trueSize, int port, bool force)
 {
   if (auto dm = vtkPVView::GetDeliveryManager(info))
   {
-    dm->SetPiece(repr, data, true, trueSize, port);
+    dm->SetPiece(repr, data, true, trueSize, port, force);
   }
 }
 
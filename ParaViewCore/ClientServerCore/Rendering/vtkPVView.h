@@ -261,7 +261,7 @@ public:
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
 
   static void SetPieceLOD(vtkInformation* info, vtkPVDataRepresentation* repr, vtkDataObject* data,
-    unsigned long trueSize = 0, int port = 0);
+    unsigned long trueSize = 0, int port = 0, bool force = false);
   static vtkDataObject* GetPieceLOD(
     vtkInformation* info, vtkPVDataRepresentation* repr, int port = 0);
   static vtkDataObject* GetDeliveredPieceLOD(
@@ -31,6 +31,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPVSession.h"
+#include "vtkPassArrays.h"
 #include "vtkProcessModule.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
@@ -337,12 +338,79 @@ public:
     return self->FetchBlock(mrbId);
   }
 
+  /**
+   * Collects the names of the hidden columns of the given table(s) that can
+   * be left out of the delivered blocks.
+   */
+  void CollectProjectedColumns(
+    vtkDataObject* dobj, vtkSpreadSheetView* self, std::set<std::string>& names)
+  {
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        this->CollectProjectedColumns(iter->GetCurrentDataObject(), self, names);
+      }
+      return;
+    }
+
+    vtkTable* table = vtkTable::SafeDownCast(dobj);
+    if (!table)
+    {
+      return;
+    }
+
+    const char* sortColumn = self->TableStreamer->GetColumnToSort();
+    for (vtkIdType cc = 0, max = table->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      auto col = table->GetColumn(cc);
+      const char* name = col->GetName();
+      bool special = false;
+      if (name == nullptr || self->IsColumnInternal(name) ||
+        (sortColumn && strcmp(sortColumn, name) == 0))
+      {
+        continue;
+      }
+      ::get_userfriendly_name(name, self, &special);
+      if (special)
+      {
+        // these identify the rows e.g. when making selections.
+        continue;
+      }
+
+      // same label as the one GetColumnLabel() returns on the client.
+      std::string label = name;
+      auto colInfo = col->GetInformation();
+      if (colInfo->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) &&
+        colInfo->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) >= 0 &&
+        colInfo->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME()))
+      {
+        label = colInfo->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME());
+      }
+      if (self->IsColumnHiddenByName(name) ||
+        (!label.empty() && self->IsColumnHiddenByLabel(label)))
+      {
+        names.insert(name);
+      }
+    }
+  }
+
+  void UpdateColumnProjection(vtkSpreadSheetView* self);
+
   vtkIdType MostRecentlyAccessedBlock;
   vtkWeakPointer<vtkSpreadSheetRepresentation> ActiveRepresentation;
   vtkCommand* Observer;
 
   std::set<std::string> HiddenColumnsByName;
   std::set<std::string> HiddenColumnsByLabel;
+
+  // Hidden columns last used to configure the ColumnProjector and the hidden
+  // columns the cached blocks were projected with.
+  std::set<std::string> ProjectedColumns;
+  std::set<std::string> ProjectedColumnsByName;
+  std::set<std::string> ProjectedColumnsByLabel;
 };
 
 namespace
@@ -415,6 +483,29 @@ vtkAlgorithmOutput* vtkGetDataProducer(vtkSpreadSheetView* self, vtkSpreadSheetR
 #endif
 }
 
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::vtkInternals::UpdateColumnProjection(vtkSpreadSheetView* self)
+{
+  std::set<std::string> names;
+  vtkAlgorithmOutput* dataPort = vtkGetDataProducer(self, this->ActiveRepresentation);
+  if (self->ColumnProjection && dataPort)
+  {
+    this->CollectProjectedColumns(
+      dataPort->GetProducer()->GetOutputDataObject(dataPort->GetIndex()), self, names);
+  }
+
+  // avoid modifying the projector, and hence re-sorting, when nothing changed.
+  if (names != this->ProjectedColumns)
+  {
+    this->ProjectedColumns = names;
+    self->ColumnProjector->ClearArrays();
+    for (const auto& name : names)
+    {
+      self->ColumnProjector->AddArray(vtkDataObject::ROW, name.c_str());
+    }
+  }
+}
+
 vtkStandardNewMacro(vtkSpreadSheetView);
 //----------------------------------------------------------------------------
 vtkSpreadSheetView::vtkSpreadSheetView()
@@ -427,6 +518,9 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   this->ShowExtractedSelection = false;
   this->TableStreamer = vtkSortedTableStreamer::New();
   this->TableSelectionMarker = vtkMarkSelectedRows::New();
+  this->ColumnProjector = vtkPassArrays::New();
+  this->ColumnProjector->RemoveArraysOn();
+  this->ColumnProjection = false;
 
   this->ReductionFilter = vtkReductionFilter::New();
   this->ReductionFilter->SetController(vtkMultiProcessController::GetGlobalController());
@@ -477,6 +571,7 @@ vtkSpreadSheetView::~vtkSpreadSheetView()
 
   this->TableStreamer->Delete();
   this->TableSelectionMarker->Delete();
+  this->ColumnProjector->Delete();
   this->ReductionFilter->Delete();
   this->DeliveryFilter->Delete();
 
@@ -577,6 +672,18 @@ bool vtkSpreadSheetView::IsColumnInternal(const char* columnName)
 void vtkSpreadSheetView::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ColumnProjection: " << this->ColumnProjection << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::SetColumnProjection(bool val)
+{
+  if (this->ColumnProjection != val)
+  {
+    this->ColumnProjection = val;
+    this->ClearCache();
+    this->Modified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -639,7 +746,8 @@ int vtkSpreadSheetView::StreamToClient()
 
   this->TableSelectionMarker->SetInputConnection(0, dataPort);
   this->TableSelectionMarker->SetInputConnection(1, cur->GetExtractedDataProducer());
-  this->TableStreamer->SetInputConnection(this->TableSelectionMarker->GetOutputPort());
+  this->ColumnProjector->SetInputConnection(this->TableSelectionMarker->GetOutputPort());
+  this->TableStreamer->SetInputConnection(this->ColumnProjector->GetOutputPort());
   if (dataPort)
   {
     dataPort->GetProducer()->Update();
@@ -658,6 +766,18 @@ int vtkSpreadSheetView::StreamToClient()
   {
     this->SomethingUpdated = true;
   }
+
+  // With column projection, the cached blocks lack the columns that were
+  // hidden when they were fetched, so they must be fetched again.
+  auto& internals = *this->Internals;
+  if (this->ColumnProjection &&
+    (internals.ProjectedColumnsByName != internals.HiddenColumnsByName ||
+      internals.ProjectedColumnsByLabel != internals.HiddenColumnsByLabel))
+  {
+    internals.ProjectedColumnsByName = internals.HiddenColumnsByName;
+    internals.ProjectedColumnsByLabel = internals.HiddenColumnsByLabel;
+    this->SomethingUpdated = true;
+  }
   this->NumberOfRows = num_rows;
   if (this->SomethingUpdated)
   {
@@ -709,6 +829,7 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
     pController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
   }
 
+  this->Internals->UpdateColumnProjection(this);
   this->TableStreamer->SetBlock(blockindex);
   this->TableStreamer->Modified();
   this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
@@ -869,6 +990,16 @@ void vtkSpreadSheetView::SetInvertSortOrder(bool val)
   this->ClearCache();
 }
 
+//----------------------------------------------------------------------------
+void vtkSpreadSheetView::SetSampleSort(bool val)
+{
+  if (this->TableStreamer->GetSampleSort() != val)
+  {
+    this->TableStreamer->SetSampleSort(val);
+    this->ClearCache();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSpreadSheetView::SetBlockSize(vtkIdType val)
 {
@@ -32,6 +32,7 @@
 class vtkCSVExporter;
 class vtkClientServerMoveData;
 class vtkMarkSelectedRows;
+class vtkPassArrays;
 class vtkReductionFilter;
 class vtkSortedTableStreamer;
 class vtkTable;
@@ -114,6 +115,18 @@ public:
   void ClearHiddenColumnsByLabel();
   //@}
 
+  //@{
+  /**
+   * When set, hidden columns are removed on the data processes before the
+   * rows are sorted, gathered and delivered to the client, instead of being
+   * delivered and simply not shown. Columns identifying the rows and the
+   * column to sort by are always delivered. Default is false.
+   * \note CallOnAllProcesses
+   */
+  void SetColumnProjection(bool);
+  vtkGetMacro(ColumnProjection, bool);
+  //@}
+
   /**
    * Get the number of columns.
    * \note CallOnClient
@@ -195,6 +208,13 @@ public:
    */
   void SetInvertSortOrder(bool);
 
+  /**
+   * Set whether the rows are globally ordered once using a distributed sample
+   * sort so that scrolling only fetches the rows of the requested blocks.
+   * \note CallOnAllProcesses
+   */
+  void SetSampleSort(bool);
+
   /**
    * Set the block size
    * \note CallOnAllProcesses
@@ -235,9 +255,11 @@ protected:
   bool GenerateCellConnectivity;
   vtkSortedTableStreamer* TableStreamer;
   vtkMarkSelectedRows* TableSelectionMarker;
+  vtkPassArrays* ColumnProjector;
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  bool ColumnProjection;
 
   unsigned long CRMICallbackTag;
   unsigned long PRMICallbackTag;
@@ -24,6 +24,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVEventTracer.h"
 #include "vtkPVInformation.h"
 #include "vtkPVInstantiator.h"
 #include "vtkPVOptions.h"
@@ -397,6 +398,7 @@ vtkObject* vtkPVSessionCore::GetRemoteObject(vtkTypeUInt32 globalid)
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::PushStateInternal(vtkSMMessage* message)
 {
+  vtkPVEventTracerScope traceScope("vtkPVSessionCore::PushState", "rmi");
   LOG(<< "----------------------------------------------------------------\n"
       << "Push State ( " << message->ByteSizeLong() << " bytes )\n"
       << "----------------------------------------------------------------\n"
@@ -624,6 +626,7 @@ void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
 void vtkPVSessionCore::ExecuteStreamInternal(
   const vtkClientServerStream& stream, bool ignore_errors)
 {
+  vtkPVEventTracerScope traceScope("vtkPVSessionCore::ExecuteStream", "rmi");
   LOG(<< "----------------------------------------------------------------\n"
       << "ExecuteStream\n"
       << stream.StreamToString()
@@ -778,6 +781,7 @@ void vtkPVSessionCore::RegisterSIObjectInternal(vtkSMMessage* message)
 bool vtkPVSessionCore::GatherInformationInternal(
   vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  vtkPVEventTracerScope traceScope(information->GetClassName(), "rmi");
   if (globalid == 0)
   {
     information->CopyFromObject(NULL);
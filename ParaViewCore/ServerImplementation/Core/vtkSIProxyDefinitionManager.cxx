@@ -516,6 +516,10 @@ vtkPVXMLElement* vtkSIProxyDefinitionManager::GetProxyDefinition(
   const char* groupName, const char* proxyName, const bool throwError)
 {
   vtkPVXMLElement* element = this->Internals->GetProxyElement(groupName, proxyName);
+  if (!element && this->LoadDeferredPlugin(groupName, proxyName))
+  {
+    element = this->Internals->GetProxyElement(groupName, proxyName);
+  }
   if (!throwError || element)
   {
     return element;
@@ -1064,6 +1068,14 @@ void vtkSIProxyDefinitionManager::MergeProxyDefinition(
 //---------------------------------------------------------------------------
 void vtkSIProxyDefinitionManager::Pull(vtkSMMessage* msg)
 {
+  // Remote clients only know about the definitions sent here and cannot
+  // request a missing one later on, hence plugins deferred on this process
+  // must be loaded first.
+  if (this->Internals->EnableXMLProxyDefinitionUpdate)
+  {
+    vtkPVPluginTracker::GetInstance()->LoadDeferredPlugins();
+  }
+
   // Setup required message header
   msg->Clear();
   msg->set_global_id(vtkSIProxyDefinitionManager::GetReservedGlobalID());
@@ -1207,10 +1219,27 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::HasDefinition(const char* groupName, const char* proxyName)
 {
-  return this->Internals->HasCustomDefinition(groupName, proxyName) ||
+  if (this->Internals->HasCustomDefinition(groupName, proxyName) ||
+    this->Internals->HasCoreDefinition(groupName, proxyName))
+  {
+    return true;
+  }
+  return this->LoadDeferredPlugin(groupName, proxyName) &&
     this->Internals->HasCoreDefinition(groupName, proxyName);
 }
 
+//---------------------------------------------------------------------------
+bool vtkSIProxyDefinitionManager::LoadDeferredPlugin(const char* groupName, const char* proxyName)
+{
+  // Definitions pushed from the server are not affected by local plugins;
+  // the server loads its deferred plugins before sending them, see Pull().
+  if (!this->Internals->EnableXMLProxyDefinitionUpdate || !groupName || !proxyName)
+  {
+    return false;
+  }
+  return vtkPVPluginTracker::GetInstance()->LoadPluginForProxy(groupName, proxyName);
+}
+
 //---------------------------------------------------------------------------
 // For now we dynamically convert InformationHelper
 // into the correct si_class and attribute sets.
@@ -37,6 +37,10 @@
  * \li \c vtkCommand::UnRegisterEvent - Fired when a proxy definition is
  * removed. Since this class only support removing custom proxies, this event is
  * fired only when a custom proxy is removed.
+ *
+ * When a requested definition is not found, the plugin tracker is asked to load
+ * the deferred plugin that provides it, if any (see
+ * vtkPVPluginTracker::SetLazyLoadPlugins).
 */
 
 #ifndef vtkSIProxyDefinitionManager_h
@@ -278,6 +282,14 @@ protected:
   void HandlePlugin(vtkPVPlugin*);
   //@}
 
+  /**
+   * Called when a definition is missing. Loads the deferred plugin providing
+   * the (group, name) proxy, if any. Returns true if a plugin was loaded.
+   * Does nothing on clients connected to a remote server, whose definitions
+   * are pulled from the server after it loaded all its deferred plugins.
+   */
+  bool LoadDeferredPlugin(const char* groupName, const char* proxyName);
+
   /**
    * Called by the XML parser to add an element from which a proxy
    * can be created. Called during parsing.
@@ -0,0 +1,71 @@
+# Checks that the Python Calculator gives the same results on composite data
+# whether the expression is evaluated once on arrays concatenated across the
+# blocks (BatchCompositeArrays) or block by block on composite arrays.
+
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk.util.numpy_support import vtk_to_numpy
+from vtkmodules.vtkCommonSystem import vtkTimerLog
+import numpy
+
+smtesting.ProcessCommandLineArguments()
+servermanager.ToggleProgressPrinting()
+
+def get_results(calculator, association):
+    output = servermanager.Fetch(calculator)
+    results = []
+    iterator = output.NewIterator()
+    iterator.InitTraversal()
+    while not iterator.IsDoneWithTraversal():
+        block = iterator.GetCurrentDataObject()
+        attributes = block.GetPointData() if association == 0 else block.GetCellData()
+        array = attributes.GetArray("result")
+        if not array:
+            raise smtesting.TestError("Missing result array")
+        results.append(vtk_to_numpy(array))
+        iterator.GoToNextItem()
+    return results
+
+def split_result_count():
+    count = 0
+    for i in range(vtkTimerLog.GetNumberOfEvents()):
+        if "PythonCalculator: Split Result" in vtkTimerLog.GetEventString(i):
+            count += 1
+    return count
+
+sphere1 = Sphere(ThetaResolution=8, PhiResolution=8)
+sphere2 = Sphere(ThetaResolution=16, PhiResolution=12, Center=[1, 2, 3])
+points = GroupDatasets(Input=[sphere1, sphere2])
+cells = PointDatatoCellData(Input=points)
+
+expressions = [ "Normals[:,0] * 2 + 1",
+                "mag(Normals)",
+                "cross(Normals, points)",
+                "Normals - mean(Normals)",
+                "dot(Normals, Normals) + max(Normals[:,1])" ]
+
+vtkTimerLog.LoggingOn()
+for source, association in ((points, 0), (cells, 1)):
+    for expression in expressions:
+        if association == 1 and "points" in expression:
+            continue
+        perBlock = PythonCalculator(Input=source, Expression=expression,
+            ArrayAssociation=association, BatchCompositeArrays=0)
+        batched = PythonCalculator(Input=source, Expression=expression,
+            ArrayAssociation=association, BatchCompositeArrays=1)
+
+        expected = get_results(perBlock, association)
+        vtkTimerLog.ResetLog()
+        results = get_results(batched, association)
+        if split_result_count() == 0:
+            raise smtesting.TestError(
+                "'%s' was not evaluated on concatenated arrays" % expression)
+
+        if len(expected) != 2 or len(results) != len(expected):
+            raise smtesting.TestError("Wrong number of blocks for '%s'" % expression)
+        for a, b in zip(expected, results):
+            if a.shape != b.shape or not numpy.allclose(a, b):
+                raise smtesting.TestError("Mismatch for '%s'" % expression)
+        Delete(batched)
+        Delete(perBlock)
+vtkTimerLog.LoggingOff()
@@ -0,0 +1,56 @@
+from paraview.simple import *
+from paraview.selection import *
+from paraview import servermanager
+
+# Checks that surface selections extracted with the RenderViewSettings
+# ParallelSelection option match the serial extraction.
+
+s = Sphere(ThetaResolution=64, PhiResolution=64)
+r = Show(s)
+view = Render()
+view.ViewSize = [300, 300]
+Render()
+
+pxm = servermanager.ProxyManager()
+settings = servermanager._getPyProxy(pxm.GetProxy("settings", "RenderViewSettings"))
+
+def GetSelectedIds(fieldType, rect):
+  SetActiveSource(s)
+  ClearSelection(s)
+  if fieldType == 'POINT':
+    SelectSurfacePoints(Rectangle=rect, View=view)
+  else:
+    SelectSurfaceCells(Rectangle=rect, View=view)
+  es = ExtractSelection()
+  data = servermanager.Fetch(es)
+  Delete(es)
+  if fieldType == 'POINT':
+    ids = data.GetPointData().GetArray("vtkOriginalPointIds")
+  else:
+    ids = data.GetCellData().GetArray("vtkOriginalCellIds")
+  if not ids:
+    return []
+  return sorted([ids.GetValue(i) for i in range(ids.GetNumberOfTuples())])
+
+rects = [[100, 100, 200, 200], [0, 0, 299, 299], [150, 150, 150, 150], [120, 80, 121, 250]]
+for fieldType in ['POINT', 'CELL']:
+  for rect in rects:
+    settings.ParallelSelection = 0
+    serial = GetSelectedIds(fieldType, rect)
+
+    settings.ParallelSelection = 1
+    parallel = GetSelectedIds(fieldType, rect)
+    # select the same region again to go through the cached result.
+    cached = GetSelectedIds(fieldType, rect)
+    # a rubber band dragged from the top right corner.
+    reversed_rect = [rect[2], rect[3], rect[0], rect[1]]
+    reversed_ids = GetSelectedIds(fieldType, reversed_rect)
+
+    print(fieldType, rect, len(serial), len(parallel))
+    if rect[0] != rect[2]:
+      assert len(serial) > 0
+    assert serial == parallel
+    assert serial == cached
+    assert serial == reversed_ids
+
+settings.ParallelSelection = 0
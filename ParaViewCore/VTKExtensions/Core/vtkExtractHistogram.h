@@ -101,6 +101,20 @@ public:
   vtkBooleanMacro(CalculateAverages, int);
   //@}
 
+  //@{
+  /**
+   * When set to true, values are binned using multiple threads and, in
+   * vtkPExtractHistogram, bin counts are reduced across processes using a
+   * tree-based reduction. Unless bins are centered around the min and max
+   * values, counts are also cached at a finer resolution so that changing
+   * BinCount by a power of two does not rescan the data. This is not used
+   * when CalculateAverages is set. False by default.
+   */
+  vtkSetMacro(ParallelBinning, bool);
+  vtkGetMacro(ParallelBinning, bool);
+  vtkBooleanMacro(ParallelBinning, bool);
+  //@}
+
 protected:
   vtkExtractHistogram();
   ~vtkExtractHistogram() override;
@@ -129,12 +143,20 @@ protected:
 
   void FillBinExtents(vtkDoubleArray* bin_extents, double min, double max);
 
+  /**
+   * Threaded counterpart of BinAnArray used when ParallelBinning is set. Bins
+   * the input array of all leaves of `input` into `bin_values`, reusing the
+   * cached fine resolution counts when possible.
+   */
+  void ParallelBinArrays(vtkDataObject* input, vtkIntArray* bin_values, double min, double max);
+
   double CustomBinRanges[2];
   bool CenterBinsAroundMinAndMax;
   bool UseCustomBinRanges;
   int Component;
   int BinCount;
   int CalculateAverages;
+  bool ParallelBinning;
 
   vtkEHInternals* Internal;
 
@@ -28,7 +28,9 @@
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 vtkStandardNewMacro(vtkPExtractHistogram);
@@ -93,11 +95,37 @@ int vtkPExtractHistogram::RequestData(
     // Nothing to do if there is no data
     return 1;
   }
+
+  bool isRoot = (this->Controller->GetLocalProcessId() == 0);
+  if (this->ParallelBinning && !this->CalculateAverages)
+  {
+    // Only the bin counts need to be reduced. The controller reduces them
+    // along a tree instead of gathering all histograms on the root node.
+    vtkIntArray* bin_values =
+      vtkIntArray::SafeDownCast(output->GetRowData()->GetArray("bin_values"));
+    std::vector<int> counts(this->BinCount, 0);
+    if (!bin_values ||
+      !this->Controller->Reduce(
+        bin_values->GetPointer(0), counts.data(), this->BinCount, vtkCommunicator::SUM_OP, 0))
+    {
+      vtkErrorMacro("Parallel communication error. Could not reduce bin values.");
+      return 0;
+    }
+    if (isRoot)
+    {
+      std::copy(counts.begin(), counts.end(), bin_values->GetPointer(0));
+    }
+    else
+    {
+      output->Initialize();
+    }
+    return 1;
+  }
+
   // Now we need to collect and reduce data from all nodes on the root.
   vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
   reduceFilter->SetController(this->Controller);
 
-  bool isRoot = (this->Controller->GetLocalProcessId() == 0);
   if (isRoot)
   {
     // PostGatherHelper needs to be set only on the root node.
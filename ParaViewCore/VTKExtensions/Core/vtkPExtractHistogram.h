@@ -17,7 +17,9 @@
  * @brief   Extract histogram for parallel dataset.
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
- * It gathers the histogram data on the root node.
+ * It gathers the histogram data on the root node. When ParallelBinning is
+ * set and CalculateAverages is not, bin counts are instead reduced to the root
+ * node along a tree.
 */
 
 #ifndef vtkPExtractHistogram_h
@@ -23,6 +23,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVEventTracer.h"
 #include "vtkPVPostFilterExecutive.h"
 
 #include <assert.h>
@@ -82,6 +83,15 @@ void vtkPVCompositeDataPipeline::CopyDefaultInformation(vtkInformation* request,
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  vtkPVEventTracerScope traceScope(
+    this->Algorithm ? this->Algorithm->GetClassName() : "vtkAlgorithm", "pipeline");
+  return this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::ResetPipelineInformation(int port, vtkInformation* info)
 {
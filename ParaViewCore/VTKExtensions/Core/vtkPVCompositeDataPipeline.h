@@ -23,6 +23,8 @@
  *     algorithms are passed along to the input vtkPVPostFilter, if one exists.
  *     vtkPVPostFilter is used to automatically extract components or generated
  *     derived arrays such as magnitude array for vectors.
+ * \li Event tracing :- each RequestData pass is recorded with vtkPVEventTracer,
+ *     when enabled, using the algorithm's class name.
 */
 
 #ifndef vtkPVCompositeDataPipeline_h
@@ -49,6 +51,10 @@ protected:
   // Remove update/whole extent when resetting pipeline information.
   void ResetPipelineInformation(int port, vtkInformation*) override;
 
+  // Record the execution with vtkPVEventTracer.
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
 private:
   vtkPVCompositeDataPipeline(const vtkPVCompositeDataPipeline&) = delete;
   void operator=(const vtkPVCompositeDataPipeline&) = delete;
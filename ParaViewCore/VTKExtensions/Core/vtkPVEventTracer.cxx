@@ -0,0 +1,305 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVEventTracer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVEventTracer.h"
+
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+struct vtkPVTracedEvent
+{
+  long long Start;
+  long long End;
+  const char* Category;
+  char Name[64];
+};
+
+// A buffer is only ever written by the thread that owns it. The owner holds
+// the buffer mutex while writing an event so that readers, which take the
+// same mutex to copy the events, never see an event being overwritten. The
+// mutex is uncontended unless events are being exported or reset.
+struct vtkPVThreadEventBuffer
+{
+  std::mutex Mutex;
+  std::vector<vtkPVTracedEvent> Events;
+  std::atomic<unsigned long long> Head;
+  int ThreadIndex;
+
+  vtkPVThreadEventBuffer(size_t capacity, int index)
+    : Events(capacity)
+    , Head(0)
+    , ThreadIndex(index)
+  {
+  }
+};
+
+struct vtkPVEventTracerRegistry
+{
+  std::mutex Mutex;
+  std::vector<std::shared_ptr<vtkPVThreadEventBuffer> > Buffers;
+  std::atomic<int> Capacity;
+
+  vtkPVEventTracerRegistry()
+    : Capacity(65536)
+  {
+  }
+};
+
+vtkPVEventTracerRegistry& GetRegistry()
+{
+  static vtkPVEventTracerRegistry registry;
+  return registry;
+}
+
+std::atomic<bool>& GetEnabledFlag()
+{
+  static std::atomic<bool> enabled(std::getenv("PARAVIEW_EVENT_TRACING") != nullptr);
+  return enabled;
+}
+
+// Offset, in nanoseconds, between the monotonic clock used to record events
+// and the system clock used when exporting them.
+long long GetEpochOffset()
+{
+  static const long long offset =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch())
+      .count() -
+    vtkPVEventTracer::GetTimeStamp();
+  return offset;
+}
+
+vtkPVThreadEventBuffer* GetThreadBuffer()
+{
+  thread_local std::shared_ptr<vtkPVThreadEventBuffer> buffer;
+  if (!buffer)
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    buffer = std::make_shared<vtkPVThreadEventBuffer>(
+      static_cast<size_t>(registry.Capacity.load()), static_cast<int>(registry.Buffers.size()));
+    registry.Buffers.push_back(buffer);
+  }
+  return buffer.get();
+}
+
+void WriteJSONString(ostream& os, const char* str)
+{
+  os << '"';
+  for (const char* c = str; *c; ++c)
+  {
+    switch (*c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) >= 0x20)
+        {
+          os << *c;
+        }
+    }
+  }
+  os << '"';
+}
+
+// Chrome trace timestamps are in microseconds; keep the nanoseconds as
+// decimals.
+void WriteMicroseconds(ostream& os, long long ns)
+{
+  os << (ns / 1000) << '.' << std::setw(3) << std::setfill('0') << (ns % 1000)
+     << std::setfill(' ');
+}
+}
+
+vtkStandardNewMacro(vtkPVEventTracer);
+//----------------------------------------------------------------------------
+vtkPVEventTracer::vtkPVEventTracer()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVEventTracer::~vtkPVEventTracer()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkPVEventTracer::SetEnabled(bool val)
+{
+  if (val)
+  {
+    // make sure the clock offset is computed before events are recorded.
+    GetEpochOffset();
+  }
+  GetEnabledFlag().store(val, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVEventTracer::GetEnabled()
+{
+  return GetEnabledFlag().load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVEventTracer::SetBufferCapacity(int capacity)
+{
+  GetRegistry().Capacity.store(std::max(capacity, 1));
+}
+
+//----------------------------------------------------------------------------
+int vtkPVEventTracer::GetBufferCapacity()
+{
+  return GetRegistry().Capacity.load();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVEventTracer::Reset()
+{
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  const size_t capacity = static_cast<size_t>(registry.Capacity.load());
+  for (auto& buffer : registry.Buffers)
+  {
+    std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+    if (buffer->Events.size() != capacity)
+    {
+      buffer->Events.resize(capacity);
+    }
+    buffer->Head.store(0, std::memory_order_release);
+  }
+}
+
+//----------------------------------------------------------------------------
+long long vtkPVEventTracer::GetTimeStamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVEventTracer::RecordEvent(
+  const char* name, const char* category, long long start, long long end)
+{
+  if (!vtkPVEventTracer::GetEnabled())
+  {
+    return;
+  }
+
+  vtkPVThreadEventBuffer* buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer->Mutex);
+  const unsigned long long head = buffer->Head.load(std::memory_order_relaxed);
+  vtkPVTracedEvent& event = buffer->Events[head % buffer->Events.size()];
+  event.Start = start;
+  event.End = end;
+  event.Category = category ? category : "";
+  strncpy(event.Name, name ? name : "", sizeof(event.Name) - 1);
+  event.Name[sizeof(event.Name) - 1] = '\0';
+  buffer->Head.store(head + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+long long vtkPVEventTracer::GetNumberOfEvents()
+{
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  long long count = 0;
+  for (auto& buffer : registry.Buffers)
+  {
+    std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+    const unsigned long long head = buffer->Head.load(std::memory_order_acquire);
+    count += static_cast<long long>(std::min<unsigned long long>(head, buffer->Events.size()));
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVEventTracer::ExportChromeTraceEvents(ostream& os, int pid, const char* processName)
+{
+  const long long offset = GetEpochOffset();
+  bool first = true;
+  if (processName)
+  {
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"tid\":0,\"args\":{\"name\":";
+    WriteJSONString(os, processName);
+    os << "}}";
+    first = false;
+  }
+
+  // Snapshot the events of each thread under its buffer lock, then format them
+  // without holding any lock so that recording threads are not held up by the
+  // output stream.
+  std::vector<std::pair<int, std::vector<vtkPVTracedEvent> > > snapshots;
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    snapshots.resize(registry.Buffers.size());
+    for (size_t bb = 0; bb < registry.Buffers.size(); ++bb)
+    {
+      vtkPVThreadEventBuffer* buffer = registry.Buffers[bb].get();
+      std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+      const unsigned long long head = buffer->Head.load(std::memory_order_acquire);
+      const unsigned long long capacity = buffer->Events.size();
+      const unsigned long long begin = head > capacity ? head - capacity : 0;
+      snapshots[bb].first = buffer->ThreadIndex;
+      snapshots[bb].second.reserve(static_cast<size_t>(head - begin));
+      for (unsigned long long cc = begin; cc < head; ++cc)
+      {
+        snapshots[bb].second.push_back(buffer->Events[cc % capacity]);
+      }
+    }
+  }
+
+  for (const auto& snapshot : snapshots)
+  {
+    for (const vtkPVTracedEvent& event : snapshot.second)
+    {
+      os << (first ? "" : ",\n") << "{\"name\":";
+      WriteJSONString(os, event.Name);
+      os << ",\"cat\":";
+      WriteJSONString(os, event.Category);
+      os << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << snapshot.first << ",\"ts\":";
+      WriteMicroseconds(os, event.Start + offset);
+      os << ",\"dur\":";
+      WriteMicroseconds(os, std::max(event.End - event.Start, 0LL));
+      os << "}";
+      first = false;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVEventTracer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPVEventTracer::GetEnabled() << endl;
+  os << indent << "BufferCapacity: " << vtkPVEventTracer::GetBufferCapacity() << endl;
+  os << indent << "NumberOfEvents: " << vtkPVEventTracer::GetNumberOfEvents() << endl;
+}
@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVEventTracer.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVEventTracer
+ * @brief   low overhead recorder for scoped timing events.
+ *
+ * vtkPVEventTracer records named, categorized intervals with nanosecond
+ * resolution so that the activity of all ranks and threads can be inspected
+ * on a common timeline. Unlike vtkTimerLog, which keeps a single global log
+ * meant for human readable dumps, each thread records into its own
+ * fixed-size ring buffer. Recording an event only locks the buffer of the
+ * calling thread, which is uncontended unless events are being exported; the
+ * first event recorded by a new thread also registers its buffer under a
+ * global mutex. When a buffer is full, the oldest events are overwritten.
+ * Events can be exported while other threads keep recording.
+ *
+ * Tracing is disabled by default, in which case a scope only checks a flag.
+ * It can be enabled with SetEnabled() or by setting the
+ * `PARAVIEW_EVENT_TRACING` environment variable before the process starts.
+ *
+ * The recorded events are exported with ExportChromeTraceEvents() in the
+ * Chrome trace event format (also understood by Perfetto) using the rank as
+ * the process id. vtkPVTimerInformation uses this to gather the events from
+ * all processes.
+ *
+ * Events are typically recorded using vtkPVEventTracerScope:
+ * @code{cpp}
+ * {
+ *   vtkPVEventTracerScope scope("vtkMPIMoveData", "data movement");
+ *   ...
+ * }
+ * @endcode
+ *
+ * This class is instantiable so that the static state can be controlled
+ * through a proxy on all processes.
+*/
+
+#ifndef vtkPVEventTracer_h
+#define vtkPVEventTracer_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVEventTracer : public vtkObject
+{
+public:
+  static vtkPVEventTracer* New();
+  vtkTypeMacro(vtkPVEventTracer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Enable/disable recording of events in this process.
+   */
+  static void SetEnabled(bool);
+  static bool GetEnabled();
+  //@}
+
+  //@{
+  /**
+   * Non-static variants of SetEnabled()/GetEnabled() for use through the
+   * server manager.
+   */
+  void SetEnableTracing(int val) { vtkPVEventTracer::SetEnabled(val != 0); }
+  int GetEnableTracing() { return vtkPVEventTracer::GetEnabled() ? 1 : 0; }
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of events each thread keeps. Changing the capacity
+   * only affects buffers of threads that have not recorded any event yet, or
+   * after Reset(). Default is 65536.
+   */
+  static void SetBufferCapacity(int capacity);
+  static int GetBufferCapacity();
+  void SetThreadBufferCapacity(int capacity) { vtkPVEventTracer::SetBufferCapacity(capacity); }
+  //@}
+
+  /**
+   * Discard all recorded events of all threads.
+   */
+  static void Reset();
+  void ResetEvents() { vtkPVEventTracer::Reset(); }
+
+  /**
+   * Returns the current time in nanoseconds on a monotonic clock.
+   */
+  static long long GetTimeStamp();
+
+  /**
+   * Record an event that started at `start` and ended at `end`, both obtained
+   * from GetTimeStamp(). `category` must point to a string that outlives the
+   * tracer, typically a literal. `name` is copied and truncated if needed.
+   * Does nothing when tracing is disabled.
+   */
+  static void RecordEvent(const char* name, const char* category, long long start, long long end);
+
+  /**
+   * Returns the number of events currently held by all threads.
+   */
+  static long long GetNumberOfEvents();
+
+  /**
+   * Write all recorded events as Chrome trace event JSON objects separated by
+   * commas, without the enclosing array, so that the output of several
+   * processes can be concatenated. `pid` identifies the process on the
+   * timeline and `processName`, when not null, is emitted as its metadata
+   * name. Timestamps are converted to microseconds since the epoch so that
+   * processes on different hosts roughly line up.
+   */
+  static void ExportChromeTraceEvents(ostream& os, int pid, const char* processName);
+
+protected:
+  vtkPVEventTracer();
+  ~vtkPVEventTracer() override;
+
+private:
+  vtkPVEventTracer(const vtkPVEventTracer&) = delete;
+  void operator=(const vtkPVEventTracer&) = delete;
+};
+
+#ifndef __VTK_WRAP__
+/**
+ * Records the lifetime of the object as a vtkPVEventTracer event. The start
+ * time is only sampled when tracing is enabled.
+ */
+class vtkPVEventTracerScope
+{
+public:
+  vtkPVEventTracerScope(const char* name, const char* category)
+    : Name(name)
+    , Category(category)
+    , Start(vtkPVEventTracer::GetEnabled() ? vtkPVEventTracer::GetTimeStamp() : -1)
+  {
+  }
+  ~vtkPVEventTracerScope()
+  {
+    if (this->Start >= 0)
+    {
+      vtkPVEventTracer::RecordEvent(
+        this->Name, this->Category, this->Start, vtkPVEventTracer::GetTimeStamp());
+    }
+  }
+
+private:
+  const char* Name;
+  const char* Category;
+  long long Start;
+
+  vtkPVEventTracerScope(const vtkPVEventTracerScope&) = delete;
+  void operator=(const vtkPVEventTracerScope&) = delete;
+};
+#endif
+
+#endif
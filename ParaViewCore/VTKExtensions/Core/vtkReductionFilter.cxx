@@ -16,6 +16,7 @@
 
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkCommunicator.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkGenericDataObjectReader.h"
@@ -60,6 +61,7 @@ vtkReductionFilter::vtkReductionFilter()
   this->GenerateProcessIds = 0;
   this->ReductionMode = vtkReductionFilter::REDUCE_ALL_TO_ONE;
   this->ReductionProcessId = 0;
+  this->UseTreeReduction = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -367,6 +369,82 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     }
   }
 
+  // Selections are serialized differently (see GatherSelection), hence they
+  // are always gathered. PostGatherHelpers may be set on some processes only,
+  // so all processes must agree before reducing along the tree.
+  int useTree = (this->UseTreeReduction && this->PassThrough < 0 &&
+                  !output->IsA("vtkSelection") && this->PostGatherHelper &&
+                  this->IsPostGatherHelperAssociative())
+    ? 1
+    : 0;
+  if (numProcs > 1)
+  {
+    int localUseTree = useTree;
+    controller->AllReduce(&localUseTree, &useTree, 1, vtkCommunicator::MIN_OP);
+  }
+  if (useTree)
+  {
+    vtkSmartPointer<vtkDataObject> reduced = preOutput;
+    bool merged = false;
+    this->TreeReduce(reduced, output, merged);
+
+    // The result is on process 0, move it where it is expected.
+    int status[2] = { (myId == 0 && reduced) ? 1 : 0, merged ? 1 : 0 };
+    int destProcessId =
+      this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL ? 0 : this->ReductionProcessId;
+    if (destProcessId != 0)
+    {
+      if (myId == 0)
+      {
+        controller->Send(status, 2, destProcessId, TREE_REDUCTION);
+        if (status[0])
+        {
+          controller->Send(reduced, destProcessId, TREE_REDUCTION);
+        }
+      }
+      else if (myId == destProcessId)
+      {
+        controller->Receive(status, 2, 0, TREE_REDUCTION);
+        reduced = nullptr;
+        if (status[0])
+        {
+          reduced.TakeReference(controller->ReceiveDataObject(0, TREE_REDUCTION));
+        }
+        merged = status[1] != 0;
+      }
+    }
+
+    int hasData = status[0];
+    if (myId == destProcessId && hasData)
+    {
+      if (merged)
+      {
+        output->ShallowCopy(reduced);
+      }
+      else
+      {
+        vtkSmartPointer<vtkDataObject> inputs[1] = { reduced };
+        this->PostProcess(output, inputs, 1);
+      }
+    }
+    else if (myId != destProcessId && preOutput &&
+      this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
+    {
+      vtkSmartPointer<vtkDataObject> inputs[1] = { preOutput };
+      this->PostProcess(output, inputs, 1);
+    }
+
+    if (this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+    {
+      controller->Broadcast(&hasData, 1, 0);
+      if (hasData)
+      {
+        controller->Broadcast(output, 0);
+      }
+    }
+    return;
+  }
+
   std::vector<vtkSmartPointer<vtkDataObject> > data_sets;
   std::vector<vtkSmartPointer<vtkDataObject> > receiveData(numProcs);
 
@@ -436,6 +514,70 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     this->PostProcess(output, &data_sets[0], static_cast<unsigned int>(data_sets.size()));
   }
 }
+
+//-----------------------------------------------------------------------------
+bool vtkReductionFilter::IsPostGatherHelperAssociative()
+{
+  return this->PostGatherHelper && (this->PostGatherHelper->IsA("vtkAppendFilter") ||
+    this->PostGatherHelper->IsA("vtkAppendPolyData") ||
+    this->PostGatherHelper->IsA("vtkAppendCompositeDataLeaves") ||
+    this->PostGatherHelper->IsA("vtkAttributeDataReductionFilter") ||
+    this->PostGatherHelper->IsA("vtkPVMergeTables"));
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::TreeReduce(
+  vtkSmartPointer<vtkDataObject>& data, vtkDataObject* output, bool& merged)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // At each level, process myId merges the results of the processes
+  // [myId, myId + step) with the ones of [myId + step, myId + 2 * step), so
+  // that inputs are always merged in process order.
+  vtkSmartPointer<vtkDataObject> result = data;
+  merged = false;
+  for (int step = 1; step < numProcs; step *= 2)
+  {
+    if (myId % (2 * step) != 0)
+    {
+      int hasData = result ? 1 : 0;
+      controller->Send(&hasData, 1, myId - step, TREE_REDUCTION);
+      if (hasData)
+      {
+        controller->Send(result, myId - step, TREE_REDUCTION);
+      }
+      return;
+    }
+    if (myId + step >= numProcs)
+    {
+      continue;
+    }
+
+    int hasData = 0;
+    controller->Receive(&hasData, 1, myId + step, TREE_REDUCTION);
+    if (!hasData)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkDataObject> received;
+    received.TakeReference(controller->ReceiveDataObject(myId + step, TREE_REDUCTION));
+    if (!result)
+    {
+      result = received;
+    }
+    else
+    {
+      vtkSmartPointer<vtkDataObject> inputs[2] = { result, received };
+      result.TakeReference(output->NewInstance());
+      this->PostProcess(result, inputs, 2);
+      merged = true;
+    }
+  }
+  data = result;
+}
+
 //----------------------------------------------------------------------------
 int vtkReductionFilter::GatherSelection(vtkSelection* sendData,
   std::vector<vtkSmartPointer<vtkDataObject> >& receiveData, int destProcessId)
@@ -486,4 +628,5 @@ void vtkReductionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "GenerateProcessIds: " << this->GenerateProcessIds << endl;
+  os << indent << "UseTreeReduction: " << this->UseTreeReduction << endl;
 }
@@ -124,9 +124,36 @@ public:
   vtkGetMacro(GenerateProcessIds, int);
   //@}
 
+  //@{
+  /**
+   * When set, data is reduced along a binary tree instead of being gathered
+   * on a single node: at each level of the tree, pairs of intermediate
+   * results are merged by the PostGatherHelper, so that merging is distributed
+   * and no node holds more than two intermediate results at a time. Results
+   * are merged in process order, so the output is the same as with the flat
+   * gather. This is only used when every process has an associative
+   * PostGatherHelper (see IsPostGatherHelperAssociative()), when PassThrough
+   * is not set and when reducing data other than selections; otherwise the
+   * data is gathered on a single node. The decision is made collectively, so
+   * this option must be set the same way on all processes. False by default.
+   */
+  vtkSetMacro(UseTreeReduction, bool);
+  vtkGetMacro(UseTreeReduction, bool);
+  vtkBooleanMacro(UseTreeReduction, bool);
+  //@}
+
+  /**
+   * Returns true if reducing the results of the PostGatherHelper again gives
+   * the same result as reducing all inputs at once. This is the case for the
+   * append filters, vtkAttributeDataReductionFilter and vtkPVMergeTables.
+   * Returns false when there is no PostGatherHelper.
+   */
+  virtual bool IsPostGatherHelperAssociative();
+
   enum Tags
   {
-    TRANSMIT_DATA_OBJECT = 23484
+    TRANSMIT_DATA_OBJECT = 23484,
+    TREE_REDUCTION = 23485
   };
 
 protected:
@@ -143,6 +170,14 @@ protected:
     vtkInformationVector* outputVector) override;
 
   void Reduce(vtkDataObject* input, vtkDataObject* output);
+
+  /**
+   * Reduces `data` on process 0 along a binary tree, merging intermediate
+   * results with the PostGatherHelper. On return, `data` is the reduced result
+   * on process 0 and `merged` is true if it is the output of the
+   * PostGatherHelper. On other processes, `data` is unchanged.
+   */
+  void TreeReduce(vtkSmartPointer<vtkDataObject>& data, vtkDataObject* output, bool& merged);
   vtkDataObject* PreProcess(vtkDataObject* input);
   void PostProcess(
     vtkDataObject* output, vtkSmartPointer<vtkDataObject> inputs[], unsigned int num_inputs);
@@ -162,6 +197,7 @@ protected:
   int GenerateProcessIds;
   int ReductionMode;
   int ReductionProcessId;
+  bool UseTreeReduction;
 
 private:
   vtkReductionFilter(const vtkReductionFilter&) = delete;
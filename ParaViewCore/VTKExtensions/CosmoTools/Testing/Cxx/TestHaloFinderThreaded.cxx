@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestHaloFinderThreaded.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the threaded friends-of-friends linking of CosmoHaloFinder
+// tags every particle with the same halo as the serial k-d tree algorithm,
+// on clustered particles and with a linking length so small compared to the
+// box that the cell list must be clamped.
+
+#include "CosmoHaloFinder.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct Particles
+{
+  std::vector<POSVEL_T> X, Y, Z;
+
+  void Add(double x, double y, double z)
+  {
+    this->X.push_back(static_cast<POSVEL_T>(x));
+    this->Y.push_back(static_cast<POSVEL_T>(y));
+    this->Z.push_back(static_cast<POSVEL_T>(z));
+  }
+  int Size() const { return static_cast<int>(this->X.size()); }
+};
+
+// Blobs of particles over a uniform background in a box of the given size,
+// with a few particles duplicated so that they link at any distance.
+Particles CreateParticles(double boxSize, double blobRadius)
+{
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> uniform(0.0, boxSize);
+  std::normal_distribution<double> normal(0.0, blobRadius);
+
+  Particles particles;
+  for (int blob = 0; blob < 40; ++blob)
+  {
+    double center[3] = { uniform(generator), uniform(generator), uniform(generator) };
+    for (int i = 0; i < 20 + 10 * blob; ++i)
+    {
+      particles.Add(center[0] + normal(generator), center[1] + normal(generator),
+        center[2] + normal(generator));
+    }
+  }
+  for (int i = 0; i < 5000; ++i)
+  {
+    particles.Add(uniform(generator), uniform(generator), uniform(generator));
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    int source = (i * 97) % particles.Size();
+    particles.Add(particles.X[source], particles.Y[source], particles.Z[source]);
+  }
+  return particles;
+}
+
+std::vector<int> FindHalos(Particles& particles, double bb, int numThreads)
+{
+  const int npart = particles.Size();
+  std::vector<int> haloTag(npart), haloStart(npart), haloList(npart);
+
+  cosmotk::CosmoHaloFinder finder;
+  finder.np = 1;
+  finder.rL = 1;
+  finder.bb = static_cast<POSVEL_T>(bb);
+  finder.nmin = 1;
+  finder.pmin = 1;
+  finder.periodic = false;
+  finder.nthreads = numThreads;
+  finder.setParticleLocations(&particles.X[0], &particles.Y[0], &particles.Z[0]);
+  finder.setHaloLocations(&haloTag[0], &haloStart[0], &haloList[0]);
+  finder.setNumberOfParticles(npart);
+  finder.Finding();
+  return haloTag;
+}
+
+bool TestSameHalos(const char* name, double boxSize, double blobRadius, double bb)
+{
+  Particles particles = CreateParticles(boxSize, blobRadius);
+  std::vector<int> expected = FindHalos(particles, bb, 1);
+
+  int numLinked = 0;
+  for (int i = 0; i < particles.Size(); ++i)
+  {
+    numLinked += expected[i] != i ? 1 : 0;
+  }
+  if (numLinked == 0)
+  {
+    std::cerr << "ERROR: " << name << ": no particle was linked." << std::endl;
+    return false;
+  }
+
+  for (int numThreads = 2; numThreads <= 8; numThreads *= 2)
+  {
+    std::vector<int> haloTag = FindHalos(particles, bb, numThreads);
+    for (int i = 0; i < particles.Size(); ++i)
+    {
+      if (haloTag[i] != expected[i])
+      {
+        std::cerr << "ERROR: " << name << ", " << numThreads << " threads: particle " << i
+                  << " has halo tag " << haloTag[i] << " instead of " << expected[i] << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestHaloFinderThreaded(int, char* [])
+{
+  bool success = TestSameHalos("clustered", 64.0, 0.4, 0.2) &&
+    TestSameHalos("small linking length", 1.0e4, 1.0e-4, 1.0e-7);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,6 +25,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTypeInt64Array.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -204,6 +206,7 @@ vtkStandardNewMacro(vtkPANLHaloFinder)
   this->Controller = vtkMultiProcessController::GetGlobalController();
   this->SetNumberOfOutputPorts(3);
   this->RunSubHaloFinder = false;
+  this->ThreadedHaloFinding = false;
   this->RL = 256;
   this->DistanceConvertFactor = 1.0;
   this->MassConvertFactor = 1.0;
@@ -237,6 +240,8 @@ vtkPANLHaloFinder::~vtkPANLHaloFinder()
 void vtkPANLHaloFinder::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "RunSubHaloFinder: " << this->RunSubHaloFinder << endl;
+  os << indent << "ThreadedHaloFinding: " << this->ThreadedHaloFinding << endl;
 }
 
 int vtkPANLHaloFinder::RequestInformation(
@@ -377,6 +382,8 @@ void vtkPANLHaloFinder::ExecuteHaloFinder(
     &this->Internal->yy[0], &this->Internal->zz[0], &this->Internal->vx[0], &this->Internal->vy[0],
     &this->Internal->vz[0], &this->Internal->potential[0], &this->Internal->tag[0],
     &this->Internal->mask[0], &this->Internal->status[0]);
+  this->Internal->haloFinder->setNumberOfThreads(
+    this->ThreadedHaloFinding ? vtkSMPTools::GetEstimatedNumberOfThreads() : 1);
   this->Internal->haloFinder->executeHaloFinder();
   this->Internal->haloFinder->collectHalos(false);
   this->Internal->fof = new cosmotk::FOFHaloProperties();
@@ -672,55 +679,75 @@ void vtkPANLHaloFinder::FindCenters(
   centers->SetNumberOfComponents(3);
   centers->SetNumberOfTuples(numberOfFOFHalos);
 
-  ExtractHalo haloData(numberOfFOFHalos, fofHaloCount, this->Internal->fof);
-  for (int halo = 0; halo < numberOfFOFHalos; ++halo)
+  if (this->CenterFindingMode != MOST_BOUND_PARTICLE &&
+    this->CenterFindingMode != MOST_CONNECTED_PARTICLE &&
+    this->CenterFindingMode != HIST_CENTER_FINDING)
   {
-    haloData.SetCurrentHalo(halo);
-    cosmotk::HaloCenterFinder centerFinder;
-    haloData.SetParticles(centerFinder);
-    centerFinder.setParameters(this->BB, this->SmoothingLength, this->DistanceConvertFactor,
-      this->RL, this->NP, OmegaMatter, OmegaCB, this->Hubble, this->RedShift);
-    int centerIndex = -1;
-    if (this->CenterFindingMode == MOST_BOUND_PARTICLE)
+    return;
+  }
+
+  // Each halo is independent, the threaded path gives every thread its own
+  // extraction buffers.
+  auto findCenters = [&](ExtractHalo& haloData, vtkIdType begin, vtkIdType end) {
+    for (vtkIdType halo = begin; halo < end; ++halo)
     {
-      float minPotential;
-      if (haloData.GetNumberOfParticlesInCurrentHalo() < MBP_THRESHOLD)
+      haloData.SetCurrentHalo(static_cast<int>(halo));
+      cosmotk::HaloCenterFinder centerFinder;
+      haloData.SetParticles(centerFinder);
+      centerFinder.setParameters(this->BB, this->SmoothingLength, this->DistanceConvertFactor,
+        this->RL, this->NP, OmegaMatter, OmegaCB, this->Hubble, this->RedShift);
+      int centerIndex = -1;
+      if (this->CenterFindingMode == MOST_BOUND_PARTICLE)
       {
-        centerIndex = centerFinder.mostBoundParticleN2(&minPotential);
+        float minPotential;
+        if (haloData.GetNumberOfParticlesInCurrentHalo() < MBP_THRESHOLD)
+        {
+          centerIndex = centerFinder.mostBoundParticleN2(&minPotential);
+        }
+        else
+        {
+          centerIndex = centerFinder.mostBoundParticleAStar(&minPotential);
+        }
       }
-      else
+      else if (this->CenterFindingMode == MOST_CONNECTED_PARTICLE)
       {
-        centerIndex = centerFinder.mostBoundParticleAStar(&minPotential);
+        if (haloData.GetNumberOfParticlesInCurrentHalo() < MCP_THRESHOLD)
+        {
+          centerIndex = centerFinder.mostConnectedParticleN2();
+        }
+        else
+        {
+          centerIndex = centerFinder.mostConnectedParticleChainMesh();
+        }
       }
-    }
-    else if (this->CenterFindingMode == MOST_CONNECTED_PARTICLE)
-    {
-      if (haloData.GetNumberOfParticlesInCurrentHalo() < MCP_THRESHOLD)
+      else
       {
-        centerIndex = centerFinder.mostConnectedParticleN2();
+        centerIndex = centerFinder.mostConnectedParticleHist();
       }
-      else
+      float center[] = { 0.0, 0.0, 0.0 };
+      if (centerIndex >= 0)
       {
-        centerIndex = centerFinder.mostConnectedParticleChainMesh();
+        double point[3];
+        allParticles->GetPoint(haloData.GetActualIndex(centerIndex), point);
+        center[0] = point[0];
+        center[1] = point[1];
+        center[2] = point[2];
       }
+      centers->SetTypedTuple(halo, center);
     }
-    else if (this->CenterFindingMode == HIST_CENTER_FINDING)
-    {
-      centerIndex = centerFinder.mostConnectedParticleHist();
-    }
-    else
-    {
-      return;
-    }
-    float center[] = { 0.0, 0.0, 0.0 };
-    if (centerIndex >= 0)
-    {
-      double* point = allParticles->GetPoint(haloData.GetActualIndex(centerIndex));
-      center[0] = point[0];
-      center[1] = point[1];
-      center[2] = point[2];
-    }
-    centers->SetTypedTuple(halo, center);
+  };
+
+  ExtractHalo haloData(numberOfFOFHalos, fofHaloCount, this->Internal->fof);
+  if (this->ThreadedHaloFinding)
+  {
+    vtkSMPThreadLocal<ExtractHalo> localHaloData(haloData);
+    vtkSMPTools::For(0, numberOfFOFHalos, 1, [&](vtkIdType begin, vtkIdType end) {
+      findCenters(localHaloData.Local(), begin, end);
+    });
+  }
+  else
+  {
+    findCenters(haloData, 0, numberOfFOFHalos);
   }
   fofProperties->GetPointData()->AddArray(centers.GetPointer());
 }
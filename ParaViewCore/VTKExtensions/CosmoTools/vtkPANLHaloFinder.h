@@ -56,6 +56,18 @@ class VTKPVVTKEXTENSIONSCOSMOTOOLS_EXPORT vtkPANLHaloFinder : public vtkUnstruct
     vtkBooleanMacro(RunSubHaloFinder, bool)
     //@}
 
+    //@{
+    /**
+     * Turns on/off threading within each process.  Friends-of-friends linking
+     * runs on a cell list with a concurrent union-find and halo centers are
+     * found in parallel over halos.  Halo tags and centers match the serial
+     * algorithm.  Periodic finds and NMin > 1 always link serially.
+     * Default: Off
+     */
+    vtkSetMacro(ThreadedHaloFinding, bool) vtkGetMacro(ThreadedHaloFinding, bool)
+      vtkBooleanMacro(ThreadedHaloFinding, bool)
+    //@}
+
     //@{
     /**
      * Gets/Sets RL, the physical coordinate box size
@@ -279,6 +291,7 @@ class VTKPVVTKEXTENSIONSCOSMOTOOLS_EXPORT vtkPANLHaloFinder : public vtkUnstruct
   int NumNeighbors;
 
   bool RunSubHaloFinder;
+  bool ThreadedHaloFinding;
 
   // Center finding parameters
   int CenterFindingMode;
@@ -0,0 +1,311 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRConnectivityFilaments.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Benchmark for the resolution of region ids between blocks by
+// vtkAMRConnectivity on long filamentary fragments. Each fragment is a
+// serpentine tube filling one plane of the domain, so it crosses every block
+// of the plane along a path whose length grows with the number of blocks.
+// The filter is run with the iterative and the union-find resolutions, the
+// region ids are compared, each fragment is checked to have a single id and
+// the maximum execution time over all processes is reported.
+//
+// The size of the problem can be changed with:
+//   -blocks N : number of blocks along each axis (default 6)
+//   -cells N  : number of cells of each block along each axis (default 8)
+
+#include "vtkAMRConnectivity.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Returns true if the cell (i, j, k) of a domain of size^3 cells is in a
+// filament. Filaments lie in the planes k = 1 (mod 4). In each plane, rows
+// j = 1 (mod 4) are joined at alternating ends to form a single snake.
+bool InFilament(int i, int j, int k, int size)
+{
+  if (k < 1 || k > size - 2 || (k - 1) % 4 != 0 || i < 1 || i > size - 2 || j < 1 ||
+    j > size - 2)
+  {
+    return false;
+  }
+  const int row = (j - 1) / 4;
+  if ((j - 1) % 4 == 0)
+  {
+    return true;
+  }
+  if (4 * row + 5 > size - 2)
+  {
+    return false;
+  }
+  return i == (row % 2 == 0 ? size - 2 : 1);
+}
+
+// Block of numCells^3 cells with one layer of ghost cells.
+vtkUniformGrid* NewBlock(const int blockIndex[3], int numCells, int size, double spacing)
+{
+  vtkUniformGrid* grid = vtkUniformGrid::New();
+  grid->SetOrigin(0.0, 0.0, 0.0);
+  grid->SetSpacing(spacing, spacing, spacing);
+  int extent[6];
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    extent[2 * ii] = blockIndex[ii] * numCells - 1;
+    extent[2 * ii + 1] = (blockIndex[ii] + 1) * numCells + 1;
+  }
+  grid->SetExtent(extent);
+
+  vtkNew<vtkDoubleArray> volumeFraction;
+  volumeFraction->SetName("VolumeFraction");
+  volumeFraction->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkIdType cellId = 0;
+  for (int k = extent[4]; k < extent[5]; ++k)
+  {
+    for (int j = extent[2]; j < extent[3]; ++j)
+    {
+      for (int i = extent[0]; i < extent[1]; ++i, ++cellId)
+      {
+        volumeFraction->SetValue(cellId, InFilament(i, j, k, size) ? 1.0 : 0.0);
+        const bool ghost = i == extent[0] || i == extent[1] - 1 || j == extent[2] ||
+          j == extent[3] - 1 || k == extent[4] || k == extent[5] - 1;
+        ghosts->SetValue(cellId, ghost ? vtkDataSetAttributes::DUPLICATECELL : 0);
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(volumeFraction);
+  grid->GetCellData()->AddArray(ghosts);
+  return grid;
+}
+
+double Execute(vtkAMRConnectivity* filter, vtkMPIController* controller, bool unionFind)
+{
+  filter->SetResolveWithUnionFind(unionFind);
+  filter->Modified();
+  controller->Barrier();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  filter->Update();
+  timer->StopTimer();
+  double elapsed = timer->GetElapsedTime();
+  double maxElapsed = 0.0;
+  controller->AllReduce(&elapsed, &maxElapsed, 1, vtkCommunicator::MAX_OP);
+  return maxElapsed;
+}
+
+// Deep copies of the region id arrays of the local blocks, in block order.
+std::vector<vtkSmartPointer<vtkIdTypeArray> > GetRegionIds(vtkNonOverlappingAMR* amr)
+{
+  std::vector<vtkSmartPointer<vtkIdTypeArray> > regionIds;
+  for (unsigned int blockId = 0; blockId < amr->GetNumberOfDataSets(0); ++blockId)
+  {
+    vtkUniformGrid* grid = amr->GetDataSet(0, blockId);
+    if (grid)
+    {
+      vtkSmartPointer<vtkIdTypeArray> regionId = vtkSmartPointer<vtkIdTypeArray>::New();
+      regionId->DeepCopy(grid->GetCellData()->GetArray("RegionId-VolumeFraction"));
+      regionIds.push_back(regionId);
+    }
+  }
+  return regionIds;
+}
+}
+
+int TestAMRConnectivityFilaments(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  int numBlocksPerAxis = 6;
+  int numCellsPerBlock = 8;
+  for (int ii = 1; ii + 1 < argc; ++ii)
+  {
+    if (strcmp(argv[ii], "-blocks") == 0)
+    {
+      numBlocksPerAxis = std::max(1, atoi(argv[++ii]));
+    }
+    else if (strcmp(argv[ii], "-cells") == 0)
+    {
+      numCellsPerBlock = std::max(4, atoi(argv[++ii]));
+    }
+  }
+
+  // Blocks are assigned to processes in contiguous ranges, so the filaments
+  // cross process boundaries many times.
+  const int numBlocks = numBlocksPerAxis * numBlocksPerAxis * numBlocksPerAxis;
+  const int size = numBlocksPerAxis * numCellsPerBlock;
+  const double spacing = 1.0 / size;
+  vtkNew<vtkNonOverlappingAMR> amr;
+  amr->Initialize(1, &numBlocks);
+  for (int blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    if (static_cast<long long>(blockId) * numRanks / numBlocks != myRank)
+    {
+      continue;
+    }
+    const int blockIndex[3] = { blockId % numBlocksPerAxis,
+      (blockId / numBlocksPerAxis) % numBlocksPerAxis,
+      blockId / (numBlocksPerAxis * numBlocksPerAxis) };
+    vtkUniformGrid* grid = NewBlock(blockIndex, numCellsPerBlock, size, spacing);
+    amr->SetDataSet(0, blockId, grid);
+    grid->Delete();
+  }
+
+  // Global meta data, so that the blocks are placed without communication.
+  vtkNew<vtkDoubleArray> globalBounds;
+  globalBounds->SetName("GlobalBounds");
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    globalBounds->InsertNextValue(0.0);
+    globalBounds->InsertNextValue(1.0);
+  }
+  vtkNew<vtkIntArray> boxSize;
+  boxSize->SetName("GlobalBoxSize");
+  vtkNew<vtkIntArray> minLevel;
+  minLevel->SetName("MinLevel");
+  minLevel->InsertNextValue(0);
+  vtkNew<vtkDoubleArray> minLevelSpacing;
+  minLevelSpacing->SetName("MinLevelSpacing");
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    boxSize->InsertNextValue(numCellsPerBlock + 2);
+    minLevelSpacing->InsertNextValue(spacing);
+  }
+  amr->GetFieldData()->AddArray(globalBounds);
+  amr->GetFieldData()->AddArray(boxSize);
+  amr->GetFieldData()->AddArray(minLevel);
+  amr->GetFieldData()->AddArray(minLevelSpacing);
+
+  vtkNew<vtkAMRConnectivity> filter;
+  filter->SetInputData(amr);
+  filter->AddInputVolumeArrayToProcess("VolumeFraction");
+  filter->SetVolumeFractionSurfaceValue(0.5);
+  filter->SetResolveBlocks(true);
+
+  const double iterativeTime = Execute(filter, controller, false);
+  std::vector<vtkSmartPointer<vtkIdTypeArray> > expected =
+    GetRegionIds(vtkNonOverlappingAMR::SafeDownCast(filter->GetOutputDataObject(0)));
+  const double unionFindTime = Execute(filter, controller, true);
+  vtkNonOverlappingAMR* output = vtkNonOverlappingAMR::SafeDownCast(filter->GetOutputDataObject(0));
+  std::vector<vtkSmartPointer<vtkIdTypeArray> > result = GetRegionIds(output);
+
+  int success = 1;
+  if (expected.size() != result.size())
+  {
+    success = 0;
+  }
+  for (size_t ii = 0; success && ii < expected.size(); ++ii)
+  {
+    const vtkIdType numCells = expected[ii]->GetNumberOfTuples();
+    if (result[ii]->GetNumberOfTuples() != numCells ||
+      !std::equal(expected[ii]->GetPointer(0), expected[ii]->GetPointer(0) + numCells,
+        result[ii]->GetPointer(0)))
+    {
+      success = 0;
+    }
+  }
+  if (!success)
+  {
+    cerr << "ERROR: region ids differ on process " << myRank << "." << endl;
+  }
+
+  // Each filament must have a single region id.
+  std::vector<vtkIdType> minIds(size, VTK_ID_MAX);
+  std::vector<vtkIdType> maxIds(size, 0);
+  size_t index = 0;
+  for (unsigned int blockId = 0; blockId < output->GetNumberOfDataSets(0); ++blockId)
+  {
+    vtkUniformGrid* grid = output->GetDataSet(0, blockId);
+    if (!grid)
+    {
+      continue;
+    }
+    vtkIdTypeArray* regionIds = result[index++];
+    vtkUnsignedCharArray* ghosts = grid->GetCellGhostArray();
+    const int* extent = grid->GetExtent();
+    vtkIdType cellId = 0;
+    for (int k = extent[4]; k < extent[5]; ++k)
+    {
+      for (int j = extent[2]; j < extent[3]; ++j)
+      {
+        for (int i = extent[0]; i < extent[1]; ++i, ++cellId)
+        {
+          if (InFilament(i, j, k, size) && ghosts->GetValue(cellId) == 0)
+          {
+            minIds[k] = std::min(minIds[k], regionIds->GetValue(cellId));
+            maxIds[k] = std::max(maxIds[k], regionIds->GetValue(cellId));
+          }
+        }
+      }
+    }
+  }
+  std::vector<vtkIdType> globalMinIds(size);
+  std::vector<vtkIdType> globalMaxIds(size);
+  controller->AllReduce(&minIds[0], &globalMinIds[0], size, vtkCommunicator::MIN_OP);
+  controller->AllReduce(&maxIds[0], &globalMaxIds[0], size, vtkCommunicator::MAX_OP);
+  int numFilaments = 0;
+  for (int k = 0; k < size; ++k)
+  {
+    if (globalMinIds[k] == VTK_ID_MAX)
+    {
+      continue;
+    }
+    ++numFilaments;
+    if (globalMinIds[k] != globalMaxIds[k] || globalMinIds[k] <= 0)
+    {
+      if (myRank == 0)
+      {
+        cerr << "ERROR: filament in plane " << k << " has more than one region id." << endl;
+      }
+      success = 0;
+    }
+  }
+
+  if (myRank == 0)
+  {
+    cout << "Processes: " << numRanks << ", blocks: " << numBlocks
+         << ", cells per block: " << numCellsPerBlock * numCellsPerBlock * numCellsPerBlock
+         << ", filaments: " << numFilaments << endl
+         << "  iterative resolution:  " << iterativeTime << " s" << endl
+         << "  union-find resolution: " << unionFindTime << " s" << endl;
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  controller->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRDualBlockDirectory.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkAMRDualContour and vtkAMRDualClip give the same output on
+// every process with EnableDistributedBlockDirectory on and off. The input is
+// a two level AMR without "Neighbors" field data: the central blocks of the
+// coarse level are refined, and the surface crosses both levels. Blocks are
+// assigned to processes in contiguous ranges, so blocks of several processes
+// meet along the surface.
+
+#include "vtkAMRDualClip.h"
+#include "vtkAMRDualContour.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+typedef std::array<double, 3> Point;
+
+const int NUMBER_OF_BLOCKS = 4;
+const int NUMBER_OF_CELLS = 6;
+
+// Coarse blocks with all indices in [1, 2] are refined.
+bool IsRefined(const int blockIndex[3])
+{
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    if (blockIndex[ii] < 1 || blockIndex[ii] > 2)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Decreases from 1 at the center of a sphere of radius 0.3 to 0 at 0.6 from
+// the center.
+double GetVolumeFraction(double x, double y, double z)
+{
+  const double dx = x - 0.51;
+  const double dy = y - 0.49;
+  const double dz = z - 0.5;
+  const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+  return std::max(0.0, std::min(1.0, 1.0 - distance / 0.6));
+}
+
+// Block with one layer of ghost cells.
+vtkUniformGrid* NewBlock(const int blockIndex[3], double spacing)
+{
+  vtkUniformGrid* grid = vtkUniformGrid::New();
+  grid->SetOrigin(0.0, 0.0, 0.0);
+  grid->SetSpacing(spacing, spacing, spacing);
+  int extent[6];
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    extent[2 * ii] = blockIndex[ii] * NUMBER_OF_CELLS - 1;
+    extent[2 * ii + 1] = (blockIndex[ii] + 1) * NUMBER_OF_CELLS + 1;
+  }
+  grid->SetExtent(extent);
+
+  vtkNew<vtkDoubleArray> volumeFraction;
+  volumeFraction->SetName("VolumeFraction");
+  volumeFraction->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkIdType cellId = 0;
+  for (int k = extent[4]; k < extent[5]; ++k)
+  {
+    for (int j = extent[2]; j < extent[3]; ++j)
+    {
+      for (int i = extent[0]; i < extent[1]; ++i, ++cellId)
+      {
+        volumeFraction->SetValue(cellId,
+          GetVolumeFraction((i + 0.5) * spacing, (j + 0.5) * spacing, (k + 0.5) * spacing));
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(volumeFraction);
+  return grid;
+}
+
+vtkSmartPointer<vtkNonOverlappingAMR> CreateInput(int myRank, int numRanks)
+{
+  // Indices of the blocks of each level.
+  std::vector<std::array<int, 3> > levelBlocks[2];
+  for (int level = 0; level < 2; ++level)
+  {
+    const int numBlocks = NUMBER_OF_BLOCKS << level;
+    for (int k = 0; k < numBlocks; ++k)
+    {
+      for (int j = 0; j < numBlocks; ++j)
+      {
+        for (int i = 0; i < numBlocks; ++i)
+        {
+          const int parentIndex[3] = { i >> level, j >> level, k >> level };
+          if (IsRefined(parentIndex) == (level == 1))
+          {
+            levelBlocks[level].push_back({ { i, j, k } });
+          }
+        }
+      }
+    }
+  }
+
+  const double spacing = 1.0 / (NUMBER_OF_BLOCKS * NUMBER_OF_CELLS);
+  const int blocksPerLevel[2] = { static_cast<int>(levelBlocks[0].size()),
+    static_cast<int>(levelBlocks[1].size()) };
+  vtkSmartPointer<vtkNonOverlappingAMR> amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(2, blocksPerLevel);
+  for (int level = 0; level < 2; ++level)
+  {
+    for (int blockId = 0; blockId < blocksPerLevel[level]; ++blockId)
+    {
+      if (static_cast<long long>(blockId) * numRanks / blocksPerLevel[level] != myRank)
+      {
+        continue;
+      }
+      vtkUniformGrid* grid = NewBlock(levelBlocks[level][blockId].data(), spacing / (1 << level));
+      amr->SetDataSet(level, blockId, grid);
+      grid->Delete();
+    }
+  }
+
+  // Global meta data, so that the blocks are placed without communication.
+  vtkNew<vtkDoubleArray> globalBounds;
+  globalBounds->SetName("GlobalBounds");
+  vtkNew<vtkIntArray> boxSize;
+  boxSize->SetName("GlobalBoxSize");
+  vtkNew<vtkIntArray> minLevel;
+  minLevel->SetName("MinLevel");
+  minLevel->InsertNextValue(0);
+  vtkNew<vtkDoubleArray> minLevelSpacing;
+  minLevelSpacing->SetName("MinLevelSpacing");
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    globalBounds->InsertNextValue(0.0);
+    globalBounds->InsertNextValue(1.0);
+    boxSize->InsertNextValue(NUMBER_OF_CELLS + 2);
+    minLevelSpacing->InsertNextValue(spacing);
+  }
+  amr->GetFieldData()->AddArray(globalBounds);
+  amr->GetFieldData()->AddArray(boxSize);
+  amr->GetFieldData()->AddArray(minLevel);
+  amr->GetFieldData()->AddArray(minLevelSpacing);
+  return amr;
+}
+
+// The sorted points and cell centroids of the local output. The centroids are
+// summed over sorted points, so they do not depend on the order of the points
+// of the cells.
+void GetGeometry(vtkAlgorithm* filter, std::vector<Point>& points, std::vector<Point>& centroids)
+{
+  points.clear();
+  centroids.clear();
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  vtkMultiPieceDataSet* pieces =
+    output ? vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0)) : nullptr;
+  vtkPointSet* mesh = pieces && pieces->GetNumberOfPieces() > 0
+    ? vtkPointSet::SafeDownCast(pieces->GetPiece(0))
+    : nullptr;
+  if (!mesh)
+  {
+    return;
+  }
+
+  Point point;
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    mesh->GetPoint(ptId, point.data());
+    points.push_back(point);
+  }
+  vtkNew<vtkIdList> ids;
+  std::vector<Point> cellPoints;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    mesh->GetCellPoints(cellId, ids);
+    cellPoints.clear();
+    for (vtkIdType ii = 0; ii < ids->GetNumberOfIds(); ++ii)
+    {
+      cellPoints.push_back(points[ids->GetId(ii)]);
+    }
+    std::sort(cellPoints.begin(), cellPoints.end());
+    Point centroid = { { 0.0, 0.0, 0.0 } };
+    for (size_t ii = 0; ii < cellPoints.size(); ++ii)
+    {
+      for (int comp = 0; comp < 3; ++comp)
+      {
+        centroid[comp] += cellPoints[ii][comp] / cellPoints.size();
+      }
+    }
+    centroids.push_back(centroid);
+  }
+  std::sort(points.begin(), points.end());
+  std::sort(centroids.begin(), centroids.end());
+}
+
+template <class FilterT>
+bool TestFilter(const char* name, vtkNonOverlappingAMR* input, vtkMPIController* controller)
+{
+  vtkNew<FilterT> filter;
+  filter->SetInputData(input);
+  filter->SetInputArrayToProcess(
+    0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "VolumeFraction");
+  filter->SetIsoValue(0.5);
+  filter->SetEnableMergePoints(1);
+  filter->SetEnableDegenerateCells(1);
+  filter->SetEnableMultiProcessCommunication(1);
+  filter->SetController(controller);
+
+  std::vector<Point> expectedPoints, expectedCentroids;
+  filter->SetEnableDistributedBlockDirectory(0);
+  filter->Update();
+  GetGeometry(filter, expectedPoints, expectedCentroids);
+
+  std::vector<Point> points, centroids;
+  filter->SetEnableDistributedBlockDirectory(1);
+  filter->Update();
+  GetGeometry(filter, points, centroids);
+
+  int valid = points == expectedPoints && centroids == expectedCentroids ? 1 : 0;
+  if (!valid)
+  {
+    cerr << "ERROR: " << name << " output differs on process " << controller->GetLocalProcessId()
+         << " with the block directory: " << points.size() << " points and " << centroids.size()
+         << " cells instead of " << expectedPoints.size() << " and " << expectedCentroids.size()
+         << "." << endl;
+  }
+
+  // The surface must not be empty.
+  long long numCells = static_cast<long long>(expectedCentroids.size());
+  long long totalNumCells = 0;
+  controller->AllReduce(&numCells, &totalNumCells, 1, vtkCommunicator::SUM_OP);
+  if (totalNumCells == 0)
+  {
+    if (controller->GetLocalProcessId() == 0)
+    {
+      cerr << "ERROR: " << name << " output is empty." << endl;
+    }
+    valid = 0;
+  }
+  return valid != 0;
+}
+}
+
+int TestAMRDualBlockDirectory(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkNonOverlappingAMR> input =
+    CreateInput(controller->GetLocalProcessId(), controller->GetNumberOfProcesses());
+
+  int valid = 1;
+  if (!TestFilter<vtkAMRDualContour>("AMR Dual Contour", input, controller))
+  {
+    valid = 0;
+  }
+  if (!TestFilter<vtkAMRDualClip>("AMR Dual Clip", input, controller))
+  {
+    valid = 0;
+  }
+
+  int allValid = 0;
+  controller->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -21,6 +21,8 @@
 #include <vtkTable.h>
 #include <vtkTesting.h>
 
+#include <fstream>
+#include <iterator>
 #include <string>
 
 namespace
@@ -28,7 +30,7 @@ namespace
 
 // ensure that the writer works when the columns are not in the same order on all ranks.
 // also ensures partial arrays don't mess things up.
-bool WriteCSV(const std::string& fname, int rank)
+void WriteCSV(const std::string& fname, int rank, bool inParallel)
 {
   vtkNew<vtkTable> table;
   vtkNew<vtkDoubleArray> col1;
@@ -66,8 +68,11 @@ bool WriteCSV(const std::string& fname, int rank)
   vtkNew<vtkCSVWriter> writer;
   writer->SetFileName(fname.c_str());
   writer->SetInputDataObject(table);
+  writer->SetWriteInParallel(inParallel);
   writer->Update();
-  return true;
+
+  // all processes must be done writing before the file is read.
+  vtkMultiProcessController::GetGlobalController()->Barrier();
 }
 
 #define VERITFY_EQ(x, y, txt)                                                                      \
@@ -111,6 +116,27 @@ bool ReadAndVerifyCSV(const std::string& fname, int rank, int numRanks)
   return true;
 }
 
+std::string ReadFile(const std::string& fname)
+{
+  std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// ensure that writing in parallel generates the very same file.
+bool CompareCSV(const std::string& fname, const std::string& baseline, int rank)
+{
+  if (rank != 0)
+  {
+    return true;
+  }
+
+  const std::string contents = ReadFile(fname);
+  const std::string expected = ReadFile(baseline);
+  VERITFY_EQ(expected.size(), contents.size(), "incorrect file size");
+  VERITFY_EQ(true, contents == expected, "files written with and without WriteInParallel differ");
+  return true;
+}
+
 } // end of namespace
 
 int TestCSVWriter(int argc, char* argv[])
@@ -133,8 +159,12 @@ int TestCSVWriter(int argc, char* argv[])
   }
 
   std::string tname{ testing->GetTempDirectory() };
-  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank) &&
-      ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks)
+  const std::string fname = tname + "/TestCSVWriter.csv";
+  const std::string pfname = tname + "/TestCSVWriterInParallel.csv";
+  WriteCSV(fname, myRank, false);
+  WriteCSV(pfname, myRank, true);
+  int success = ReadAndVerifyCSV(fname, myRank, numRanks) &&
+      ReadAndVerifyCSV(pfname, myRank, numRanks) && CompareCSV(pfname, fname, myRank)
     ? 1
     : 0;
 
@@ -0,0 +1,243 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMaterialInterfaceFilterScaling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Strong-scaling benchmark for the resolution of fragments split between
+// processes by vtkMaterialInterfaceFilter. A synthetic volume fraction field
+// made of spheres crossing block boundaries is defined on a fixed AMR grid
+// whose blocks are distributed among the processes. The filter is run with
+// the default and the distributed equivalence resolution, the results are
+// compared and the maximum execution time over all processes is reported.
+//
+// Run with an increasing number of processes to measure strong scaling.
+// The size of the problem can be changed with:
+//   -blocks N : number of blocks along each axis (default 6)
+//   -cells N  : number of cells of each block along each axis (default 8)
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMPIController.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+struct Sphere
+{
+  double Center[3];
+  double Radius;
+};
+
+// Deterministic set of spheres, some of them overlapping, in [0, 1]^3.
+std::vector<Sphere> MakeSpheres()
+{
+  std::vector<Sphere> spheres;
+  vtkMath::RandomSeed(8775070);
+  for (int ii = 0; ii < 40; ++ii)
+  {
+    Sphere sphere;
+    for (int jj = 0; jj < 3; ++jj)
+    {
+      sphere.Center[jj] = vtkMath::Random(0.05, 0.95);
+    }
+    sphere.Radius = vtkMath::Random(0.03, 0.15);
+    spheres.push_back(sphere);
+  }
+  return spheres;
+}
+
+vtkUniformGrid* NewBlock(const int blockIndex[3], int numCells, double spacing,
+  const std::vector<Sphere>& spheres)
+{
+  vtkUniformGrid* grid = vtkUniformGrid::New();
+  grid->SetOrigin(0.0, 0.0, 0.0);
+  grid->SetSpacing(spacing, spacing, spacing);
+  grid->SetExtent(blockIndex[0] * numCells, (blockIndex[0] + 1) * numCells,
+    blockIndex[1] * numCells, (blockIndex[1] + 1) * numCells, blockIndex[2] * numCells,
+    (blockIndex[2] + 1) * numCells);
+
+  vtkNew<vtkUnsignedCharArray> volumeFraction;
+  volumeFraction->SetName("VolumeFraction");
+  volumeFraction->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkIdType cellId = 0;
+  for (int k = 0; k < numCells; ++k)
+  {
+    for (int j = 0; j < numCells; ++j)
+    {
+      for (int i = 0; i < numCells; ++i, ++cellId)
+      {
+        const double x[3] = { (blockIndex[0] * numCells + i + 0.5) * spacing,
+          (blockIndex[1] * numCells + j + 0.5) * spacing,
+          (blockIndex[2] * numCells + k + 0.5) * spacing };
+        // Signed distance to the surface of the union of the spheres, in cells.
+        double depth = -VTK_DOUBLE_MAX;
+        for (const Sphere& sphere : spheres)
+        {
+          const double distance = sqrt(vtkMath::Distance2BetweenPoints(x, sphere.Center));
+          depth = std::max(depth, (sphere.Radius - distance) / spacing);
+        }
+        const double fraction = std::min(1.0, std::max(0.0, depth + 0.5));
+        volumeFraction->SetValue(cellId, static_cast<unsigned char>(255.0 * fraction));
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(volumeFraction);
+  return grid;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int comp = 0; comp < a->GetNumberOfComponents(); ++comp)
+    {
+      const double va = a->GetComponent(cc, comp);
+      const double vb = b->GetComponent(cc, comp);
+      if (std::abs(va - vb) > 1e-9 * std::max(1.0, std::abs(va)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+double Execute(vtkMaterialInterfaceFilter* filter, vtkMPIController* controller, bool distributed)
+{
+  filter->SetDistributedEquivalenceResolution(distributed);
+  controller->Barrier();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  filter->Update();
+  timer->StopTimer();
+  double elapsed = timer->GetElapsedTime();
+  double maxElapsed = 0.0;
+  controller->AllReduce(&elapsed, &maxElapsed, 1, vtkCommunicator::MAX_OP);
+  return maxElapsed;
+}
+}
+
+int TestMaterialInterfaceFilterScaling(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  int numBlocksPerAxis = 6;
+  int numCellsPerBlock = 8;
+  for (int ii = 1; ii + 1 < argc; ++ii)
+  {
+    if (strcmp(argv[ii], "-blocks") == 0)
+    {
+      numBlocksPerAxis = std::max(1, atoi(argv[++ii]));
+    }
+    else if (strcmp(argv[ii], "-cells") == 0)
+    {
+      numCellsPerBlock = std::max(2, atoi(argv[++ii]));
+    }
+  }
+
+  // Blocks are assigned to processes in contiguous ranges so that most
+  // neighbors are local.
+  const int numBlocks = numBlocksPerAxis * numBlocksPerAxis * numBlocksPerAxis;
+  const double spacing = 1.0 / (numBlocksPerAxis * numCellsPerBlock);
+  const std::vector<Sphere> spheres = MakeSpheres();
+  vtkNew<vtkNonOverlappingAMR> amr;
+  amr->Initialize(1, &numBlocks);
+  for (int blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    if (static_cast<long long>(blockId) * numRanks / numBlocks != myRank)
+    {
+      continue;
+    }
+    const int blockIndex[3] = { blockId % numBlocksPerAxis,
+      (blockId / numBlocksPerAxis) % numBlocksPerAxis,
+      blockId / (numBlocksPerAxis * numBlocksPerAxis) };
+    vtkUniformGrid* grid = NewBlock(blockIndex, numCellsPerBlock, spacing, spheres);
+    amr->SetDataSet(0, blockId, grid);
+    grid->Delete();
+  }
+
+  vtkNew<vtkMaterialInterfaceFilter> filter;
+  filter->SetInputData(amr);
+  filter->SelectMaterialArray("VolumeFraction");
+
+  const double defaultTime = Execute(filter, controller, false);
+  vtkNew<vtkMultiBlockDataSet> expected;
+  expected->DeepCopy(filter->GetOutputDataObject(1));
+  const double distributedTime = Execute(filter, controller, true);
+  vtkMultiBlockDataSet* result = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(1));
+
+  int success = 1;
+  if (myRank == 0)
+  {
+    vtkPolyData* expectedCenters = vtkPolyData::SafeDownCast(expected->GetBlock(0));
+    vtkPolyData* centers = result ? vtkPolyData::SafeDownCast(result->GetBlock(0)) : nullptr;
+    if (!expectedCenters || !centers ||
+      expectedCenters->GetNumberOfPoints() != centers->GetNumberOfPoints() ||
+      !SameArrays(expectedCenters->GetPoints()->GetData(), centers->GetPoints()->GetData()))
+    {
+      cerr << "ERROR: fragments differ." << endl;
+      success = 0;
+    }
+    else
+    {
+      vtkPointData* expectedPD = expectedCenters->GetPointData();
+      for (int ii = 0; ii < expectedPD->GetNumberOfArrays(); ++ii)
+      {
+        if (!SameArrays(expectedPD->GetArray(ii),
+              centers->GetPointData()->GetArray(expectedPD->GetArrayName(ii))))
+        {
+          cerr << "ERROR: fragment attribute '" << expectedPD->GetArrayName(ii) << "' differs."
+               << endl;
+          success = 0;
+        }
+      }
+    }
+    cout << "Processes: " << numRanks << ", blocks: " << numBlocks
+         << ", cells per block: " << numCellsPerBlock * numCellsPerBlock * numCellsPerBlock
+         << ", fragments: " << (centers ? centers->GetNumberOfPoints() : 0) << endl
+         << "  default resolution:     " << defaultTime << " s" << endl
+         << "  distributed resolution: " << distributedTime << " s" << endl;
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  controller->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVArrayCalculatorCompiled.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayCalculator.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkDataArray> Evaluate(
+  vtkPVArrayCalculator* calc, const char* function, bool compiled)
+{
+  calc->SetFunction(function);
+  calc->SetUseCompiledEvaluation(compiled);
+  calc->Update();
+  vtkDataSet* output = vtkDataSet::SafeDownCast(calc->GetOutputDataObject(0));
+  return output ? output->GetPointData()->GetArray("Result") : nullptr;
+}
+
+bool TestFunction(vtkPVArrayCalculator* calc, const char* function)
+{
+  vtkSmartPointer<vtkDataArray> expected = Evaluate(calc, function, false);
+  TASSERT(!calc->GetCompiledEvaluationUsed());
+  vtkSmartPointer<vtkDataArray> result = Evaluate(calc, function, true);
+  // Make sure the compiled path did not silently fall back to the interpreter.
+  TASSERT(calc->GetCompiledEvaluationUsed());
+  TASSERT(expected != nullptr && result != nullptr);
+  TASSERT(expected->GetDataType() == result->GetDataType());
+  TASSERT(expected->GetNumberOfTuples() == result->GetNumberOfTuples());
+  TASSERT(expected->GetNumberOfComponents() == result->GetNumberOfComponents());
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfTuples(); ++cc)
+  {
+    for (int comp = 0; comp < expected->GetNumberOfComponents(); ++comp)
+    {
+      const double a = expected->GetComponent(cc, comp);
+      const double b = result->GetComponent(cc, comp);
+      TASSERT(std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(a)));
+    }
+  }
+  return true;
+}
+}
+
+int TestPVArrayCalculatorCompiled(int, char* [])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+
+  vtkNew<vtkPVArrayCalculator> calc;
+  calc->SetInputConnection(wavelet->GetOutputPort());
+  calc->SetResultArrayName("Result");
+
+  const char* functions[] = { "RTData * 2 + coordsX", "sqrt(abs(RTData)) - 3 ^ 2",
+    "sin(RTData) * cos(coordsY) / (1 + exp(-coordsZ / 10))", "min(RTData, 100) + max(coordsX, 0)",
+    "if(RTData > 150, RTData, -RTData)", "coords * RTData / 100 - jHat",
+    "cross(coords, iHat) + 2 * kHat", "mag(coords) + ln(RTData) + log10(RTData)",
+    "if(coordsX < 0 & coordsY > 0, coords, -coords)" };
+  for (const char* function : functions)
+  {
+    if (!TestFunction(calc, function))
+    {
+      cerr << "Mismatch for '" << function << "'" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Invalid values are replaced the same way.
+  calc->ReplaceInvalidValuesOn();
+  calc->SetReplacementValue(-1);
+  if (!TestFunction(calc, "sqrt(coordsX) + 1 / coordsY"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Results are converted to the requested type.
+  calc->SetResultArrayType(VTK_INT);
+  if (!TestFunction(calc, "RTData / 3"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
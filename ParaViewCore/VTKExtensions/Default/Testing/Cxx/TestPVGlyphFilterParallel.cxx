@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGlyphFilterParallel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkNew.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphereSource.h"
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  TASSERT(a != nullptr && b != nullptr);
+  TASSERT(a->GetDataType() == b->GetDataType());
+  TASSERT(a->GetNumberOfTuples() == b->GetNumberOfTuples());
+  TASSERT(a->GetNumberOfComponents() == b->GetNumberOfComponents());
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int comp = 0; comp < a->GetNumberOfComponents(); ++comp)
+    {
+      TASSERT(a->GetComponent(cc, comp) == b->GetComponent(cc, comp));
+    }
+  }
+  return true;
+}
+
+bool SameCells(vtkCellArray* a, vtkCellArray* b)
+{
+  TASSERT(a->GetNumberOfCells() == b->GetNumberOfCells());
+  return SameArrays(a->GetOffsetsArray(), b->GetOffsetsArray()) &&
+    SameArrays(a->GetConnectivityArray(), b->GetConnectivityArray());
+}
+
+bool SameOutput(vtkPolyData* serial, vtkPolyData* parallel)
+{
+  TASSERT(serial->GetNumberOfPoints() > 0);
+  TASSERT(SameArrays(serial->GetPoints()->GetData(), parallel->GetPoints()->GetData()));
+  TASSERT(SameCells(serial->GetVerts(), parallel->GetVerts()));
+  TASSERT(SameCells(serial->GetLines(), parallel->GetLines()));
+  TASSERT(SameCells(serial->GetPolys(), parallel->GetPolys()));
+  TASSERT(SameCells(serial->GetStrips(), parallel->GetStrips()));
+
+  vtkPointData* spd = serial->GetPointData();
+  vtkPointData* ppd = parallel->GetPointData();
+  TASSERT(spd->GetNumberOfArrays() == ppd->GetNumberOfArrays());
+  for (int cc = 0; cc < spd->GetNumberOfArrays(); ++cc)
+  {
+    TASSERT(SameArrays(spd->GetArray(cc), ppd->GetArray(spd->GetArrayName(cc))));
+  }
+  return true;
+}
+
+bool TestGlyphMode(int glyphMode)
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-10, 10, -10, 10, -10, 10);
+
+  vtkNew<vtkSphereSource> sphere;
+
+  vtkNew<vtkPVGlyphFilter> glyph;
+  glyph->SetInputConnection(wavelet->GetOutputPort());
+  glyph->SetSourceConnection(sphere->GetOutputPort());
+  glyph->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+  glyph->SetScaleFactor(0.005);
+  glyph->SetGlyphMode(glyphMode);
+  glyph->SetStride(3);
+  glyph->SetMaximumNumberOfSamplePoints(500);
+
+  glyph->ParallelGlyphingOff();
+  glyph->Update();
+  TASSERT(vtkPolyData::SafeDownCast(glyph->GetOutputDataObject(0)) != nullptr);
+  vtkNew<vtkPolyData> serial;
+  serial->DeepCopy(glyph->GetOutputDataObject(0));
+
+  glyph->ParallelGlyphingOn();
+  glyph->Update();
+  vtkPolyData* parallel = vtkPolyData::SafeDownCast(glyph->GetOutputDataObject(0));
+  TASSERT(parallel != nullptr);
+
+  return SameOutput(serial, parallel);
+}
+}
+
+int TestPVGlyphFilterParallel(int, char* [])
+{
+  if (!TestGlyphMode(vtkPVGlyphFilter::ALL_POINTS) ||
+    !TestGlyphMode(vtkPVGlyphFilter::EVERY_NTH_POINT) ||
+    !TestGlyphMode(vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION) ||
+    !TestGlyphMode(vtkPVGlyphFilter::SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_VOLUME))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestReductionFilterTree.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkReductionFilter gives the same output on every process with
+// UseTreeReduction on and off, for all reduction modes, when reducing to the
+// first or the last process and when the first, second or last process has no
+// input. Datasets are appended with vtkAppendPolyData and point data is added
+// with vtkAttributeDataReductionFilter. Run on a number of processes that is
+// not a power of two, the tree has a process without a partner.
+
+#include "vtkAppendPolyData.h"
+#include "vtkAttributeDataReductionFilter.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkReductionFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTrivialProducer.h"
+
+#include <initializer_list>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// A sphere centered at (rank, 0, 0), with a "values" point array holding
+// integers, so that sums do not depend on the order of the additions.
+vtkSmartPointer<vtkPolyData> CreateInput(int rank)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(rank, 0, 0);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> input = sphere->GetOutput();
+  input->GetPointData()->RemoveArray("Normals");
+
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    values->SetValue(i, (rank + 1) * i);
+  }
+  input->GetPointData()->AddArray(values);
+  return input;
+}
+
+vtkSmartPointer<vtkPolyData> Reduce(vtkMultiProcessController* controller, bool addAttributes,
+  int mode, int processId, int nullRank, bool useTree)
+{
+  vtkSmartPointer<vtkAlgorithm> helper;
+  if (addAttributes)
+  {
+    vtkNew<vtkAttributeDataReductionFilter> attributeReduction;
+    attributeReduction->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+    helper = attributeReduction.GetPointer();
+  }
+  else
+  {
+    helper = vtkSmartPointer<vtkAppendPolyData>::New();
+  }
+
+  vtkNew<vtkReductionFilter> reduction;
+  reduction->SetController(controller);
+  reduction->SetPostGatherHelper(helper);
+  reduction->SetReductionMode(mode);
+  reduction->SetReductionProcessId(processId);
+  reduction->SetGenerateProcessIds(1);
+  reduction->SetUseTreeReduction(useTree);
+
+  vtkNew<vtkTrivialProducer> producer;
+  const int rank = controller->GetLocalProcessId();
+  if (rank != nullRank)
+  {
+    producer->SetOutput(CreateInput(rank));
+    reduction->SetInputConnection(producer->GetOutputPort());
+  }
+  reduction->Update();
+
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->DeepCopy(reduction->GetOutputDataObject(0));
+  return output;
+}
+
+bool CompareAttributes(vtkDataSetAttributes* attributes, vtkDataSetAttributes* expected)
+{
+  TASSERT(attributes->GetNumberOfArrays() == expected->GetNumberOfArrays());
+  for (int cc = 0; cc < expected->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(cc);
+    vtkDataArray* array = attributes->GetArray(expectedArray->GetName());
+    TASSERT(array != nullptr);
+    TASSERT(array->GetNumberOfComponents() == expectedArray->GetNumberOfComponents());
+    TASSERT(array->GetNumberOfTuples() == expectedArray->GetNumberOfTuples());
+    for (vtkIdType i = 0; i < expectedArray->GetNumberOfTuples(); ++i)
+    {
+      for (int comp = 0; comp < expectedArray->GetNumberOfComponents(); ++comp)
+      {
+        TASSERT(array->GetComponent(i, comp) == expectedArray->GetComponent(i, comp));
+      }
+    }
+  }
+  return true;
+}
+
+bool Compare(vtkPolyData* output, vtkPolyData* expected)
+{
+  TASSERT(output->GetNumberOfPoints() == expected->GetNumberOfPoints());
+  TASSERT(output->GetNumberOfCells() == expected->GetNumberOfCells());
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double point[3], expectedPoint[3];
+    output->GetPoint(i, point);
+    expected->GetPoint(i, expectedPoint);
+    TASSERT(point[0] == expectedPoint[0] && point[1] == expectedPoint[1] &&
+      point[2] == expectedPoint[2]);
+  }
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> expectedIds;
+  for (vtkIdType i = 0; i < expected->GetNumberOfCells(); ++i)
+  {
+    output->GetCellPoints(i, ids);
+    expected->GetCellPoints(i, expectedIds);
+    TASSERT(ids->GetNumberOfIds() == expectedIds->GetNumberOfIds());
+    for (vtkIdType j = 0; j < expectedIds->GetNumberOfIds(); ++j)
+    {
+      TASSERT(ids->GetId(j) == expectedIds->GetId(j));
+    }
+  }
+  TASSERT(CompareAttributes(output->GetPointData(), expected->GetPointData()));
+  TASSERT(CompareAttributes(output->GetCellData(), expected->GetCellData()));
+  return true;
+}
+
+bool TestReduction(vtkMultiProcessController* controller, bool addAttributes, int mode,
+  int processId, int nullRank)
+{
+  vtkSmartPointer<vtkPolyData> expected =
+    Reduce(controller, addAttributes, mode, processId, nullRank, false);
+  vtkSmartPointer<vtkPolyData> output =
+    Reduce(controller, addAttributes, mode, processId, nullRank, true);
+  TASSERT(Compare(output, expected));
+
+  // Also check the flat gather, hence both outputs, against the inputs.
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const vtkIdType numPoints = CreateInput(0)->GetNumberOfPoints();
+  const int numInputs = nullRank < 0 ? numProcs : numProcs - 1;
+  if (rank == processId || mode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+  {
+    TASSERT(output->GetNumberOfPoints() == (addAttributes ? 1 : numInputs) * numPoints);
+    vtkDataArray* values = output->GetPointData()->GetArray("values");
+    TASSERT(values != nullptr);
+    vtkDataArray* processIds = output->GetPointData()->GetArray("vtkOriginalProcessIds");
+    TASSERT(processIds != nullptr);
+    if (addAttributes)
+    {
+      const int sum = numProcs * (numProcs + 1) / 2;
+      for (vtkIdType i = 0; i < numPoints; ++i)
+      {
+        TASSERT(values->GetTuple1(i) == sum * i);
+        TASSERT(processIds->GetTuple1(i) == (numProcs - 1) * numProcs / 2);
+      }
+    }
+    else
+    {
+      // Inputs are appended in process order.
+      vtkIdType offset = 0;
+      for (int p = 0; p < numProcs; ++p)
+      {
+        if (p == nullRank)
+        {
+          continue;
+        }
+        for (vtkIdType i = 0; i < numPoints; ++i)
+        {
+          TASSERT(values->GetTuple1(offset + i) == (p + 1) * i);
+          TASSERT(processIds->GetTuple1(offset + i) == p);
+        }
+        offset += numPoints;
+      }
+    }
+  }
+  else if (mode == vtkReductionFilter::REDUCE_ALL_TO_ONE && rank != nullRank)
+  {
+    TASSERT(output->GetNumberOfPoints() == numPoints);
+  }
+  else
+  {
+    TASSERT(output->GetNumberOfPoints() == 0);
+  }
+  return true;
+}
+}
+
+int TestReductionFilterTree(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int modes[] = { vtkReductionFilter::REDUCE_ALL_TO_ONE, vtkReductionFilter::MOVE_ALL_TO_ONE,
+    vtkReductionFilter::REDUCE_ALL_TO_ALL };
+  const int nullRanks[] = { -1, 0, 1, numProcs - 1 };
+
+  int valid = 1;
+  for (int mode : modes)
+  {
+    for (int processId : { 0, numProcs - 1 })
+    {
+      for (int nullRank : nullRanks)
+      {
+        if (!TestReduction(controller, false, mode, processId, nullRank))
+        {
+          cerr << "Appending with mode " << mode << ", process id " << processId
+               << " and no input on process " << nullRank << " failed." << endl;
+          valid = 0;
+        }
+      }
+      // The output of vtkAttributeDataReductionFilter has the type of its
+      // input, hence all processes need one.
+      if (!TestReduction(controller, true, mode, processId, -1))
+      {
+        cerr << "Adding attributes with mode " << mode << ", process id " << processId
+             << " failed." << endl;
+        valid = 0;
+      }
+    }
+  }
+
+  int allValid = 0;
+  controller->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
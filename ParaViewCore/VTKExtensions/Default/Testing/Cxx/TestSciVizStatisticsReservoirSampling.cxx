@@ -0,0 +1,245 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSciVizStatisticsReservoirSampling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the training table that vtkSciVizStatistics samples when
+// ReservoirSampling is on, on several processes holding different numbers of
+// observations. The sample has the size given by TrainingFraction for all the
+// observations, each process draws its share in proportion to its number of
+// observations, and the table has the columns of the table of all
+// observations, with distinct rows taken from it.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPSciVizDescriptiveStats.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkVariant.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+class vtkTestSampledStatistics : public vtkPSciVizDescriptiveStats
+{
+public:
+  static vtkTestSampledStatistics* New();
+  vtkTypeMacro(vtkTestSampledStatistics, vtkPSciVizDescriptiveStats);
+
+  using vtkPSciVizDescriptiveStats::PrepareFullDataTable;
+  using vtkPSciVizDescriptiveStats::PrepareSampledTrainingTable;
+};
+vtkStandardNewMacro(vtkTestSampledStatistics);
+
+// The third process, if any, has no observations.
+vtkIdType GetNumberOfRows(int rank)
+{
+  return rank == 2 ? 0 : 1500 + 1100 * rank;
+}
+
+vtkIdType GetFirstRow(int rank)
+{
+  vtkIdType first = 0;
+  for (int p = 0; p < rank; ++p)
+  {
+    first += GetNumberOfRows(p);
+  }
+  return first;
+}
+
+// Scalar, multi-component, named-component, integer and string arrays. The
+// "Row" array holds the global index of each observation.
+vtkSmartPointer<vtkPolyData> CreateInput(int rank)
+{
+  const vtkIdType numRows = GetNumberOfRows(rank);
+  const vtkIdType first = GetFirstRow(rank);
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numRows);
+
+  vtkNew<vtkDoubleArray> row;
+  row->SetName("Row");
+  row->SetNumberOfTuples(numRows);
+  vtkNew<vtkFloatArray> vector;
+  vector->SetName("Vector");
+  vector->SetNumberOfComponents(3);
+  vector->SetNumberOfTuples(numRows);
+  vtkNew<vtkDoubleArray> named;
+  named->SetName("Named");
+  named->SetNumberOfComponents(2);
+  named->SetComponentName(0, "first");
+  named->SetComponentName(1, "second");
+  named->SetNumberOfTuples(numRows);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(numRows);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Label");
+  labels->SetNumberOfTuples(numRows);
+  for (vtkIdType i = 0; i < numRows; ++i)
+  {
+    const vtkIdType id = first + i;
+    points->SetPoint(i, static_cast<double>(id), 0, 0);
+    row->SetValue(i, static_cast<double>(id));
+    for (int c = 0; c < 3; ++c)
+    {
+      vector->SetComponent(i, c, static_cast<float>(10 * id + c));
+    }
+    named->SetComponent(i, 0, -static_cast<double>(id));
+    named->SetComponent(i, 1, 0.5 * id);
+    ids->SetValue(i, static_cast<int>(7 * id));
+    std::ostringstream label;
+    label << "row" << id;
+    labels->SetValue(i, label.str());
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(row);
+  input->GetPointData()->AddArray(vector);
+  input->GetPointData()->AddArray(named);
+  input->GetPointData()->AddArray(ids);
+  input->GetPointData()->AddArray(labels);
+  return input;
+}
+
+bool SameLayout(vtkTable* table, vtkTable* expected)
+{
+  TASSERT(table->GetNumberOfColumns() == expected->GetNumberOfColumns());
+  TASSERT(expected->GetNumberOfColumns() == 8);
+  for (vtkIdType c = 0; c < expected->GetNumberOfColumns(); ++c)
+  {
+    vtkAbstractArray* column = table->GetColumn(c);
+    vtkAbstractArray* expectedColumn = expected->GetColumn(c);
+    TASSERT(std::string(column->GetName()) == expectedColumn->GetName());
+    TASSERT(column->GetDataType() == expectedColumn->GetDataType());
+    TASSERT(column->GetNumberOfComponents() == 1);
+  }
+  TASSERT(table->GetColumnByName("Named_first") && table->GetColumnByName("Vector_2"));
+  return true;
+}
+
+// The rows of the sample must be distinct rows of the table of all
+// observations, in the same order.
+bool SampledRows(vtkTable* sample, vtkTable* full, vtkIdType first)
+{
+  vtkIdType previous = -1;
+  for (vtkIdType r = 0; r < sample->GetNumberOfRows(); ++r)
+  {
+    vtkIdType source = static_cast<vtkIdType>(sample->GetValueByName(r, "Row").ToDouble()) - first;
+    TASSERT(source > previous && source < full->GetNumberOfRows());
+    for (vtkIdType c = 0; c < full->GetNumberOfColumns(); ++c)
+    {
+      TASSERT(sample->GetValue(r, c).ToString() == full->GetValue(source, c).ToString());
+    }
+    previous = source;
+  }
+  return true;
+}
+
+bool TestSample(vtkMultiProcessController* contr, vtkPolyData* input, double fraction)
+{
+  const int rank = contr->GetLocalProcessId();
+  const vtkIdType numRows = GetNumberOfRows(rank);
+  const vtkIdType first = GetFirstRow(rank);
+  vtkIdType total = 0;
+  contr->AllReduce(&numRows, &total, 1, vtkCommunicator::SUM_OP);
+
+  vtkNew<vtkTestSampledStatistics> stats;
+  stats->SetAttributeMode(vtkDataObject::POINT);
+  stats->SetTrainingFraction(fraction);
+  stats->ReservoirSamplingOn();
+  const char* names[] = { "Row", "Vector", "Named", "Ids", "Label" };
+  for (const char* name : names)
+  {
+    stats->EnableAttributeArray(name);
+  }
+
+  vtkNew<vtkTable> full;
+  vtkNew<vtkTable> sample;
+  int valid = stats->PrepareFullDataTable(full, input->GetPointData()) == 1 &&
+    stats->PrepareSampledTrainingTable(sample, input->GetPointData()) == 1;
+  valid = valid && SameLayout(sample, full) && SampledRows(sample, full, first);
+
+  // the share of this process, from the size of the sample of all observations.
+  vtkIdType expectedTotal = static_cast<vtkIdType>(total * fraction);
+  if (expectedTotal < 100)
+  {
+    expectedTotal = std::min(total, static_cast<vtkIdType>(100));
+  }
+  const double scale = static_cast<double>(expectedTotal) / total;
+  const vtkIdType expected = static_cast<vtkIdType>(std::floor(scale * (first + numRows))) -
+    static_cast<vtkIdType>(std::floor(scale * first));
+  const vtkIdType numSampled = sample->GetNumberOfRows();
+  if (numSampled != expected || std::fabs(numSampled - scale * numRows) > 1.)
+  {
+    cerr << "ERROR: rank " << rank << " sampled " << numSampled << " of " << numRows
+         << " observations instead of " << expected << "." << endl;
+    valid = 0;
+  }
+
+  vtkIdType allSampled = 0;
+  contr->AllReduce(&numSampled, &allSampled, 1, vtkCommunicator::SUM_OP);
+  int allValid = 0;
+  contr->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+  if (allSampled != expectedTotal)
+  {
+    if (rank == 0)
+    {
+      cerr << "ERROR: " << allSampled << " observations were sampled instead of " << expectedTotal
+           << " for a training fraction of " << fraction << "." << endl;
+    }
+    return false;
+  }
+  if (!allValid && rank == 0)
+  {
+    cerr << "ERROR: unexpected sample for a training fraction of " << fraction << "." << endl;
+  }
+  return allValid == 1;
+}
+}
+
+int TestSciVizStatisticsReservoirSampling(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  vtkSmartPointer<vtkPolyData> input = CreateInput(contr->GetLocalProcessId());
+  // a fraction small enough for the 100 observations minimum, a usual one and
+  // all the observations.
+  bool success = TestSample(contr, input, 0.01) && TestSample(contr, input, 0.1) &&
+    TestSample(contr, input, 0.37) && TestSample(contr, input, 1.0);
+
+  input = nullptr;
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
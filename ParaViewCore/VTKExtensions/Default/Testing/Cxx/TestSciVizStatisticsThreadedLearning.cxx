@@ -0,0 +1,308 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSciVizStatisticsThreadedLearning.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the ThreadedLearning option of the SciViz statistics filters on
+// several processes. The models of descriptive, multicorrelative and PCA
+// statistics aggregated from blocks of rows learned on several threads must
+// match the models of the parallel statistics engines. Mini-batch k-means
+// must converge to the centers of well separated clusters.
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkDoubleArray.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPSciVizDescriptiveStats.h"
+#include "vtkPSciVizKMeans.h"
+#include "vtkPSciVizMultiCorrelativeStats.h"
+#include "vtkPSciVizPCAStats.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+#include "vtkVariant.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Enough rows for the training table to be split into several blocks.
+vtkIdType GetNumberOfRows(int rank)
+{
+  return 20000 + 3000 * rank;
+}
+
+vtkIdType GetFirstRow(int rank)
+{
+  vtkIdType first = 0;
+  for (int p = 0; p < rank; ++p)
+  {
+    first += GetNumberOfRows(p);
+  }
+  return first;
+}
+
+vtkSmartPointer<vtkPolyData> CreateInput(
+  const std::vector<const char*>& names, int rank, double (*value)(vtkIdType, int))
+{
+  const vtkIdType numRows = GetNumberOfRows(rank);
+  const vtkIdType first = GetFirstRow(rank);
+  vtkSmartPointer<vtkPolyData> input = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numRows);
+  for (vtkIdType i = 0; i < numRows; ++i)
+  {
+    points->SetPoint(i, static_cast<double>(first + i), 0, 0);
+  }
+  input->SetPoints(points);
+  for (size_t c = 0; c < names.size(); ++c)
+  {
+    vtkNew<vtkDoubleArray> array;
+    array->SetName(names[c]);
+    array->SetNumberOfTuples(numRows);
+    for (vtkIdType i = 0; i < numRows; ++i)
+    {
+      array->SetValue(i, value(first + i, static_cast<int>(c)));
+    }
+    input->GetPointData()->AddArray(array);
+  }
+  return input;
+}
+
+// Correlated variables with different variances.
+double CorrelatedValue(vtkIdType row, int column)
+{
+  double x = 3.0 * std::cos(0.37 * row) + 1.0e-5 * row;
+  switch (column)
+  {
+    case 0:
+      return x;
+    case 1:
+      return 0.5 * x + std::sin(1.3 * row);
+    default:
+      return 2.0 + 0.2 * std::sin(0.11 * row) * std::cos(0.7 * row);
+  }
+}
+
+// Three clusters whose members alternate, so that the first rows seed one
+// center in each cluster.
+const double ClusterCenters[3][3] = { { 5, 5, 5 }, { 15, 5, 5 }, { 5, 15, 10 } };
+
+double ClusteredValue(vtkIdType row, int column)
+{
+  return ClusterCenters[row % 3][column] + 0.5 * std::sin(0.7 * row + 1.9 * column);
+}
+
+bool SameValue(const vtkVariant& a, const vtkVariant& b)
+{
+  if (a.IsNumeric() && b.IsNumeric())
+  {
+    double x = a.ToDouble();
+    double y = b.ToDouble();
+    return std::fabs(x - y) <= 1e-8 * std::max(1.0, std::max(std::fabs(x), std::fabs(y)));
+  }
+  return a.ToString() == b.ToString();
+}
+
+bool SameTable(vtkTable* a, vtkTable* b)
+{
+  TASSERT(a && b);
+  TASSERT(a->GetNumberOfColumns() == b->GetNumberOfColumns());
+  TASSERT(a->GetNumberOfRows() == b->GetNumberOfRows());
+  for (vtkIdType c = 0; c < a->GetNumberOfColumns(); ++c)
+  {
+    TASSERT(std::string(a->GetColumnName(c)) == b->GetColumnName(c));
+    for (vtkIdType r = 0; r < a->GetNumberOfRows(); ++r)
+    {
+      if (!SameValue(a->GetValue(r, c), b->GetValue(r, c)))
+      {
+        cerr << "ERROR: " << a->GetColumnName(c) << " differs at row " << r << ": "
+             << a->GetValue(r, c).ToString() << " != " << b->GetValue(r, c).ToString() << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameModel(vtkDataObject* a, vtkDataObject* b)
+{
+  auto mba = vtkMultiBlockDataSet::SafeDownCast(a);
+  auto mbb = vtkMultiBlockDataSet::SafeDownCast(b);
+  if (!mba || !mbb)
+  {
+    return SameTable(vtkTable::SafeDownCast(a), vtkTable::SafeDownCast(b));
+  }
+  TASSERT(mba->GetNumberOfBlocks() == mbb->GetNumberOfBlocks());
+  TASSERT(mba->GetNumberOfBlocks() > 0);
+  for (unsigned int i = 0; i < mba->GetNumberOfBlocks(); ++i)
+  {
+    TASSERT(SameModel(mba->GetBlock(i), mbb->GetBlock(i)));
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkDataObject> LearnModel(
+  vtkSciVizStatistics* filter, vtkPolyData* input, const std::vector<const char*>& names)
+{
+  filter->SetInputData(input);
+  filter->SetAttributeMode(vtkDataObject::POINT);
+  filter->SetTask(vtkSciVizStatistics::MODEL_INPUT);
+  for (const char* name : names)
+  {
+    filter->EnableAttributeArray(name);
+  }
+  filter->Update();
+  vtkSmartPointer<vtkDataObject> model;
+  model.TakeReference(filter->GetOutputDataObject(0)->NewInstance());
+  model->DeepCopy(filter->GetOutputDataObject(0));
+  return model;
+}
+
+template <typename FilterT>
+bool TestSameModel(vtkMultiProcessController* contr, const char* name)
+{
+  const std::vector<const char*> names = { "X", "Y", "Z" };
+  vtkSmartPointer<vtkPolyData> input =
+    CreateInput(names, contr->GetLocalProcessId(), CorrelatedValue);
+
+  vtkNew<FilterT> engine;
+  vtkSmartPointer<vtkDataObject> expected = LearnModel(engine, input, names);
+  vtkNew<FilterT> threaded;
+  threaded->ThreadedLearningOn();
+  vtkSmartPointer<vtkDataObject> model = LearnModel(threaded, input, names);
+
+  int valid = SameModel(model, expected) ? 1 : 0;
+  int allValid = 0;
+  contr->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+  if (!allValid && contr->GetLocalProcessId() == 0)
+  {
+    cerr << "ERROR: the threaded " << name << " model differs from the engine's." << endl;
+  }
+  return allValid == 1;
+}
+
+// Every cluster must have a center of the model within `tolerance` of the
+// mean of its members.
+bool HasClusterCenters(vtkDataObject* model, const double means[3][3], double tolerance)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(vtkMultiBlockDataSet::SafeDownCast(model)->NewIterator());
+  vtkTable* centers = nullptr;
+  for (iter->InitTraversal(); !centers && !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    if (table && table->GetColumnByName("U") && table->GetColumnByName("V") &&
+      table->GetColumnByName("W"))
+    {
+      centers = table;
+    }
+  }
+  TASSERT(centers && centers->GetNumberOfRows() == 3);
+  for (int k = 0; k < 3; ++k)
+  {
+    double nearest = VTK_DOUBLE_MAX;
+    for (vtkIdType r = 0; r < centers->GetNumberOfRows(); ++r)
+    {
+      double dist2 = 0;
+      const char* columns[3] = { "U", "V", "W" };
+      for (int j = 0; j < 3; ++j)
+      {
+        double delta = centers->GetValueByName(r, columns[j]).ToDouble() - means[k][j];
+        dist2 += delta * delta;
+      }
+      nearest = std::min(nearest, std::sqrt(dist2));
+    }
+    if (nearest > tolerance)
+    {
+      cerr << "ERROR: cluster " << k << " is " << nearest << " away from the closest center."
+           << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestMiniBatchKMeans(vtkMultiProcessController* contr)
+{
+  const std::vector<const char*> names = { "U", "V", "W" };
+  const int rank = contr->GetLocalProcessId();
+  vtkSmartPointer<vtkPolyData> input = CreateInput(names, rank, ClusteredValue);
+
+  // the exact means of the clusters over all processes.
+  double sums[12] = { 0 };
+  const vtkIdType first = GetFirstRow(rank);
+  for (vtkIdType row = first; row < first + GetNumberOfRows(rank); ++row)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      sums[(row % 3) * 3 + j] += ClusteredValue(row, j);
+    }
+    sums[9 + row % 3] += 1;
+  }
+  double allSums[12];
+  contr->AllReduce(sums, allSums, 12, vtkCommunicator::SUM_OP);
+  double means[3][3];
+  for (int k = 0; k < 3; ++k)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      means[k][j] = allSums[k * 3 + j] / allSums[9 + k];
+    }
+  }
+
+  vtkNew<vtkPSciVizKMeans> kmeans;
+  kmeans->ThreadedLearningOn();
+  kmeans->SetK(3);
+  kmeans->SetMiniBatchSize(256);
+  kmeans->SetMaxNumIterations(200);
+  kmeans->SetTolerance(0.001);
+  vtkSmartPointer<vtkDataObject> model = LearnModel(kmeans, input, names);
+
+  int valid = HasClusterCenters(model, means, 0.05) ? 1 : 0;
+  int allValid = 0;
+  contr->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+  if (!allValid && rank == 0)
+  {
+    cerr << "ERROR: mini-batch k-means did not find the cluster centers." << endl;
+  }
+  return allValid == 1;
+}
+}
+
+int TestSciVizStatisticsThreadedLearning(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  bool success = TestSameModel<vtkPSciVizDescriptiveStats>(contr, "descriptive") &&
+    TestSameModel<vtkPSciVizMultiCorrelativeStats>(contr, "multicorrelative") &&
+    TestSameModel<vtkPSciVizPCAStats>(contr, "PCA") && TestMiniBatchKMeans(contr);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
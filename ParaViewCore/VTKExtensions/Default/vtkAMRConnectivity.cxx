@@ -45,6 +45,7 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 vtkStandardNewMacro(vtkAMRConnectivity);
 
@@ -181,6 +182,85 @@ private:
   vtkSmartPointer<vtkIntArray> set_to_min_id;
 };
 
+//-----------------------------------------------------------------------------
+// Union-find over region ids. Each set is represented by its smallest member,
+// like in vtkAMRConnectivityEquivalence, and only members that do not
+// represent their set are stored.
+class vtkAMRConnectivityUnionFind
+{
+public:
+  // Return the id of the set the member belongs to.
+  int Find(int memberId)
+  {
+    int setId = memberId;
+    std::unordered_map<int, int>::iterator it = this->Parents.find(setId);
+    while (it != this->Parents.end())
+    {
+      setId = it->second;
+      it = this->Parents.find(setId);
+    }
+    // Compress the path.
+    while (memberId != setId)
+    {
+      it = this->Parents.find(memberId);
+      memberId = it->second;
+      it->second = setId;
+    }
+    return setId;
+  }
+
+  void AddEquivalence(int id1, int id2)
+  {
+    id1 = this->Find(id1);
+    id2 = this->Find(id2);
+    if (id1 < id2)
+    {
+      this->Parents[id2] = id1;
+    }
+    else if (id2 < id1)
+    {
+      this->Parents[id1] = id2;
+    }
+  }
+
+  // Append (member id, set id) pairs for the members that do not represent
+  // their set. When numProcs is positive, only members created by processes
+  // in [firstProc, lastProc) are considered.
+  void GetEquivalences(
+    std::vector<int>& pairs, int numProcs = 0, int firstProc = 0, int lastProc = 0)
+  {
+    std::unordered_map<int, int>::iterator it;
+    for (it = this->Parents.begin(); it != this->Parents.end(); ++it)
+    {
+      if (numProcs > 0)
+      {
+        // Region ids are created as proc + 1 + n * numProcs.
+        int proc = (it->first - 1) % numProcs;
+        if (proc < firstProc || proc >= lastProc)
+        {
+          continue;
+        }
+      }
+      pairs.push_back(it->first);
+      pairs.push_back(this->Find(it->first));
+    }
+  }
+
+  void AddEquivalences(const std::vector<int>& pairs)
+  {
+    for (size_t ii = 0; ii + 1 < pairs.size(); ii += 2)
+    {
+      this->AddEquivalence(pairs[ii], pairs[ii + 1]);
+    }
+  }
+
+private:
+  std::unordered_map<int, int> Parents;
+};
+
+static const int UNION_FIND_SIZE_TAG = 748958;
+static const int UNION_FIND_TAG = 357346;
+
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
 
 static const int BOUNDARY_TAG = 857089;
@@ -242,8 +322,10 @@ vtkAMRConnectivity::vtkAMRConnectivity()
   this->VolumeFractionSurfaceValue = 0.5;
   this->Helper = 0;
   this->Equivalence = 0;
+  this->UnionFind = 0;
   this->ResolveBlocks = 1;
   this->PropagateGhosts = 0;
+  this->ResolveWithUnionFind = false;
 }
 
 vtkAMRConnectivity::~vtkAMRConnectivity()
@@ -254,6 +336,7 @@ void vtkAMRConnectivity::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "VolumeFractionSurfaceValue: " << this->VolumeFractionSurfaceValue << endl;
+  os << indent << "ResolveWithUnionFind: " << this->ResolveWithUnionFind << endl;
 }
 
 void vtkAMRConnectivity::AddInputVolumeArrayToProcess(const char* name)
@@ -490,6 +573,10 @@ int vtkAMRConnectivity::DoRequestData(vtkNonOverlappingAMR* volume, const char*
 #endif
     // Process all boundaries at the neighbors to find the equivalence pairs at the boundaries
     this->Equivalence = new vtkAMRConnectivityEquivalence;
+    if (this->ResolveWithUnionFind)
+    {
+      this->UnionFind = new vtkAMRConnectivityUnionFind;
+    }
 
     // Initialize equivalence with all regions independent
     for (size_t i = 0; i < this->BoundaryArrays.size(); i++)
@@ -507,7 +594,18 @@ int vtkAMRConnectivity::DoRequestData(vtkNonOverlappingAMR* volume, const char*
 
     vtkTimerLog::MarkStartEvent("Transferring equivalence");
     this->EquivPairs.resize(numProcs);
-    while (true)
+    if (this->UnionFind)
+    {
+      int success = this->ResolveUnionFind(volume);
+      delete this->UnionFind;
+      this->UnionFind = 0;
+      if (!success)
+      {
+        return 0;
+      }
+    }
+    // Otherwise iterate exchanges with the neighbors until no set changes.
+    while (!this->ResolveWithUnionFind)
     {
       int sets_changed = 0;
       // Relabel all fragment IDs with the equivalence set number
@@ -1299,7 +1397,7 @@ void vtkAMRConnectivity::ProcessBoundaryAtNeighbor(
           int blockRegion = array->GetTuple1(index);
           if (neighborRegion != 0 && blockRegion != 0)
           {
-            this->Equivalence->AddEquivalence(neighborRegion, blockRegion);
+            this->AddEquivalence(neighborRegion, blockRegion);
           }
         }
         index++;
@@ -1320,7 +1418,7 @@ void vtkAMRConnectivity::ProcessBoundaryAtNeighbor(
           int blockRegion = array->GetTuple1(index);
           if (neighborRegion != 0 && blockRegion != 0)
           {
-            this->Equivalence->AddEquivalence(neighborRegion, blockRegion);
+            this->AddEquivalence(neighborRegion, blockRegion);
           }
           index++;
         }
@@ -1328,3 +1426,126 @@ void vtkAMRConnectivity::ProcessBoundaryAtNeighbor(
     }
   }
 }
+
+//----------------------------------------------------------------------------
+void vtkAMRConnectivity::AddEquivalence(int id1, int id2)
+{
+  if (this->UnionFind)
+  {
+    this->UnionFind->AddEquivalence(id1, id2);
+  }
+  else
+  {
+    this->Equivalence->AddEquivalence(id1, id2);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Resolves the equivalences collapsed in this->UnionFind on every process.
+// The union-finds are merged along a binary tree rooted at process 0. On the
+// way back, each process only receives the resolved ids of the regions
+// created by the processes of its subtree, since a process only relabels the
+// regions it created. This takes 2 log(numProcs) rounds of messages.
+int vtkAMRConnectivity::ResolveUnionFind(vtkNonOverlappingAMR* volume)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  int myProc = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  // Merge the equivalences of the children.
+  std::vector<int> pairs;
+  int parentStep = numProcs;
+  int step = 1;
+  for (; step < numProcs; step *= 2)
+  {
+    if (myProc % (2 * step) == step)
+    {
+      parentStep = step;
+      pairs.clear();
+      this->UnionFind->GetEquivalences(pairs);
+      int numValues = static_cast<int>(pairs.size());
+      controller->Send(&numValues, 1, myProc - step, UNION_FIND_SIZE_TAG);
+      if (numValues > 0)
+      {
+        controller->Send(&pairs[0], numValues, myProc - step, UNION_FIND_TAG);
+      }
+      break;
+    }
+    if (myProc + step < numProcs)
+    {
+      int numValues = 0;
+      controller->Receive(&numValues, 1, myProc + step, UNION_FIND_SIZE_TAG);
+      pairs.resize(numValues);
+      if (numValues > 0)
+      {
+        controller->Receive(&pairs[0], numValues, myProc + step, UNION_FIND_TAG);
+      }
+      this->UnionFind->AddEquivalences(pairs);
+    }
+  }
+
+  // Get the resolved ids of the regions of this subtree from the parent.
+  if (parentStep < numProcs)
+  {
+    int numValues = 0;
+    controller->Receive(&numValues, 1, myProc - parentStep, UNION_FIND_SIZE_TAG);
+    pairs.resize(numValues);
+    if (numValues > 0)
+    {
+      controller->Receive(&pairs[0], numValues, myProc - parentStep, UNION_FIND_TAG);
+    }
+    this->UnionFind->AddEquivalences(pairs);
+  }
+
+  // Send the resolved ids of the regions of their subtree to the children.
+  for (step = (parentStep < numProcs ? parentStep : step) / 2; step >= 1; step /= 2)
+  {
+    if (myProc + step >= numProcs)
+    {
+      continue;
+    }
+    pairs.clear();
+    int lastProc = myProc + 2 * step < numProcs ? myProc + 2 * step : numProcs;
+    this->UnionFind->GetEquivalences(pairs, numProcs, myProc + step, lastProc);
+    int numValues = static_cast<int>(pairs.size());
+    controller->Send(&numValues, 1, myProc + step, UNION_FIND_SIZE_TAG);
+    if (numValues > 0)
+    {
+      controller->Send(&pairs[0], numValues, myProc + step, UNION_FIND_TAG);
+    }
+  }
+
+  // Relabel the regions of the local blocks.
+  for (int level = 0; level < this->Helper->GetNumberOfLevels(); level++)
+  {
+    for (int blockId = 0; blockId < this->Helper->GetNumberOfBlocksInLevel(level); blockId++)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->ProcessId != myProc)
+      {
+        continue;
+      }
+      vtkUniformGrid* grid = volume->GetDataSet(block->Level, block->BlockId);
+      vtkIdTypeArray* regionIdArray =
+        vtkIdTypeArray::SafeDownCast(grid->GetCellData()->GetArray(this->RegionName.c_str()));
+      if (regionIdArray == 0)
+      {
+        vtkErrorMacro("block Image doesn't not contain the regionId just added");
+        return 0;
+      }
+      for (vtkIdType i = 0; i < regionIdArray->GetNumberOfTuples(); i++)
+      {
+        vtkIdType regionId = regionIdArray->GetValue(i);
+        if (regionId > 0)
+        {
+          regionIdArray->SetValue(i, this->UnionFind->Find(static_cast<int>(regionId)));
+        }
+        else
+        {
+          regionIdArray->SetValue(i, 0);
+        }
+      }
+    }
+  }
+  return 1;
+}
@@ -37,6 +37,7 @@ class vtkIntArray;
 class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRConnectivityEquivalence;
+class vtkAMRConnectivityUnionFind;
 class vtkMPIController;
 class vtkUnsignedCharArray;
 
@@ -79,6 +80,20 @@ public:
   vtkSetMacro(PropagateGhosts, bool);
   //@}
 
+  //@{
+  /**
+   * Get / Set whether region ids are resolved between blocks with a union-find
+   * instead of iterating exchanges of equivalences between neighboring
+   * processes. Equivalences found on each process are first collapsed
+   * locally, then merged along a binary tree of processes, so the number of
+   * communication rounds grows with the logarithm of the number of processes
+   * rather than with the size of the largest fragment. Resulting region ids
+   * are the same. Off by default.
+   */
+  vtkGetMacro(ResolveWithUnionFind, bool);
+  vtkSetMacro(ResolveWithUnionFind, bool);
+  //@}
+
 protected:
   vtkAMRConnectivity();
   ~vtkAMRConnectivity() override;
@@ -86,9 +101,11 @@ protected:
   double VolumeFractionSurfaceValue;
   vtkAMRDualGridHelper* Helper;
   vtkAMRConnectivityEquivalence* Equivalence;
+  vtkAMRConnectivityUnionFind* UnionFind;
 
   bool ResolveBlocks;
   bool PropagateGhosts;
+  bool ResolveWithUnionFind;
 
   std::string RegionName;
   vtkIdType NextRegionId;
@@ -117,6 +134,8 @@ protected:
   int ExchangeBoundaries(vtkMPIController* controller);
   int ExchangeEquivPairs(vtkMPIController* controller);
   void ProcessBoundaryAtNeighbor(vtkNonOverlappingAMR* volume, vtkIdTypeArray* array);
+  void AddEquivalence(int id1, int id2);
+  int ResolveUnionFind(vtkNonOverlappingAMR* volume);
 
 private:
   vtkAMRConnectivity(const vtkAMRConnectivity&) = delete;
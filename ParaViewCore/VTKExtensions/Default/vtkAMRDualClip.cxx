@@ -1030,6 +1030,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->EnableDistributedBlockDirectory = 0;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1064,6 +1065,8 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableDistributedBlockDirectory: " << this->EnableDistributedBlockDirectory
+     << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1166,6 +1169,7 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
 
   this->Helper = vtkAMRDualGridHelper::New();
   this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
+  this->Helper->SetEnableDistributedBlockDirectory(this->EnableDistributedBlockDirectory);
   if (this->EnableMultiProcessCommunication)
   {
     this->Helper->SetController(this->Controller);
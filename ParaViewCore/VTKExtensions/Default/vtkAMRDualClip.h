@@ -85,6 +85,17 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * When on, processes discover their neighbors through a distributed block
+   * directory instead of gathering every block.  See
+   * vtkAMRDualGridHelper::SetEnableDistributedBlockDirectory.  Off by default.
+   */
+  vtkSetMacro(EnableDistributedBlockDirectory, int);
+  vtkGetMacro(EnableDistributedBlockDirectory, int);
+  vtkBooleanMacro(EnableDistributedBlockDirectory, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -99,6 +110,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int EnableDistributedBlockDirectory;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
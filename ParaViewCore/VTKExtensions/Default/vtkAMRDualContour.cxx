@@ -623,6 +623,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->EnableDistributedBlockDirectory = 0;
 
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -661,6 +662,8 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "EnableDistributedBlockDirectory: " << this->EnableDistributedBlockDirectory
+     << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -763,6 +766,7 @@ void vtkAMRDualContour::InitializeRequest(vtkNonOverlappingAMR* hbdsInput)
   this->Helper = vtkAMRDualGridHelper::New();
   this->Helper->SetEnableDegenerateCells(this->EnableDegenerateCells);
   this->Helper->SetSkipGhostCopy(this->SkipGhostCopy);
+  this->Helper->SetEnableDistributedBlockDirectory(this->EnableDistributedBlockDirectory);
   if (this->EnableMultiProcessCommunication)
   {
     this->Helper->SetController(this->Controller);
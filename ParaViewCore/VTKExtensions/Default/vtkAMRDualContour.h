@@ -114,6 +114,17 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   //@}
 
+  //@{
+  /**
+   * When on, processes discover their neighbors through a distributed block
+   * directory instead of gathering every block.  See
+   * vtkAMRDualGridHelper::SetEnableDistributedBlockDirectory.  Off by default.
+   */
+  vtkSetMacro(EnableDistributedBlockDirectory, int);
+  vtkGetMacro(EnableDistributedBlockDirectory, int);
+  vtkBooleanMacro(EnableDistributedBlockDirectory, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -130,6 +141,7 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  int EnableDistributedBlockDirectory;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
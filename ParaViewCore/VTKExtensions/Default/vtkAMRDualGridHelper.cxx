@@ -34,7 +34,10 @@
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+#include <algorithm>
 #include <list>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "vtksys/SystemTools.hxx"
@@ -60,6 +63,8 @@ class vtkAMRDualGridHelperSeed;
 // Tags used in communication.
 static const int SHARED_BLOCK_TAG = 2392734;
 static const int DEGENERATE_REGION_TAG = 879015;
+static const int BLOCK_DIRECTORY_REGISTER_TAG = 3391417;
+static const int BLOCK_DIRECTORY_REPLY_TAG = 3391419;
 
 //=============================================================================
 #if 1
@@ -719,6 +724,7 @@ vtkAMRDualGridHelper::vtkAMRDualGridHelper()
   this->ArrayName = 0;
   this->EnableDegenerateCells = 1;
   this->EnableAsynchronousCommunication = 1;
+  this->EnableDistributedBlockDirectory = 0;
   this->NumberOfBlocksInThisProcess = 0;
   for (ii = 0; ii < 3; ++ii)
   {
@@ -768,6 +774,8 @@ void vtkAMRDualGridHelper::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableAsynchronousCommunication: " << this->EnableAsynchronousCommunication
      << endl;
+  os << indent << "EnableDistributedBlockDirectory: " << this->EnableDistributedBlockDirectory
+     << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -2322,6 +2330,23 @@ int vtkAMRDualGridHelper::Initialize(vtkNonOverlappingAMR* input)
     vtkSortDataArray::Sort(neighbors);
     this->ShareBlocksWithNeighbors(neighbors);
   }
+#ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  else if (this->EnableDistributedBlockDirectory &&
+    this->Controller->GetNumberOfProcesses() > 1 && this->Controller->IsA("vtkMPIController"))
+  {
+    // Find the neighbors through the block directory and then proceed as if
+    // they had been passed in.
+    VTK_CREATE(vtkIntArray, directoryNeighbors);
+    if (this->ComputeNeighborsFromBlockDirectory(directoryNeighbors))
+    {
+      this->ShareBlocksWithNeighbors(directoryNeighbors);
+    }
+    else
+    {
+      this->ShareBlocks();
+    }
+  }
+#endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
   else
   {
     // otherwise share block information with all processes
@@ -2412,6 +2437,284 @@ void vtkAMRDualGridHelper::ShareBlocks()
   this->UnmarshalBlocks(recvBuffer);
 }
 
+#ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+namespace
+{
+// Level 0 cell of the block grid that contains a block.  Levels are refined
+// by a factor of two, so a level L block lies in cell (index >> L).
+struct vtkAMRDualGridHelperDirectoryCell
+{
+  int Index[3];
+  bool operator<(const vtkAMRDualGridHelperDirectoryCell& other) const
+  {
+    return std::lexicographical_compare(this->Index, this->Index + 3, other.Index, other.Index + 3);
+  }
+};
+
+// Process that holds the directory entry of a cell.
+int vtkAMRDualGridHelperDirectoryOwner(const int index[3], int numProcs)
+{
+  unsigned int hash = static_cast<unsigned int>(index[0]) * 73856093u ^
+    static_cast<unsigned int>(index[1]) * 19349663u ^
+    static_cast<unsigned int>(index[2]) * 83492791u;
+  return static_cast<int>(hash % static_cast<unsigned int>(numProcs));
+}
+
+typedef std::map<int, std::vector<int> > vtkAMRDualGridHelperMessages;
+
+// Posts a (sender, length) header to the key of every message, followed by the
+// payload with the next tag when it is not empty.  Empty messages are sent as
+// well, so that the receivers can expect them.
+void vtkAMRDualGridHelperSendMessages(vtkMPIController* controller,
+  const vtkAMRDualGridHelperMessages& messages, int tag, std::vector<int>& headers,
+  std::vector<vtkMPICommunicator::Request>& requests)
+{
+  int myProc = controller->GetLocalProcessId();
+  headers.resize(2 * messages.size());
+  requests.resize(2 * messages.size());
+  size_t numRequests = 0;
+  int* header = headers.empty() ? nullptr : &headers[0];
+  vtkAMRDualGridHelperMessages::const_iterator it;
+  for (it = messages.begin(); it != messages.end(); ++it, header += 2)
+  {
+    header[0] = myProc;
+    header[1] = static_cast<int>(it->second.size());
+    controller->NoBlockSend(header, 2, it->first, tag, requests[numRequests++]);
+    if (header[1] > 0)
+    {
+      controller->NoBlockSend(
+        &it->second[0], header[1], it->first, tag + 1, requests[numRequests++]);
+    }
+  }
+  requests.resize(numRequests);
+}
+
+void vtkAMRDualGridHelperReceiveMessage(
+  vtkMPIController* controller, int source, int tag, vtkAMRDualGridHelperMessages& result)
+{
+  int header[2];
+  controller->Receive(header, 2, source, tag);
+  std::vector<int>& payload = result[header[0]];
+  payload.resize(header[1]);
+  if (header[1] > 0)
+  {
+    controller->Receive(&payload[0], header[1], header[0], tag + 1);
+  }
+}
+
+void vtkAMRDualGridHelperWaitAll(std::vector<vtkMPICommunicator::Request>& requests)
+{
+  for (size_t ii = 0; ii < requests.size(); ++ii)
+  {
+    requests[ii].Wait();
+  }
+}
+
+// Sends the messages to the processes they are keyed by and returns the
+// messages received by this process keyed by sender.  Receivers do not know
+// their senders, so messages are received as they arrive until every message
+// sent by any process has been received.  This only needs the global count of
+// pending messages, hence reductions of a single value rather than one value
+// per process.
+void vtkAMRDualGridHelperSparseExchange(vtkMPIController* controller,
+  const vtkAMRDualGridHelperMessages& messages, int tag, vtkAMRDualGridHelperMessages& result)
+{
+  vtkMPICommunicator* communicator =
+    vtkMPICommunicator::SafeDownCast(controller->GetCommunicator());
+
+  std::vector<int> headers;
+  std::vector<vtkMPICommunicator::Request> requests;
+  vtkAMRDualGridHelperSendMessages(controller, messages, tag, headers, requests);
+
+  // Messages sent by this process minus the ones it received.  Their sum over
+  // all processes is the number of messages still in flight.
+  int balance = static_cast<int>(messages.size());
+  int numInFlight = 0;
+  do
+  {
+    int flag = 1;
+    while (flag)
+    {
+      int source = -1;
+      communicator->Iprobe(vtkMultiProcessController::ANY_SOURCE, tag, &flag, &source);
+      if (flag)
+      {
+        vtkAMRDualGridHelperReceiveMessage(controller, source, tag, result);
+        --balance;
+      }
+    }
+    controller->AllReduce(&balance, &numInFlight, 1, vtkCommunicator::SUM_OP);
+  } while (numInFlight > 0);
+
+  vtkAMRDualGridHelperWaitAll(requests);
+}
+
+// Sends the messages to the processes they are keyed by and returns the one
+// message received from each of the given sources, keyed by sender.
+void vtkAMRDualGridHelperExchange(vtkMPIController* controller,
+  const vtkAMRDualGridHelperMessages& messages, const std::vector<int>& sources, int tag,
+  vtkAMRDualGridHelperMessages& result)
+{
+  std::vector<int> headers;
+  std::vector<vtkMPICommunicator::Request> requests;
+  vtkAMRDualGridHelperSendMessages(controller, messages, tag, headers, requests);
+  for (size_t ii = 0; ii < sources.size(); ++ii)
+  {
+    vtkAMRDualGridHelperReceiveMessage(controller, sources[ii], tag, result);
+  }
+  vtkAMRDualGridHelperWaitAll(requests);
+}
+}
+
+//-----------------------------------------------------------------------------
+// Each process registers every level 0 cell covered by its blocks, together
+// with the surrounding cells, with the process owning the cell in the
+// directory.  The owner replies to each registering process with all the
+// processes that registered the cells it covers.  Since blocks only interact
+// with blocks in adjacent cells, this yields the neighbor processes without any
+// process seeing the global block list.
+bool vtkAMRDualGridHelper::ComputeNeighborsFromBlockDirectory(vtkIntArray* neighbors)
+{
+  vtkTimerLogSmartMarkEvent markevent("ComputeNeighborsFromBlockDirectory", this->Controller);
+
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
+  if (!controller)
+  {
+    vtkErrorMacro("Internal error:"
+                  " ComputeNeighborsFromBlockDirectory called without"
+                  " MPI controller.");
+    return false;
+  }
+
+  int numProcs = controller->GetNumberOfProcesses();
+  int myProc = controller->GetLocalProcessId();
+
+  // Cells covered by local blocks.
+  std::set<vtkAMRDualGridHelperDirectoryCell> occupied;
+  int numLevels = this->GetNumberOfLevels();
+  for (int levelIdx = 0; levelIdx < numLevels; ++levelIdx)
+  {
+    vtkAMRDualGridHelperLevel* level = this->Levels[levelIdx];
+    for (size_t blockIdx = 0; blockIdx < level->Blocks.size(); ++blockIdx)
+    {
+      vtkAMRDualGridHelperBlock* block = level->Blocks[blockIdx];
+      vtkAMRDualGridHelperDirectoryCell cell;
+      for (int ii = 0; ii < 3; ++ii)
+      {
+        cell.Index[ii] = block->GridIndex[ii] >> levelIdx;
+      }
+      occupied.insert(cell);
+    }
+  }
+
+  // Register (x, y, z, occupied) records with the directory owners.
+  vtkAMRDualGridHelperMessages registrations;
+  std::set<vtkAMRDualGridHelperDirectoryCell> registered;
+  std::set<vtkAMRDualGridHelperDirectoryCell>::const_iterator it;
+  for (it = occupied.begin(); it != occupied.end(); ++it)
+  {
+    for (int dz = -1; dz <= 1; ++dz)
+    {
+      for (int dy = -1; dy <= 1; ++dy)
+      {
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+          vtkAMRDualGridHelperDirectoryCell cell;
+          cell.Index[0] = it->Index[0] + dx;
+          cell.Index[1] = it->Index[1] + dy;
+          cell.Index[2] = it->Index[2] + dz;
+          if (!registered.insert(cell).second)
+          {
+            continue;
+          }
+          std::vector<int>& message =
+            registrations[vtkAMRDualGridHelperDirectoryOwner(cell.Index, numProcs)];
+          message.insert(message.end(), cell.Index, cell.Index + 3);
+          message.push_back(occupied.count(cell) ? 1 : 0);
+        }
+      }
+    }
+  }
+
+  vtkAMRDualGridHelperMessages received;
+  vtkAMRDualGridHelperSparseExchange(
+    controller, registrations, BLOCK_DIRECTORY_REGISTER_TAG, received);
+
+  // Every owner replies to the processes that registered cells with it, hence
+  // the replies come from known processes.
+  std::vector<int> owners;
+  vtkAMRDualGridHelperMessages::const_iterator msgIt;
+  for (msgIt = registrations.begin(); msgIt != registrations.end(); ++msgIt)
+  {
+    owners.push_back(msgIt->first);
+  }
+  registrations.clear();
+
+  // Directory entries: processes registering a cell and processes covering it.
+  typedef std::pair<std::set<int>, std::set<int> > DirectoryEntry;
+  std::map<vtkAMRDualGridHelperDirectoryCell, DirectoryEntry> directory;
+  std::map<int, std::set<int> > replySets;
+  for (msgIt = received.begin(); msgIt != received.end(); ++msgIt)
+  {
+    const std::vector<int>& message = msgIt->second;
+    // Registering processes get a reply, even an empty one.
+    replySets[msgIt->first];
+    for (size_t ii = 0; ii + 3 < message.size(); ii += 4)
+    {
+      vtkAMRDualGridHelperDirectoryCell cell;
+      cell.Index[0] = message[ii];
+      cell.Index[1] = message[ii + 1];
+      cell.Index[2] = message[ii + 2];
+      DirectoryEntry& entry = directory[cell];
+      entry.first.insert(msgIt->first);
+      if (message[ii + 3])
+      {
+        entry.second.insert(msgIt->first);
+      }
+    }
+  }
+  received.clear();
+
+  std::map<vtkAMRDualGridHelperDirectoryCell, DirectoryEntry>::const_iterator dirIt;
+  for (dirIt = directory.begin(); dirIt != directory.end(); ++dirIt)
+  {
+    const std::set<int>& occupants = dirIt->second.second;
+    for (std::set<int>::const_iterator occIt = occupants.begin(); occIt != occupants.end();
+         ++occIt)
+    {
+      replySets[*occIt].insert(dirIt->second.first.begin(), dirIt->second.first.end());
+    }
+  }
+  directory.clear();
+
+  vtkAMRDualGridHelperMessages replies;
+  std::map<int, std::set<int> >::const_iterator replyIt;
+  for (replyIt = replySets.begin(); replyIt != replySets.end(); ++replyIt)
+  {
+    replies[replyIt->first].assign(replyIt->second.begin(), replyIt->second.end());
+  }
+  replySets.clear();
+
+  vtkAMRDualGridHelperExchange(controller, replies, owners, BLOCK_DIRECTORY_REPLY_TAG, received);
+
+  std::set<int> neighborProcs;
+  for (msgIt = received.begin(); msgIt != received.end(); ++msgIt)
+  {
+    neighborProcs.insert(msgIt->second.begin(), msgIt->second.end());
+  }
+  neighborProcs.erase(myProc);
+
+  // Sorted, as the neighbors passed in the field data are.
+  neighbors->SetNumberOfValues(0);
+  for (std::set<int>::const_iterator procIt = neighborProcs.begin();
+       procIt != neighborProcs.end(); ++procIt)
+  {
+    neighbors->InsertNextValue(*procIt);
+  }
+  return true;
+}
+#endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+
 void vtkAMRDualGridHelper::ShareBlocksWithNeighbors(vtkIntArray* neighbors)
 {
 // Intentionally sharing twice so that we can get agreement with neighbors of neighbors
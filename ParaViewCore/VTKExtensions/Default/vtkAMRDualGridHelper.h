@@ -87,6 +87,23 @@ public:
   vtkBooleanMacro(EnableAsynchronousCommunication, int);
   //@}
 
+  //@{
+  /**
+   * When this option is on and the input does not provide a "Neighbors" field
+   * array, discover the neighboring processes through a distributed directory
+   * instead of gathering every block on every process.  Each level 0 cell of
+   * the block grid is owned by a process chosen by a spatial hash; processes
+   * register the cells their blocks cover with the owners, which answer with
+   * the processes touching the surrounding cells.  Blocks are then only shared
+   * with those neighbors, so memory and communication scale with the local
+   * block count.  This requires MPI and falls back to the global exchange
+   * otherwise.  This is off by default.  Set this before you call initialize.
+   */
+  vtkGetMacro(EnableDistributedBlockDirectory, int);
+  vtkSetMacro(EnableDistributedBlockDirectory, int);
+  vtkBooleanMacro(EnableDistributedBlockDirectory, int);
+  //@}
+
   //@{
   /**
    * The controller to use for communication.
@@ -156,6 +173,8 @@ private:
   void ShareBlocksWithNeighbors(vtkIntArray* neighbors);
   void ShareBlocksWithNeighborsAsynchronous(vtkIntArray* neighbors);
   void ShareBlocksWithNeighborsSynchronous(vtkIntArray* neighbors);
+  // NOTE: This method is NOT DEFINED if not compiled with MPI.
+  bool ComputeNeighborsFromBlockDirectory(vtkIntArray* neighbors);
   void MarshalBlocks(vtkIntArray* buffer);
   void UnmarshalBlocks(vtkIntArray* buffer);
   void UnmarshalBlocksFromOne(vtkIntArray* buffer, int blockProc);
@@ -224,6 +243,8 @@ private:
 
   int EnableAsynchronousCommunication;
 
+  int EnableDistributedBlockDirectory;
+
 private:
   vtkAMRDualGridHelper(const vtkAMRDualGridHelper&) = delete;
   void operator=(const vtkAMRDualGridHelper&) = delete;
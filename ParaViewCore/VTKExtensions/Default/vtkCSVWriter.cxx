@@ -18,22 +18,27 @@
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkAttributeDataToTableFilter.h"
 #include "vtkCellData.h"
+#include "vtkCommunicator.h"
 #include "vtkDataArray.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <algorithm>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <vector>
 
 vtkStandardNewMacro(vtkCSVWriter);
@@ -52,6 +57,7 @@ vtkCSVWriter::vtkCSVWriter()
   this->FieldAssociation = 0;
   this->AddMetaData = false;
   this->AddTime = false;
+  this->WriteInParallel = false;
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
@@ -97,7 +103,7 @@ namespace
 //-----------------------------------------------------------------------------
 template <class iterT>
 void vtkCSVWriterGetDataString(
-  iterT* iter, vtkIdType tupleIndex, ofstream& stream, vtkCSVWriter* writer, bool* first)
+  iterT* iter, vtkIdType tupleIndex, std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -118,7 +124,7 @@ void vtkCSVWriterGetDataString(
 //-----------------------------------------------------------------------------
 template <>
 void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>* iter, vtkIdType tupleIndex,
-  ofstream& stream, vtkCSVWriter* writer, bool* first)
+  std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -139,7 +145,7 @@ void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>* iter, vtk
 //-----------------------------------------------------------------------------
 template <>
 void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<char>* iter, vtkIdType tupleIndex,
-  ofstream& stream, vtkCSVWriter* writer, bool* first)
+  std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -160,7 +166,7 @@ void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<char>* iter, vtkIdType t
 //-----------------------------------------------------------------------------
 template <>
 void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<unsigned char>* iter, vtkIdType tupleIndex,
-  ofstream& stream, vtkCSVWriter* writer, bool* first)
+  std::ostream& stream, vtkCSVWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
@@ -190,7 +196,12 @@ void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<unsigned char>* iter, vt
 
 class vtkCSVWriter::CSVFile
 {
-  ofstream Stream;
+  ofstream File;
+  // Used instead of File when formatting in memory.
+  std::ostringstream Buffer;
+  std::string Text;
+  std::ostream* Stream = nullptr;
+  const char* NewLine = "\n";
   std::vector<std::pair<std::string, int> > ColumnInfo;
   double Time = vtkMath::Nan();
 
@@ -207,14 +218,55 @@ public:
       return vtkErrorCode::NoFileNameError;
     }
 
-    this->Stream.open(filename, ios::out);
-    if (this->Stream.fail())
+    this->File.open(filename, ios::out);
+    if (this->File.fail())
     {
       return vtkErrorCode::CannotOpenFileError;
     }
+    this->Stream = &this->File;
     return vtkErrorCode::NoError;
   }
 
+  /**
+   * Format the header and rows in memory instead of writing them to a file.
+   * The formatted text is obtained using GetText().
+   */
+  void OpenBuffer()
+  {
+    this->Stream = &this->Buffer;
+#if defined(_WIN32)
+    // match the line endings generated by a file opened in text mode.
+    this->NewLine = "\r\n";
+#endif
+  }
+
+  const std::string& GetText()
+  {
+    this->Text += this->Buffer.str();
+    this->Buffer.str(std::string());
+    return this->Text;
+  }
+
+  void SaveColumns(vtkMultiProcessStream& stream) const
+  {
+    stream << static_cast<int>(this->ColumnInfo.size());
+    for (const auto& cinfo : this->ColumnInfo)
+    {
+      stream << cinfo.first << cinfo.second;
+    }
+  }
+
+  void LoadColumns(vtkMultiProcessStream& stream)
+  {
+    int count = 0;
+    stream >> count;
+    this->ColumnInfo.resize(count);
+    for (auto& cinfo : this->ColumnInfo)
+    {
+      stream >> cinfo.first >> cinfo.second;
+    }
+  }
+
   void WriteHeader(vtkTable* table, vtkCSVWriter* self)
   {
     this->WriteHeader(table->GetRowData(), self);
@@ -226,7 +278,7 @@ public:
     if (!vtkMath::IsNan(this->Time))
     {
       // add a time column.
-      this->Stream << "Time";
+      (*this->Stream) << "Time";
       add_delimiter = true;
     }
     for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
@@ -242,7 +294,7 @@ public:
         if (add_delimiter)
         {
           // add separator for all but the very first column
-          this->Stream << self->GetFieldDelimiter();
+          (*this->Stream) << self->GetFieldDelimiter();
         }
         add_delimiter = true;
 
@@ -252,18 +304,12 @@ public:
         {
           array_name << ":" << comp;
         }
-        this->Stream << self->GetString(array_name.str());
+        (*this->Stream) << self->GetString(array_name.str());
       }
     }
-    this->Stream << "\n";
-
-    // push the floating point precision/notation type.
-    if (self->GetUseScientificNotation())
-    {
-      this->Stream << std::scientific;
-    }
+    (*this->Stream) << this->NewLine;
 
-    this->Stream << std::setprecision(self->GetPrecision());
+    this->ApplyFormat(*this->Stream, self);
   }
 
   void WriteData(vtkTable* table, vtkCSVWriter* self)
@@ -272,6 +318,65 @@ public:
   }
 
   void WriteData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
+  {
+    auto columnsIters = this->NewColumnIterators(dsa, self);
+    this->WriteRows(*this->Stream, columnsIters, 0, dsa->GetNumberOfTuples(), self);
+  }
+
+  /**
+   * Same as WriteData() but formats chunks of rows in parallel and appends
+   * them to the in-memory text. Requires OpenBuffer().
+   */
+  void FormatData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
+  {
+    auto columnsIters = this->NewColumnIterators(dsa, self);
+
+    const vtkIdType num_tuples = dsa->GetNumberOfTuples();
+    const vtkIdType grain = 4096;
+    const vtkIdType num_chunks = (num_tuples + grain - 1) / grain;
+    std::vector<std::string> chunks(num_chunks);
+    vtkSMPTools::For(0, num_chunks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        std::ostringstream stream;
+        this->ApplyFormat(stream, self);
+        this->WriteRows(stream, columnsIters, chunk * grain,
+          std::min(num_tuples, (chunk + 1) * grain), self);
+        chunks[chunk] = stream.str();
+      }
+    });
+
+    this->GetText();
+    size_t size = this->Text.size();
+    for (const auto& chunk : chunks)
+    {
+      size += chunk.size();
+    }
+    this->Text.reserve(size);
+    for (auto& chunk : chunks)
+    {
+      this->Text += chunk;
+      std::string().swap(chunk);
+    }
+  }
+
+private:
+  CSVFile(const CSVFile&) = delete;
+  void operator=(const CSVFile&) = delete;
+
+  // push the floating point precision/notation type.
+  static void ApplyFormat(std::ostream& stream, vtkCSVWriter* self)
+  {
+    if (self->GetUseScientificNotation())
+    {
+      stream << std::scientific;
+    }
+
+    stream << std::setprecision(self->GetPrecision());
+  }
+
+  std::vector<vtkSmartPointer<vtkArrayIterator> > NewColumnIterators(
+    vtkDataSetAttributes* dsa, vtkCSVWriter* self)
   {
     std::vector<vtkSmartPointer<vtkArrayIterator> > columnsIters;
     for (const auto& cinfo : this->ColumnInfo)
@@ -285,15 +390,21 @@ public:
       columnsIters.push_back(iter);
       iter->FastDelete();
     }
+    return columnsIters;
+  }
 
-    const auto num_tuples = dsa->GetNumberOfTuples();
-    for (vtkIdType cc = 0; cc < num_tuples; ++cc)
+  // Iterators are only read from, hence this may be called concurrently.
+  void WriteRows(std::ostream& stream,
+    const std::vector<vtkSmartPointer<vtkArrayIterator> >& columnsIters, vtkIdType begin,
+    vtkIdType end, vtkCSVWriter* self) const
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
     {
       bool first_column = true;
       if (!vtkMath::IsNan(this->Time))
       {
         // add a time column.
-        this->Stream << this->Time;
+        stream << this->Time;
         first_column = false;
       }
 
@@ -302,16 +413,12 @@ public:
         switch (iter->GetDataType())
         {
           vtkArrayIteratorTemplateMacro(vtkCSVWriterGetDataString(
-            static_cast<VTK_TT*>(iter.GetPointer()), cc, this->Stream, self, &first_column));
+            static_cast<VTK_TT*>(iter.GetPointer()), cc, stream, self, &first_column));
         }
       }
-      this->Stream << "\n";
+      stream << this->NewLine;
     }
   }
-
-private:
-  CSVFile(const CSVFile&) = delete;
-  void operator=(const CSVFile&) = delete;
 };
 
 //-----------------------------------------------------------------------------
@@ -371,6 +478,12 @@ void vtkCSVWriter::WriteData()
     return;
   }
 
+  if (this->WriteInParallel)
+  {
+    this->WriteDataInParallel(table, time);
+    return;
+  }
+
   const int myRank = controller->GetLocalProcessId();
   const int numRanks = controller->GetNumberOfProcesses();
   if (myRank > 0)
@@ -477,6 +590,140 @@ void vtkCSVWriter::WriteData()
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkCSVWriter::WriteDataInParallel(vtkTable* table, double time)
+{
+  auto controller = this->Controller;
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  // all ranks need to know which ranks have rows since only those contribute
+  // to the columns written out.
+  const vtkIdType row_count = table->GetNumberOfRows();
+  std::vector<vtkIdType> global_row_counts(numRanks, 0);
+  controller->AllGather(&row_count, &global_row_counts[0], 1);
+
+  vtkCSVWriter::CSVFile file(time);
+  file.OpenBuffer();
+
+  // determine the columns to write on the root, exactly as done when the root
+  // writes all the rows, and share them with all ranks.
+  vtkMultiProcessStream columnsStream;
+  if (myRank == 0)
+  {
+    vtkDataSetAttributes::FieldList columns;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (global_row_counts[rank] > 0)
+      {
+        if (rank == 0)
+        {
+          columns.IntersectFieldList(table->GetRowData());
+        }
+        else
+        {
+          vtkNew<vtkTable> emptytable;
+          controller->Receive(emptytable, vtkMultiProcessController::ANY_SOURCE, 88020);
+          columns.IntersectFieldList(emptytable->GetRowData());
+        }
+      }
+    }
+
+    vtkNew<vtkDataSetAttributes> tmp;
+    tmp->CopyAllOn();
+    columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
+    file.WriteHeader(tmp, this);
+    file.SaveColumns(columnsStream);
+  }
+  else if (row_count > 0)
+  {
+    vtkNew<vtkTable> clone;
+    auto cloneRD = clone->GetRowData();
+    cloneRD->CopyAllOn();
+    cloneRD->CopyAllocate(table->GetRowData(), /*sze=*/1);
+    cloneRD->CopyData(table->GetRowData(), 0, 1, 0);
+    controller->Send(clone, 0, 88020);
+  }
+  controller->Broadcast(columnsStream, 0);
+  if (myRank > 0)
+  {
+    file.LoadColumns(columnsStream);
+  }
+
+  // format local rows.
+  if (row_count > 0)
+  {
+    file.FormatData(table->GetRowData(), this);
+  }
+  const std::string& text = file.GetText();
+
+  // exclusive scan of the formatted sizes gives the offset for this rank.
+  const vtkTypeInt64 local_size = static_cast<vtkTypeInt64>(text.size());
+  std::vector<vtkTypeInt64> sizes(numRanks, 0);
+  controller->AllGather(&local_size, &sizes[0], 1);
+  const vtkTypeInt64 offset =
+    std::accumulate(sizes.begin(), sizes.begin() + myRank, static_cast<vtkTypeInt64>(0));
+
+  // the root creates (or truncates) the file before any rank writes to it.
+  int error_code = vtkErrorCode::NoError;
+  std::ofstream rootStream;
+  if (myRank == 0)
+  {
+    if (!this->FileName)
+    {
+      error_code = vtkErrorCode::NoFileNameError;
+    }
+    else
+    {
+      rootStream.open(this->FileName, ios::out | ios::binary | ios::trunc);
+      if (rootStream.fail())
+      {
+        error_code = vtkErrorCode::CannotOpenFileError;
+      }
+    }
+  }
+  controller->Broadcast(&error_code, 1, 0);
+  if (error_code != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(error_code);
+    return;
+  }
+
+  if (local_size > 0)
+  {
+    std::fstream rankStream;
+    std::ostream* stream = &rootStream;
+    if (myRank > 0)
+    {
+      // open without truncating and write at the offset for this rank.
+      rankStream.open(this->FileName, ios::in | ios::out | ios::binary);
+      stream = &rankStream;
+      if (rankStream.fail())
+      {
+        error_code = vtkErrorCode::CannotOpenFileError;
+      }
+      else
+      {
+        rankStream.seekp(static_cast<std::streamoff>(offset));
+      }
+    }
+    if (error_code == vtkErrorCode::NoError)
+    {
+      stream->write(text.data(), static_cast<std::streamsize>(local_size));
+      stream->flush();
+      if (stream->fail())
+      {
+        error_code = vtkErrorCode::OutOfDiskSpaceError;
+      }
+    }
+  }
+  rootStream.close();
+
+  int global_error_code = vtkErrorCode::NoError;
+  controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+  this->SetErrorCode(global_error_code);
+}
+
 //-----------------------------------------------------------------------------
 void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -491,6 +738,7 @@ void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Precision: " << this->Precision << endl;
   os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
   os << indent << "AddMetaData: " << this->AddMetaData << endl;
+  os << indent << "WriteInParallel: " << this->WriteInParallel << endl;
   if (this->Controller)
   {
     os << indent << "Controller: " << this->Controller << endl;
@@ -130,6 +130,21 @@ public:
   vtkBooleanMacro(AddTime, bool);
   //@}
 
+  //@{
+  /**
+   * When running in parallel, the default is to ship all rows to the root
+   * node which then formats and writes them. When WriteInParallel is true, each
+   * process formats its own rows instead and writes them to its slice of the
+   * output file using positioned writes, with offsets determined by the sizes
+   * of the formatted rows on preceding processes. The generated file is
+   * identical in either case. This requires that FileName refers to the same
+   * file on a shared filesystem for all processes. Default is false.
+   */
+  vtkSetMacro(WriteInParallel, bool);
+  vtkGetMacro(WriteInParallel, bool);
+  vtkBooleanMacro(WriteInParallel, bool);
+  //@}
+
   //@{
   /**
    * Internal method: decorates the "string" with the "StringDelimiter" if
@@ -144,6 +159,12 @@ protected:
 
   void WriteData() override;
 
+  /**
+   * Called by WriteData() on all processes when WriteInParallel is true and
+   * there is more than one process.
+   */
+  void WriteDataInParallel(vtkTable* table, double time);
+
   // see algorithm for more info.
   // This writer takes in vtkTable, vtkDataSet or vtkCompositeDataSet.
   int FillInputPortInformation(int port, vtkInformation* info) override;
@@ -161,6 +182,7 @@ protected:
   int FieldAssociation;
   bool AddMetaData;
   bool AddTime;
+  bool WriteInParallel;
 
   vtkMultiProcessController* Controller;
 
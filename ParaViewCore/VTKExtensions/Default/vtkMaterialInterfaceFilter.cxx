@@ -60,6 +60,10 @@
 #include "vtkDataSetWriter.h"
 #include "vtkMaterialInterfaceCommBuffer.h"
 #include "vtkXMLPolyDataWriter.h"
+#include "vtkPVConfig.h"
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPIController.h"
+#endif
 // Filters
 #include "vtkAppendPolyData.h"
 #include "vtkAppendPolyData.h"
@@ -79,6 +83,8 @@ using std::ostringstream;
 using std::vector;
 #include <string>
 using std::string;
+#include <map>
+#include <unordered_map>
 #include "algorithm"
 // ansi c
 #include <ctime>
@@ -273,6 +279,15 @@ public:
   // Be very careful with the pointer.
   int* GetPointer() { return this->EquivalenceArray->GetPointer(0); }
 
+  // Makes this a resolved set of the numMembers members starting at
+  // firstMember. Set ids must be filled in through GetPointer().
+  void InitializeResolved(int numMembers, int firstMember = 0)
+  {
+    this->EquivalenceArray->SetNumberOfTuples(numMembers);
+    this->FirstMember = firstMember;
+    this->Resolved = 1;
+  }
+
   // Free unused memory
   void Squeeze() { this->EquivalenceArray->Squeeze(); }
 
@@ -283,6 +298,9 @@ public:
   int Resolved;
 
 private:
+  // Id of the first member of a resolved set holding only a range of members.
+  int FirstMember;
+
   // To merge connected framgments that have different ids because they were
   // traversed by different processes or passes.
   vtkIntArray* EquivalenceArray;
@@ -296,6 +314,7 @@ private:
 vtkMaterialInterfaceEquivalenceSet::vtkMaterialInterfaceEquivalenceSet()
 {
   this->Resolved = 0;
+  this->FirstMember = 0;
   this->EquivalenceArray = vtkIntArray::New();
 }
 
@@ -314,6 +333,7 @@ vtkMaterialInterfaceEquivalenceSet::~vtkMaterialInterfaceEquivalenceSet()
 void vtkMaterialInterfaceEquivalenceSet::Initialize()
 {
   this->Resolved = 0;
+  this->FirstMember = 0;
   this->EquivalenceArray->Initialize();
 }
 
@@ -321,6 +341,7 @@ void vtkMaterialInterfaceEquivalenceSet::Initialize()
 void vtkMaterialInterfaceEquivalenceSet::DeepCopy(vtkMaterialInterfaceEquivalenceSet* in)
 {
   this->Resolved = in->Resolved;
+  this->FirstMember = in->FirstMember;
   this->EquivalenceArray->DeepCopy(in->EquivalenceArray);
 }
 
@@ -356,11 +377,12 @@ int vtkMaterialInterfaceEquivalenceSet::GetEquivalentSetId(int memberId)
 // Return the id of the equivalent set.
 int vtkMaterialInterfaceEquivalenceSet::GetReference(int memberId)
 {
-  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
+  const int index = memberId - this->FirstMember;
+  if (index < 0 || index >= this->EquivalenceArray->GetNumberOfTuples())
   { // We might consider this an error ...
     return memberId;
   }
-  return this->EquivalenceArray->GetValue(memberId);
+  return this->EquivalenceArray->GetValue(index);
 }
 
 //----------------------------------------------------------------------------
@@ -464,6 +486,73 @@ int vtkMaterialInterfaceEquivalenceSet::ResolveEquivalences()
   return count;
 }
 
+//============================================================================
+// Union-find over sparse (global) fragment ids, used by the distributed
+// resolution of equivalences. Each set is represented by its smallest
+// member, like in vtkMaterialInterfaceEquivalenceSet, and only members that
+// do not represent their set are stored.
+class vtkMaterialInterfaceUnionFind
+{
+public:
+  // Return the id of the set the member belongs to.
+  int Find(int memberId)
+  {
+    int setId = memberId;
+    std::unordered_map<int, int>::iterator it = this->Parents.find(setId);
+    while (it != this->Parents.end())
+    {
+      setId = it->second;
+      it = this->Parents.find(setId);
+    }
+    // Compress the path.
+    while (memberId != setId)
+    {
+      it = this->Parents.find(memberId);
+      memberId = it->second;
+      it->second = setId;
+    }
+    return setId;
+  }
+
+  void AddEquivalence(int id1, int id2)
+  {
+    id1 = this->Find(id1);
+    id2 = this->Find(id2);
+    if (id1 < id2)
+    {
+      this->Parents[id2] = id1;
+    }
+    else if (id2 < id1)
+    {
+      this->Parents[id1] = id2;
+    }
+  }
+
+  // Append (member id, set id) pairs for all members that do not represent
+  // their set.
+  void GetEquivalences(vector<int>& pairs)
+  {
+    pairs.reserve(pairs.size() + 2 * this->Parents.size());
+    std::unordered_map<int, int>::iterator it;
+    for (it = this->Parents.begin(); it != this->Parents.end(); ++it)
+    {
+      pairs.push_back(it->first);
+      pairs.push_back(this->Find(it->first));
+    }
+  }
+
+  void AddEquivalences(const vector<int>& pairs)
+  {
+    for (size_t ii = 0; ii + 1 < pairs.size(); ii += 2)
+    {
+      this->AddEquivalence(pairs[ii], pairs[ii + 1]);
+    }
+  }
+
+private:
+  std::unordered_map<int, int> Parents;
+};
+
 //============================================================================
 // Helper object to clip hexahedra with implicit half sphere.
 class vtkMaterialInterfaceFilterHalfSphere
@@ -1642,6 +1731,7 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->NToSum = 0;
   this->ComputeMoments = false;
   this->ComputeOBB = false;
+  this->DistributedEquivalenceResolution = false;
 
   this->MaterialFractionThreshold = 0.5;
   this->scaledMaterialFractionThreshold = 127.5;
@@ -5746,6 +5836,8 @@ void vtkMaterialInterfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   // TODO print state
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DistributedEquivalenceResolution: " << this->DistributedEquivalenceResolution
+     << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -8275,6 +8367,11 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   this->Progress += this->ProgressResolutionInc;
   this->UpdateProgress(this->Progress);
 
+  if (this->DistributedEquivalenceResolution && this->GatherEquivalenceSetsDistributed(set))
+  {
+    return;
+  }
+
   const int numProcs = this->Controller->GetNumberOfProcesses();
   const int myProcId = this->Controller->GetLocalProcessId();
   const int numLocalMembers = set->GetNumberOfMembers();
@@ -8357,6 +8454,429 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   delete globalSet;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Binary tree rooted at process 0 along which equivalences are reduced and
+// set ids are sent back. The children of a process are procId + step for
+// each power of two step smaller than the lowest set bit of procId.
+void GetEquivalenceTree(int procId, int numProcs, int& parent, vector<int>& children)
+{
+  parent = -1;
+  children.clear();
+  for (int step = 1; step < numProcs; step *= 2)
+  {
+    if (procId % (2 * step) == step)
+    {
+      parent = procId - step;
+      break;
+    }
+    if (procId + step < numProcs)
+    {
+      children.push_back(procId + step);
+    }
+  }
+}
+
+void SendIds(vtkMultiProcessController* controller, vector<int>& ids, int procId, int tag)
+{
+  int numValues = static_cast<int>(ids.size());
+  controller->Send(&numValues, 1, procId, tag);
+  if (numValues > 0)
+  {
+    controller->Send(&ids[0], numValues, procId, tag + 1);
+  }
+}
+
+void ReceiveIds(vtkMultiProcessController* controller, vector<int>& ids, int procId, int tag)
+{
+  int numValues = 0;
+  controller->Receive(&numValues, 1, procId, tag);
+  ids.resize(numValues);
+  if (numValues > 0)
+  {
+    controller->Receive(&ids[0], numValues, procId, tag + 1);
+  }
+}
+
+void SortUnique(vector<int>& ids)
+{
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+}
+
+//----------------------------------------------------------------------------
+// Distributed version of the resolution done by GatherEquivalenceSets.
+// Fragment ids are first replaced by the global id of the smallest member of
+// their local set. Ghost fragment ids are then only sent to the processes
+// owning the ghost blocks, and the inter-process equivalences found are
+// merged along a binary tree rooted at process 0 using a union-find. Going
+// back down the tree, each process only receives the sets of the ids its
+// subtree references, and later the resolved ids of these sets, so no
+// process but 0 holds data proportional to the total number of fragments.
+// Process 0 still receives the resolved id of every fragment since it
+// resolves the integrated attributes. Resolved fragment ids are numbered
+// exactly as GatherEquivalenceSets does. Returns false, without
+// communicating, when the controller does not support it.
+bool vtkMaterialInterfaceFilter::GatherEquivalenceSetsDistributed(
+  vtkMaterialInterfaceEquivalenceSet* set)
+{
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  const int myProcId = this->Controller->GetLocalProcessId();
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (numProcs > 1 && !vtkMPIController::SafeDownCast(this->Controller))
+#else
+  if (numProcs > 1)
+#endif
+  {
+    return false;
+  }
+
+  const int numLocalMembers = set->GetNumberOfMembers();
+  this->Controller->AllGather(&numLocalMembers, this->NumberOfRawFragmentsInProcess, 1);
+  int totalNumberOfIds = 0;
+  for (int ii = 0; ii < numProcs; ++ii)
+  {
+    this->LocalToGlobalOffsets[ii] = totalNumberOfIds;
+    totalNumberOfIds += this->NumberOfRawFragmentsInProcess[ii];
+  }
+  this->TotalNumberOfRawFragments = totalNumberOfIds;
+  const int myOffset = this->LocalToGlobalOffsets[myProcId];
+
+  // Global id of the smallest member of the local set of each fragment.
+  vector<int> localSetIds(numLocalMembers);
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    localSetIds[ii] = set->GetEquivalentSetId(ii) + myOffset;
+  }
+
+  // Inter-process equivalences between local sets. The sets sent in ghost
+  // blocks may be merged by other processes, so their set is needed too.
+  vtkMaterialInterfaceUnionFind equivalences;
+  vector<int> myIds;
+  if (numProcs > 1)
+  {
+    this->ExchangeGhostEquivalences(localSetIds, equivalences, myIds);
+  }
+  equivalences.GetEquivalences(myIds);
+  SortUnique(myIds);
+
+  int parent;
+  vector<int> children;
+  GetEquivalenceTree(myProcId, numProcs, parent, children);
+
+  // Reduce the equivalences up the tree. Each subtree also sends the ids it
+  // references, as (id, id) pairs, and they are kept to only send back the
+  // sets of these ids.
+  vector<vector<int> > childIds(children.size());
+  vector<int> subtreeIds(myIds);
+  vector<int> pairs;
+  for (size_t cc = 0; cc < children.size(); ++cc)
+  {
+    ReceiveIds(this->Controller, pairs, children[cc], 342323);
+    equivalences.AddEquivalences(pairs);
+    childIds[cc] = pairs;
+    SortUnique(childIds[cc]);
+    subtreeIds.insert(subtreeIds.end(), childIds[cc].begin(), childIds[cc].end());
+  }
+  if (parent >= 0)
+  {
+    SortUnique(subtreeIds);
+    pairs.clear();
+    equivalences.GetEquivalences(pairs);
+    for (size_t ii = 0; ii < subtreeIds.size(); ++ii)
+    {
+      pairs.push_back(subtreeIds[ii]);
+      pairs.push_back(subtreeIds[ii]);
+    }
+    SendIds(this->Controller, pairs, parent, 342323);
+    vector<int>().swap(subtreeIds);
+
+    // Then get the final sets of the ids referenced by our subtree.
+    ReceiveIds(this->Controller, pairs, parent, 342325);
+    equivalences.AddEquivalences(pairs);
+  }
+  for (size_t cc = 0; cc < children.size(); ++cc)
+  {
+    pairs.clear();
+    for (size_t ii = 0; ii < childIds[cc].size(); ++ii)
+    {
+      const int setId = equivalences.Find(childIds[cc][ii]);
+      if (setId != childIds[cc][ii])
+      {
+        pairs.push_back(childIds[cc][ii]);
+        pairs.push_back(setId);
+      }
+    }
+    SendIds(this->Controller, pairs, children[cc], 342325);
+  }
+
+  // Resolved fragments are numbered in the order of the global id of their
+  // smallest member, first locally and then offset by the number of resolved
+  // fragments in the previous processes.
+  vector<int> globalIds(numLocalMembers);
+  int numLocalResolved = 0;
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    globalIds[ii] = equivalences.Find(localSetIds[ii]);
+    if (globalIds[ii] == ii + myOffset)
+    {
+      ++numLocalResolved;
+    }
+  }
+  vector<int> numResolvedInProcess(numProcs);
+  this->Controller->AllGather(&numLocalResolved, &numResolvedInProcess[0], 1);
+  int resolvedOffset = 0;
+  this->NumberOfResolvedFragments = 0;
+  for (int ii = 0; ii < numProcs; ++ii)
+  {
+    resolvedOffset += (ii < myProcId) ? numResolvedInProcess[ii] : 0;
+    this->NumberOfResolvedFragments += numResolvedInProcess[ii];
+  }
+
+  vector<int> resolvedIds(numLocalMembers, -1);
+  int nextResolvedId = resolvedOffset;
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    const int setId = globalIds[ii];
+    if (setId == ii + myOffset)
+    {
+      resolvedIds[ii] = nextResolvedId++;
+    }
+    else if (setId >= myOffset)
+    {
+      // smaller members are resolved already.
+      resolvedIds[ii] = resolvedIds[setId - myOffset];
+    }
+  }
+
+  // Share the resolved ids of the sets spanning several processes the same
+  // way: the ids of the sets owned by each subtree go up the tree, and each
+  // subtree gets back the ones of the sets it references.
+  std::unordered_map<int, int> resolvedSetIds;
+  for (size_t ii = 0; ii < myIds.size(); ++ii)
+  {
+    const int setId = equivalences.Find(myIds[ii]);
+    if (setId >= myOffset && setId < myOffset + numLocalMembers)
+    {
+      resolvedSetIds[setId] = resolvedIds[setId - myOffset];
+    }
+  }
+  for (size_t cc = 0; cc < children.size(); ++cc)
+  {
+    ReceiveIds(this->Controller, pairs, children[cc], 342327);
+    for (size_t ii = 0; ii + 1 < pairs.size(); ii += 2)
+    {
+      resolvedSetIds[pairs[ii]] = pairs[ii + 1];
+    }
+  }
+  if (parent >= 0)
+  {
+    pairs.clear();
+    std::unordered_map<int, int>::const_iterator it;
+    for (it = resolvedSetIds.begin(); it != resolvedSetIds.end(); ++it)
+    {
+      pairs.push_back(it->first);
+      pairs.push_back(it->second);
+    }
+    SendIds(this->Controller, pairs, parent, 342327);
+    ReceiveIds(this->Controller, pairs, parent, 342329);
+    for (size_t ii = 0; ii + 1 < pairs.size(); ii += 2)
+    {
+      resolvedSetIds[pairs[ii]] = pairs[ii + 1];
+    }
+  }
+  vector<int> setIds;
+  for (size_t cc = 0; cc < children.size(); ++cc)
+  {
+    setIds.clear();
+    for (size_t ii = 0; ii < childIds[cc].size(); ++ii)
+    {
+      setIds.push_back(equivalences.Find(childIds[cc][ii]));
+    }
+    SortUnique(setIds);
+    pairs.clear();
+    for (size_t ii = 0; ii < setIds.size(); ++ii)
+    {
+      std::unordered_map<int, int>::const_iterator it = resolvedSetIds.find(setIds[ii]);
+      if (it != resolvedSetIds.end())
+      {
+        pairs.push_back(it->first);
+        pairs.push_back(it->second);
+      }
+    }
+    SendIds(this->Controller, pairs, children[cc], 342329);
+  }
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    if (resolvedIds[ii] < 0)
+    {
+      std::unordered_map<int, int>::const_iterator it = resolvedSetIds.find(globalIds[ii]);
+      if (it == resolvedSetIds.end())
+      {
+        vtkErrorMacro("Missing resolved id of fragment set " << globalIds[ii] << ".");
+        resolvedIds[ii] = 0;
+        continue;
+      }
+      resolvedIds[ii] = it->second;
+    }
+  }
+
+  // Every process needs the resolved ids of its own fragments only, process 0
+  // resolves the integrated attributes of all of them.
+  set->Initialize();
+  if (myProcId == 0)
+  {
+    set->InitializeResolved(totalNumberOfIds);
+  }
+  else
+  {
+    set->InitializeResolved(numLocalMembers, myOffset);
+  }
+  int* resolvedSet = set->GetPointer();
+  std::copy(resolvedIds.begin(), resolvedIds.end(), resolvedSet);
+  if (numProcs > 1)
+  {
+    vector<vtkIdType> lengths(numProcs);
+    vector<vtkIdType> offsets(numProcs);
+    for (int ii = 0; ii < numProcs; ++ii)
+    {
+      lengths[ii] = this->NumberOfRawFragmentsInProcess[ii];
+      offsets[ii] = this->LocalToGlobalOffsets[ii];
+    }
+    resolvedIds.push_back(0);
+    int dummy = 0;
+    this->Controller->GatherV(&resolvedIds[0],
+      (myProcId == 0 && totalNumberOfIds > 0) ? resolvedSet : &dummy, numLocalMembers,
+      &lengths[0], &offsets[0], 0);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Sends the fragment ids of ghost blocks, as global local set ids, to the
+// processes owning the blocks, and adds the equivalences found between the
+// ghost blocks received and the local blocks. Only the processes involved
+// exchange messages. The set ids sent are appended to sentSetIds, with
+// possible duplicates.
+void vtkMaterialInterfaceFilter::ExchangeGhostEquivalences(const vector<int>& localSetIds,
+  vtkMaterialInterfaceUnionFind& equivalences, vector<int>& sentSetIds)
+{
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myProcId = controller->GetLocalProcessId();
+
+  // Pack the ghost blocks of each owner: block id, cell extent, set ids.
+  std::map<int, vector<int> > sendBuffers;
+  int num = static_cast<int>(this->GhostBlocks.size());
+  for (int blockId = 0; blockId < num; ++blockId)
+  {
+    vtkMaterialInterfaceFilterBlock* block = this->GhostBlocks[blockId];
+    if (!block || !block->GetGhostFlag() || block->GetOwnerProcessId() == myProcId)
+    {
+      continue;
+    }
+    vector<int>& buffer = sendBuffers[block->GetOwnerProcessId()];
+    int ext[6];
+    block->GetCellExtent(ext);
+    buffer.push_back(block->GetBlockId());
+    buffer.insert(buffer.end(), ext, ext + 6);
+    const int* fragmentIds = block->GetFragmentIdPointer();
+    const int numCells = (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+    for (int ii = 0; ii < numCells; ++ii)
+    {
+      buffer.push_back(fragmentIds[ii] >= 0 ? localSetIds[fragmentIds[ii]] : -1);
+      if (fragmentIds[ii] >= 0 &&
+        (sentSetIds.empty() || sentSetIds.back() != localSetIds[fragmentIds[ii]]))
+      {
+        sentSetIds.push_back(localSetIds[fragmentIds[ii]]);
+      }
+    }
+  }
+
+  // Find out how many processes will send us their ghost blocks.
+  vector<int> sendFlags(numProcs, 0);
+  vector<int> receiveCounts(numProcs, 0);
+  std::map<int, vector<int> >::iterator it;
+  for (it = sendBuffers.begin(); it != sendBuffers.end(); ++it)
+  {
+    sendFlags[it->first] = 1;
+  }
+  controller->AllReduce(&sendFlags[0], &receiveCounts[0], numProcs, vtkCommunicator::SUM_OP);
+
+  vector<int> headers;
+  headers.reserve(2 * sendBuffers.size());
+  vector<vtkMPICommunicator::Request> requests(2 * sendBuffers.size());
+  size_t requestId = 0;
+  for (it = sendBuffers.begin(); it != sendBuffers.end(); ++it, requestId += 2)
+  {
+    headers.push_back(myProcId);
+    headers.push_back(static_cast<int>(it->second.size()));
+    controller->NoBlockSend(&headers[requestId], 2, it->first, 722267, requests[requestId]);
+    controller->NoBlockSend(&it->second[0], static_cast<int>(it->second.size()), it->first,
+      722268, requests[requestId + 1]);
+  }
+
+  vector<int> buffer;
+  for (int message = 0; message < receiveCounts[myProcId]; ++message)
+  {
+    int header[2];
+    controller->Receive(header, 2, vtkMultiProcessController::ANY_SOURCE, 722267);
+    buffer.resize(header[1]);
+    controller->Receive(&buffer[0], header[1], header[0], 722268);
+
+    size_t pos = 0;
+    while (pos + 7 <= buffer.size())
+    {
+      vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[buffer[pos]];
+      const int* remoteExt = &buffer[pos + 1];
+      const int* remoteSetIds = &buffer[pos + 7];
+      pos += 7 + (remoteExt[1] - remoteExt[0] + 1) * (remoteExt[3] - remoteExt[2] + 1) *
+        (remoteExt[5] - remoteExt[4] + 1);
+      if (block == 0)
+      {
+        vtkErrorMacro("Missing block request.");
+        continue;
+      }
+      // Loop through the voxels of the local block covered by the ghost block.
+      int* localFragmentIds = block->GetFragmentIdPointer();
+      int localExt[6];
+      int localIncs[3];
+      block->GetCellExtent(localExt);
+      block->GetCellIncrements(localIncs);
+      int* pz = localFragmentIds + (remoteExt[0] - localExt[0]) * localIncs[0] +
+        (remoteExt[2] - localExt[2]) * localIncs[1] + (remoteExt[4] - localExt[4]) * localIncs[2];
+      for (int iz = remoteExt[4]; iz <= remoteExt[5]; ++iz, pz += localIncs[2])
+      {
+        int* py = pz;
+        for (int iy = remoteExt[2]; iy <= remoteExt[3]; ++iy, py += localIncs[1])
+        {
+          int* px = py;
+          for (int ix = remoteExt[0]; ix <= remoteExt[1]; ++ix, ++px, ++remoteSetIds)
+          {
+            if (*px >= 0 && *remoteSetIds >= 0)
+            {
+              equivalences.AddEquivalence(localSetIds[*px], *remoteSetIds);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t ii = 0; ii < requests.size(); ++ii)
+  {
+    requests[ii].Wait();
+  }
+#else
+  (void)localSetIds;
+  (void)equivalences;
+  (void)sentSetIds;
+#endif
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
   vtkMaterialInterfaceEquivalenceSet* globalSet)
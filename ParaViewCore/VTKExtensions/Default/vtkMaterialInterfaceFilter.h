@@ -62,6 +62,7 @@ class vtkMaterialInterfaceLevel;
 class vtkMaterialInterfaceFilterBlock;
 class vtkMaterialInterfaceFilterIterator;
 class vtkMaterialInterfaceEquivalenceSet;
+class vtkMaterialInterfaceUnionFind;
 class vtkMaterialInterfaceFilterRingBuffer;
 class vtkMaterialInterfacePieceLoading;
 class vtkMaterialInterfaceCommBuffer;
@@ -327,6 +328,20 @@ public:
   vtkGetMacro(InvertVolumeFraction, int);
   //@}
 
+  //@{
+  /**
+   * When on, fragment equivalences between processes are resolved with a
+   * distributed union-find: ghost fragment ids are only exchanged between
+   * neighboring processes and equivalences are merged along a tree, instead
+   * of gathering the equivalences of every process on process 0. Requires
+   * MPI when running in parallel, otherwise the default resolution is used.
+   * Resulting fragment ids are the same. Off by default.
+   */
+  vtkSetMacro(DistributedEquivalenceResolution, bool);
+  vtkGetMacro(DistributedEquivalenceResolution, bool);
+  vtkBooleanMacro(DistributedEquivalenceResolution, bool);
+  //@}
+
   /**
    * Return the mtime also considering the locator and clip function.
    */
@@ -396,6 +411,9 @@ protected:
   void ShareGhostEquivalences(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets);
   void ReceiveGhostFragmentIds(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffset);
   void MergeGhostEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* globalSet);
+  bool GatherEquivalenceSetsDistributed(vtkMaterialInterfaceEquivalenceSet* set);
+  void ExchangeGhostEquivalences(const std::vector<int>& localSetIds,
+    vtkMaterialInterfaceUnionFind& equivalences, std::vector<int>& sentSetIds);
 
   // Sum/finalize attribute's contribution for those
   // which are split over multiple processes.
@@ -603,6 +621,7 @@ protected:
   vtkDoubleArray* FragmentOBBs;
   // turn on/off OBB calculation
   bool ComputeOBB;
+  bool DistributedEquivalenceResolution;
 
   // Upper bound used to exclude heavily loaded procs
   // from work sharing. Reducing may aliviate oom issues.
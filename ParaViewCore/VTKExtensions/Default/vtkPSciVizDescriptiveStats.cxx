@@ -2,6 +2,7 @@
 #include "vtkSciVizStatisticsPrivate.h"
 
 #include "vtkDataSetAttributes.h"
+#include "vtkDescriptiveStatistics.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
@@ -58,6 +59,17 @@ int vtkPSciVizDescriptiveStats::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vt
   return 1;
 }
 
+vtkStatisticsAlgorithm* vtkPSciVizDescriptiveStats::NewSerialEngine(vtkTable* inData)
+{
+  vtkDescriptiveStatistics* stats = vtkDescriptiveStatistics::New();
+  vtkIdType ncols = inData->GetNumberOfColumns();
+  for (vtkIdType i = 0; i < ncols; ++i)
+  {
+    stats->AddColumn(inData->GetColumnName(i));
+  }
+  return stats;
+}
+
 int vtkPSciVizDescriptiveStats::AssessData(
   vtkTable* observations, vtkDataObject* assessedOut, vtkMultiBlockDataSet* modelOut)
 {
@@ -1,15 +1,27 @@
 #include "vtkPSciVizKMeans.h"
 #include "vtkSciVizStatisticsPrivate.h"
 
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKMeansStatistics.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkPSciVizKMeans);
 
 vtkPSciVizKMeans::vtkPSciVizKMeans()
@@ -17,6 +29,7 @@ vtkPSciVizKMeans::vtkPSciVizKMeans()
   this->K = 5;
   this->MaxNumIterations = 50;
   this->Tolerance = 0.01;
+  this->MiniBatchSize = 0;
 }
 
 vtkPSciVizKMeans::~vtkPSciVizKMeans()
@@ -29,9 +42,220 @@ void vtkPSciVizKMeans::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "K: " << K << "\n";
   os << indent << "MaxNumIterations: " << this->MaxNumIterations << "\n";
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "MiniBatchSize: " << this->MiniBatchSize << "\n";
 }
 
 int vtkPSciVizKMeans::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable* inData)
+{
+  if (this->MiniBatchSize > 0)
+  {
+    return this->LearnClusterCenters(modelDO, inData);
+  }
+  return this->LearnAndDeriveWithEngine(modelDO, inData, nullptr);
+}
+
+int vtkPSciVizKMeans::ThreadedLearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable* inData)
+{
+  return this->LearnClusterCenters(modelDO, inData);
+}
+
+int vtkPSciVizKMeans::LearnClusterCenters(vtkMultiBlockDataSet* modelDO, vtkTable* inData)
+{
+  int dim = static_cast<int>(inData->GetNumberOfColumns());
+  std::vector<vtkDataArray*> cols(dim);
+  for (int j = 0; j < dim; ++j)
+  {
+    cols[j] = vtkArrayDownCast<vtkDataArray>(inData->GetColumn(j));
+    if (!cols[j])
+    {
+      // Only numeric observations have coordinates to average.
+      return this->LearnAndDeriveWithEngine(modelDO, inData, nullptr);
+    }
+  }
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  vtkIdType numRows = inData->GetNumberOfRows();
+  int maxClusters = std::max(this->K, 1);
+
+  // I. The initial centers are the first K observations, in process order.
+  vtkIdType localCount = std::min(static_cast<vtkIdType>(maxClusters), numRows);
+  std::vector<double> localCandidates(maxClusters * dim, 0.);
+  for (vtkIdType i = 0; i < localCount; ++i)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      localCandidates[i * dim + j] = cols[j]->GetComponent(i, 0);
+    }
+  }
+  std::vector<vtkIdType> counts(numProcs, localCount);
+  std::vector<double> candidates(localCandidates);
+  vtkIdType totalRows = numRows;
+  if (numProcs > 1)
+  {
+    candidates.resize(numProcs * maxClusters * dim);
+    controller->AllGather(&localCount, &counts[0], 1);
+    controller->AllGather(&localCandidates[0], &candidates[0], maxClusters * dim);
+    controller->AllReduce(&numRows, &totalRows, 1, vtkCommunicator::SUM_OP);
+  }
+  std::vector<double> centers;
+  int numClusters = 0;
+  for (int p = 0; p < numProcs && numClusters < maxClusters; ++p)
+  {
+    for (vtkIdType i = 0; i < counts[p] && numClusters < maxClusters; ++i, ++numClusters)
+    {
+      double* candidate = &candidates[(p * maxClusters + i) * dim];
+      centers.insert(centers.end(), candidate, candidate + dim);
+    }
+  }
+  if (numClusters == 0)
+  {
+    return this->LearnAndDeriveWithEngine(modelDO, inData, nullptr);
+  }
+
+  // II. Iterate, accumulating the coordinate sums and member counts of each cluster
+  // (plus the number of membership changes) per thread, then across processes.
+  bool miniBatch = this->MiniBatchSize > 0;
+  vtkIdType batchSize = miniBatch ? std::min(this->MiniBatchSize, numRows) : numRows;
+  std::vector<vtkIdType> batch(miniBatch ? batchSize : 0);
+  std::vector<int> membership(miniBatch ? 0 : numRows, -1);
+  std::vector<double> seen(numClusters, 0.);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1 + (controller ? controller->GetLocalProcessId() : 0));
+
+  const vtkIdType countOffset = numClusters * dim;
+  const vtkIdType accSize = countOffset + numClusters + 1;
+  vtkSMPThreadLocal<std::vector<double> > localAccumulators(std::vector<double>(accSize, 0.));
+  auto accumulate = [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double>& acc = localAccumulators.Local();
+    std::vector<double> coords(dim);
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType row = miniBatch ? batch[i] : i;
+      for (int j = 0; j < dim; ++j)
+      {
+        coords[j] = cols[j]->GetComponent(row, 0);
+      }
+      int nearest = 0;
+      double nearestDist2 = VTK_DOUBLE_MAX;
+      for (int c = 0; c < numClusters; ++c)
+      {
+        double dist2 = 0.;
+        for (int j = 0; j < dim; ++j)
+        {
+          double delta = coords[j] - centers[c * dim + j];
+          dist2 += delta * delta;
+        }
+        if (dist2 < nearestDist2)
+        {
+          nearest = c;
+          nearestDist2 = dist2;
+        }
+      }
+      for (int j = 0; j < dim; ++j)
+      {
+        acc[nearest * dim + j] += coords[j];
+      }
+      acc[countOffset + nearest] += 1.;
+      if (!miniBatch && membership[row] != nearest)
+      {
+        membership[row] = nearest;
+        acc[accSize - 1] += 1.;
+      }
+    }
+  };
+
+  for (int iter = 0; iter < this->MaxNumIterations; ++iter)
+  {
+    for (vtkIdType i = 0; i < static_cast<vtkIdType>(batch.size()); ++i)
+    {
+      random->Next();
+      batch[i] = std::min(static_cast<vtkIdType>(random->GetValue() * numRows), numRows - 1);
+    }
+    if (this->ThreadedLearning)
+    {
+      vtkSMPTools::For(0, batchSize, accumulate);
+    }
+    else
+    {
+      accumulate(0, batchSize);
+    }
+
+    std::vector<double> sums(accSize, 0.);
+    for (auto it = localAccumulators.begin(); it != localAccumulators.end(); ++it)
+    {
+      for (vtkIdType k = 0; k < accSize; ++k)
+      {
+        sums[k] += (*it)[k];
+      }
+      std::fill((*it).begin(), (*it).end(), 0.);
+    }
+    if (numProcs > 1)
+    {
+      std::vector<double> globalSums(accSize);
+      controller->AllReduce(&sums[0], &globalSums[0], accSize, vtkCommunicator::SUM_OP);
+      sums.swap(globalSums);
+    }
+
+    bool converged = true;
+    for (int c = 0; c < numClusters; ++c)
+    {
+      double count = sums[countOffset + c];
+      if (count <= 0.)
+      {
+        continue;
+      }
+      // Full passes replace each center by the mean of its members; mini-batches move it
+      // toward the batch mean with a step that shrinks as the center sees more members.
+      seen[c] += count;
+      double step = miniBatch ? count / seen[c] : 1.;
+      double shift2 = 0.;
+      double length2 = 0.;
+      for (int j = 0; j < dim; ++j)
+      {
+        double& coord = centers[c * dim + j];
+        double delta = step * (sums[c * dim + j] / count - coord);
+        length2 += coord * coord;
+        shift2 += delta * delta;
+        coord += delta;
+      }
+      converged = converged && shift2 <= this->Tolerance * this->Tolerance * length2;
+    }
+    if (!miniBatch)
+    {
+      // Same criterion as the engine: few enough observations changed clusters.
+      converged = sums[accSize - 1] <= this->Tolerance * totalRows;
+    }
+    if (converged)
+    {
+      break;
+    }
+  }
+
+  // III. Hand the centers to the engine, which assigns every observation in one pass
+  // and fills in the model.
+  vtkNew<vtkTable> initialCenters;
+  vtkNew<vtkIdTypeArray> clusterCounts;
+  clusterCounts->SetName("K");
+  clusterCounts->SetNumberOfTuples(numClusters);
+  clusterCounts->FillComponent(0, numClusters);
+  initialCenters->AddColumn(clusterCounts);
+  for (int j = 0; j < dim; ++j)
+  {
+    vtkNew<vtkDoubleArray> coord;
+    coord->SetName(inData->GetColumnName(j));
+    coord->SetNumberOfTuples(numClusters);
+    for (int c = 0; c < numClusters; ++c)
+    {
+      coord->SetValue(c, centers[c * dim + j]);
+    }
+    initialCenters->AddColumn(coord);
+  }
+  return this->LearnAndDeriveWithEngine(modelDO, inData, initialCenters);
+}
+
+int vtkPSciVizKMeans::LearnAndDeriveWithEngine(
+  vtkMultiBlockDataSet* modelDO, vtkTable* inData, vtkTable* initialCenters)
 {
   // Create the statistics filter and run it
   vtkPKMeansStatistics* stats = vtkPKMeansStatistics::New();
@@ -39,6 +263,11 @@ int vtkPSciVizKMeans::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable* in
   stats->SetDefaultNumberOfClusters(this->K);
   stats->SetMaxNumIterations(this->MaxNumIterations);
   stats->SetTolerance(this->Tolerance);
+  if (initialCenters)
+  {
+    stats->SetInputData(vtkStatisticsAlgorithm::LEARN_PARAMETERS, initialCenters);
+    stats->SetMaxNumIterations(1);
+  }
   vtkIdType ncols = inData->GetNumberOfColumns();
   for (vtkIdType i = 0; i < ncols; ++i)
   {
@@ -73,17 +73,45 @@ public:
   vtkGetMacro(Tolerance, double);
   //@}
 
+  //@{
+  /**
+   * The number of observations each process samples per iteration to learn cluster centers
+   * by mini-batch k-means.
+   * Each center moves toward the mean of its batch members by the fraction of all the members
+   * it has been assigned so far, until no center moves by more than \a Tolerance relative to
+   * its length or \a MaxNumIterations is reached.
+   * A final pass over the training data then assigns every observation.
+   * The default value of 0 iterates full passes over all observations.
+   */
+  vtkSetClampMacro(MiniBatchSize, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(MiniBatchSize, vtkIdType);
+  //@}
+
 protected:
   vtkPSciVizKMeans();
   ~vtkPSciVizKMeans() override;
 
   int LearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) override;
+  int ThreadedLearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) override;
   int AssessData(
     vtkTable* observations, vtkDataObject* dataset, vtkMultiBlockDataSet* model) override;
 
+  /**
+   * Iterate cluster centers over the observations of \a inData, across threads when
+   * \a ThreadedLearning is on and across processes, and model \a inData around them.
+   */
+  int LearnClusterCenters(vtkMultiBlockDataSet* model, vtkTable* inData);
+
+  /**
+   * Run the k-means engine on \a inData, starting from \a initialCenters when given.
+   */
+  int LearnAndDeriveWithEngine(
+    vtkMultiBlockDataSet* model, vtkTable* inData, vtkTable* initialCenters);
+
   int K;
   int MaxNumIterations;
   double Tolerance;
+  vtkIdType MiniBatchSize;
 
 private:
   vtkPSciVizKMeans(const vtkPSciVizKMeans&) = delete;
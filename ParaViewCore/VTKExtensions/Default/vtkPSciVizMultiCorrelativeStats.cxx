@@ -5,6 +5,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiCorrelativeStatistics.h"
 #include "vtkObjectFactory.h"
 #include "vtkPMultiCorrelativeStatistics.h"
 #include "vtkStringArray.h"
@@ -49,6 +50,17 @@ int vtkPSciVizMultiCorrelativeStats::LearnAndDerive(vtkMultiBlockDataSet* modelD
   return 1;
 }
 
+vtkStatisticsAlgorithm* vtkPSciVizMultiCorrelativeStats::NewSerialEngine(vtkTable* inData)
+{
+  vtkMultiCorrelativeStatistics* stats = vtkMultiCorrelativeStatistics::New();
+  vtkIdType ncols = inData->GetNumberOfColumns();
+  for (vtkIdType i = 0; i < ncols; ++i)
+  {
+    stats->SetColumnStatus(inData->GetColumnName(i), 1);
+  }
+  return stats;
+}
+
 int vtkPSciVizMultiCorrelativeStats::AssessData(
   vtkTable* observations, vtkDataObject* assessedOut, vtkMultiBlockDataSet* modelOut)
 {
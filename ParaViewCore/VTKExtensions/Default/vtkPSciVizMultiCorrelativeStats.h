@@ -86,6 +86,7 @@ protected:
   int LearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) override;
   int AssessData(
     vtkTable* observations, vtkDataObject* dataset, vtkMultiBlockDataSet* model) override;
+  vtkStatisticsAlgorithm* NewSerialEngine(vtkTable* inData) override;
 
 private:
   vtkPSciVizMultiCorrelativeStats(const vtkPSciVizMultiCorrelativeStats&) = delete;
@@ -6,6 +6,7 @@
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
+#include "vtkPCAStatistics.h"
 #include "vtkPPCAStatistics.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
@@ -61,6 +62,24 @@ int vtkPSciVizPCAStats::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable*
   return 1;
 }
 
+vtkStatisticsAlgorithm* vtkPSciVizPCAStats::NewSerialEngine(vtkTable* inData)
+{
+  if (this->RobustPCA)
+  {
+    // Median absolute deviations are not sums, so partial models cannot be aggregated.
+    return nullptr;
+  }
+
+  vtkPCAStatistics* stats = vtkPCAStatistics::New();
+  vtkIdType ncols = inData->GetNumberOfColumns();
+  for (vtkIdType i = 0; i < ncols; ++i)
+  {
+    stats->SetColumnStatus(inData->GetColumnName(i), 1);
+  }
+  stats->SetNormalizationScheme(this->NormalizationScheme);
+  return stats;
+}
+
 int vtkPSciVizPCAStats::AssessData(
   vtkTable* observations, vtkDataObject* assessedOut, vtkMultiBlockDataSet* modelOut)
 {
@@ -14,25 +14,40 @@
 =========================================================================*/
 #include "vtkPVArrayCalculator.h"
 
+#include "vtkArrayDispatch.h"
+#include "vtkCallbackCommand.h"
 #include "vtkCellData.h"
+#include "vtkCommand.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkFunctionParser.h"
 #include "vtkGraph.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <cmath>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -69,11 +84,722 @@ public:
     this->Calc->AddScalarVariable(name.c_str(), this->ArrayName, this->Component);
   }
 };
+
+//----------------------------------------------------------------------------
+// vtkFunctionParser subclass giving access to the byte code generated when
+// parsing the function.
+class vtkPVArrayCalculatorParser : public vtkFunctionParser
+{
+public:
+  static vtkPVArrayCalculatorParser* New();
+  vtkTypeMacro(vtkPVArrayCalculatorParser, vtkFunctionParser);
+
+  bool GetByteCode(std::vector<unsigned int>& byteCode, std::vector<double>& immediates)
+  {
+    // IsScalarResult() and IsVectorResult() parse the function when needed.
+    if (!this->IsScalarResult() && !this->IsVectorResult())
+    {
+      return false;
+    }
+    byteCode.clear();
+    for (int cc = 0; cc < this->ByteCodeSize; ++cc)
+    {
+      byteCode.push_back(static_cast<unsigned int>(this->ByteCode[cc]));
+    }
+    immediates.clear();
+    for (int cc = 0; cc < this->ImmediatesSize; ++cc)
+    {
+      immediates.push_back(this->Immediates[cc]);
+    }
+    return true;
+  }
+
+protected:
+  vtkPVArrayCalculatorParser() {}
+  ~vtkPVArrayCalculatorParser() override {}
+
+private:
+  vtkPVArrayCalculatorParser(const vtkPVArrayCalculatorParser&) = delete;
+  void operator=(const vtkPVArrayCalculatorParser&) = delete;
+};
+vtkStandardNewMacro(vtkPVArrayCalculatorParser);
+
+//----------------------------------------------------------------------------
+// Copies component `comp` of tuples [begin, begin + n) as doubles.
+struct LoadComponentWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int comp, vtkIdType begin, vtkIdType n, double* out) const
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(array);
+    for (vtkIdType cc = 0; cc < n; ++cc)
+    {
+      out[cc] = static_cast<double>(accessor.Get(begin + cc, comp));
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Stores `nComps` result components of tuples [begin, begin + n), converting
+// them to the value type of the result array as vtkDataArray::SetTuple() does.
+struct StoreResultWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, const double* const* values, int nComps, vtkIdType begin, vtkIdType n) const
+  {
+    vtkDataArrayAccessor<ArrayT> accessor(array);
+    using ValueT = typename vtkDataArrayAccessor<ArrayT>::APIType;
+    for (int comp = 0; comp < nComps; ++comp)
+    {
+      const double* compValues = values[comp];
+      for (vtkIdType cc = 0; cc < n; ++cc)
+      {
+        accessor.Set(begin + cc, comp, static_cast<ValueT>(compValues[cc]));
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Program compiled from the vtkFunctionParser byte code. Each instruction
+// operates on stack slots that hold a whole block of tuples, so that every
+// instruction is a tight loop over the block. The semantics of each
+// instruction match vtkFunctionParser::Evaluate().
+class vtkCompiledExpression
+{
+public:
+  static const vtkIdType BlockSize = 1024;
+
+  // Source of a variable component.
+  struct Load
+  {
+    vtkDataArray* Array;
+    int Component;
+  };
+
+  struct Instruction
+  {
+    unsigned int OpCode;
+    int Slot;       // first stack slot read or written by the instruction
+    double Value;   // for VTK_PARSER_IMMEDIATE
+    int Loads[3];   // indices in Loads, for variables
+    int NumberOfLoads;
+  };
+
+  bool ReplaceInvalidValues = false;
+  double ReplacementValue = 0.0;
+  vtkDataSet* CoordinatesDataSet = nullptr;
+  std::vector<Load> Loads;
+  std::vector<Instruction> Program;
+  int StackDepth = 0;
+  int NumberOfResultComponents = 0;
+
+  //--------------------------------------------------------------------------
+  // Builds the program. `resolve(varIndex, isVector, loads)` must fill the
+  // loads of parser variable `varIndex`. Returns false if the byte code uses
+  // operations not supported here.
+  template <typename ResolverT>
+  bool Compile(const std::vector<unsigned int>& byteCode, const std::vector<double>& immediates,
+    int numberOfScalarVariables, ResolverT resolve)
+  {
+    this->Program.clear();
+    this->Loads.clear();
+    this->StackDepth = 0;
+
+    int top = -1;
+    size_t immediate = 0;
+    for (unsigned int opCode : byteCode)
+    {
+      Instruction inst;
+      inst.OpCode = opCode;
+      inst.Value = 0.0;
+      inst.NumberOfLoads = 0;
+      int pop = 0;  // number of slots consumed
+      int push = 0; // number of slots produced
+      switch (opCode)
+      {
+        case VTK_PARSER_UNARY_PLUS:
+        case VTK_PARSER_VECTOR_UNARY_PLUS:
+          continue;
+
+        case VTK_PARSER_IMMEDIATE:
+          if (immediate >= immediates.size())
+          {
+            return false;
+          }
+          inst.Value = immediates[immediate++];
+          push = 1;
+          break;
+
+        case VTK_PARSER_UNARY_MINUS:
+        case VTK_PARSER_ABSOLUTE_VALUE:
+        case VTK_PARSER_EXPONENT:
+        case VTK_PARSER_CEILING:
+        case VTK_PARSER_FLOOR:
+        case VTK_PARSER_LOGARITHME:
+        case VTK_PARSER_LOGARITHM10:
+        case VTK_PARSER_SQUARE_ROOT:
+        case VTK_PARSER_SINE:
+        case VTK_PARSER_COSINE:
+        case VTK_PARSER_TANGENT:
+        case VTK_PARSER_ARCSINE:
+        case VTK_PARSER_ARCCOSINE:
+        case VTK_PARSER_ARCTANGENT:
+        case VTK_PARSER_HYPERBOLIC_SINE:
+        case VTK_PARSER_HYPERBOLIC_COSINE:
+        case VTK_PARSER_HYPERBOLIC_TANGENT:
+        case VTK_PARSER_SIGN:
+          pop = push = 1;
+          break;
+
+        case VTK_PARSER_ADD:
+        case VTK_PARSER_SUBTRACT:
+        case VTK_PARSER_MULTIPLY:
+        case VTK_PARSER_DIVIDE:
+        case VTK_PARSER_POWER:
+        case VTK_PARSER_MIN:
+        case VTK_PARSER_MAX:
+        case VTK_PARSER_LESS_THAN:
+        case VTK_PARSER_GREATER_THAN:
+        case VTK_PARSER_EQUAL_TO:
+        case VTK_PARSER_AND:
+        case VTK_PARSER_OR:
+          pop = 2;
+          push = 1;
+          break;
+
+        case VTK_PARSER_IF:
+          pop = 3;
+          push = 1;
+          break;
+
+        case VTK_PARSER_IHAT:
+        case VTK_PARSER_JHAT:
+        case VTK_PARSER_KHAT:
+          push = 3;
+          break;
+
+        case VTK_PARSER_VECTOR_UNARY_MINUS:
+        case VTK_PARSER_NORMALIZE:
+          pop = push = 3;
+          break;
+
+        case VTK_PARSER_MAGNITUDE:
+          pop = 3;
+          push = 1;
+          break;
+
+        case VTK_PARSER_DOT_PRODUCT:
+          pop = 6;
+          push = 1;
+          break;
+
+        case VTK_PARSER_VECTOR_ADD:
+        case VTK_PARSER_VECTOR_SUBTRACT:
+        case VTK_PARSER_CROSS:
+          pop = 6;
+          push = 3;
+          break;
+
+        case VTK_PARSER_SCALAR_TIMES_VECTOR:
+        case VTK_PARSER_VECTOR_TIMES_SCALAR:
+        case VTK_PARSER_VECTOR_OVER_SCALAR:
+          pop = 4;
+          push = 3;
+          break;
+
+        case VTK_PARSER_VECTOR_IF:
+          pop = 7;
+          push = 3;
+          break;
+
+        default:
+        {
+          if (opCode < VTK_PARSER_BEGIN_VARIABLES)
+          {
+            // includes the deprecated `log`, whose semantics changed over time.
+            return false;
+          }
+          const int varIndex = static_cast<int>(opCode - VTK_PARSER_BEGIN_VARIABLES);
+          const bool isVector = varIndex >= numberOfScalarVariables;
+          std::vector<Load> loads;
+          if (!resolve(isVector ? varIndex - numberOfScalarVariables : varIndex, isVector, loads) ||
+            loads.size() != (isVector ? 3u : 1u))
+          {
+            return false;
+          }
+          for (size_t cc = 0; cc < loads.size(); ++cc)
+          {
+            inst.Loads[cc] = static_cast<int>(this->Loads.size());
+            this->Loads.push_back(loads[cc]);
+          }
+          inst.NumberOfLoads = static_cast<int>(loads.size());
+          push = inst.NumberOfLoads;
+        }
+        break;
+      }
+
+      if (top + 1 < pop)
+      {
+        return false;
+      }
+      top -= pop;
+      inst.Slot = top + 1;
+      top += push;
+      this->StackDepth = std::max(this->StackDepth, top + 1);
+      this->Program.push_back(inst);
+    }
+
+    if (top != 0 && top != 2)
+    {
+      return false;
+    }
+    this->NumberOfResultComponents = top + 1;
+    return !this->Program.empty();
+  }
+
+  //--------------------------------------------------------------------------
+  // Evaluates the program for tuples [begin, begin + n), n <= BlockSize, using
+  // `stack` as storage for StackDepth * BlockSize values. Returns false if an
+  // invalid value is met while ReplaceInvalidValues is off.
+  bool Evaluate(vtkIdType begin, vtkIdType n, double* stack) const
+  {
+    const double rv = this->ReplacementValue;
+    bool valid = true;
+    for (const Instruction& inst : this->Program)
+    {
+      double* a = stack + inst.Slot * BlockSize;
+      double* b = a + BlockSize;
+      double* c = b + BlockSize;
+      vtkIdType i;
+      switch (inst.OpCode)
+      {
+        case VTK_PARSER_IMMEDIATE:
+          std::fill(a, a + n, inst.Value);
+          break;
+        case VTK_PARSER_UNARY_MINUS:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = -a[i];
+          }
+          break;
+        case VTK_PARSER_ADD:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] += b[i];
+          }
+          break;
+        case VTK_PARSER_SUBTRACT:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] -= b[i];
+          }
+          break;
+        case VTK_PARSER_MULTIPLY:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] *= b[i];
+          }
+          break;
+        case VTK_PARSER_DIVIDE:
+          valid = valid && (this->ReplaceInvalidValues || std::find(b, b + n, 0.0) == b + n);
+          for (i = 0; i < n; ++i)
+          {
+            const double q = a[i] / b[i];
+            a[i] = (b[i] == 0.0) ? rv : q;
+          }
+          break;
+        case VTK_PARSER_POWER:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = pow(a[i], b[i]);
+          }
+          break;
+        case VTK_PARSER_ABSOLUTE_VALUE:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = fabs(a[i]);
+          }
+          break;
+        case VTK_PARSER_EXPONENT:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = exp(a[i]);
+          }
+          break;
+        case VTK_PARSER_CEILING:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = ceil(a[i]);
+          }
+          break;
+        case VTK_PARSER_FLOOR:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = floor(a[i]);
+          }
+          break;
+        case VTK_PARSER_LOGARITHME:
+          for (i = 0; i < n; ++i)
+          {
+            valid = valid && (this->ReplaceInvalidValues || a[i] > 0);
+            a[i] = (a[i] <= 0) ? rv : log(a[i]);
+          }
+          break;
+        case VTK_PARSER_LOGARITHM10:
+          for (i = 0; i < n; ++i)
+          {
+            valid = valid && (this->ReplaceInvalidValues || a[i] > 0);
+            a[i] = (a[i] <= 0) ? rv : log10(a[i]);
+          }
+          break;
+        case VTK_PARSER_SQUARE_ROOT:
+          for (i = 0; i < n; ++i)
+          {
+            valid = valid && (this->ReplaceInvalidValues || !(a[i] < 0));
+            a[i] = (a[i] < 0) ? rv : sqrt(a[i]);
+          }
+          break;
+        case VTK_PARSER_SINE:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = sin(a[i]);
+          }
+          break;
+        case VTK_PARSER_COSINE:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = cos(a[i]);
+          }
+          break;
+        case VTK_PARSER_TANGENT:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = tan(a[i]);
+          }
+          break;
+        case VTK_PARSER_ARCSINE:
+          for (i = 0; i < n; ++i)
+          {
+            const bool invalid = a[i] < -1 || a[i] > 1;
+            valid = valid && (this->ReplaceInvalidValues || !invalid);
+            a[i] = invalid ? rv : asin(a[i]);
+          }
+          break;
+        case VTK_PARSER_ARCCOSINE:
+          for (i = 0; i < n; ++i)
+          {
+            const bool invalid = a[i] < -1 || a[i] > 1;
+            valid = valid && (this->ReplaceInvalidValues || !invalid);
+            a[i] = invalid ? rv : acos(a[i]);
+          }
+          break;
+        case VTK_PARSER_ARCTANGENT:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = atan(a[i]);
+          }
+          break;
+        case VTK_PARSER_HYPERBOLIC_SINE:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = sinh(a[i]);
+          }
+          break;
+        case VTK_PARSER_HYPERBOLIC_COSINE:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = cosh(a[i]);
+          }
+          break;
+        case VTK_PARSER_HYPERBOLIC_TANGENT:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = tanh(a[i]);
+          }
+          break;
+        case VTK_PARSER_MIN:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (b[i] < a[i]) ? b[i] : a[i];
+          }
+          break;
+        case VTK_PARSER_MAX:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (b[i] > a[i]) ? b[i] : a[i];
+          }
+          break;
+        case VTK_PARSER_SIGN:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] < 0) ? -1.0 : ((a[i] == 0) ? 0.0 : 1.0);
+          }
+          break;
+        case VTK_PARSER_LESS_THAN:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] < b[i]) ? 1.0 : 0.0;
+          }
+          break;
+        case VTK_PARSER_GREATER_THAN:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] > b[i]) ? 1.0 : 0.0;
+          }
+          break;
+        case VTK_PARSER_EQUAL_TO:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] == b[i]) ? 1.0 : 0.0;
+          }
+          break;
+        case VTK_PARSER_AND:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] != 0.0 && b[i] != 0.0) ? 1.0 : 0.0;
+          }
+          break;
+        case VTK_PARSER_OR:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] != 0.0 || b[i] != 0.0) ? 1.0 : 0.0;
+          }
+          break;
+        case VTK_PARSER_IF:
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = (a[i] != 0.0) ? b[i] : c[i];
+          }
+          break;
+        case VTK_PARSER_IHAT:
+        case VTK_PARSER_JHAT:
+        case VTK_PARSER_KHAT:
+          std::fill(a, a + n, inst.OpCode == VTK_PARSER_IHAT ? 1.0 : 0.0);
+          std::fill(b, b + n, inst.OpCode == VTK_PARSER_JHAT ? 1.0 : 0.0);
+          std::fill(c, c + n, inst.OpCode == VTK_PARSER_KHAT ? 1.0 : 0.0);
+          break;
+        case VTK_PARSER_VECTOR_UNARY_MINUS:
+          for (int comp = 0; comp < 3; ++comp)
+          {
+            double* v = a + comp * BlockSize;
+            for (i = 0; i < n; ++i)
+            {
+              v[i] = -v[i];
+            }
+          }
+          break;
+        case VTK_PARSER_VECTOR_ADD:
+        case VTK_PARSER_VECTOR_SUBTRACT:
+        {
+          const double sign = inst.OpCode == VTK_PARSER_VECTOR_ADD ? 1.0 : -1.0;
+          for (int comp = 0; comp < 3; ++comp)
+          {
+            double* v = a + comp * BlockSize;
+            const double* w = v + 3 * BlockSize;
+            if (sign > 0)
+            {
+              for (i = 0; i < n; ++i)
+              {
+                v[i] += w[i];
+              }
+            }
+            else
+            {
+              for (i = 0; i < n; ++i)
+              {
+                v[i] -= w[i];
+              }
+            }
+          }
+        }
+        break;
+        case VTK_PARSER_DOT_PRODUCT:
+        {
+          const double* w = a + 3 * BlockSize;
+          for (i = 0; i < n; ++i)
+          {
+            a[i] = a[i] * w[i] + b[i] * w[i + BlockSize] + c[i] * w[i + 2 * BlockSize];
+          }
+        }
+        break;
+        case VTK_PARSER_CROSS:
+        {
+          const double* w = a + 3 * BlockSize;
+          for (i = 0; i < n; ++i)
+          {
+            double v1[3] = { a[i], b[i], c[i] };
+            double v2[3] = { w[i], w[i + BlockSize], w[i + 2 * BlockSize] };
+            double r[3];
+            vtkMath::Cross(v1, v2, r);
+            a[i] = r[0];
+            b[i] = r[1];
+            c[i] = r[2];
+          }
+        }
+        break;
+        case VTK_PARSER_SCALAR_TIMES_VECTOR:
+        {
+          // the scalar in slot `a` is followed by the vector.
+          const double* w = c + BlockSize;
+          for (i = 0; i < n; ++i)
+          {
+            const double s = a[i];
+            a[i] = s * b[i];
+            b[i] = s * c[i];
+            c[i] = s * w[i];
+          }
+        }
+        break;
+        case VTK_PARSER_VECTOR_TIMES_SCALAR:
+        {
+          const double* s = a + 3 * BlockSize;
+          for (int comp = 0; comp < 3; ++comp)
+          {
+            double* v = a + comp * BlockSize;
+            for (i = 0; i < n; ++i)
+            {
+              v[i] *= s[i];
+            }
+          }
+        }
+        break;
+        case VTK_PARSER_VECTOR_OVER_SCALAR:
+        {
+          // replacement semantics are not handled here, see the superclass.
+          const double* s = a + 3 * BlockSize;
+          valid = valid && std::find(s, s + n, 0.0) == s + n;
+          for (int comp = 0; comp < 3; ++comp)
+          {
+            double* v = a + comp * BlockSize;
+            for (i = 0; i < n; ++i)
+            {
+              v[i] /= s[i];
+            }
+          }
+        }
+        break;
+        case VTK_PARSER_MAGNITUDE:
+          for (i = 0; i < n; ++i)
+          {
+            double v[3] = { a[i], b[i], c[i] };
+            a[i] = vtkMath::Norm(v);
+          }
+          break;
+        case VTK_PARSER_NORMALIZE:
+          for (i = 0; i < n; ++i)
+          {
+            double v[3] = { a[i], b[i], c[i] };
+            const double mag = vtkMath::Norm(v);
+            // zero vectors are left to the superclass.
+            valid = valid && mag != 0.0;
+            a[i] /= mag;
+            b[i] /= mag;
+            c[i] /= mag;
+          }
+          break;
+        case VTK_PARSER_VECTOR_IF:
+        {
+          // the condition in slot `a` is followed by the two vectors.
+          const double* t = b;
+          const double* f = b + 3 * BlockSize;
+          for (i = 0; i < n; ++i)
+          {
+            const bool cond = a[i] != 0.0;
+            a[i] = cond ? t[i] : f[i];
+            b[i] = cond ? t[i + BlockSize] : f[i + BlockSize];
+            c[i] = cond ? t[i + 2 * BlockSize] : f[i + 2 * BlockSize];
+          }
+        }
+        break;
+        default:
+          // variables
+          for (int cc = 0; cc < inst.NumberOfLoads; ++cc)
+          {
+            const Load& load = this->Loads[inst.Loads[cc]];
+            double* values = a + cc * BlockSize;
+            if (load.Array)
+            {
+              LoadComponentWorker worker;
+              if (!vtkArrayDispatch::Dispatch::Execute(
+                    load.Array, worker, load.Component, begin, n, values))
+              {
+                worker(load.Array, load.Component, begin, n, values);
+              }
+            }
+            else
+            {
+              this->LoadCoordinate(load.Component, begin, n, values);
+            }
+          }
+          break;
+      }
+    }
+    return valid;
+  }
+
+private:
+  void LoadCoordinate(int comp, vtkIdType begin, vtkIdType n, double* values) const
+  {
+    double pt[3];
+    for (vtkIdType cc = 0; cc < n; ++cc)
+    {
+      this->CoordinatesDataSet->GetPoint(begin + cc, pt);
+      values[cc] = pt[comp];
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Evaluates a vtkCompiledExpression on ranges of tuples.
+struct CompiledExpressionFunctor
+{
+  const vtkCompiledExpression* Expression;
+  vtkDataArray* Result;
+  std::atomic<bool> Valid;
+  vtkSMPThreadLocal<std::vector<double> > Stack;
+
+  CompiledExpressionFunctor(const vtkCompiledExpression* expression, vtkDataArray* result)
+    : Expression(expression)
+    , Result(result)
+    , Valid(true)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType blockSize = vtkCompiledExpression::BlockSize;
+    std::vector<double>& stack = this->Stack.Local();
+    // two extra slots so that instructions may address the slots following
+    // their operands.
+    stack.resize(static_cast<size_t>((this->Expression->StackDepth + 2) * blockSize));
+    const double* values[3] = { &stack[0], &stack[0] + blockSize, &stack[0] + 2 * blockSize };
+    const int nComps = this->Expression->NumberOfResultComponents;
+
+    for (vtkIdType blockBegin = begin; blockBegin < end && this->Valid; blockBegin += blockSize)
+    {
+      const vtkIdType n = std::min(blockSize, end - blockBegin);
+      if (!this->Expression->Evaluate(blockBegin, n, &stack[0]))
+      {
+        this->Valid = false;
+        return;
+      }
+      StoreResultWorker worker;
+      if (!vtkArrayDispatch::Dispatch::Execute(this->Result, worker, values, nComps, blockBegin, n))
+      {
+        worker(this->Result, values, nComps, blockBegin, n);
+      }
+    }
+  }
+};
 }
 
 vtkStandardNewMacro(vtkPVArrayCalculator);
 // ----------------------------------------------------------------------------
 vtkPVArrayCalculator::vtkPVArrayCalculator()
+  : UseCompiledEvaluation(false)
+  , CompiledEvaluationUsed(false)
 {
   // We'll tell the superclass about all arrays (partial and full) and have it
   // ignore missing arrays when evaluating the calculator.
@@ -241,11 +967,183 @@ int vtkPVArrayCalculator::RequestData(
   assert(this->GetMTime() == mtime && "post: mtime cannot be changed in RequestData()");
   (void)mtime;
 
+  this->CompiledEvaluationUsed = this->UseCompiledEvaluation &&
+    this->ExecuteCompiled(input, vtkDataObject::GetData(outputVector, 0));
+  if (this->CompiledEvaluationUsed)
+  {
+    return 1;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+// ----------------------------------------------------------------------------
+bool vtkPVArrayCalculator::ExecuteCompiled(vtkDataObject* input, vtkDataObject* output)
+{
+  if (!input || !output || vtkCompositeDataSet::SafeDownCast(input) || !this->Function ||
+    this->Function[0] == '\0' || !this->ResultArrayName || this->ResultArrayName[0] == '\0' ||
+    this->CoordinateResults || this->ResultNormals || this->ResultTCoords)
+  {
+    return false;
+  }
+
+  const int attributeType = this->GetAttributeTypeFromInput(input);
+  vtkDataSetAttributes* inAttrs = input->GetAttributes(attributeType);
+  const vtkIdType numTuples = inAttrs ? inAttrs->GetNumberOfTuples() : 0;
+  if (numTuples < 1)
+  {
+    return false;
+  }
+
+  // Coordinate variables are only available for point data of datasets.
+  vtkDataSet* dsInput = vtkDataSet::SafeDownCast(input);
+  const bool hasCoordinates = dsInput && attributeType == vtkDataObject::POINT;
+  vtkDataArray* coordinates = nullptr;
+  if (hasCoordinates)
+  {
+    vtkPointSet* psInput = vtkPointSet::SafeDownCast(input);
+    coordinates = psInput && psInput->GetPoints() ? psInput->GetPoints()->GetData() : nullptr;
+    if (!coordinates)
+    {
+      // Make sure GetPoint() is thread safe by calling it once.
+      double pt[3];
+      dsInput->GetPoint(0, pt);
+    }
+  }
+
+  // Parse the function with a private parser that knows all the variables.
+  // Errors are not reported here, the superclass will report them.
+  vtkNew<vtkPVArrayCalculatorParser> parser;
+  vtkNew<vtkCallbackCommand> ignoreErrors;
+  parser->AddObserver(vtkCommand::ErrorEvent, ignoreErrors);
+  for (int cc = 0; cc < this->NumberOfScalarArrays; ++cc)
+  {
+    parser->SetScalarVariableValue(this->ScalarVariableNames[cc], 0.0);
+  }
+  for (int cc = 0; hasCoordinates && cc < this->NumberOfCoordinateScalarArrays; ++cc)
+  {
+    parser->SetScalarVariableValue(this->CoordinateScalarVariableNames[cc], 0.0);
+  }
+  for (int cc = 0; cc < this->NumberOfVectorArrays; ++cc)
+  {
+    parser->SetVectorVariableValue(this->VectorVariableNames[cc], 0.0, 0.0, 0.0);
+  }
+  for (int cc = 0; hasCoordinates && cc < this->NumberOfCoordinateVectorArrays; ++cc)
+  {
+    parser->SetVectorVariableValue(this->CoordinateVectorVariableNames[cc], 0.0, 0.0, 0.0);
+  }
+  parser->SetFunction(this->Function);
+
+  std::vector<unsigned int> byteCode;
+  std::vector<double> immediates;
+  if (!parser->GetByteCode(byteCode, immediates))
+  {
+    return false;
+  }
+
+  // Maps a parser variable to the array components providing its values.
+  // When a variable name is registered more than once, the last one wins, as
+  // it does when the superclass sets variable values by name.
+  auto resolve = [&](int index, bool isVector, std::vector<vtkCompiledExpression::Load>& loads) {
+    const std::string name =
+      isVector ? parser->GetVectorVariableName(index) : parser->GetScalarVariableName(index);
+    const int numComps = isVector ? 3 : 1;
+    loads.clear();
+    if (hasCoordinates)
+    {
+      const int count =
+        isVector ? this->NumberOfCoordinateVectorArrays : this->NumberOfCoordinateScalarArrays;
+      for (int cc = count - 1; cc >= 0 && loads.empty(); --cc)
+      {
+        const char* varName = isVector ? this->CoordinateVectorVariableNames[cc]
+                                       : this->CoordinateScalarVariableNames[cc];
+        for (int comp = 0; name == varName && comp < numComps; ++comp)
+        {
+          const int selected = isVector
+            ? this->SelectedCoordinateVectorComponents[cc]->GetValue(comp)
+            : this->SelectedCoordinateScalarComponents[cc];
+          if (selected < 0 || selected > 2)
+          {
+            return false;
+          }
+          loads.push_back(vtkCompiledExpression::Load{ coordinates, selected });
+        }
+      }
+      if (!loads.empty())
+      {
+        return true;
+      }
+    }
+
+    const int count = isVector ? this->NumberOfVectorArrays : this->NumberOfScalarArrays;
+    for (int cc = count - 1; cc >= 0; --cc)
+    {
+      const char* varName =
+        isVector ? this->VectorVariableNames[cc] : this->ScalarVariableNames[cc];
+      if (name != varName)
+      {
+        continue;
+      }
+      vtkDataArray* array = inAttrs->GetArray(
+        isVector ? this->VectorArrayNames[cc] : this->ScalarArrayNames[cc]);
+      if (!array)
+      {
+        return false;
+      }
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        const int selected = isVector ? this->SelectedVectorComponents[cc]->GetValue(comp)
+                                      : this->SelectedScalarComponents[cc];
+        if (selected < 0 || selected >= array->GetNumberOfComponents())
+        {
+          return false;
+        }
+        loads.push_back(vtkCompiledExpression::Load{ array, selected });
+      }
+      return true;
+    }
+    return false;
+  };
+
+  vtkCompiledExpression expression;
+  expression.ReplaceInvalidValues = this->ReplaceInvalidValues != 0;
+  expression.ReplacementValue = this->ReplacementValue;
+  expression.CoordinatesDataSet = dsInput;
+  if (!expression.Compile(byteCode, immediates, parser->GetNumberOfScalarVariables(), resolve))
+  {
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataArray> result;
+  result.TakeReference(vtkDataArray::CreateDataArray(this->ResultArrayType));
+  if (!result)
+  {
+    return false;
+  }
+  result->SetNumberOfComponents(expression.NumberOfResultComponents);
+  result->SetNumberOfTuples(numTuples);
+  result->SetName(this->ResultArrayName);
+
+  CompiledExpressionFunctor functor(&expression, result);
+  vtkSMPTools::For(0, numTuples, vtkCompiledExpression::BlockSize, functor);
+  if (!functor.Valid)
+  {
+    // Let the superclass handle (and report) invalid values.
+    return false;
+  }
+
+  output->ShallowCopy(input);
+  vtkDataSetAttributes* outAttrs = output->GetAttributes(attributeType);
+  const int idx = outAttrs->AddArray(result);
+  outAttrs->SetActiveAttribute(idx,
+    expression.NumberOfResultComponents == 1 ? vtkDataSetAttributes::SCALARS
+                                             : vtkDataSetAttributes::VECTORS);
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 void vtkPVArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseCompiledEvaluation: " << this->UseCompiledEvaluation << endl;
+  os << indent << "CompiledEvaluationUsed: " << this->CompiledEvaluationUsed << endl;
 }
@@ -24,6 +24,10 @@
  *  their mapping with the input fields. We extend vtkArrayCalculator to
  *  automatically add scalar/vector fields mapping using the array available in
  *  the input.
+ *
+ *  When UseCompiledEvaluation is enabled, the function is compiled once into a
+ *  byte code program that is evaluated on blocks of tuples using vtkSMPTools
+ *  instead of being interpreted by vtkFunctionParser for each tuple.
  * @sa
  *  vtkArrayCalculator vtkFunctionParser
 */
@@ -45,6 +49,27 @@ public:
 
   static vtkPVArrayCalculator* New();
 
+  //@{
+  /**
+   * When set, the function is compiled once from the byte code generated by
+   * vtkFunctionParser into a program whose instructions each operate on a
+   * block of tuples. Blocks are evaluated concurrently using vtkSMPTools. The
+   * program follows vtkFunctionParser semantics, including replacement of
+   * invalid values. Whenever the function, the input or the requested output
+   * cannot be handled that way, the vtkArrayCalculator implementation is used
+   * instead. Default is false.
+   */
+  vtkSetMacro(UseCompiledEvaluation, bool);
+  vtkGetMacro(UseCompiledEvaluation, bool);
+  vtkBooleanMacro(UseCompiledEvaluation, bool);
+  //@}
+
+  /**
+   * Returns true if the last execution evaluated the function using the
+   * compiled backend, false if the vtkArrayCalculator implementation was used.
+   */
+  vtkGetMacro(CompiledEvaluationUsed, bool);
+
 protected:
   vtkPVArrayCalculator();
   ~vtkPVArrayCalculator() override;
@@ -76,6 +101,17 @@ protected:
    */
   void AddArrayAndVariableNames(vtkDataObject* theInputObj, vtkDataSetAttributes* inDataAttrs);
 
+  /**
+   * Evaluates the function on \c input using the compiled backend and fills
+   * \c output. Returns false, leaving \c output untouched, if the superclass
+   * implementation must be used instead. This function should be called by
+   * RequestData() only, once variables have been added.
+   */
+  bool ExecuteCompiled(vtkDataObject* input, vtkDataObject* output);
+
+  bool UseCompiledEvaluation;
+  bool CompiledEvaluationUsed;
+
 private:
   vtkPVArrayCalculator(const vtkPVArrayCalculator&) = delete;
   void operator=(const vtkPVArrayCalculator&) = delete;
@@ -16,6 +16,7 @@
 
 // VTK includes
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
 #include "vtkCellCenters.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
@@ -34,6 +35,8 @@
 #include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
@@ -52,6 +55,7 @@
 #include <numeric>
 #include <random>
 #include <set>
+#include <utility>
 #include <vector>
 
 static const std::string IDS_ARRAY_NAME = "vtkPVGlyphFilter_Ids";
@@ -493,6 +497,24 @@ public:
     }
     return false;
   }
+
+  //---------------------------------------------------------------------------
+  // Thread-safe counterpart of IsPointVisible used by the threaded code path.
+  // ComputeVisiblePointsIfNeeded must have been called for the dataset first.
+  bool IsPointSelected(vtkIdType ptId, int glyphMode, int stride) const
+  {
+    switch (glyphMode)
+    {
+      case vtkPVGlyphFilter::ALL_POINTS:
+        return true;
+
+      case vtkPVGlyphFilter::EVERY_NTH_POINT:
+        return stride <= 1 || (ptId % stride) == 0;
+
+      default:
+        return std::binary_search(this->PointIds.begin(), this->PointIds.end(), ptId);
+    }
+  }
 };
 
 vtkStandardNewMacro(vtkPVGlyphFilter);
@@ -507,6 +529,7 @@ vtkPVGlyphFilter::vtkPVGlyphFilter()
   , Seed(1)
   , Stride(1)
   , Controller(0)
+  , ParallelGlyphing(false)
   , Internals(new vtkPVGlyphFilter::vtkInternals())
 {
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -780,6 +803,240 @@ bool vtkPVGlyphFilter::UseCellCenters(vtkDataSet* input)
     inVectorsAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS;
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Sets up `trans` to translate, orient and scale the glyph for point `inPtId`.
+// This is shared by the serial and threaded code paths so that both produce
+// identical transforms. Only thread-safe dataset/array accessors are used.
+void SetupGlyphTransform(vtkTransform* trans, vtkDataSet* input, vtkIdType inPtId,
+  vtkDataArray* scaleArray, vtkDataArray* orientArray, int vectorScaleMode, double scaleFactor)
+{
+  double scalex(1.0), scaley(1.0), scalez(1.0);
+
+  // Get the scalar and vector data
+  if (scaleArray)
+  {
+    if (scaleArray->GetNumberOfComponents() == 1)
+    {
+      scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
+    }
+    else
+    {
+      // Consider the vector scaling mode
+      if (scaleArray->GetNumberOfComponents() == 2)
+      {
+        double vec2[2];
+        scaleArray->GetTuple(inPtId, vec2);
+        if (vectorScaleMode == vtkPVGlyphFilter::SCALE_BY_MAGNITUDE)
+        {
+          scalex = scaley = scalez = vtkMath::Norm2D(vec2);
+        }
+        else if (vectorScaleMode == vtkPVGlyphFilter::SCALE_BY_COMPONENTS)
+        {
+          scalex = vec2[0];
+          scaley = vec2[1];
+          // leave scalez alone for 2D
+        }
+      }
+      else if (scaleArray->GetNumberOfComponents() == 3)
+      {
+        double vec3[3];
+        scaleArray->GetTuple(inPtId, vec3);
+        if (vectorScaleMode == vtkPVGlyphFilter::SCALE_BY_MAGNITUDE)
+        {
+          scalex = scaley = scalez = vtkMath::Norm(vec3);
+        }
+        else
+        {
+          scalex = vec3[0];
+          scaley = vec3[1];
+          scalez = vec3[2];
+        }
+      }
+    }
+  }
+
+  // Apply scale factor
+  scalex *= scaleFactor;
+  scaley *= scaleFactor;
+  scalez *= scaleFactor;
+
+  // Now begin copying/transforming glyph
+  trans->Identity();
+
+  // translate Source to Input point
+  double x[3];
+  input->GetPoint(inPtId, x);
+  trans->Translate(x[0], x[1], x[2]);
+
+  if (orientArray)
+  {
+    double v[3] = { 0.0 };
+    orientArray->GetTuple(inPtId, v);
+    double vMag = vtkMath::Norm(v);
+    if (vMag > 0.0)
+    {
+      // if there is no y or z component
+      if (v[1] == 0.0 && v[2] == 0.0)
+      {
+        if (v[0] < 0) // just flip x if we need to
+        {
+          trans->RotateWXYZ(180.0, 0, 1, 0);
+        }
+      }
+      else
+      {
+        double vNew[3];
+        vNew[0] = (v[0] + vMag) / 2.0;
+        vNew[1] = v[1] / 2.0;
+        vNew[2] = v[2] / 2.0;
+        trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+      }
+    }
+  }
+
+  // scale data if appropriate
+  if (scalex == 0.0)
+  {
+    scalex = 1.0e-10;
+  }
+  if (scaley == 0.0)
+  {
+    scaley = 1.0e-10;
+  }
+  if (scalez == 0.0)
+  {
+    scalez = 1.0e-10;
+  }
+  trans->Scale(scalex, scaley, scalez);
+}
+
+//-----------------------------------------------------------------------------
+// Connectivity of one of the 4 cell arrays of the glyph source, copied into
+// flat vectors so that it can be replicated concurrently.
+struct GlyphCellTemplate
+{
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Connectivity;
+  vtkIdType* OutOffsets = nullptr;
+  vtkIdType* OutConnectivity = nullptr;
+
+  vtkIdType GetNumberOfCells() const { return static_cast<vtkIdType>(this->Offsets.size()); }
+  vtkIdType GetConnectivitySize() const
+  {
+    return static_cast<vtkIdType>(this->Connectivity.size());
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Functor used by vtkPVGlyphFilter::ExecuteParallel() to fill the preallocated
+// output. Glyph `glyphId` owns points [glyphId * NumberOfSourcePoints,
+// (glyphId + 1) * NumberOfSourcePoints) and the matching ranges of each cell
+// array, hence threads never write to the same locations.
+struct GlyphGenerator
+{
+  vtkDataSet* Input;
+  vtkPoints* GlyphPoints;
+  vtkDataArray* SourceNormals;
+  vtkDataArray* ScaleArray;
+  vtkDataArray* OrientArray;
+  int VectorScaleMode;
+  double ScaleFactor;
+  const unsigned char* Mask;
+  const vtkIdType* GlyphOffsets;
+  vtkIdType NumberOfSourcePoints;
+  vtkDataArray* OutPoints;
+  vtkFloatArray* OutNormals;
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*> > PointDataArrays;
+  GlyphCellTemplate* CellTemplates;
+
+  vtkSMPThreadLocalObject<vtkTransform> Transform;
+  vtkSMPThreadLocalObject<vtkPoints> LocalPoints;
+  vtkSMPThreadLocalObject<vtkFloatArray> LocalNormals;
+
+  void Initialize()
+  {
+    this->LocalPoints.Local()->SetDataType(this->OutPoints->GetDataType());
+    this->LocalNormals.Local()->SetNumberOfComponents(3);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkTransform* trans = this->Transform.Local();
+    vtkPoints* localPts = this->LocalPoints.Local();
+    vtkFloatArray* localNormals = this->LocalNormals.Local();
+    const vtkIdType numSourcePts = this->NumberOfSourcePoints;
+
+    double x[3];
+    float n[3];
+    for (vtkIdType inPtId = begin; inPtId < end; ++inPtId)
+    {
+      if (!this->Mask[inPtId])
+      {
+        continue;
+      }
+      const vtkIdType glyphId = this->GlyphOffsets[inPtId];
+      const vtkIdType ptOffset = glyphId * numSourcePts;
+
+      ::SetupGlyphTransform(trans, this->Input, inPtId, this->ScaleArray, this->OrientArray,
+        this->VectorScaleMode, this->ScaleFactor);
+
+      // Transform into thread-local buffers using the same vtkTransform API as
+      // the serial path, then scatter at this glyph's offset.
+      localPts->Reset();
+      trans->TransformPoints(this->GlyphPoints, localPts);
+      for (vtkIdType i = 0; i < numSourcePts; ++i)
+      {
+        localPts->GetPoint(i, x);
+        this->OutPoints->SetTuple(ptOffset + i, x);
+      }
+
+      if (this->OutNormals)
+      {
+        localNormals->Reset();
+        trans->TransformNormals(this->SourceNormals, localNormals);
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+        {
+          localNormals->GetTypedTuple(i, n);
+          this->OutNormals->SetTypedTuple(ptOffset + i, n);
+        }
+      }
+
+      // Copy point data from input
+      for (const auto& arrays : this->PointDataArrays)
+      {
+        for (vtkIdType i = 0; i < numSourcePts; ++i)
+        {
+          arrays.second->SetTuple(ptOffset + i, inPtId, arrays.first);
+        }
+      }
+
+      // Copy all topology, shifting point ids to this glyph's points
+      for (int type = 0; type < 4; ++type)
+      {
+        const GlyphCellTemplate& cells = this->CellTemplates[type];
+        const vtkIdType numCells = cells.GetNumberOfCells();
+        const vtkIdType connSize = cells.GetConnectivitySize();
+        vtkIdType* outOffsets = cells.OutOffsets + glyphId * numCells;
+        vtkIdType* outConn = cells.OutConnectivity + glyphId * connSize;
+        for (vtkIdType c = 0; c < numCells; ++c)
+        {
+          outOffsets[c] = glyphId * connSize + cells.Offsets[c];
+        }
+        for (vtkIdType c = 0; c < connSize; ++c)
+        {
+          outConn[c] = cells.Connectivity[c] + ptOffset;
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVGlyphFilter::Execute(
   unsigned int index, vtkDataSet* input, vtkInformationVector* sourceVector, vtkPolyData* output)
@@ -888,10 +1145,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
 
-  // Prepare to copy output.
-  pd = input->GetPointData();
-  outputPD->CopyAllocate(pd, numPts * numSourcePts);
-
   vtkNew<vtkIdList> srcPointIdList;
   srcPointIdList->SetNumberOfIds(numSourcePts);
   vtkNew<vtkIdList> dstPointIdList;
@@ -917,6 +1170,16 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
     newPts->SetDataType(VTK_DOUBLE);
   }
 
+  if (this->ParallelGlyphing)
+  {
+    return this->ExecuteParallel(
+      index, input, source, output, newPts, scaleArray, orientArray, cellCenters);
+  }
+
+  // Prepare to copy output.
+  pd = input->GetPointData();
+  outputPD->CopyAllocate(pd, numPts * numSourcePts);
+
   newPts->Allocate(numPts * numSourcePts);
 
   vtkSmartPointer<vtkFloatArray> newNormals;
@@ -941,9 +1204,9 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
   vtkNew<vtkIdList> pointIdList;
   vtkIdType ptIncr = 0;
   vtkIdType cellIncr = 0;
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
   for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
   {
-    double scalex(1.0), scaley(1.0), scalez(1.0);
     if (!(inPtId % 10000))
     {
       this->UpdateProgress(static_cast<double>(inPtId) / numPts);
@@ -953,52 +1216,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
       }
     }
 
-    // Get the scalar and vector data
-    if (scaleArray)
-    {
-      if (scaleArray->GetNumberOfComponents() == 1)
-      {
-        scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
-      }
-      else
-      {
-        // Consider the vector scaling mode
-        if (scaleArray->GetNumberOfComponents() == 2)
-        {
-          double* vec2 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm2D(vec2);
-          }
-          else if (this->VectorScaleMode == SCALE_BY_COMPONENTS)
-          {
-            scalex = vec2[0];
-            scaley = vec2[1];
-            // leave scalez alone for 2D
-          }
-        }
-        else if (scaleArray->GetNumberOfComponents() == 3)
-        {
-          double* vec3 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm(vec3);
-          }
-          else
-          {
-            scalex = vec3[0];
-            scaley = vec3[1];
-            scalez = vec3[2];
-          }
-        }
-      }
-    }
-
-    // Apply scale factor
-    scalex *= this->ScaleFactor;
-    scaley *= this->ScaleFactor;
-    scalez *= this->ScaleFactor;
-
     // Check ghost points.
     // If we are processing a piece, we do not want to duplicate
     // glyphs on the borders.
@@ -1008,7 +1225,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
     }
 
     // this is used to respect blanking specified on uniform grids.
-    vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
     if (inputUG && !inputUG->IsPointVisible(inPtId))
     {
       // input is a vtkUniformGrid and the current point is blanked. Don't glyph
@@ -1021,9 +1237,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
       continue;
     }
 
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
     // Copy all topology (transformation independent)
     for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
     {
@@ -1037,51 +1250,9 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
       output->InsertNextCell(source->GetCellType(cellId), pts);
     }
 
-    // translate Source to Input point
-    double x[3];
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (orientArray)
-    {
-      double v[3] = { 0.0 };
-      orientArray->GetTuple(inPtId, v);
-      double vMag = vtkMath::Norm(v);
-      if (vMag > 0.0)
-      {
-        // if there is no y or z component
-        if (v[1] == 0.0 && v[2] == 0.0)
-        {
-          if (v[0] < 0) // just flip x if we need to
-          {
-            trans->RotateWXYZ(180.0, 0, 1, 0);
-          }
-        }
-        else
-        {
-          double vNew[3];
-          vNew[0] = (v[0] + vMag) / 2.0;
-          vNew[1] = v[1] / 2.0;
-          vNew[2] = v[2] / 2.0;
-          trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
-        }
-      }
-    }
-
-    // scale data if appropriate
-    if (scalex == 0.0)
-    {
-      scalex = 1.0e-10;
-    }
-    if (scaley == 0.0)
-    {
-      scaley = 1.0e-10;
-    }
-    if (scalez == 0.0)
-    {
-      scalez = 1.0e-10;
-    }
-    trans->Scale(scalex, scaley, scalez);
+    // translate, orient and scale the glyph
+    ::SetupGlyphTransform(trans, input, inPtId, scaleArray, orientArray, this->VectorScaleMode,
+      this->ScaleFactor);
 
     // multiply points and normals by resulting matrix
     if (this->SourceTransform)
@@ -1131,6 +1302,195 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVGlyphFilter::ExecuteParallel(unsigned int index, vtkDataSet* input,
+  vtkPolyData* source, vtkPolyData* output, vtkPoints* newPts, vtkDataArray* scaleArray,
+  vtkDataArray* orientArray, bool cellCenters)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPoints* sourcePts = source->GetPoints();
+  const vtkIdType numSourcePts = sourcePts->GetNumberOfPoints();
+  vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outputPD = output->GetPointData();
+
+  unsigned char* inGhostLevels = nullptr;
+  vtkUnsignedCharArray* ghosts = vtkUnsignedCharArray::SafeDownCast(
+    pd ? pd->GetArray(vtkDataSetAttributes::GhostArrayName()) : nullptr);
+  if (ghosts && ghosts->GetNumberOfComponents() == 1)
+  {
+    inGhostLevels = ghosts->GetPointer(0);
+  }
+
+  // These methods are only thread safe once they have been called from a
+  // single thread, since they may build internal structures on first call.
+  double x[3];
+  input->GetPoint(0, x);
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
+  if (inputUG)
+  {
+    inputUG->IsPointVisible(0);
+  }
+
+  // Sampling is done once per dataset, as in the serial path.
+  this->Internals->ComputeVisiblePointsIfNeeded(index, input, cellCenters, this);
+
+  // Masking and selection of the points to glyph.
+  const int glyphMode = this->GlyphMode;
+  const int stride = this->Stride;
+  vtkInternals* internals = this->Internals;
+  std::vector<unsigned char> mask(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType inPtId = begin; inPtId < end; ++inPtId)
+    {
+      mask[inPtId] =
+        !(inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT) &&
+        !(inputUG && !inputUG->IsPointVisible(inPtId)) &&
+        internals->IsPointSelected(inPtId, glyphMode, stride);
+    }
+  });
+
+  this->UpdateProgress(0.25);
+  if (this->GetAbortExecute())
+  {
+    return true;
+  }
+
+  // Exclusive prefix sum of the per-point glyph counts. Since each glyph has
+  // the same number of points and cells, this gives the output location of
+  // every glyph.
+  std::vector<vtkIdType> glyphOffsets(numPts + 1);
+  glyphOffsets[0] = 0;
+  for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+  {
+    glyphOffsets[inPtId + 1] = glyphOffsets[inPtId] + mask[inPtId];
+  }
+  const vtkIdType numGlyphs = glyphOffsets[numPts];
+  const vtkIdType numOutPts = numGlyphs * numSourcePts;
+
+  // Preallocate output points, normals and point data.
+  newPts->SetNumberOfPoints(numOutPts);
+
+  vtkSmartPointer<vtkFloatArray> newNormals;
+  if (sourceNormals)
+  {
+    newNormals.TakeReference(vtkFloatArray::New());
+    newNormals->SetNumberOfComponents(3);
+    newNormals->SetNumberOfTuples(numOutPts);
+    newNormals->SetName("Normals");
+  }
+
+  outputPD->CopyAllocate(pd, numOutPts);
+  outputPD->SetNumberOfTuples(numOutPts);
+
+  // vtkDataSetAttributes::CopyData() is not thread safe, so pair input and
+  // output arrays by name and copy tuples directly. Unnamed arrays cannot be
+  // paired this way and are copied serially afterwards.
+  std::vector<std::pair<vtkAbstractArray*, vtkAbstractArray*> > pointDataArrays;
+  bool allArraysPaired = true;
+  for (int cc = 0; cc < outputPD->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* outArray = outputPD->GetAbstractArray(cc);
+    vtkAbstractArray* inArray =
+      outArray->GetName() ? pd->GetAbstractArray(outArray->GetName()) : nullptr;
+    if (inArray == nullptr)
+    {
+      allArraysPaired = false;
+      pointDataArrays.clear();
+      break;
+    }
+    pointDataArrays.push_back(std::make_pair(inArray, outArray));
+  }
+
+  // Preallocate output topology for each of the 4 polydata cell arrays.
+  vtkCellArray* sourceCells[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+    source->GetStrips() };
+  GlyphCellTemplate cellTemplates[4];
+  vtkNew<vtkCellArray> outputCells[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    GlyphCellTemplate& cells = cellTemplates[type];
+    vtkIdType nPts;
+    const vtkIdType* pts;
+    for (sourceCells[type]->InitTraversal(); sourceCells[type]->GetNextCell(nPts, pts);)
+    {
+      cells.Offsets.push_back(cells.GetConnectivitySize());
+      cells.Connectivity.insert(cells.Connectivity.end(), pts, pts + nPts);
+    }
+
+    // Use the default storage, as the serial path does.
+    vtkCellArray* cellArray = outputCells[type];
+    cellArray->ResizeExact(
+      numGlyphs * cells.GetNumberOfCells(), numGlyphs * cells.GetConnectivitySize());
+#ifdef VTK_USE_64BIT_IDS
+    cells.OutOffsets = cellArray->GetOffsetsArray64()->GetPointer(0);
+    cells.OutConnectivity = cellArray->GetConnectivityArray64()->GetPointer(0);
+#else
+    cells.OutOffsets = cellArray->GetOffsetsArray32()->GetPointer(0);
+    cells.OutConnectivity = cellArray->GetConnectivityArray32()->GetPointer(0);
+#endif
+    cells.OutOffsets[numGlyphs * cells.GetNumberOfCells()] =
+      numGlyphs * cells.GetConnectivitySize();
+  }
+
+  // Source points are transformed by SourceTransform once for all glyphs.
+  vtkSmartPointer<vtkPoints> glyphPts = sourcePts;
+  if (this->SourceTransform)
+  {
+    glyphPts = vtkSmartPointer<vtkPoints>::New();
+    glyphPts->SetDataTypeToDouble();
+    glyphPts->Allocate(numSourcePts);
+    this->SourceTransform->TransformPoints(sourcePts, glyphPts);
+  }
+
+  GlyphGenerator generator;
+  generator.Input = input;
+  generator.GlyphPoints = glyphPts;
+  generator.SourceNormals = sourceNormals;
+  generator.ScaleArray = scaleArray;
+  generator.OrientArray = orientArray;
+  generator.VectorScaleMode = this->VectorScaleMode;
+  generator.ScaleFactor = this->ScaleFactor;
+  generator.Mask = mask.data();
+  generator.GlyphOffsets = glyphOffsets.data();
+  generator.NumberOfSourcePoints = numSourcePts;
+  generator.OutPoints = newPts->GetData();
+  generator.OutNormals = newNormals;
+  generator.PointDataArrays = pointDataArrays;
+  generator.CellTemplates = cellTemplates;
+  vtkSMPTools::For(0, numPts, generator);
+
+  if (!allArraysPaired)
+  {
+    for (vtkIdType inPtId = 0; inPtId < numPts; ++inPtId)
+    {
+      for (vtkIdType i = 0; mask[inPtId] && i < numSourcePts; ++i)
+      {
+        outputPD->CopyData(pd, inPtId, glyphOffsets[inPtId] * numSourcePts + i);
+      }
+    }
+  }
+  this->UpdateProgress(1.0);
+
+  output->SetVerts(outputCells[0]);
+  output->SetLines(outputCells[1]);
+  output->SetPolys(outputCells[2]);
+  output->SetStrips(outputCells[3]);
+
+  if (newNormals.GetPointer())
+  {
+    outputPD->SetNormals(newNormals);
+  }
+
+  // In certain cases, we can have a left over processing array, remove it.
+  outputPD->RemoveArray(IDS_ARRAY_NAME.c_str());
+
+  output->SetPoints(newPts);
+  output->Squeeze();
+
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVGlyphFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1165,4 +1525,5 @@ void vtkPVGlyphFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Seed: " << this->Seed << endl;
   os << indent << "Stride: " << this->Stride << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "ParallelGlyphing: " << this->ParallelGlyphing << endl;
 }
@@ -54,6 +54,10 @@
  * In parallel and with composite dataset, this filter ensures that each piece
  * samples only a representative number of points.
  * Note that the grid will be tetrahedralized first.
+ *
+ * When \c ParallelGlyphing is enabled, masking, point selection and glyph
+ * generation are done using vtkSMPTools. The output is identical to the one
+ * produced by the serial code path.
 */
 
 #ifndef vtkPVGlyphFilter_h
@@ -63,6 +67,7 @@
 #include "vtkPolyDataAlgorithm.h"
 
 class vtkMultiProcessController;
+class vtkPoints;
 class vtkTransform;
 
 class VTKPVVTKEXTENSIONSDEFAULT_EXPORT vtkPVGlyphFilter : public vtkPolyDataAlgorithm
@@ -186,6 +191,20 @@ public:
   vtkGetMacro(MaximumNumberOfSamplePoints, int);
   //@}
 
+  //@{
+  /**
+   * Enable/disable the threaded implementation. When enabled, points to glyph
+   * are selected in parallel, the output is preallocated using a prefix sum of
+   * the per-point glyph sizes and transforms as well as point data are filled
+   * in using vtkSMPTools. Note that this code path does not call
+   * IsPointVisible() for each point, hence subclasses overriding it should
+   * leave this off. Default is false.
+   */
+  vtkSetMacro(ParallelGlyphing, bool);
+  vtkGetMacro(ParallelGlyphing, bool);
+  vtkBooleanMacro(ParallelGlyphing, bool);
+  //@}
+
   /**
    * Overridden to create output data of appropriate type.
    */
@@ -248,6 +267,14 @@ protected:
     bool cellCenters = false);
   //@}
 
+  /**
+   * Called by Execute() when ParallelGlyphing is enabled to generate the glyphs
+   * for all the points of \c input using vtkSMPTools.
+   */
+  bool ExecuteParallel(unsigned int index, vtkDataSet* input, vtkPolyData* source,
+    vtkPolyData* output, vtkPoints* newPts, vtkDataArray* scaleArray, vtkDataArray* orientArray,
+    bool cellCenters);
+
   int VectorScaleMode;
   vtkTransform* SourceTransform;
   double ScaleFactor;
@@ -257,6 +284,7 @@ protected:
   int Stride;
   vtkMultiProcessController* Controller;
   int OutputPointsPrecision;
+  bool ParallelGlyphing;
 
 private:
   vtkPVGlyphFilter(const vtkPVGlyphFilter&) = delete;
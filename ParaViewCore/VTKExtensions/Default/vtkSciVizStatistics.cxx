@@ -6,33 +6,93 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
 #include "vtkDataObject.h"
+#include "vtkDataObjectCollection.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStatisticsAlgorithm.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <sstream>
+#include <vector>
 
 vtkInformationKeyMacro(vtkSciVizStatistics, MULTIPLE_MODELS, Integer);
 
+namespace
+{
+// Fewer rows than this per block are not worth a thread of their own.
+const vtkIdType SCIVIZ_MIN_ROWS_PER_BLOCK = 4096;
+const int SCIVIZ_PARTIAL_MODEL_TAG = 28643;
+
+// Number of observations to train on out of \a N, see GetNumberOfObservationsForTraining().
+vtkIdType TrainingSize(vtkIdType N, double trainingFraction)
+{
+  vtkIdType M = static_cast<vtkIdType>(N * trainingFraction);
+  return M < 100 ? (N < 100 ? N : 100) : M;
+}
+
+// A uniform random number in (0, 1), for the logarithms of reservoir sampling.
+double RandomOpenUnit()
+{
+  double u = vtkMath::Random();
+  return u > 0. ? u : VTK_DBL_MIN;
+}
+
+// Names of the table columns holding each component of a multi-component array.
+std::vector<std::string> ComponentColumnNames(vtkAbstractArray* arr)
+{
+  int ncomp = arr->GetNumberOfComponents();
+
+  // Check component names can be used
+  std::set<std::string> compCheckSet;
+  bool useCompNames = true;
+  for (int i = 0; i < ncomp; ++i)
+  {
+    const char* compName = arr->GetComponentName(i);
+    if (!compName || compCheckSet.count(compName) > 0)
+    {
+      useCompNames = false;
+      break;
+    }
+    compCheckSet.emplace(compName);
+  }
+
+  std::vector<std::string> names;
+  for (int i = 0; i < ncomp; ++i)
+  {
+    std::ostringstream os;
+    os << arr->GetName() << "_";
+    useCompNames ? os << arr->GetComponentName(i) : os << i;
+    names.push_back(os.str());
+  }
+  return names;
+}
+}
+
 vtkSciVizStatistics::vtkSciVizStatistics()
 {
   this->P = new vtkSciVizStatisticsP;
   this->AttributeMode = vtkDataObject::POINT;
   this->TrainingFraction = 0.1;
   this->Task = MODEL_AND_ASSESS;
+  this->ThreadedLearning = false;
+  this->ReservoirSampling = false;
   this->SetNumberOfInputPorts(2);  // data + optional model
   this->SetNumberOfOutputPorts(2); // model + assessed input
 }
@@ -48,6 +108,8 @@ void vtkSciVizStatistics::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Task: " << this->Task << "\n";
   os << indent << "AttributeMode: " << this->AttributeMode << "\n";
   os << indent << "TrainingFraction: " << this->TrainingFraction << "\n";
+  os << indent << "ThreadedLearning: " << this->ThreadedLearning << "\n";
+  os << indent << "ReservoirSampling: " << this->ReservoirSampling << "\n";
 }
 
 int vtkSciVizStatistics::GetNumberOfAttributeArrays()
@@ -414,9 +476,15 @@ int vtkSciVizStatistics::RequestData(
     return 1;
   }
 
-  // Create a table with all the data
+  // Create a table with all the data, unless only a sample of it is needed
   vtkNew<vtkTable> inTable;
-  int stat = this->PrepareFullDataTable(inTable, dataAttrIn);
+  bool sampleTraining = this->ReservoirSampling &&
+    (this->Task == CREATE_MODEL || this->Task == MODEL_AND_ASSESS);
+  int stat = 1;
+  if (!sampleTraining || this->Task == MODEL_AND_ASSESS)
+  {
+    stat = this->PrepareFullDataTable(inTable, dataAttrIn);
+  }
   if (stat < 1)
   { // return an error (stat=0) or success (stat=-1)
     return -stat;
@@ -430,7 +498,16 @@ int vtkSciVizStatistics::RequestData(
     vtkSmartPointer<vtkTable> train = nullptr;
     vtkIdType N = inTable->GetNumberOfRows();
     vtkIdType M = this->Task == MODEL_INPUT ? N : this->GetNumberOfObservationsForTraining(inTable);
-    if (M == N)
+    if (sampleTraining)
+    {
+      train = vtkSmartPointer<vtkTable>::New();
+      stat = this->PrepareSampledTrainingTable(train, dataAttrIn);
+      if (stat < 1)
+      {
+        return -stat;
+      }
+    }
+    else if (M == N)
     {
       train = inTable;
       if (this->Task != MODEL_INPUT && this->TrainingFraction < 1.)
@@ -458,7 +535,8 @@ int vtkSciVizStatistics::RequestData(
     else
     {
       outModel->Initialize();
-      stat = this->LearnAndDerive(outModelDS, train);
+      stat = this->ThreadedLearning ? this->ThreadedLearnAndDerive(outModelDS, train)
+                                    : this->LearnAndDerive(outModelDS, train);
     }
   }
   else
@@ -514,31 +592,11 @@ int vtkSciVizStatistics::PrepareFullDataTable(vtkTable* inTable, vtkFieldData* d
         // Create a column in the table for each component of non-scalar arrays requested.
         // FIXME: Should we add a "norm" column when arr is a vtkDataArray? It would make sense.
         std::vector<vtkAbstractArray*> comps;
-        const char* compName;
-
-        // Check component names can be used
-        std::set<std::string> compCheckSet;
-        bool useCompNames = true;
-        for (int i = 0; i < ncomp; ++i)
-        {
-          compName = arr->GetComponentName(i);
-          if (!compName || compCheckSet.count(compName) > 0)
-          {
-            useCompNames = false;
-            break;
-          }
-          compCheckSet.emplace(compName);
-        }
-
+        std::vector<std::string> compNames = ComponentColumnNames(arr);
         for (int i = 0; i < ncomp; ++i)
         {
-          std::ostringstream os;
-          compName = arr->GetComponentName(i);
-          os << arr->GetName() << "_";
-          useCompNames ? os << compName : os << i;
-
           vtkAbstractArray* arrCol = vtkAbstractArray::CreateArray(arr->GetDataType());
-          arrCol->SetName(os.str().c_str());
+          arrCol->SetName(compNames[i].c_str());
           arrCol->SetNumberOfComponents(1);
           arrCol->SetNumberOfTuples(ntup);
           comps.push_back(arrCol);
@@ -647,11 +705,256 @@ int vtkSciVizStatistics::PrepareTrainingTable(
   return 1;
 }
 
+int vtkSciVizStatistics::ThreadedLearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData)
+{
+  vtkSmartPointer<vtkStatisticsAlgorithm> engine;
+  engine.TakeReference(this->NewSerialEngine(inData));
+  if (!engine)
+  {
+    return this->LearnAndDerive(model, inData);
+  }
+
+  // I. Learn a partial model of each block of rows on its own thread.
+  // Engines and their inputs are set up here so only Update() runs concurrently.
+  vtkIdType numRows = inData->GetNumberOfRows();
+  vtkIdType numBlocks = std::min(static_cast<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads()),
+    numRows / SCIVIZ_MIN_ROWS_PER_BLOCK);
+  numBlocks = std::max(numBlocks, static_cast<vtkIdType>(1));
+  std::vector<vtkSmartPointer<vtkTable> > blocks(numBlocks);
+  std::vector<vtkSmartPointer<vtkStatisticsAlgorithm> > learners(numBlocks);
+  for (vtkIdType b = 0; b < numBlocks; ++b)
+  {
+    blocks[b] = vtkSmartPointer<vtkTable>::New();
+    for (vtkIdType c = 0; c < inData->GetNumberOfColumns(); ++c)
+    {
+      vtkAbstractArray* srcCol = inData->GetColumn(c);
+      vtkAbstractArray* dstCol = srcCol->NewInstance();
+      dstCol->SetName(srcCol->GetName());
+      dstCol->SetNumberOfComponents(srcCol->GetNumberOfComponents());
+      blocks[b]->AddColumn(dstCol);
+      dstCol->FastDelete();
+    }
+    learners[b].TakeReference(this->NewSerialEngine(inData));
+    learners[b]->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, blocks[b]);
+    learners[b]->SetLearnOption(true);
+    learners[b]->SetDeriveOption(false);
+    learners[b]->SetAssessOption(false);
+  }
+
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType b = first; b < last; ++b)
+    {
+      vtkIdType begin = numRows * b / numBlocks;
+      vtkIdType end = numRows * (b + 1) / numBlocks;
+      for (vtkIdType c = 0; c < inData->GetNumberOfColumns(); ++c)
+      {
+        blocks[b]->GetColumn(c)->InsertTuples(0, end - begin, begin, inData->GetColumn(c));
+      }
+      learners[b]->Update();
+    }
+  });
+
+  // II. Aggregate the partial models of this process.
+  vtkNew<vtkMultiBlockDataSet> primary;
+  if (numBlocks == 1)
+  {
+    primary->ShallowCopy(learners[0]->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  }
+  else
+  {
+    vtkNew<vtkDataObjectCollection> partials;
+    for (vtkIdType b = 0; b < numBlocks; ++b)
+    {
+      partials->AddItem(learners[b]->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+    }
+    engine->Aggregate(partials, primary);
+  }
+  learners.clear();
+  blocks.clear();
+
+  // III. Aggregate the models of all processes holding observations on the first one,
+  // which then hands the result back to every process.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int hasRows = numRows > 0 ? 1 : 0;
+    if (controller->GetLocalProcessId() == 0)
+    {
+      vtkNew<vtkDataObjectCollection> partials;
+      if (hasRows)
+      {
+        partials->AddItem(primary);
+      }
+      for (int p = 1; p < controller->GetNumberOfProcesses(); ++p)
+      {
+        int remoteHasRows = 0;
+        controller->Receive(&remoteHasRows, 1, p, SCIVIZ_PARTIAL_MODEL_TAG);
+        if (remoteHasRows)
+        {
+          vtkDataObject* remote = controller->ReceiveDataObject(p, SCIVIZ_PARTIAL_MODEL_TAG);
+          partials->AddItem(remote);
+          remote->Delete();
+        }
+      }
+      if (partials->GetNumberOfItems() > 1)
+      {
+        vtkNew<vtkMultiBlockDataSet> global;
+        engine->Aggregate(partials, global);
+        primary->ShallowCopy(global);
+      }
+      else if (partials->GetNumberOfItems() == 1)
+      {
+        primary->ShallowCopy(partials->GetItem(0));
+      }
+    }
+    else
+    {
+      controller->Send(&hasRows, 1, 0, SCIVIZ_PARTIAL_MODEL_TAG);
+      if (hasRows)
+      {
+        controller->Send(primary.GetPointer(), 0, SCIVIZ_PARTIAL_MODEL_TAG);
+      }
+    }
+    controller->Broadcast(primary.GetPointer(), 0);
+  }
+
+  // IV. Derive the full model from the aggregated primary statistics.
+  engine->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, inData);
+  engine->SetInputData(vtkStatisticsAlgorithm::INPUT_MODEL, primary);
+  engine->SetLearnOption(false);
+  engine->SetDeriveOption(true);
+  engine->SetAssessOption(false);
+  engine->Update();
+
+  model->ShallowCopy(engine->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL));
+  return 1;
+}
+
+vtkStatisticsAlgorithm* vtkSciVizStatistics::NewSerialEngine(vtkTable* vtkNotUsed(inData))
+{
+  return nullptr;
+}
+
+int vtkSciVizStatistics::PrepareSampledTrainingTable(
+  vtkTable* trainingTable, vtkFieldData* dataAttrIn)
+{
+  std::vector<vtkAbstractArray*> arrays;
+  std::set<vtkStdString>::iterator colIt;
+  for (colIt = this->P->Buffer.begin(); colIt != this->P->Buffer.end(); ++colIt)
+  {
+    vtkAbstractArray* arr = dataAttrIn->GetAbstractArray(colIt->c_str());
+    if (arr)
+    {
+      arrays.push_back(arr);
+    }
+  }
+  if (arrays.empty())
+  {
+    vtkWarningMacro("Every requested array wasn't a scalar or wasn't present.");
+    return -1;
+  }
+
+  // I. Size the sample from all observations and take this process' share of it:
+  // the processes before this one hold observations [offset, offset + N) of the total.
+  vtkIdType N = arrays[0]->GetNumberOfTuples();
+  vtkIdType offset = 0;
+  vtkIdType total = N;
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    std::vector<vtkIdType> counts(controller->GetNumberOfProcesses());
+    controller->AllGather(&N, &counts[0], 1);
+    total = 0;
+    for (int p = 0; p < controller->GetNumberOfProcesses(); ++p)
+    {
+      offset += p < controller->GetLocalProcessId() ? counts[p] : 0;
+      total += counts[p];
+    }
+  }
+  vtkIdType M = 0;
+  if (total > 0)
+  {
+    double scale = static_cast<double>(TrainingSize(total, this->TrainingFraction)) / total;
+    M = static_cast<vtkIdType>(std::floor(scale * (offset + N))) -
+      static_cast<vtkIdType>(std::floor(scale * offset));
+    M = std::min(std::max(M, static_cast<vtkIdType>(0)), N);
+  }
+
+  // II. Draw M of the N rows in one pass (Li's algorithm L), which skips ahead between
+  // replacements instead of drawing a random number for every row.
+  vtkNew<vtkIdList> rows;
+  rows->SetNumberOfIds(M);
+  for (vtkIdType i = 0; i < M; ++i)
+  {
+    rows->SetId(i, i);
+  }
+  if (M > 0 && M < N)
+  {
+    double w = std::exp(std::log(RandomOpenUnit()) / M);
+    vtkIdType i = M - 1;
+    while (true)
+    {
+      double skip = std::floor(std::log(RandomOpenUnit()) / std::log1p(-w));
+      if (skip >= static_cast<double>(N - i - 1))
+      {
+        break;
+      }
+      i += static_cast<vtkIdType>(skip) + 1;
+      vtkIdType slot = std::min(static_cast<vtkIdType>(vtkMath::Random() * M), M - 1);
+      rows->SetId(slot, i);
+      w *= std::exp(std::log(RandomOpenUnit()) / M);
+    }
+    std::sort(rows->GetPointer(0), rows->GetPointer(0) + M);
+  }
+
+  // III. Copy the sampled rows, splitting multi-component arrays as PrepareFullDataTable does.
+  trainingTable->Initialize();
+  for (size_t a = 0; a < arrays.size(); ++a)
+  {
+    vtkAbstractArray* arr = arrays[a];
+    int ncomp = arr->GetNumberOfComponents();
+    if (ncomp == 1)
+    {
+      vtkAbstractArray* col = arr->NewInstance();
+      col->SetName(arr->GetName());
+      col->SetNumberOfComponents(1);
+      col->SetNumberOfTuples(M);
+      arr->GetTuples(rows, col);
+      trainingTable->AddColumn(col);
+      col->FastDelete();
+      continue;
+    }
+
+    std::vector<std::string> names = ComponentColumnNames(arr);
+    vtkDataArray* darr = vtkDataArray::SafeDownCast(arr);
+    for (int c = 0; c < ncomp; ++c)
+    {
+      vtkAbstractArray* col = vtkAbstractArray::CreateArray(arr->GetDataType());
+      col->SetName(names[c].c_str());
+      col->SetNumberOfComponents(1);
+      col->SetNumberOfTuples(M);
+      vtkDataArray* dcol = vtkDataArray::SafeDownCast(col);
+      for (vtkIdType i = 0; i < M; ++i)
+      {
+        if (darr && dcol)
+        {
+          dcol->SetComponent(i, 0, darr->GetComponent(rows->GetId(i), c));
+        }
+        else
+        {
+          col->SetVariantValue(i, arr->GetVariantValue(rows->GetId(i) * ncomp + c));
+        }
+      }
+      trainingTable->AddColumn(col);
+      col->FastDelete();
+    }
+  }
+  return 1;
+}
+
 vtkIdType vtkSciVizStatistics::GetNumberOfObservationsForTraining(vtkTable* observations)
 {
-  vtkIdType N = observations->GetNumberOfRows();
-  vtkIdType M = static_cast<vtkIdType>(N * this->TrainingFraction);
-  return M < 100 ? (N < 100 ? N : 100) : M;
+  return TrainingSize(observations->GetNumberOfRows(), this->TrainingFraction);
 }
 
 void vtkSciVizStatistics::ShallowCopy(vtkDataObject* out, vtkDataObject* in)
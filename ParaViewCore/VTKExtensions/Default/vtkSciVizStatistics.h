@@ -104,6 +104,35 @@ public:
   vtkGetMacro(TrainingFraction, double);
   //@}
 
+  //@{
+  /**
+   * Set/get whether training data is drawn by reservoir sampling.
+   * When on and the task trains on a random subset, the training table is filled in a single
+   * pass over the selected arrays with memory proportional to the sample size, and the table
+   * of all observations is only built when the task also assesses the input.
+   * The sample size follows \a TrainingFraction applied to the observations of all processes
+   * and is spread across processes in proportion to their number of observations.
+   * The default is off.
+   */
+  vtkSetMacro(ReservoirSampling, bool);
+  vtkGetMacro(ReservoirSampling, bool);
+  vtkBooleanMacro(ReservoirSampling, bool);
+  //@}
+
+  //@{
+  /**
+   * Set/get whether the model is learned on several threads.
+   * When on, the training table is split into blocks of rows whose partial models are
+   * learned concurrently with vtkSMPTools and aggregated, first within each process and
+   * then across processes, before the model is derived.
+   * Filters whose statistics engine cannot aggregate models learn serially.
+   * The default is off.
+   */
+  vtkSetMacro(ThreadedLearning, bool);
+  vtkGetMacro(ThreadedLearning, bool);
+  vtkBooleanMacro(ThreadedLearning, bool);
+  //@}
+
   /**\brief Possible tasks the filter can perform.
     *
     * The MODEL_AND_ASSESS task is not recommended;
@@ -162,6 +191,13 @@ protected:
   virtual int PrepareTrainingTable(
     vtkTable* trainingTable, vtkTable* fullDataTable, vtkIdType numObservations);
 
+  /**
+   * Fill \a trainingTable with a reservoir sample of the selected arrays of \a dataAttrIn,
+   * sized and spread across processes as described for \a ReservoirSampling.
+   * Returns 1 on success, 0 on error and -1 when no selected array is present.
+   */
+  virtual int PrepareSampledTrainingTable(vtkTable* trainingTable, vtkFieldData* dataAttrIn);
+
   /**
    * Method subclasses <b>must</b> override to calculate a full model from the given input data.
    * The model should be placed on the first output port of the passed vtkInformationVector
@@ -169,6 +205,24 @@ protected:
    */
   virtual int LearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData) = 0;
 
+  /**
+   * Calculate a full model like LearnAndDerive() using several threads.
+   * This is called instead of LearnAndDerive() when \a ThreadedLearning is on.
+   * The default implementation learns a partial model of each block of rows with the
+   * engine returned by NewSerialEngine(), aggregates the partial models within this process
+   * and then across processes, and derives the aggregate.
+   * It falls back to LearnAndDerive() when NewSerialEngine() returns nullptr.
+   */
+  virtual int ThreadedLearnAndDerive(vtkMultiBlockDataSet* model, vtkTable* inData);
+
+  /**
+   * Subclasses <b>may</b> override this function to return a new, serial statistics engine
+   * whose models can be aggregated, with the columns of \a inData selected.
+   * The caller owns the returned engine.
+   * By default, it returns nullptr so that threaded learning falls back to LearnAndDerive().
+   */
+  virtual vtkStatisticsAlgorithm* NewSerialEngine(vtkTable* inData);
+
   /**
    * Method subclasses <b>must</b> override to assess an input table given a model of the proper
    type.
@@ -209,6 +263,8 @@ protected:
   int AttributeMode;
   int Task;
   double TrainingFraction;
+  bool ThreadedLearning;
+  bool ReservoirSampling;
   vtkSciVizStatisticsP* P;
 
 private:
@@ -0,0 +1,222 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestOrderedCompositeDistributorIncremental.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the Incremental mode of vtkOrderedCompositeDistributor on several
+// processes. After the first full redistribution, modified point and cell
+// arrays are moved using the recorded map while the redistributed geometry is
+// reused. The output must match a full redistribution of the same input, also
+// when only some of the processes modified their arrays and after the points
+// changed.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkKdTreeManager.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreateInput(int rank, int numProcs)
+{
+  // each process holds a slice of a sphere.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(16 * numProcs);
+  sphere->SetPhiResolution(16);
+  sphere->SetStartTheta(360.0 * rank / numProcs);
+  sphere->SetEndTheta(360.0 * (rank + 1) / numProcs);
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> input = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> pointValues;
+  pointValues->SetName("PointValues");
+  pointValues->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+  {
+    pointValues->SetValue(cc, rank * 1000 + cc);
+  }
+  input->GetPointData()->AddArray(pointValues);
+
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfCells(); ++cc)
+  {
+    cellValues->SetValue(cc, rank * 1000 + static_cast<int>(cc));
+  }
+  input->GetCellData()->AddArray(cellValues);
+  return input;
+}
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int kk = 0; kk < a->GetNumberOfComponents(); ++kk)
+    {
+      if (a->GetComponent(cc, kk) != b->GetComponent(cc, kk))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* output, vtkPolyData* expected)
+{
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    return false;
+  }
+  if (expected->GetNumberOfPoints() == 0)
+  {
+    return true;
+  }
+  return SameArray(output->GetPoints()->GetData(), expected->GetPoints()->GetData()) &&
+    SameArray(output->GetPolys()->GetData(), expected->GetPolys()->GetData()) &&
+    SameArray(output->GetPointData()->GetArray("PointValues"),
+      expected->GetPointData()->GetArray("PointValues")) &&
+    SameArray(output->GetCellData()->GetArray("CellValues"),
+      expected->GetCellData()->GetArray("CellValues"));
+}
+
+// Compares the output of the incremental distributor to a full
+// redistribution of the same input. `reused` tells whether the redistributed
+// points of the previous update, kept in `lastPoints`, are expected to be
+// reused.
+bool CheckStep(vtkMultiProcessController* contr, vtkOrderedCompositeDistributor* incremental,
+  vtkPolyData* input, vtkPKdTree* kdTree, const char* step,
+  vtkSmartPointer<vtkDataArray>& lastPoints, bool reused)
+{
+  incremental->Modified();
+  incremental->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(incremental->GetOutputDataObject(0));
+
+  vtkNew<vtkOrderedCompositeDistributor> full;
+  full->SetController(contr);
+  full->SetPKdTree(kdTree);
+  full->SetBoundaryMode(vtkOrderedCompositeDistributor::ASSIGN_TO_ALL_INTERSECTING_REGIONS);
+  full->SetInputData(input);
+  full->Update();
+  vtkPolyData* expected = vtkPolyData::SafeDownCast(full->GetOutputDataObject(0));
+
+  vtkDataArray* points = output && output->GetPoints() ? output->GetPoints()->GetData() : nullptr;
+  int valid = output && expected && SameOutput(output, expected) ? 1 : 0;
+  if (valid && output->GetNumberOfPoints() > 0 && (points == lastPoints) != reused)
+  {
+    cerr << "ERROR: rank " << contr->GetLocalProcessId() << ", " << step << ": the points were"
+         << (reused ? " not" : "") << " reused." << endl;
+    valid = 0;
+  }
+  lastPoints = points;
+
+  int allValid = 0;
+  contr->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+  if (!allValid && contr->GetLocalProcessId() == 0)
+  {
+    cerr << "ERROR: " << step << ": the incremental output differs from a full redistribution."
+         << endl;
+  }
+  return allValid == 1;
+}
+}
+
+int TestOrderedCompositeDistributorIncremental(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int rank = contr->GetLocalProcessId();
+  vtkSmartPointer<vtkPolyData> input = CreateInput(rank, contr->GetNumberOfProcesses());
+
+  vtkNew<vtkKdTreeManager> cutsGenerator;
+  cutsGenerator->AddDataObject(input);
+  cutsGenerator->GenerateKdTree();
+  vtkPKdTree* kdTree = cutsGenerator->GetKdTree();
+
+  // boundary cells are duplicated, so that every redistributed point is a
+  // copy of an input point and point arrays can be moved incrementally.
+  vtkNew<vtkOrderedCompositeDistributor> incremental;
+  incremental->SetController(contr);
+  incremental->SetPKdTree(kdTree);
+  incremental->SetBoundaryMode(vtkOrderedCompositeDistributor::ASSIGN_TO_ALL_INTERSECTING_REGIONS);
+  incremental->SetIncremental(true);
+  incremental->SetInputData(input);
+
+  vtkSmartPointer<vtkDataArray> lastPoints;
+  bool success = CheckStep(contr, incremental, input, kdTree, "first update", lastPoints, false);
+
+  // modify the point array on all processes.
+  vtkDataArray* pointValues = input->GetPointData()->GetArray("PointValues");
+  for (vtkIdType cc = 0; cc < pointValues->GetNumberOfTuples(); ++cc)
+  {
+    pointValues->SetComponent(cc, 0, -pointValues->GetComponent(cc, 0));
+  }
+  pointValues->Modified();
+  success = success &&
+    CheckStep(contr, incremental, input, kdTree, "point array update", lastPoints, true);
+
+  // modify the cell array on the first process only.
+  if (rank == 0)
+  {
+    vtkDataArray* cellValues = input->GetCellData()->GetArray("CellValues");
+    for (vtkIdType cc = 0; cc < cellValues->GetNumberOfTuples(); ++cc)
+    {
+      cellValues->SetComponent(cc, 0, 7 * cc);
+    }
+    cellValues->Modified();
+  }
+  success = success &&
+    CheckStep(contr, incremental, input, kdTree, "cell array update", lastPoints, true);
+
+  // an update with nothing modified moves nothing.
+  success =
+    success && CheckStep(contr, incremental, input, kdTree, "no update", lastPoints, true);
+
+  // moving the points requires a full redistribution.
+  vtkPoints* points = input->GetPoints();
+  for (vtkIdType cc = 0; cc < points->GetNumberOfPoints(); ++cc)
+  {
+    double pt[3];
+    points->GetPoint(cc, pt);
+    pt[2] += 0.01;
+    points->SetPoint(cc, pt);
+  }
+  points->Modified();
+  success =
+    success && CheckStep(contr, incremental, input, kdTree, "geometry update", lastPoints, false);
+
+  input = nullptr;
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSortedTableStreamerMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the SampleSort mode of vtkSortedTableStreamer on several processes.
+// Every process holds a different number of rows. Each block of the sorted
+// table is compared to the order obtained by gathering all the keys, for
+// 64 bit integer keys that a double can not tell apart, unsigned keys and
+// double keys with many duplicates.
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkTypeUInt64Array.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+const int BlockSize = 17;
+
+vtkTable* CreateTable(int rank)
+{
+  const int numRows = 50 + 7 * rank;
+  vtkNew<vtkTypeInt64Array> int64Keys;
+  int64Keys->SetName("Int64");
+  vtkNew<vtkTypeUInt64Array> uint64Keys;
+  uint64Keys->SetName("UInt64");
+  vtkNew<vtkDoubleArray> doubleKeys;
+  doubleKeys->SetName("Double");
+  vtkNew<vtkIntArray> pids;
+  pids->SetName("Rank");
+  vtkNew<vtkIntArray> rows;
+  rows->SetName("Row");
+  for (int i = 0; i < numRows; ++i)
+  {
+    // consecutive values above 2^53 that map to the same double.
+    const int offset = (i * 37 + rank * 11) % 97;
+    int64Keys->InsertNextValue((static_cast<vtkTypeInt64>(1) << 60) - 48 + offset);
+    uint64Keys->InsertNextValue((static_cast<vtkTypeUInt64>(1) << 63) + offset);
+    doubleKeys->InsertNextValue((i * 13 + rank) % 10);
+    pids->InsertNextValue(rank);
+    rows->InsertNextValue(i);
+  }
+
+  vtkTable* table = vtkTable::New();
+  table->AddColumn(int64Keys);
+  table->AddColumn(uint64Keys);
+  table->AddColumn(doubleKeys);
+  table->AddColumn(pids);
+  table->AddColumn(rows);
+  return table;
+}
+
+// Sort the (key, rank, row) triplets of all processes.
+template <typename KeyT>
+std::vector<std::tuple<KeyT, int, int> > GetExpectedOrder(
+  vtkMultiProcessController* contr, const KeyT* keys, vtkIdType numRows, bool invert)
+{
+  const int numProcs = contr->GetNumberOfProcesses();
+  std::vector<vtkIdType> counts(numProcs);
+  std::vector<vtkIdType> offsets(numProcs);
+  contr->AllGather(&numRows, &counts[0], 1);
+  vtkIdType total = 0;
+  for (int p = 0; p < numProcs; ++p)
+  {
+    offsets[p] = total;
+    total += counts[p];
+  }
+  std::vector<KeyT> allKeys(total);
+  contr->AllGatherV(keys, &allKeys[0], numRows, &counts[0], &offsets[0]);
+
+  std::vector<std::tuple<KeyT, int, int> > order;
+  for (int p = 0; p < numProcs; ++p)
+  {
+    for (vtkIdType i = 0; i < counts[p]; ++i)
+    {
+      order.push_back(std::make_tuple(allKeys[offsets[p] + i], p, static_cast<int>(i)));
+    }
+  }
+  std::sort(order.begin(), order.end());
+  if (invert)
+  {
+    std::reverse(order.begin(), order.end());
+  }
+  return order;
+}
+
+template <typename ArrayT>
+bool TestSampleSort(vtkMultiProcessController* contr, vtkTable* input, const char* column)
+{
+  typedef typename ArrayT::ValueType KeyT;
+  const int rank = contr->GetLocalProcessId();
+  ArrayT* keys = ArrayT::SafeDownCast(input->GetColumnByName(column));
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(contr);
+  streamer->SetInputData(input);
+  streamer->SetColumnNameToSort(column);
+  streamer->SetSelectedComponent(0);
+  streamer->SetBlockSize(BlockSize);
+  streamer->SampleSortOn();
+
+  for (int invert = 0; invert < 2; ++invert)
+  {
+    const auto expected =
+      GetExpectedOrder(contr, keys->GetPointer(0), keys->GetNumberOfTuples(), invert != 0);
+    const vtkIdType total = static_cast<vtkIdType>(expected.size());
+    streamer->SetInvertOrder(invert);
+    for (vtkIdType block = 0; block * BlockSize < total; ++block)
+    {
+      streamer->SetBlock(block);
+      streamer->Update();
+
+      // Only the process that merged the block has rows.
+      vtkTable* output = streamer->GetOutput();
+      int valid = 1;
+      vtkIdType numRows = output->GetNumberOfRows();
+      if (numRows > 0)
+      {
+        ArrayT* outKeys = ArrayT::SafeDownCast(output->GetColumnByName(column));
+        vtkIntArray* outPids = vtkIntArray::SafeDownCast(output->GetColumnByName("Rank"));
+        vtkIntArray* outRows = vtkIntArray::SafeDownCast(output->GetColumnByName("Row"));
+        valid = outKeys && outPids && outRows &&
+          numRows == std::min<vtkIdType>(BlockSize, total - block * BlockSize);
+        for (vtkIdType i = 0; valid && i < numRows; ++i)
+        {
+          const auto& row = expected[block * BlockSize + i];
+          valid = outKeys->GetValue(i) == std::get<0>(row) &&
+            outPids->GetValue(i) == std::get<1>(row) && outRows->GetValue(i) == std::get<2>(row);
+          if (!valid)
+          {
+            cerr << "ERROR: rank " << rank << ", column " << column << ", invert " << invert
+                 << ", block " << block << ": unexpected row " << i << endl;
+          }
+        }
+      }
+
+      int allValid = 0;
+      vtkIdType allRows = 0;
+      contr->AllReduce(&valid, &allValid, 1, vtkCommunicator::MIN_OP);
+      contr->AllReduce(&numRows, &allRows, 1, vtkCommunicator::SUM_OP);
+      if (!allValid || allRows != std::min<vtkIdType>(BlockSize, total - block * BlockSize))
+      {
+        if (rank == 0)
+        {
+          cerr << "ERROR: column " << column << ", invert " << invert << ", block " << block
+               << " has " << allRows << " rows." << endl;
+        }
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestSortedTableStreamerMPI(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  vtkTable* input = CreateTable(contr->GetLocalProcessId());
+  bool success = TestSampleSort<vtkTypeInt64Array>(contr, input, "Int64") &&
+    TestSampleSort<vtkTypeUInt64Array>(contr, input, "UInt64") &&
+    TestSampleSort<vtkDoubleArray>(contr, input, "Double");
+  input->Delete();
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
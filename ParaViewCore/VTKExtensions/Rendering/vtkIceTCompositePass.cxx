@@ -30,6 +30,7 @@
 #include "vtkOpenGLRenderUtilities.h"
 #include "vtkOpenGLRenderWindow.h"
 #include "vtkOpenGLState.h"
+#include "vtkPVEventTracer.h"
 #include "vtkPVLogger.h"
 #include "vtkPartitionOrderingInterface.h"
 #include "vtkPixelBufferObject.h"
@@ -362,6 +363,7 @@ void vtkIceTCompositePass::CleanupContext(const vtkRenderState*)
 //----------------------------------------------------------------------------
 void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
 {
+  vtkPVEventTracerScope traceScope("vtkIceTCompositePass::Render", "compositing");
   vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: Render", vtkLogIdentifier(this));
   vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass::Render Start");
   this->IceTContext->SetController(this->Controller);
@@ -26,8 +26,17 @@
 
 #include "vtkBSPCuts.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -35,8 +44,23 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
 
 #if VTK_MODULE_ENABLE_VTK_FiltersParallelMPI
 #include "vtkDistributedDataFilter.h"
@@ -55,7 +79,599 @@ static void D3UpdateProgress(vtkObject* _D3, unsigned long, void* _distributor,
 }
 #endif
 //-----------------------------------------------------------------------------
+namespace
+{
+const char* SOURCE_RANK_ARRAY_NAME = "vtkOCDSourceRank";
+const char* SOURCE_ID_ARRAY_NAME = "vtkOCDSourceId";
+const char* SOURCE_ID_SQUARED_ARRAY_NAME = "vtkOCDSourceIdSquared";
+
+// Source point ids are tagged as doubles, along with their square, so that
+// points interpolated when splitting cells can be told apart from copies.
+// Beyond this, the squares are no longer exact.
+const vtkIdType MAX_TAGGED_POINT_ID = static_cast<vtkIdType>(1) << 26;
+
+const vtkTypeUInt64 HASH_OFFSET = 14695981039346656037ULL;
+const vtkTypeUInt64 HASH_PRIME = 1099511628211ULL;
+
+// FNV-1a, on 64-bit words followed by the remaining bytes.
+vtkTypeUInt64 HashBytes(const void* data, size_t size, vtkTypeUInt64 hash)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  size_t cc = 0;
+  for (; cc + sizeof(vtkTypeUInt64) <= size; cc += sizeof(vtkTypeUInt64))
+  {
+    vtkTypeUInt64 word;
+    memcpy(&word, bytes + cc, sizeof(word));
+    hash = (hash ^ word) * HASH_PRIME;
+  }
+  for (; cc < size; ++cc)
+  {
+    hash = (hash ^ bytes[cc]) * HASH_PRIME;
+  }
+  return hash;
+}
+
+vtkTypeUInt64 HashArray(vtkAbstractArray* array, vtkTypeUInt64 hash)
+{
+  if (array == nullptr)
+  {
+    return hash * HASH_PRIME;
+  }
+  const vtkTypeUInt64 header[3] = { static_cast<vtkTypeUInt64>(array->GetDataType()),
+    static_cast<vtkTypeUInt64>(array->GetNumberOfComponents()),
+    static_cast<vtkTypeUInt64>(array->GetNumberOfTuples()) };
+  hash = HashBytes(header, sizeof(header), hash);
+  if (vtkDataArray::SafeDownCast(array))
+  {
+    return HashBytes(array->GetVoidPointer(0),
+      static_cast<size_t>(array->GetNumberOfValues()) * array->GetDataTypeSize(), hash);
+  }
+  // other arrays are always regenerated along with their values.
+  const vtkTypeUInt64 mtime = array->GetMTime();
+  return HashBytes(&mtime, sizeof(mtime), hash);
+}
+
+// Hashes the address and modification time of an array, without looking at
+// its values.
+vtkTypeUInt64 StampArray(vtkAbstractArray* array, vtkTypeUInt64 hash)
+{
+  const vtkTypeUInt64 stamp[2] = { static_cast<vtkTypeUInt64>(reinterpret_cast<uintptr_t>(array)),
+    static_cast<vtkTypeUInt64>(array ? array->GetMTime() : 0) };
+  return HashBytes(stamp, sizeof(stamp), hash);
+}
+
+template <typename HashFunctor>
+vtkTypeUInt64 HashGeometry(vtkDataObject* dobj, vtkTypeUInt64 hash, HashFunctor hashArray)
+{
+  if (auto pd = vtkPolyData::SafeDownCast(dobj))
+  {
+    hash = hashArray(pd->GetPoints() ? pd->GetPoints()->GetData() : nullptr, hash);
+    hash = hashArray(pd->GetVerts()->GetData(), hash);
+    hash = hashArray(pd->GetLines()->GetData(), hash);
+    hash = hashArray(pd->GetPolys()->GetData(), hash);
+    hash = hashArray(pd->GetStrips()->GetData(), hash);
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(dobj))
+  {
+    hash = hashArray(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr, hash);
+    hash = hashArray(ug->GetCells() ? ug->GetCells()->GetData() : nullptr, hash);
+    hash = hashArray(ug->GetCellTypesArray(), hash);
+    hash = hashArray(ug->GetFaces(), hash);
+  }
+  else if (dobj)
+  {
+    // other types are not redistributed incrementally.
+    const vtkTypeUInt64 mtime = dobj->GetMTime();
+    hash = HashBytes(&mtime, sizeof(mtime), hash);
+  }
+  return hash;
+}
+
+template <typename HashFunctor>
+vtkTypeUInt64 HashDataObject(vtkDataObject* dobj, HashFunctor hashArray)
+{
+  vtkTypeUInt64 hash = HASH_OFFSET;
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      const vtkTypeUInt64 index = iter->GetCurrentFlatIndex();
+      hash = HashBytes(&index, sizeof(index), hash);
+      hash = HashGeometry(iter->GetCurrentDataObject(), hash, hashArray);
+    }
+    return hash;
+  }
+  return HashGeometry(dobj, hash, hashArray);
+}
+
+// Content hash of an array, along with the stamp it was computed for.
+struct vtkArrayHash
+{
+  vtkTypeUInt64 Stamp;
+  vtkTypeUInt64 Value;
+};
+typedef std::map<std::string, vtkArrayHash> vtkArrayHashes;
+
+// Hashes all arrays by name. The values of an array are only hashed again
+// when its stamp differs from the one in `previous`. Returns false if an
+// array has no name or a duplicate name, since such arrays cannot be matched
+// in the output.
+bool HashArrays(vtkFieldData* fd, const vtkArrayHashes& previous, vtkArrayHashes& hashes)
+{
+  hashes.clear();
+  for (int cc = 0; cc < fd->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* array = fd->GetAbstractArray(cc);
+    if (array->GetName() == nullptr)
+    {
+      return false;
+    }
+    vtkArrayHash hash;
+    hash.Stamp = StampArray(array, HASH_OFFSET);
+    auto iter = previous.find(array->GetName());
+    hash.Value = iter != previous.end() && iter->second.Stamp == hash.Stamp
+      ? iter->second.Value
+      : HashArray(array, HASH_OFFSET);
+    if (!hashes.insert(std::make_pair(array->GetName(), hash)).second)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HaveSameArrays(const vtkArrayHashes& a, const vtkArrayHashes& b)
+{
+  return a.size() == b.size() &&
+    std::equal(a.begin(), a.end(), b.begin(),
+      [](const vtkArrayHashes::value_type& x, const vtkArrayHashes::value_type& y) {
+        return x.first == y.first;
+      });
+}
+
+std::vector<std::string> GetModifiedArrays(
+  const vtkArrayHashes& current, const vtkArrayHashes& previous)
+{
+  std::vector<std::string> names;
+  for (const auto& pair : current)
+  {
+    auto iter = previous.find(pair.first);
+    if (iter == previous.end() || iter->second.Value != pair.second.Value)
+    {
+      names.push_back(pair.first);
+    }
+  }
+  return names;
+}
+
+// Gathers variable length buffers from all ranks on `root`. On `root`,
+// `offsets` has one entry per rank followed by the total length.
+template <typename T>
+void GatherBuffers(vtkMultiProcessController* controller, const T* data, vtkIdType length,
+  int root, std::vector<T>& received, std::vector<vtkIdType>& offsets)
+{
+  const bool isRoot = controller->GetLocalProcessId() == root;
+  const int numProcs = controller->GetNumberOfProcesses();
+  std::vector<vtkIdType> lengths(isRoot ? numProcs : 0);
+  controller->Gather(&length, lengths.data(), 1, root);
+  offsets.assign(isRoot ? numProcs + 1 : 0, 0);
+  if (isRoot)
+  {
+    std::partial_sum(lengths.begin(), lengths.end(), offsets.begin() + 1);
+  }
+  received.resize(isRoot ? offsets.back() : 0);
+  controller->GatherV(data, received.data(), length, lengths.data(), offsets.data(), root);
+}
+}
+
+//-----------------------------------------------------------------------------
+class vtkOrderedCompositeDistributor::vtkInternals
+{
+public:
+  // State of the last full redistribution.
+  bool Valid = false;
+  bool PointMapValid = false;
+  int DataObjectType = -1;
+  int BoundaryMode = -1;
+  vtkTypeUInt64 GeometryHash = 0;
+  vtkTypeUInt64 GeometryStamp = 0;
+  vtkWeakPointer<vtkPKdTree> KdTree;
+  vtkMTimeType KdTreeTime = 0;
+  vtkArrayHashes PointArrayHashes;
+  vtkArrayHashes CellArrayHashes;
+  vtkSmartPointer<vtkDataSet> Output;
+
+  // Ids of the input points and cells to send to each rank, in the order
+  // that rank expects them.
+  std::vector<vtkSmartPointer<vtkIdList> > SendPointIds;
+  std::vector<vtkSmartPointer<vtkIdList> > SendCellIds;
+
+  // Output indices of the points and cells received from each rank.
+  std::vector<vtkSmartPointer<vtkIdList> > RecvPointIds;
+  std::vector<vtkSmartPointer<vtkIdList> > RecvCellIds;
+
+  void Reset()
+  {
+    this->Valid = false;
+    this->Output = nullptr;
+    this->SendPointIds.clear();
+    this->SendCellIds.clear();
+    this->RecvPointIds.clear();
+    this->RecvCellIds.clear();
+  }
+
+  static void ResetIdLists(std::vector<vtkSmartPointer<vtkIdList> >& lists, int size)
+  {
+    lists.resize(size);
+    for (auto& list : lists)
+    {
+      list = vtkSmartPointer<vtkIdList>::New();
+    }
+  }
+
+  /**
+   * Returns a shallow copy of the input with the source rank and index of
+   * every point and cell attached as arrays.
+   */
+  vtkSmartPointer<vtkDataSet> NewTaggedInput(vtkDataSet* input, int rank)
+  {
+    vtkSmartPointer<vtkDataSet> tagged;
+    tagged.TakeReference(input->NewInstance());
+    tagged->ShallowCopy(input);
+
+    const vtkIdType numPoints = input->GetNumberOfPoints();
+    vtkNew<vtkDoubleArray> pointRanks;
+    vtkNew<vtkDoubleArray> pointIds;
+    vtkNew<vtkDoubleArray> pointIdsSquared;
+    pointRanks->SetName(SOURCE_RANK_ARRAY_NAME);
+    pointIds->SetName(SOURCE_ID_ARRAY_NAME);
+    pointIdsSquared->SetName(SOURCE_ID_SQUARED_ARRAY_NAME);
+    pointRanks->SetNumberOfTuples(numPoints);
+    pointIds->SetNumberOfTuples(numPoints);
+    pointIdsSquared->SetNumberOfTuples(numPoints);
+    for (vtkIdType cc = 0; cc < numPoints; ++cc)
+    {
+      const double id = static_cast<double>(cc);
+      pointRanks->SetValue(cc, rank);
+      pointIds->SetValue(cc, id);
+      pointIdsSquared->SetValue(cc, id * id);
+    }
+    tagged->GetPointData()->AddArray(pointRanks);
+    tagged->GetPointData()->AddArray(pointIds);
+    tagged->GetPointData()->AddArray(pointIdsSquared);
+
+    const vtkIdType numCells = input->GetNumberOfCells();
+    vtkNew<vtkIdTypeArray> cellRanks;
+    vtkNew<vtkIdTypeArray> cellIds;
+    cellRanks->SetName(SOURCE_RANK_ARRAY_NAME);
+    cellIds->SetName(SOURCE_ID_ARRAY_NAME);
+    cellRanks->SetNumberOfTuples(numCells);
+    cellIds->SetNumberOfTuples(numCells);
+    for (vtkIdType cc = 0; cc < numCells; ++cc)
+    {
+      cellRanks->SetValue(cc, rank);
+      cellIds->SetValue(cc, cc);
+    }
+    tagged->GetCellData()->AddArray(cellRanks);
+    tagged->GetCellData()->AddArray(cellIds);
+    return tagged;
+  }
+
+  /**
+   * Called on all ranks after a full redistribution of a tagged input.
+   * Removes the tags from the output and records where each output point and
+   * cell came from.
+   */
+  void BuildMap(vtkOrderedCompositeDistributor* self, vtkDataSet* input, vtkDataSet* output)
+  {
+    vtkMultiProcessController* controller = self->GetController();
+    const int numProcs = controller->GetNumberOfProcesses();
+    std::vector<vtkSmartPointer<vtkIdList> > requestedPointIds;
+    std::vector<vtkSmartPointer<vtkIdList> > requestedCellIds;
+    ResetIdLists(requestedPointIds, numProcs);
+    ResetIdLists(requestedCellIds, numProcs);
+    ResetIdLists(this->RecvPointIds, numProcs);
+    ResetIdLists(this->RecvCellIds, numProcs);
+    ResetIdLists(this->SendPointIds, numProcs);
+    ResetIdLists(this->SendCellIds, numProcs);
+
+    int pointsMapped = input->GetNumberOfPoints() <= MAX_TAGGED_POINT_ID ? 1 : 0;
+    vtkPointData* opd = output->GetPointData();
+    vtkDoubleArray* pointRanks =
+      vtkDoubleArray::SafeDownCast(opd->GetArray(SOURCE_RANK_ARRAY_NAME));
+    vtkDoubleArray* pointIds = vtkDoubleArray::SafeDownCast(opd->GetArray(SOURCE_ID_ARRAY_NAME));
+    vtkDoubleArray* pointIdsSquared =
+      vtkDoubleArray::SafeDownCast(opd->GetArray(SOURCE_ID_SQUARED_ARRAY_NAME));
+    if (pointRanks && pointIds && pointIdsSquared)
+    {
+      const vtkIdType numPoints = output->GetNumberOfPoints();
+      for (vtkIdType cc = 0; cc < numPoints; ++cc)
+      {
+        const double source = pointRanks->GetValue(cc);
+        const double id = pointIds->GetValue(cc);
+        const int rank = static_cast<int>(source);
+        // an interpolated id has a fractional part, or a square that
+        // differs from the interpolated squares.
+        if (rank != source || rank < 0 || rank >= numProcs || id != std::floor(id) ||
+          pointIdsSquared->GetValue(cc) != id * id)
+        {
+          pointsMapped = 0;
+          continue;
+        }
+        requestedPointIds[rank]->InsertNextId(static_cast<vtkIdType>(id));
+        this->RecvPointIds[rank]->InsertNextId(cc);
+      }
+    }
+    else if (output->GetNumberOfPoints() > 0)
+    {
+      pointsMapped = 0;
+    }
+
+    int cellsMapped = 1;
+    vtkCellData* ocd = output->GetCellData();
+    vtkIdTypeArray* cellRanks = vtkIdTypeArray::SafeDownCast(ocd->GetArray(SOURCE_RANK_ARRAY_NAME));
+    vtkIdTypeArray* cellIds = vtkIdTypeArray::SafeDownCast(ocd->GetArray(SOURCE_ID_ARRAY_NAME));
+    if (cellRanks && cellIds)
+    {
+      const vtkIdType numCells = output->GetNumberOfCells();
+      for (vtkIdType cc = 0; cc < numCells; ++cc)
+      {
+        const vtkIdType rank = cellRanks->GetValue(cc);
+        if (rank < 0 || rank >= numProcs)
+        {
+          cellsMapped = 0;
+          continue;
+        }
+        requestedCellIds[rank]->InsertNextId(cellIds->GetValue(cc));
+        this->RecvCellIds[rank]->InsertNextId(cc);
+      }
+    }
+    else if (output->GetNumberOfCells() > 0)
+    {
+      cellsMapped = 0;
+    }
+
+    opd->RemoveArray(SOURCE_RANK_ARRAY_NAME);
+    opd->RemoveArray(SOURCE_ID_ARRAY_NAME);
+    opd->RemoveArray(SOURCE_ID_SQUARED_ARRAY_NAME);
+    ocd->RemoveArray(SOURCE_RANK_ARRAY_NAME);
+    ocd->RemoveArray(SOURCE_ID_ARRAY_NAME);
+
+    // tell every rank which of its points and cells we hold, and in which
+    // order.
+    const int myRank = controller->GetLocalProcessId();
+    for (int root = 0; root < numProcs; ++root)
+    {
+      std::vector<vtkIdType> request;
+      vtkIdList* rpids = requestedPointIds[root];
+      vtkIdList* rcids = requestedCellIds[root];
+      request.reserve(1 + rpids->GetNumberOfIds() + rcids->GetNumberOfIds());
+      request.push_back(rpids->GetNumberOfIds());
+      request.insert(request.end(), rpids->GetPointer(0),
+        rpids->GetPointer(0) + rpids->GetNumberOfIds());
+      request.insert(request.end(), rcids->GetPointer(0),
+        rcids->GetPointer(0) + rcids->GetNumberOfIds());
+
+      std::vector<vtkIdType> received;
+      std::vector<vtkIdType> offsets;
+      GatherBuffers(controller, request.data(), static_cast<vtkIdType>(request.size()), root,
+        received, offsets);
+      if (myRank != root)
+      {
+        continue;
+      }
+      for (int src = 0; src < numProcs; ++src)
+      {
+        if (offsets[src + 1] == offsets[src])
+        {
+          continue;
+        }
+        const vtkIdType* ids = received.data() + offsets[src];
+        const vtkIdType numPoints = ids[0];
+        const vtkIdType numCells = offsets[src + 1] - offsets[src] - 1 - numPoints;
+        this->SendPointIds[src]->SetNumberOfIds(numPoints);
+        std::copy(ids + 1, ids + 1 + numPoints, this->SendPointIds[src]->GetPointer(0));
+        this->SendCellIds[src]->SetNumberOfIds(numCells);
+        std::copy(ids + 1 + numPoints, ids + 1 + numPoints + numCells,
+          this->SendCellIds[src]->GetPointer(0));
+      }
+    }
+
+    int local[2] = { cellsMapped, pointsMapped };
+    int global[2];
+    controller->AllReduce(local, global, 2, vtkCommunicator::MIN_OP);
+
+    this->Output.TakeReference(output->NewInstance());
+    this->Output->ShallowCopy(output);
+    this->DataObjectType = input->GetDataObjectType();
+    this->BoundaryMode = self->GetBoundaryMode();
+    this->KdTree = self->GetPKdTree();
+    this->KdTreeTime = self->GetPKdTree()->GetMTime();
+    this->GeometryHash = vtkOrderedCompositeDistributor::ComputeGeometryHash(input);
+    this->GeometryStamp = vtkOrderedCompositeDistributor::ComputeGeometryStamp(input);
+    this->PointMapValid = global[1] == 1;
+    const vtkArrayHashes none;
+    this->Valid = global[0] == 1 &&
+      HashArrays(input->GetPointData(), none, this->PointArrayHashes) &&
+      HashArrays(input->GetCellData(), none, this->CellArrayHashes);
+  }
 
+  /**
+   * Returns true if the geometry of `input` is the one of the last full
+   * redistribution. The values are only hashed when the arrays holding the
+   * geometry were replaced or modified.
+   */
+  bool HasSameGeometry(vtkDataSet* input)
+  {
+    const vtkTypeUInt64 stamp = vtkOrderedCompositeDistributor::ComputeGeometryStamp(input);
+    if (stamp == this->GeometryStamp)
+    {
+      return true;
+    }
+    if (vtkOrderedCompositeDistributor::ComputeGeometryHash(input) == this->GeometryHash)
+    {
+      this->GeometryStamp = stamp;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Called on all ranks. If the last redistribution can be reused, fills
+   * `output` with it after moving the modified arrays, and returns true.
+   */
+  bool MoveArrays(vtkOrderedCompositeDistributor* self, vtkDataSet* input, vtkDataSet* output)
+  {
+    vtkMultiProcessController* controller = self->GetController();
+    vtkArrayHashes pointHashes;
+    vtkArrayHashes cellHashes;
+    const bool reusable = this->Valid && input->GetDataObjectType() == this->DataObjectType &&
+      self->GetBoundaryMode() == this->BoundaryMode && self->GetPKdTree() == this->KdTree &&
+      self->GetPKdTree()->GetMTime() == this->KdTreeTime &&
+      HashArrays(input->GetPointData(), this->PointArrayHashes, pointHashes) &&
+      HaveSameArrays(pointHashes, this->PointArrayHashes) &&
+      HashArrays(input->GetCellData(), this->CellArrayHashes, cellHashes) &&
+      HaveSameArrays(cellHashes, this->CellArrayHashes) && this->HasSameGeometry(input);
+
+    const auto modifiedPointArrays = GetModifiedArrays(pointHashes, this->PointArrayHashes);
+    const auto modifiedCellArrays = GetModifiedArrays(cellHashes, this->CellArrayHashes);
+    int local[3] = { reusable ? 1 : 0, modifiedPointArrays.empty() ? 1 : 0,
+      modifiedCellArrays.empty() ? 1 : 0 };
+    int global[3];
+    controller->AllReduce(local, global, 3, vtkCommunicator::MIN_OP);
+    const bool movePointArrays = global[1] == 0;
+    const bool moveCellArrays = global[2] == 0;
+    if (global[0] == 0 || (movePointArrays && !this->PointMapValid))
+    {
+      return false;
+    }
+
+    output->ShallowCopy(this->Output);
+    if (movePointArrays)
+    {
+      this->Exchange(controller, input->GetPointData(), modifiedPointArrays, this->SendPointIds,
+        this->RecvPointIds, output->GetPointData(), output->GetNumberOfPoints());
+    }
+    if (moveCellArrays)
+    {
+      this->Exchange(controller, input->GetCellData(), modifiedCellArrays, this->SendCellIds,
+        this->RecvCellIds, output->GetCellData(), output->GetNumberOfCells());
+    }
+    this->Output->ShallowCopy(output);
+    this->PointArrayHashes.swap(pointHashes);
+    this->CellArrayHashes.swap(cellHashes);
+    return true;
+  }
+
+  /**
+   * Sends the tuples of the named arrays to the ranks holding them and
+   * updates the corresponding arrays in `target`.
+   */
+  void Exchange(vtkMultiProcessController* controller, vtkDataSetAttributes* source,
+    const std::vector<std::string>& names, const std::vector<vtkSmartPointer<vtkIdList> >& sendIds,
+    const std::vector<vtkSmartPointer<vtkIdList> >& recvIds, vtkDataSetAttributes* target,
+    vtkIdType numberOfTuples)
+  {
+    const int myRank = controller->GetLocalProcessId();
+    const int numProcs = controller->GetNumberOfProcesses();
+    std::set<std::string> copiedArrays;
+    for (int root = 0; root < numProcs; ++root)
+    {
+      vtkNew<vtkCharArray> buffer;
+      vtkIdList* ids = sendIds[root];
+      if (ids->GetNumberOfIds() > 0 && !names.empty())
+      {
+        vtkNew<vtkTable> piece;
+        for (const auto& name : names)
+        {
+          vtkAbstractArray* array = source->GetAbstractArray(name.c_str());
+          vtkSmartPointer<vtkAbstractArray> values;
+          values.TakeReference(array->NewInstance());
+          values->SetName(name.c_str());
+          values->SetNumberOfComponents(array->GetNumberOfComponents());
+          values->SetNumberOfTuples(ids->GetNumberOfIds());
+          array->GetTuples(ids, values);
+          piece->AddColumn(values);
+        }
+        vtkCommunicator::MarshalDataObject(piece, buffer);
+      }
+
+      std::vector<char> received;
+      std::vector<vtkIdType> offsets;
+      GatherBuffers(controller, buffer->GetPointer(0), buffer->GetNumberOfTuples(), root,
+        received, offsets);
+      if (myRank != root)
+      {
+        continue;
+      }
+      for (int src = 0; src < numProcs; ++src)
+      {
+        if (offsets[src + 1] == offsets[src])
+        {
+          continue;
+        }
+        vtkNew<vtkCharArray> srcBuffer;
+        srcBuffer->SetArray(received.data() + offsets[src], offsets[src + 1] - offsets[src], 1);
+        vtkNew<vtkTable> srcPiece;
+        vtkCommunicator::UnMarshalDataObject(srcBuffer, srcPiece);
+        vtkIdList* targetIds = recvIds[src];
+        for (vtkIdType col = 0; col < srcPiece->GetNumberOfColumns(); ++col)
+        {
+          vtkAbstractArray* values = srcPiece->GetColumn(col);
+          vtkAbstractArray* array =
+            this->GetModifiableArray(target, values, numberOfTuples, copiedArrays);
+          const vtkIdType count =
+            std::min(targetIds->GetNumberOfIds(), values->GetNumberOfTuples());
+          for (vtkIdType cc = 0; cc < count; ++cc)
+          {
+            array->SetTuple(targetIds->GetId(cc), cc, values);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns the array in `target` matching `values`. The first time an array
+   * is requested it is replaced by a copy, since the previous one is shared
+   * with earlier outputs.
+   */
+  vtkAbstractArray* GetModifiableArray(vtkDataSetAttributes* target, vtkAbstractArray* values,
+    vtkIdType numberOfTuples, std::set<std::string>& copiedArrays)
+  {
+    vtkAbstractArray* current = target->GetAbstractArray(values->GetName());
+    if (!copiedArrays.insert(values->GetName()).second)
+    {
+      return current;
+    }
+
+    vtkSmartPointer<vtkAbstractArray> copy;
+    copy.TakeReference(values->NewInstance());
+    if (current && current->GetDataType() == values->GetDataType() &&
+      current->GetNumberOfComponents() == values->GetNumberOfComponents() &&
+      current->GetNumberOfTuples() == numberOfTuples)
+    {
+      // tuples from ranks where the array did not change are kept.
+      copy->DeepCopy(current);
+    }
+    else
+    {
+      copy->SetNumberOfComponents(values->GetNumberOfComponents());
+      copy->SetNumberOfTuples(numberOfTuples);
+      if (auto da = vtkDataArray::SafeDownCast(copy))
+      {
+        da->Fill(0.0);
+      }
+    }
+    copy->SetName(values->GetName());
+    target->AddArray(copy);
+    return copy;
+  }
+};
+
+//-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkOrderedCompositeDistributor);
 vtkCxxSetObjectMacro(vtkOrderedCompositeDistributor, PKdTree, vtkPKdTree);
 vtkCxxSetObjectMacro(vtkOrderedCompositeDistributor, Controller, vtkMultiProcessController);
@@ -66,8 +682,10 @@ vtkOrderedCompositeDistributor::vtkOrderedCompositeDistributor()
   this->PKdTree = NULL;
   this->Controller = NULL;
   this->PassThrough = false;
+  this->Incremental = false;
   this->OutputType = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->Internals = new vtkInternals();
 }
 
 //-----------------------------------------------------------------------------
@@ -76,6 +694,7 @@ vtkOrderedCompositeDistributor::~vtkOrderedCompositeDistributor()
   this->SetPKdTree(NULL);
   this->SetController(NULL);
   this->SetOutputType(NULL);
+  delete this->Internals;
 }
 
 //-----------------------------------------------------------------------------
@@ -86,6 +705,7 @@ void vtkOrderedCompositeDistributor::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PKdTree: " << this->PKdTree << endl;
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
+  os << indent << "Incremental: " << this->Incremental << endl;
   os << indent << "OutputType: " << (this->OutputType ? this->OutputType : "(none)") << endl;
 }
 
@@ -188,10 +808,20 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
   this->Controller->AllReduce(&valid_bounds, &reduced_valid_bounds, 1, vtkCommunicator::MAX_OP);
   if (!reduced_valid_bounds)
   {
+    this->Internals->Reset();
     output->ShallowCopy(input);
     return 1;
   }
 
+  if (!this->Incremental)
+  {
+    this->Internals->Reset();
+  }
+  else if (this->Internals->MoveArrays(this, input, output))
+  {
+    return 1;
+  }
+
   this->UpdateProgress(0.01);
 
   vtkNew<vtkDistributedDataFilter> d3;
@@ -213,7 +843,12 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
       d3->SetBoundaryModeToAssignToAllIntersectingRegions();
       break;
   }
-  d3->SetInputData(input);
+  vtkSmartPointer<vtkDataSet> d3Input = input;
+  if (this->Incremental)
+  {
+    d3Input = this->Internals->NewTaggedInput(input, this->Controller->GetLocalProcessId());
+  }
+  d3->SetInputData(d3Input);
   d3->SetCuts(cuts);
 
   // We need to pass the region assignments from PKdTree to D3
@@ -247,7 +882,24 @@ int vtkOrderedCompositeDistributor::RequestData(vtkInformation* vtkNotUsed(reque
       return 0;
     }
   }
+
+  if (this->Incremental)
+  {
+    this->Internals->BuildMap(this, input, output);
+  }
 #endif
 
   return 1;
 }
+
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkOrderedCompositeDistributor::ComputeGeometryHash(vtkDataObject* dobj)
+{
+  return HashDataObject(dobj, HashArray);
+}
+
+//-----------------------------------------------------------------------------
+vtkTypeUInt64 vtkOrderedCompositeDistributor::ComputeGeometryStamp(vtkDataObject* dobj)
+{
+  return HashDataObject(dobj, StampArray);
+}
@@ -36,6 +36,13 @@
  * This class also has an optional pass through mode to make it easy to
  * turn ordered compositing on and off.
  *
+ * When Incremental is on, the filter remembers, for every redistributed
+ * point and cell, the rank and index of the input element it was copied
+ * from. If a later update has the same points and cells on all ranks and
+ * uses the same kd-tree, the partitioning is not applied again. Only the
+ * point and cell arrays that changed are sent to the ranks that hold the
+ * redistributed elements.
+ *
 */
 
 #ifndef vtkOrderedCompositeDistributor_h
@@ -113,6 +120,36 @@ public:
   vtkGetMacro(BoundaryMode, int);
   //@}
 
+  //@{
+  /**
+   * When on, the point and cell mapping of the last redistribution is kept
+   * and reused while the input geometry and the kd-tree are unchanged, so that
+   * only modified arrays are communicated. Point arrays can only be moved this
+   * way when every redistributed point is a copy of an input point, i.e. when
+   * no cell was split by the kd-tree cuts; otherwise changing point arrays
+   * results in a full redistribution. Composite inputs are always fully
+   * redistributed. Default is off.
+   */
+  vtkSetMacro(Incremental, bool);
+  vtkGetMacro(Incremental, bool);
+  vtkBooleanMacro(Incremental, bool);
+  //@}
+
+  /**
+   * Returns a hash of the points and cells of the given vtkPointSet, or of
+   * all vtkPointSet leaves of the given composite dataset. Attribute arrays
+   * are not included.
+   */
+  static vtkTypeUInt64 ComputeGeometryHash(vtkDataObject* dobj);
+
+  /**
+   * Returns a hash of the addresses and modification times of the arrays
+   * holding the points and cells, without reading their values. When it is
+   * unchanged, so is ComputeGeometryHash(), which makes it a cheap test to run
+   * before the latter.
+   */
+  static vtkTypeUInt64 ComputeGeometryStamp(vtkDataObject* dobj);
+
 protected:
   vtkOrderedCompositeDistributor();
   ~vtkOrderedCompositeDistributor() override;
@@ -120,6 +157,7 @@ protected:
   int BoundaryMode;
   char* OutputType;
   bool PassThrough;
+  bool Incremental;
   vtkPKdTree* PKdTree;
   vtkMultiProcessController* Controller;
 
@@ -130,6 +168,9 @@ protected:
 private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor&) = delete;
   void operator=(const vtkOrderedCompositeDistributor&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif // vtkOrderedCompositeDistributor_h
@@ -22,6 +22,7 @@
 #include "vtkEventForwarderCommand.h"
 #include "vtkExtractSelection.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -49,6 +50,7 @@
 
 #include <algorithm>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 #include <float.h>
@@ -70,6 +72,8 @@ public:
     vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
   virtual int Compute(
     vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
+  virtual int ComputeWithSampleSort(
+    vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
   virtual bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) = 0;
   virtual bool IsSortable() = 0;
   virtual bool TestInternalClasses() = 0;
@@ -594,6 +598,9 @@ public:
     // Create internal objects
     this->LocalSorter = new ArraySorter();
     this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
+
+    this->NeedToBuildOrder = true;
+    this->OrderInverted = false;
   }
 
   ~Internals() override
@@ -988,6 +995,463 @@ public:
     return 1;
   }
 
+  // --------------------------------------------------------------------------
+  // Global position of a row in the sample sort: rows are ordered by value,
+  // then by process and then by local index, all reversed when inverted.
+  template <typename KeyT>
+  static bool OrderLess(
+    KeyT keyA, int pidA, vtkIdType idxA, KeyT keyB, int pidB, vtkIdType idxB, bool inverted)
+  {
+    if (inverted)
+    {
+      std::swap(keyA, keyB);
+      std::swap(pidA, pidB);
+      std::swap(idxA, idxB);
+    }
+    if (keyA != keyB)
+    {
+      return keyA < keyB;
+    }
+    return pidA != pidB ? pidA < pidB : idxA < idxB;
+  }
+
+  // --------------------------------------------------------------------------
+  // Component to sort on, -1 for the magnitude.
+  int GetSortComponent()
+  {
+    int component = this->SelectedComponent;
+    if (this->DataToSort && this->DataToSort->GetNumberOfComponents() == 1 && component < 0)
+    {
+      component = 0; // We can not compute magnitude on scalar value
+    }
+    return component;
+  }
+
+  // --------------------------------------------------------------------------
+  // Sort key of each local row, NaN being sorted as +inf.
+  void ComputeSortKeys(std::vector<double>& keys)
+  {
+    vtkIdType numTuples = this->DataToSort ? this->DataToSort->GetNumberOfTuples() : 0;
+    keys.resize(numTuples);
+    if (numTuples == 0)
+    {
+      return;
+    }
+    const T* dataPtr = static_cast<T*>(this->DataToSort->GetVoidPointer(0));
+    const int numComponents = this->DataToSort->GetNumberOfComponents();
+    const int component = this->GetSortComponent();
+    for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+      double value = 0;
+      if (component < 0)
+      {
+        for (int k = 0; k < numComponents; k++)
+        {
+          double tmp = static_cast<double>(dataPtr[k + i * numComponents]);
+          value += tmp * tmp;
+        }
+        value = sqrt(value) / sqrt(static_cast<double>(numComponents));
+      }
+      else
+      {
+        value = static_cast<double>(dataPtr[component + i * numComponents]);
+      }
+      keys[i] = vtkMath::IsNan(value) ? VTK_DOUBLE_MAX : value;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Sort key of each local row for a component of an integral array. The
+  // values are kept integral since a double can not represent all 64 bit
+  // integers.
+  template <typename KeyT>
+  void ComputeSortKeys(std::vector<KeyT>& keys)
+  {
+    vtkIdType numTuples = this->DataToSort ? this->DataToSort->GetNumberOfTuples() : 0;
+    keys.resize(numTuples);
+    if (numTuples == 0)
+    {
+      return;
+    }
+    const T* dataPtr = static_cast<T*>(this->DataToSort->GetVoidPointer(0));
+    const int numComponents = this->DataToSort->GetNumberOfComponents();
+    const int component = this->GetSortComponent();
+    for (vtkIdType i = 0; i < numTuples; ++i)
+    {
+      keys[i] = static_cast<KeyT>(dataPtr[component + i * numComponents]);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Distributed sample sort. Every process sorts its rows, a set of splitters
+  // is chosen from regularly spaced samples of all processes and the rows
+  // (key and local index only) are sent to the process owning their bucket.
+  // Process p then owns the global positions [OrderOffsets[p],
+  // OrderOffsets[p + 1]) and knows which process and local row each of them
+  // comes from.
+  void BuildGlobalOrder(bool invertOrder)
+  {
+    this->NeedToBuildOrder = false;
+    this->OrderInverted = invertOrder;
+
+    typedef typename std::conditional<std::is_signed<T>::value, long long,
+      unsigned long long>::type IntegralKeyType;
+    if (std::is_integral<T>::value && this->GetSortComponent() >= 0)
+    {
+      std::vector<IntegralKeyType> keys;
+      this->ComputeSortKeys(keys);
+      this->BuildGlobalOrder(keys, invertOrder);
+    }
+    else
+    {
+      std::vector<double> keys;
+      this->ComputeSortKeys(keys);
+      this->BuildGlobalOrder(keys, invertOrder);
+    }
+  }
+
+  template <typename KeyT>
+  void BuildGlobalOrder(const std::vector<KeyT>& keys, bool invertOrder)
+  {
+    // Sort the local rows
+    const vtkIdType numRows = static_cast<vtkIdType>(keys.size());
+    std::vector<vtkIdType> order(numRows);
+    for (vtkIdType i = 0; i < numRows; ++i)
+    {
+      order[i] = i;
+    }
+    const int me = this->Me;
+    std::sort(order.begin(), order.end(), [&](vtkIdType a, vtkIdType b) {
+      return OrderLess(keys[a], me, a, keys[b], me, b, invertOrder);
+    });
+    std::vector<KeyT> sortedKeys(numRows);
+    for (vtkIdType i = 0; i < numRows; ++i)
+    {
+      sortedKeys[i] = keys[order[i]];
+    }
+
+    // Regular sampling, NumProcs samples per process at most
+    vtkIdType numSamples = std::min(static_cast<vtkIdType>(this->NumProcs), numRows);
+    std::vector<KeyT> sampleKeys(numSamples);
+    std::vector<vtkIdType> sampleIds(2 * numSamples);
+    for (vtkIdType i = 0; i < numSamples; ++i)
+    {
+      vtkIdType pos = (i * numRows) / numSamples;
+      sampleKeys[i] = sortedKeys[pos];
+      sampleIds[2 * i] = me;
+      sampleIds[2 * i + 1] = order[pos];
+    }
+
+    std::vector<vtkIdType> sampleCounts(this->NumProcs);
+    this->MPI->AllGather(&numSamples, &sampleCounts[0], 1);
+    std::vector<vtkIdType> keyOffsets(this->NumProcs, 0);
+    std::vector<vtkIdType> idCounts(this->NumProcs);
+    std::vector<vtkIdType> idOffsets(this->NumProcs, 0);
+    vtkIdType totalSamples = 0;
+    for (int p = 0; p < this->NumProcs; ++p)
+    {
+      keyOffsets[p] = totalSamples;
+      idOffsets[p] = 2 * totalSamples;
+      idCounts[p] = 2 * sampleCounts[p];
+      totalSamples += sampleCounts[p];
+    }
+    std::vector<KeyT> allSampleKeys(totalSamples + 1);
+    std::vector<vtkIdType> allSampleIds(2 * totalSamples + 1);
+    this->MPI->AllGatherV(sampleKeys.data(), &allSampleKeys[0], numSamples, &sampleCounts[0],
+      &keyOffsets[0]);
+    this->MPI->AllGatherV(
+      sampleIds.data(), &allSampleIds[0], 2 * numSamples, &idCounts[0], &idOffsets[0]);
+
+    // Choose the splitters
+    std::vector<vtkIdType> samples(totalSamples);
+    for (vtkIdType i = 0; i < totalSamples; ++i)
+    {
+      samples[i] = i;
+    }
+    std::sort(samples.begin(), samples.end(), [&](vtkIdType a, vtkIdType b) {
+      return OrderLess(allSampleKeys[a], static_cast<int>(allSampleIds[2 * a]),
+        allSampleIds[2 * a + 1], allSampleKeys[b], static_cast<int>(allSampleIds[2 * b]),
+        allSampleIds[2 * b + 1], invertOrder);
+    });
+
+    // Bucket p holds the local rows in [bounds[p], bounds[p + 1])
+    std::vector<vtkIdType> bounds(this->NumProcs + 1, numRows);
+    bounds[0] = 0;
+    for (int p = 1; p < this->NumProcs && totalSamples > 0; ++p)
+    {
+      vtkIdType splitter = samples[(p * totalSamples) / this->NumProcs];
+      KeyT splitterKey = allSampleKeys[splitter];
+      int splitterPid = static_cast<int>(allSampleIds[2 * splitter]);
+      vtkIdType splitterIdx = allSampleIds[2 * splitter + 1];
+      vtkIdType first = bounds[p - 1];
+      vtkIdType count = numRows - first;
+      while (count > 0)
+      {
+        vtkIdType step = count / 2;
+        vtkIdType mid = first + step;
+        if (OrderLess(sortedKeys[mid], me, order[mid], splitterKey, splitterPid, splitterIdx,
+              invertOrder))
+        {
+          first = mid + 1;
+          count -= step + 1;
+        }
+        else
+        {
+          count = step;
+        }
+      }
+      bounds[p] = first;
+    }
+
+    // Send every bucket to its owner. The buckets are exchanged pairwise: at
+    // step s, each process trades with process (me ^ s), so every pair of
+    // processes talks once and the lower rank always sends first.
+    std::vector<std::vector<KeyT> > bucketKeys(this->NumProcs);
+    std::vector<std::vector<vtkIdType> > bucketIndices(this->NumProcs);
+    bucketKeys[me].assign(sortedKeys.begin() + bounds[me], sortedKeys.begin() + bounds[me + 1]);
+    bucketIndices[me].assign(order.begin() + bounds[me], order.begin() + bounds[me + 1]);
+    int numSteps = 1;
+    while (numSteps < this->NumProcs)
+    {
+      numSteps *= 2;
+    }
+    for (int step = 1; step < numSteps; ++step)
+    {
+      const int other = me ^ step;
+      if (other >= this->NumProcs)
+      {
+        continue;
+      }
+      if (me < other)
+      {
+        this->SendBucket(sortedKeys, order, bounds[other], bounds[other + 1], other);
+        this->ReceiveBucket(bucketKeys[other], bucketIndices[other], other);
+      }
+      else
+      {
+        this->ReceiveBucket(bucketKeys[other], bucketIndices[other], other);
+        this->SendBucket(sortedKeys, order, bounds[other], bounds[other + 1], other);
+      }
+    }
+
+    std::vector<KeyT> ownedKeys;
+    std::vector<vtkIdType> ownedIndices;
+    std::vector<int> ownedPids;
+    for (int p = 0; p < this->NumProcs; ++p)
+    {
+      ownedKeys.insert(ownedKeys.end(), bucketKeys[p].begin(), bucketKeys[p].end());
+      ownedIndices.insert(ownedIndices.end(), bucketIndices[p].begin(), bucketIndices[p].end());
+      ownedPids.insert(ownedPids.end(), bucketKeys[p].size(), p);
+    }
+
+    // Order the owned rows
+    const vtkIdType numOwned = static_cast<vtkIdType>(ownedPids.size());
+    std::vector<vtkIdType> ownedOrder(numOwned);
+    for (vtkIdType i = 0; i < numOwned; ++i)
+    {
+      ownedOrder[i] = i;
+    }
+    std::sort(ownedOrder.begin(), ownedOrder.end(), [&](vtkIdType a, vtkIdType b) {
+      return OrderLess(ownedKeys[a], ownedPids[a], ownedIndices[a], ownedKeys[b], ownedPids[b],
+        ownedIndices[b], invertOrder);
+    });
+    this->OrderPids.resize(numOwned);
+    this->OrderIndices.resize(numOwned);
+    for (vtkIdType i = 0; i < numOwned; ++i)
+    {
+      this->OrderPids[i] = ownedPids[ownedOrder[i]];
+      this->OrderIndices[i] = ownedIndices[ownedOrder[i]];
+    }
+
+    std::vector<vtkIdType> ownedCounts(this->NumProcs);
+    vtkIdType localOwned = numOwned;
+    this->MPI->AllGather(&localOwned, &ownedCounts[0], 1);
+    this->OrderOffsets.assign(this->NumProcs + 1, 0);
+    for (int p = 0; p < this->NumProcs; ++p)
+    {
+      this->OrderOffsets[p + 1] = this->OrderOffsets[p] + ownedCounts[p];
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Sends the keys and local indices of the sorted rows [begin, end).
+  template <typename KeyT>
+  void SendBucket(const std::vector<KeyT>& sortedKeys, const std::vector<vtkIdType>& order,
+    vtkIdType begin, vtkIdType end, int dest)
+  {
+    vtkIdType count = end - begin;
+    this->MPI->Send(&count, 1, dest, VTK_SAMPLE_SORT_COUNT_TAG);
+    if (count > 0)
+    {
+      this->MPI->Send(sortedKeys.data() + begin, count, dest, VTK_SAMPLE_SORT_KEYS_TAG);
+      this->MPI->Send(order.data() + begin, count, dest, VTK_SAMPLE_SORT_INDICES_TAG);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  template <typename KeyT>
+  void ReceiveBucket(std::vector<KeyT>& keys, std::vector<vtkIdType>& indices, int source)
+  {
+    vtkIdType count = 0;
+    this->MPI->Receive(&count, 1, source, VTK_SAMPLE_SORT_COUNT_TAG);
+    keys.resize(count);
+    indices.resize(count);
+    if (count > 0)
+    {
+      this->MPI->Receive(keys.data(), count, source, VTK_SAMPLE_SORT_KEYS_TAG);
+      this->MPI->Receive(indices.data(), count, source, VTK_SAMPLE_SORT_INDICES_TAG);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  int ComputeWithSampleSort(vtkTable* input, vtkTable* output, vtkIdType block,
+    vtkIdType blockSize, bool revertOrder) override
+  {
+    if (this->NeedToBuildOrder || this->OrderInverted != revertOrder)
+    {
+      this->BuildGlobalOrder(revertOrder);
+    }
+
+    // ------------------------------------------------------------------------
+    // Share the (process, row) pairs of the requested block
+    // ------------------------------------------------------------------------
+    const vtkIdType total = this->OrderOffsets[this->NumProcs];
+    const vtkIdType begin = std::min(block * blockSize, total);
+    const vtkIdType end = std::min(begin + blockSize, total);
+    const vtkIdType localBegin = std::max(begin, this->OrderOffsets[this->Me]);
+    const vtkIdType localEnd = std::min(end, this->OrderOffsets[this->Me + 1]);
+
+    std::vector<vtkIdType> localPairs;
+    for (vtkIdType pos = localBegin; pos < localEnd; ++pos)
+    {
+      vtkIdType idx = pos - this->OrderOffsets[this->Me];
+      localPairs.push_back(this->OrderPids[idx]);
+      localPairs.push_back(this->OrderIndices[idx]);
+    }
+
+    std::vector<vtkIdType> pairCounts(this->NumProcs);
+    std::vector<vtkIdType> pairOffsets(this->NumProcs);
+    vtkIdType localCount = static_cast<vtkIdType>(localPairs.size());
+    this->MPI->AllGather(&localCount, &pairCounts[0], 1);
+    vtkIdType numPairs = 0;
+    for (int p = 0; p < this->NumProcs; ++p)
+    {
+      pairOffsets[p] = numPairs;
+      numPairs += pairCounts[p];
+    }
+    std::vector<vtkIdType> blockPairs(numPairs + 1);
+    this->MPI->AllGatherV(
+      localPairs.data(), &blockPairs[0], localCount, &pairCounts[0], &pairOffsets[0]);
+    const vtkIdType blockRows = numPairs / 2;
+
+    // ------------------------------------------------------------------------
+    // Extract the local rows of the block and pick the merging process, the
+    // one owning most of the rows.
+    // ------------------------------------------------------------------------
+    std::vector<vtkIdType> rowsPerProcess(this->NumProcs, 0);
+    vtkSmartPointer<vtkIdList> localRows = vtkSmartPointer<vtkIdList>::New();
+    for (vtkIdType i = 0; i < blockRows; ++i)
+    {
+      int pid = static_cast<int>(blockPairs[2 * i]);
+      rowsPerProcess[pid]++;
+      if (pid == this->Me)
+      {
+        localRows->InsertNextId(blockPairs[2 * i + 1]);
+      }
+    }
+    int mergePid = 0;
+    for (int p = 1; p < this->NumProcs; ++p)
+    {
+      if (rowsPerProcess[p] > rowsPerProcess[mergePid])
+      {
+        mergePid = p;
+      }
+    }
+
+    vtkSmartPointer<vtkTable> localSubset;
+    localSubset.TakeReference(NewRowsTable(input, localRows));
+
+    if (this->Me != mergePid)
+    {
+      this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+      this->DecorateTable(input, NULL, mergePid);
+      return 1;
+    }
+
+    if (this->NumProcs > 1)
+    {
+      vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
+      processIdArray->SetName("vtkOriginalProcessIds");
+      processIdArray->SetNumberOfComponents(1);
+      processIdArray->Allocate(blockSize);
+      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
+      {
+        processIdArray->InsertNextTuple1(mergePid);
+      }
+      localSubset->GetRowData()->AddArray(processIdArray);
+    }
+
+    // Rows of process p start at chunkStart[p] in the merged table
+    std::vector<vtkIdType> chunkStart(this->NumProcs, 0);
+    vtkIdType nextChunk = localSubset->GetNumberOfRows();
+    vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
+    for (int i = 0; i < this->NumProcs; i++)
+    {
+      if (i == mergePid)
+        continue;
+
+      this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
+      chunkStart[i] = nextChunk;
+      nextChunk += tmp->GetNumberOfRows();
+      this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+    }
+
+    // Put the rows back in the global order
+    vtkSmartPointer<vtkIdList> blockOrder = vtkSmartPointer<vtkIdList>::New();
+    blockOrder->SetNumberOfIds(blockRows);
+    for (vtkIdType i = 0; i < blockRows; ++i)
+    {
+      blockOrder->SetId(i, chunkStart[blockPairs[2 * i]]++);
+    }
+    localSubset.TakeReference(NewRowsTable(localSubset.GetPointer(), blockOrder));
+
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, localSubset.GetPointer(), mergePid);
+
+    // ShallowCopy it to the output
+    output->ShallowCopy(localSubset.GetPointer());
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Returns a new table holding the given rows of srcTable, in that order.
+  static vtkTable* NewRowsTable(vtkTable* srcTable, vtkIdList* rows)
+  {
+    vtkTable* subTable = vtkTable::New();
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
+    {
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
+      vtkAbstractArray* subArray = srcArray->NewInstance();
+      subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      subArray->SetName(srcArray->GetName());
+      if (auto sinfo = srcArray->GetInformation())
+      {
+        subArray->CopyInformation(sinfo);
+      }
+      subArray->Allocate(rows->GetNumberOfIds() * srcArray->GetNumberOfComponents());
+      for (vtkIdType idx = 0; idx < rows->GetNumberOfIds(); ++idx)
+      {
+        if (subArray->InsertNextTuple(rows->GetId(idx), srcArray) == -1)
+        {
+          cout << "ERROR NewRowsTable::InsertNextTuple is not working." << endl;
+        }
+      }
+      subTable->GetRowData()->AddArray(subArray);
+      subArray->FastDelete();
+    }
+    return subTable;
+  }
+
   // --------------------------------------------------------------------------
   // nbGlobalToSkip is the number of elements that should be skipped at the end
   // if you exactly want to reach the searchedGlobalIndex.
@@ -1118,7 +1582,11 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  void InvalidateCache() override { this->NeedToBuildCache = true; }
+  void InvalidateCache() override
+  {
+    this->NeedToBuildCache = true;
+    this->NeedToBuildOrder = true;
+  }
 
   // --------------------------------------------------------------------------
   bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
@@ -1330,7 +1798,17 @@ private:
   bool NeedToBuildCache;
   bool Debug;
 
+  // Global order computed by BuildGlobalOrder()
+  std::vector<int> OrderPids;          // Process owning each row of the local range
+  std::vector<vtkIdType> OrderIndices; // Row index on that process
+  std::vector<vtkIdType> OrderOffsets; // First global position of each process
+  bool OrderInverted;
+  bool NeedToBuildOrder;
+
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
+  const static int VTK_SAMPLE_SORT_COUNT_TAG = 51;
+  const static int VTK_SAMPLE_SORT_KEYS_TAG = 52;
+  const static int VTK_SAMPLE_SORT_INDICES_TAG = 53;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
   // correctly we set the histogram size to be their max number of element
@@ -1354,6 +1832,9 @@ vtkSortedTableStreamer::vtkSortedTableStreamer()
   this->BlockSize = 1024;
   this->Internal = 0;
   this->SelectedComponent = 0;
+  this->SampleSort = false;
+  this->MergedInputSource = nullptr;
+  this->MergedInputTime = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -1391,6 +1872,19 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
 
   bool orderInverted = this->InvertOrder > 0;
 
+  // With SampleSort, reuse the table merged for a previous block as long as
+  // the composite input did not change, so the global order is kept.
+  if (!input && this->SampleSort && this->MergedInput && this->MergedInputSource == inputDO &&
+    this->MergedInputTime == inputDO->GetMTime())
+  {
+    input = this->MergedInput;
+  }
+  else if (!this->SampleSort)
+  {
+    this->MergedInput = nullptr;
+    this->MergedInputSource = nullptr;
+  }
+
   // Convert a composite dataset into a vtkTable input.
   if (!input)
   {
@@ -1470,6 +1964,13 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
       }
     }
     iter->Delete();
+
+    if (this->SampleSort)
+    {
+      this->MergedInput = input;
+      this->MergedInputSource = inputDO;
+      this->MergedInputTime = inputDO->GetMTime();
+    }
   }
 
   // Get input data
@@ -1504,6 +2005,11 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   {
     this->Internal->Extract(input, output, this->Block, this->BlockSize, orderInverted);
   }
+  else if (this->SampleSort)
+  {
+    this->Internal->ComputeWithSampleSort(
+      input, output, this->Block, this->BlockSize, orderInverted);
+  }
   else
   {
     this->Internal->Compute(input, output, this->Block, this->BlockSize, orderInverted);
@@ -1518,6 +2024,7 @@ void vtkSortedTableStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Sorting column: " << (this->ColumnToSort ? this->ColumnToSort : "(none)")
      << endl;
+  os << indent << "SampleSort: " << this->SampleSort << endl;
 }
 
 //----------------------------------------------------------------------------
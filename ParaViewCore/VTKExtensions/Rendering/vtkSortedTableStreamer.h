@@ -20,12 +20,18 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * When SampleSort is enabled, the global order of the rows is computed once,
+ * using a distributed sample sort, and kept until the input, the column, the
+ * component or the order changes. Requesting another block then only
+ * transfers the rows of that block.
 */
 
 #ifndef vtkSortedTableStreamer_h
 #define vtkSortedTableStreamer_h
 
 #include "vtkPVVTKExtensionsRenderingModule.h" // needed for export macro
+#include "vtkSmartPointer.h"                     // needed for ivar
 #include "vtkTableAlgorithm.h"
 class vtkTable;
 class vtkDataArray;
@@ -101,6 +107,19 @@ public:
   void SetInvertOrder(int newValue);
   vtkGetMacro(InvertOrder, int);
 
+  //@{
+  /**
+   * When set, the rows are globally ordered once with a distributed sample
+   * sort and the resulting order is kept across block requests, so that
+   * each request only fetches the rows of the block from the processes
+   * owning them. Rows with equal values are ordered by process and then by
+   * row index. Default is false.
+   */
+  vtkSetMacro(SampleSort, bool);
+  vtkGetMacro(SampleSort, bool);
+  vtkBooleanMacro(SampleSort, bool);
+  //@}
+
 protected:
   vtkSortedTableStreamer();
   ~vtkSortedTableStreamer() override;
@@ -125,6 +144,13 @@ protected:
   char* ColumnToSort;
   int SelectedComponent;
   int InvertOrder;
+  bool SampleSort;
+
+  // Table merged from a composite input, kept when SampleSort is enabled so
+  // that the sort order built on it remains valid across block requests.
+  vtkSmartPointer<vtkTable> MergedInput;
+  vtkDataObject* MergedInputSource;
+  vtkMTimeType MergedInputTime;
 
 private:
   vtkSortedTableStreamer(const vtkSortedTableStreamer&) = delete;
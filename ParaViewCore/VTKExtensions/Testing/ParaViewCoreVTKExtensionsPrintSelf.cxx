@@ -98,6 +98,7 @@
 #include "vtkPVEnSightMasterServerReader.h"
 #include "vtkPVEnSightMasterServerReader2.h"
 #include "vtkPVEnSightMasterServerTranslator.h"
+#include "vtkPVEventTracer.h"
 #include "vtkPVExponentialKeyFrame.h"
 #include "vtkPVExtractVOI.h"
 #include "vtkPVFrustumActor.h"
@@ -282,6 +283,7 @@ int ParaViewCoreVTKExtensionsPrintSelf(int, char* [])
   PRINT_SELF(vtkPVEnSightMasterServerReader);
   PRINT_SELF(vtkPVEnSightMasterServerReader2);
   PRINT_SELF(vtkPVEnSightMasterServerTranslator);
+  PRINT_SELF(vtkPVEventTracer);
   PRINT_SELF(vtkPVExponentialKeyFrame);
   PRINT_SELF(vtkPVExtractVOI);
   PRINT_SELF(vtkPVFrustumActor);
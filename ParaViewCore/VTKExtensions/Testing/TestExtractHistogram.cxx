@@ -92,5 +92,41 @@ int TestExtractHistogram(int, char* [])
     vtkGenericWarningMacro("incorrect bin value.");
     return 1;
   }
+
+  // The threaded binning must give the same counts, including when they are
+  // derived from the cached finer resolution counts.
+  vtkSmartPointer<vtkExtractHistogram> parallel = vtkSmartPointer<vtkExtractHistogram>::New();
+  parallel->SetInputConnection(sphere->GetOutputPort());
+  parallel->SetInputArrayToProcess(
+    0, 0, 0, vtkDataSet::FIELD_ASSOCIATION_POINTS_THEN_CELLS, "Normals");
+  parallel->ParallelBinningOn();
+  const int componentsAndBins[6][2] = { { 0, 3 }, { 0, 6 }, { 0, 12 }, { 1, 24 }, { 3, 8 },
+    { 3, 4 } };
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    extraction->SetComponent(componentsAndBins[cc][0]);
+    extraction->SetBinCount(componentsAndBins[cc][1]);
+    extraction->Update();
+    parallel->SetComponent(componentsAndBins[cc][0]);
+    parallel->SetBinCount(componentsAndBins[cc][1]);
+    parallel->Update();
+    vtkIntArray* const expected =
+      vtkIntArray::SafeDownCast(extraction->GetOutput()->GetRowData()->GetArray("bin_values"));
+    vtkIntArray* const values =
+      vtkIntArray::SafeDownCast(parallel->GetOutput()->GetRowData()->GetArray("bin_values"));
+    if (!expected || !values || expected->GetNumberOfTuples() != values->GetNumberOfTuples())
+    {
+      vtkGenericWarningMacro("parallel binning produced an incorrect number of bins.");
+      return 1;
+    }
+    for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+      if (expected->GetValue(i) != values->GetValue(i))
+      {
+        vtkGenericWarningMacro("incorrect parallel bin value.");
+        return 1;
+      }
+    }
+  }
   return 0;
 }
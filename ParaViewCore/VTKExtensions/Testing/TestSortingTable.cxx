@@ -164,6 +164,51 @@ int sortMagnitudeOnUnsignedCharVector()
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+int sortWithSampleSort(bool debug)
+{
+  const int size = 10;
+  const int blockSize = 3;
+  double dataArray[size] = { 0, 1, 2, 1, 3, 1, 3, 1, 2, 100000 };
+  double sortedArray[size] = { 0, 1, 1, 1, 1, 2, 2, 3, 3, 100000 };
+  double invertedArray[size] = { 100000, 3, 3, 2, 2, 1, 1, 1, 1, 0 };
+
+  vtkSmartPointer<vtkDoubleArray> dataToSort = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(dataToSort.GetPointer(), dataArray, size, "data");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(dataToSort);
+
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetColumnNameToSort("data");
+  sortingfilter->SampleSortOn();
+  sortingfilter->SetBlockSize(blockSize);
+
+  for (int invert = 0; invert < 2; invert++)
+  {
+    sortingfilter->SetInvertOrder(invert);
+    double* expected = invert ? invertedArray : sortedArray;
+    for (int block = 0; block * blockSize < size; block++)
+    {
+      sortingfilter->SetBlock(block);
+      sortingfilter->Update();
+
+      int offset = block * blockSize;
+      int count = (size - offset < blockSize) ? size - offset : blockSize;
+      if (!compareArray(sortingfilter->GetOutput(), "data", expected + offset, count, debug))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
 {
@@ -183,6 +228,8 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   cout << "Testing sorting with magnitude on unsigned char: "
        << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  cout << "Testing sample sort over several blocks: "
+       << ((result += sortWithSampleSort(debug)) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
 
   // Delete Fake MPI controller
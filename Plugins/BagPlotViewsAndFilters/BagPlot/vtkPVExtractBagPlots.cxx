@@ -7,17 +7,21 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPCAStatistics.h"
 #include "vtkPSciVizPCAStats.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkTransposeTable.h"
 
 #include <algorithm>
+#include <cmath>
 #include <set>
 #include <sstream>
 #include <string>
@@ -52,6 +56,150 @@ public:
   std::set<std::string> Columns;
 };
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Gaussian kernel density estimate of the 2D observations on the nodes of a
+// regular grid. The observations are linearly binned on the nodes in
+// parallel, then the bins are convolved with the separable kernel truncated
+// at 4 sigma. This costs O(N + G^2 R) instead of O(N G^2) for N observations,
+// G^2 nodes and a kernel radius of R nodes.
+void ComputeBinnedDensity(const double* obs, vtkIdType nbObs, const int dims[2],
+  const double origin[2], const double spacing[2], double sigma, double* density)
+{
+  const vtkIdType nbNodes = static_cast<vtkIdType>(dims[0]) * dims[1];
+  std::fill(density, density + nbNodes, 0.);
+  if (nbObs == 0 || sigma <= 0.)
+  {
+    return;
+  }
+
+  vtkSMPThreadLocal<std::vector<double> > localBins;
+  vtkSMPTools::For(0, nbObs, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double>& bins = localBins.Local();
+    bins.resize(nbNodes, 0.);
+    for (vtkIdType obsId = begin; obsId < end; ++obsId)
+    {
+      int index[2];
+      double weight[2];
+      for (int axis = 0; axis < 2; ++axis)
+      {
+        double pos =
+          spacing[axis] > 0. ? (obs[2 * obsId + axis] - origin[axis]) / spacing[axis] : 0.;
+        index[axis] = static_cast<int>(std::floor(pos));
+        weight[axis] = pos - index[axis];
+      }
+      for (int dj = 0; dj < 2; ++dj)
+      {
+        int j = index[1] + dj;
+        if (j < 0 || j >= dims[1])
+        {
+          continue;
+        }
+        double wy = dj ? weight[1] : 1. - weight[1];
+        for (int di = 0; di < 2; ++di)
+        {
+          int i = index[0] + di;
+          if (i < 0 || i >= dims[0])
+          {
+            continue;
+          }
+          bins[j * dims[0] + i] += wy * (di ? weight[0] : 1. - weight[0]);
+        }
+      }
+    }
+  });
+
+  std::vector<double> bins(nbNodes, 0.);
+  for (auto it = localBins.begin(); it != localBins.end(); ++it)
+  {
+    for (vtkIdType node = 0; node < static_cast<vtkIdType>(it->size()); ++node)
+    {
+      bins[node] += (*it)[node];
+    }
+  }
+
+  // Half kernels along each axis.
+  std::vector<double> kernels[2];
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    int radius = 0;
+    if (spacing[axis] > 0.)
+    {
+      radius = std::min(dims[axis] - 1, static_cast<int>(std::ceil(4. * sigma / spacing[axis])));
+    }
+    kernels[axis].resize(radius + 1);
+    for (int d = 0; d <= radius; ++d)
+    {
+      double x = d * spacing[axis] / sigma;
+      kernels[axis][d] = exp(-0.5 * x * x);
+    }
+  }
+
+  // Convolve along x, then along y.
+  std::vector<double> rows(nbNodes, 0.);
+  vtkSMPTools::For(0, dims[1], [&](int begin, int end) {
+    const std::vector<double>& kernel = kernels[0];
+    const int radius = static_cast<int>(kernel.size()) - 1;
+    for (int j = begin; j < end; ++j)
+    {
+      const double* in = &bins[j * dims[0]];
+      double* out = &rows[j * dims[0]];
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        double sum = kernel[0] * in[i];
+        for (int d = 1; d <= radius; ++d)
+        {
+          sum += kernel[d] * ((i >= d ? in[i - d] : 0.) + (i + d < dims[0] ? in[i + d] : 0.));
+        }
+        out[i] = sum;
+      }
+    }
+  });
+
+  const double norm = 1. / (2. * vtkMath::Pi() * sigma * sigma * nbObs);
+  vtkSMPTools::For(0, dims[1], [&](int begin, int end) {
+    const std::vector<double>& kernel = kernels[1];
+    const int radius = static_cast<int>(kernel.size()) - 1;
+    for (int j = begin; j < end; ++j)
+    {
+      double* out = density + j * dims[0];
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        double sum = kernel[0] * rows[j * dims[0] + i];
+        for (int d = 1; d <= radius; ++d)
+        {
+          sum += kernel[d] * ((j >= d ? rows[(j - d) * dims[0] + i] : 0.) +
+                               (j + d < dims[1] ? rows[(j + d) * dims[0] + i] : 0.));
+        }
+        out[i] = norm * sum;
+      }
+    }
+  });
+}
+
+// Bilinear interpolation of the density grid computed by ComputeBinnedDensity.
+double InterpolateDensity(const double* density, const int dims[2], const double origin[2],
+  const double spacing[2], const double* x)
+{
+  int index[2];
+  double weight[2];
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    double pos = spacing[axis] > 0. ? (x[axis] - origin[axis]) / spacing[axis] : 0.;
+    pos = std::max(0., std::min(pos, dims[axis] - 1.));
+    index[axis] = std::min(static_cast<int>(pos), std::max(dims[axis] - 2, 0));
+    weight[axis] = dims[axis] > 1 ? pos - index[axis] : 0.;
+  }
+  const int i1 = std::min(index[0] + 1, dims[0] - 1);
+  const int j1 = std::min(index[1] + 1, dims[1] - 1);
+  const double* row0 = density + index[1] * dims[0];
+  const double* row1 = density + j1 * dims[0];
+  return (1. - weight[1]) * ((1. - weight[0]) * row0[index[0]] + weight[0] * row0[i1]) +
+    weight[1] * ((1. - weight[0]) * row1[index[0]] + weight[0] * row1[i1]);
+}
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkPVExtractBagPlots);
 
@@ -62,6 +210,7 @@ vtkPVExtractBagPlots::vtkPVExtractBagPlots()
   this->RobustPCA = false;
   this->KernelWidth = 1.;
   this->UseSilvermanRule = false;
+  this->BinnedDensityEstimation = false;
   this->GridSize = 100;
   this->UserQuantile = 95;
   this->Internal = new PVExtractBagPlotsInternal();
@@ -113,6 +262,7 @@ void vtkPVExtractBagPlots::PrintSelf(ostream& os, vtkIndent indent)
   os << "KernelWidth: " << this->KernelWidth << std::endl;
   os << "UseSilvermanRule: " << this->UseSilvermanRule << std::endl;
   os << "GridSize: " << this->GridSize << std::endl;
+  os << "BinnedDensityEstimation: " << this->BinnedDensityEstimation << std::endl;
   os << "UserQuantile: " << this->UserQuantile << std::endl;
 }
 
@@ -323,41 +473,46 @@ int vtkPVExtractBagPlots::RequestData(
   hdrArrays[0]->GetRange(&bounds[0], 0);
   hdrArrays[1]->GetRange(&bounds[2], 0);
 
+  // Observations of the HDR, stored contiguously.
+  vtkNew<vtkDoubleArray> inObs;
+  inObs->SetNumberOfComponents(2);
+  inObs->SetNumberOfTuples(hdrArrays[0]->GetNumberOfTuples());
+
+  inObs->CopyComponent(0, hdrArrays[0], 0);
+  inObs->CopyComponent(1, hdrArrays[1], 0);
+  const double* obs = inObs->GetPointer(0);
+  const vtkIdType nbObs = inObs->GetNumberOfTuples();
+
   double sigma = this->KernelWidth;
   if (this->UseSilvermanRule)
   {
-    vtkIdType len = hdrArrays[0]->GetNumberOfTuples();
+    vtkIdType len = nbObs;
     double xMean = 0.0;
     for (vtkIdType i = 0; i < len; i++)
     {
-      xMean += hdrArrays[0]->GetTuple1(i);
+      xMean += obs[2 * i];
     }
     xMean /= len;
 
     sigma = 0.0;
     for (vtkIdType i = 0; i < len; i++)
     {
-      sigma += (hdrArrays[0]->GetTuple1(i) - xMean) * (hdrArrays[0]->GetTuple1(i) - xMean);
+      sigma += (obs[2 * i] - xMean) * (obs[2 * i] - xMean);
     }
     sigma /= len;
     sigma = sqrt(sigma) * pow(len, -1. / 6.);
   }
 
+  // The binned estimation derives the HDR of the observations from the grid.
   hdr->SetSigma(sigma);
   hdr->AddColumnPair("x0", "x1");
   hdr->SetLearnOption(true);
-  hdr->SetDeriveOption(true);
+  hdr->SetDeriveOption(!this->BinnedDensityEstimation);
   hdr->SetAssessOption(false);
   hdr->SetTestOption(false);
   hdr->Update();
 
   // Compute Grid
-  vtkNew<vtkDoubleArray> inObs;
-  inObs->SetNumberOfComponents(2);
-  inObs->SetNumberOfTuples(hdrArrays[0]->GetNumberOfTuples());
-
-  inObs->CopyComponent(0, hdrArrays[0], 0);
-  inObs->CopyComponent(1, hdrArrays[1], 0);
 
   // Add border to grid
   const double borderSize = 0.15;
@@ -392,7 +547,19 @@ int vtkPVExtractBagPlots::RequestData(
   outDens->SetNumberOfTuples(gridWidth * gridHeight);
 
   // Evaluate the HDR on every pixel of the grid
-  hdr->ComputeHDR(inObs.Get(), inPOI.Get(), outDens);
+  const int gridDims[2] = { gridWidth, gridHeight };
+  const double gridOrigin[2] = { bounds[0], bounds[2] };
+  const double gridSpacing[2] = { spaceX, spaceY };
+  vtkDoubleArray* binnedDens = vtkDoubleArray::SafeDownCast(outDens);
+  if (this->BinnedDensityEstimation && binnedDens)
+  {
+    ComputeBinnedDensity(
+      obs, nbObs, gridDims, gridOrigin, gridSpacing, sigma, binnedDens->GetPointer(0));
+  }
+  else
+  {
+    hdr->ComputeHDR(inObs.Get(), inPOI.Get(), outDens);
+  }
 
   vtkNew<vtkImageData> grid;
   grid->SetDimensions(gridWidth, gridHeight, 1);
@@ -465,6 +632,24 @@ int vtkPVExtractBagPlots::RequestData(
   vtkTable* outputHDRTable = vtkTable::SafeDownCast(outputHDR->GetBlock(0));
   outTable2 = outputHDRTable;
 
+  if (this->BinnedDensityEstimation && binnedDens)
+  {
+    // Interpolate the HDR of the observations from the density grid.
+    const double* gridDensities = binnedDens->GetPointer(0);
+    vtkNew<vtkDoubleArray> obsHdr;
+    obsHdr->SetName("HDR (x1,x0)");
+    obsHdr->SetNumberOfTuples(nbObs);
+    double* obsHdrPtr = obsHdr->GetPointer(0);
+    vtkSMPTools::For(0, nbObs, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType obsId = begin; obsId < end; ++obsId)
+      {
+        obsHdrPtr[obsId] =
+          InterpolateDensity(gridDensities, gridDims, gridOrigin, gridSpacing, obs + 2 * obsId);
+      }
+    });
+    outputHDRTable->AddColumn(obsHdr.Get());
+  }
+
   for (auto* arr : cArrays)
   {
     outTable2->AddColumn(arr);
@@ -94,6 +94,21 @@ public:
   vtkSetMacro(GridSize, int);
   //@}
 
+  //@{
+  /**
+   * Set/get if the density must be estimated on the grid by binning the
+   * observations on the grid nodes and convolving the bins with the Gaussian
+   * kernel, instead of summing the kernel of every observation at every grid
+   * node. The density of the observations is then interpolated from the
+   * grid. This is an approximation which scales linearly with the number of
+   * observations, to be used with large numbers of curves.
+   * Default is FALSE.
+   */
+  vtkGetMacro(BinnedDensityEstimation, bool);
+  vtkSetMacro(BinnedDensityEstimation, bool);
+  vtkBooleanMacro(BinnedDensityEstimation, bool);
+  //@}
+
   //@{
   /**
    * Set/get the user quantile (in percent). Beyond this threshold, input
@@ -133,6 +148,7 @@ protected:
   bool TransposeTable;
   bool RobustPCA;
   bool UseSilvermanRule;
+  bool BinnedDensityEstimation;
   int NumberOfProjectionAxes = 2;
 
 private:
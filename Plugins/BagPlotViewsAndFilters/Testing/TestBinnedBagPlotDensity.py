@@ -0,0 +1,64 @@
+from paraview.simple import *
+from paraview import servermanager
+
+# Checks that the BinnedDensityEstimation option of Extract Bag Plots
+# approximates the density grid, the HDR of the curves and the quantile
+# densities (TValues) computed by the exact kernel density estimation.
+
+LoadDistributedPlugin("BagPlotViewsAndFilters", remote=False, ns=globals())
+
+src = ProgrammableSource()
+src.OutputDataSetType = 'vtkTable'
+src.Script = """
+import math
+table = self.GetTableOutput()
+for c in range(120):
+    curve = vtk.vtkDoubleArray()
+    curve.SetName("curve%d" % c)
+    phase = (0.37 * c) % (2 * math.pi)
+    amplitude = 1.0 + 0.3 * math.sin(1.3 * c)
+    offset = 3.0 if c % 40 == 0 else 0.1 * math.cos(0.7 * c)
+    for t in range(40):
+        curve.InsertNextValue(amplitude * math.sin(0.2 * t + phase) + offset)
+    table.AddColumn(curve)
+"""
+src.UpdatePipeline()
+names = ["curve%d" % c for c in range(120)]
+
+def extract(binned):
+    bag = ExtractBagPlots(Input=src)
+    bag.SelectArrays = names
+    bag.BinnedDensityEstimation = binned
+    data = servermanager.Fetch(bag)
+    Delete(bag)
+    hdr = data.GetBlock(1).GetColumnByName("HDR (x1,x0)")
+    grid = data.GetBlock(2).GetPointData().GetScalars()
+    tvalues = data.GetBlock(3).GetColumnByName("TValues")
+    return ([hdr.GetValue(i) for i in range(hdr.GetNumberOfTuples())],
+            [grid.GetTuple1(i) for i in range(grid.GetNumberOfTuples())],
+            [tvalues.GetValue(i) for i in range(tvalues.GetNumberOfTuples())])
+
+exactHdr, exactGrid, exactTValues = extract(0)
+binnedHdr, binnedGrid, binnedTValues = extract(1)
+
+def maxError(values, expected):
+    assert len(values) == len(expected)
+    return max(abs(v - e) for v, e in zip(values, expected)) / max(expected)
+
+gridError = maxError(binnedGrid, exactGrid)
+hdrError = maxError(binnedHdr, exactHdr)
+print("grid error", gridError, "HDR error", hdrError)
+print("exact TValues", exactTValues)
+print("binned TValues", binnedTValues)
+
+assert gridError < 0.02
+assert hdrError < 0.03
+
+# TValues holds 50, p50, the user quantile, pUser, the explained variance
+# and the kernel width, which do not depend on the density estimation.
+assert len(binnedTValues) == 6
+for i in [0, 2, 4, 5]:
+    assert abs(binnedTValues[i] - exactTValues[i]) <= 1e-9 * max(1., abs(exactTValues[i]))
+for i in [1, 3]:
+    assert exactTValues[i] > 0
+    assert abs(binnedTValues[i] - exactTValues[i]) < 0.05 * exactTValues[i]
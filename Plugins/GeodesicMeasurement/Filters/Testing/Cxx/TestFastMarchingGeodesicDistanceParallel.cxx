@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestFastMarchingGeodesicDistanceParallel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the ParallelMarching option of vtkFastMarchingGeodesicDistance on a
+// triangulated sphere. The parallel field must be close to the field of the
+// serial fast marching, and adding a seed to a previous execution, which only
+// marches from the new seed, must give the field computed from scratch.
+
+#include "vtkDataArray.h"
+#include "vtkFastMarchingGeodesicDistance.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> ComputeField(
+  vtkFastMarchingGeodesicDistance* filter, vtkIdList* seeds, bool parallel)
+{
+  filter->SetFieldDataName("Distance");
+  filter->SetParallelMarching(parallel);
+  filter->SetSeeds(seeds);
+  filter->Update();
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  output->DeepCopy(filter->GetOutput());
+  return output;
+}
+
+// Largest difference between two distance fields, relative to the largest
+// distance of the reference field. Every point must have been visited.
+double GetFieldDifference(vtkPolyData* field, vtkPolyData* reference)
+{
+  vtkDataArray* distance = field->GetPointData()->GetArray("Distance");
+  vtkDataArray* expected = reference->GetPointData()->GetArray("Distance");
+  if (!distance || !expected || distance->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    return VTK_DOUBLE_MAX;
+  }
+  double difference = 0.0;
+  double maximum = 0.0;
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfTuples(); ++cc)
+  {
+    if (distance->GetTuple1(cc) < 0 || expected->GetTuple1(cc) < 0)
+    {
+      return VTK_DOUBLE_MAX;
+    }
+    difference = std::max(difference, std::fabs(distance->GetTuple1(cc) - expected->GetTuple1(cc)));
+    maximum = std::max(maximum, expected->GetTuple1(cc));
+  }
+  return maximum > 0 ? difference / maximum : VTK_DOUBLE_MAX;
+}
+
+bool TestSerialAndParallel(vtkSphereSource* sphere, vtkIdList* seeds)
+{
+  vtkNew<vtkFastMarchingGeodesicDistance> serial;
+  serial->SetInputConnection(sphere->GetOutputPort());
+  auto expected = ComputeField(serial, seeds, false);
+
+  vtkNew<vtkFastMarchingGeodesicDistance> parallel;
+  parallel->SetInputConnection(sphere->GetOutputPort());
+  auto field = ComputeField(parallel, seeds, true);
+
+  // obtuse triangles are not unfolded by the parallel solver.
+  double difference = GetFieldDifference(field, expected);
+  cout << "Parallel and serial fields differ by " << difference << endl;
+  TASSERT(difference < 0.02);
+  TASSERT(parallel->GetNumberOfVisitedPoints() == serial->GetNumberOfVisitedPoints());
+  TASSERT(std::fabs(parallel->GetMaximumDistance() - serial->GetMaximumDistance()) <
+    0.02 * serial->GetMaximumDistance());
+  return true;
+}
+
+bool TestAddedSeed(vtkSphereSource* sphere, vtkIdList* seeds, vtkIdType addedSeed)
+{
+  vtkNew<vtkIdList> allSeeds;
+  allSeeds->DeepCopy(seeds);
+  allSeeds->InsertNextId(addedSeed);
+
+  vtkNew<vtkFastMarchingGeodesicDistance> scratch;
+  scratch->SetInputConnection(sphere->GetOutputPort());
+  auto expected = ComputeField(scratch, allSeeds, true);
+
+  // the second execution only adds a seed, so it starts from the first field.
+  vtkNew<vtkFastMarchingGeodesicDistance> incremental;
+  incremental->SetInputConnection(sphere->GetOutputPort());
+  auto first = ComputeField(incremental, seeds, true);
+  auto field = ComputeField(incremental, allSeeds, true);
+
+  TASSERT(GetFieldDifference(first, expected) > 0.1);
+  double difference = GetFieldDifference(field, expected);
+  cout << "Incremental and from scratch fields differ by " << difference << endl;
+  TASSERT(difference < 1e-4);
+  TASSERT(incremental->GetNumberOfVisitedPoints() == scratch->GetNumberOfVisitedPoints());
+  return true;
+}
+}
+
+int TestFastMarchingGeodesicDistanceParallel(int, char* [])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(48);
+  sphere->SetPhiResolution(48);
+  sphere->Update();
+  const vtkIdType numPoints = sphere->GetOutput()->GetNumberOfPoints();
+
+  // the north pole, and then a point on the other side of the sphere.
+  vtkNew<vtkIdList> seeds;
+  seeds->InsertNextId(0);
+  if (!TestSerialAndParallel(sphere, seeds) || !TestAddedSeed(sphere, seeds, numPoints / 2))
+  {
+    return EXIT_FAILURE;
+  }
+
+  seeds->InsertNextId(numPoints / 3);
+  if (!TestSerialAndParallel(sphere, seeds) || !TestAddedSeed(sphere, seeds, 1))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
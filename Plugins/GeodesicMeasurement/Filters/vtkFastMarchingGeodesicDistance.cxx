@@ -31,13 +31,19 @@
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include "gw_core/GW_Face.h"
 #include "gw_core/GW_Vertex.h"
 #include "gw_geodesic/GW_GeodesicMesh.h"
 #include "gw_geodesic/GW_GeodesicPath.h"
+#include <algorithm>
 #include <assert.h>
+#include <iterator>
+#include <limits>
 #include <set>
+#include <vector>
 
 #ifdef _WIN32
 // new is being defined to a new method that takes in 4 parameters.
@@ -53,11 +59,26 @@ vtkCxxSetObjectMacro(vtkFastMarchingGeodesicDistance, DestinationVertexStopCrite
 vtkCxxSetObjectMacro(vtkFastMarchingGeodesicDistance, ExclusionPointIds, vtkIdList);
 vtkCxxSetObjectMacro(vtkFastMarchingGeodesicDistance, PropagationWeights, vtkDataArray);
 
+//-----------------------------------------------------------------------------
+static const double vtkGeodesicInfinity = std::numeric_limits<double>::infinity();
+
+// Relative change below which the parallel solver considers a distance
+// converged.
+static const double vtkGeodesicConvergenceTolerance = 1e-6;
+
 //-----------------------------------------------------------------------------
 class vtkGeodesicMeshInternals
 {
 public:
-  vtkGeodesicMeshInternals() { this->Mesh = NULL; }
+  vtkGeodesicMeshInternals()
+  {
+    this->Mesh = NULL;
+    this->FieldDistanceStopCriterion = -1;
+    this->FieldWeights = NULL;
+    this->FieldWeightsMTime = 0;
+    this->FieldExclusion = NULL;
+    this->FieldExclusionMTime = 0;
+  }
 
   ~vtkGeodesicMeshInternals()
   {
@@ -130,7 +151,213 @@ public:
     return 1.0;
   }
 
+  // Local update of the distance at a vertex from a triangle whose two other
+  // vertices have distances d1 <= d2, at distances b and a from it. This is
+  // the update GW_GeodesicMesh::ComputeUpdate_SethianMethod, which is private
+  // to the toolkit, does.
+  static double ComputeUpdate(double d1, double d2, double a, double b, double dot, double F)
+  {
+    double t = -vtkGeodesicInfinity;
+    double cosAngle = dot;
+    double sinAngle = sqrt(1 - dot * dot);
+
+    double u = d2 - d1;
+    double f2 = a * a + b * b - 2 * a * b * cosAngle;
+    double f1 = b * u * (a * cosAngle - b);
+    double f0 = b * b * (u * u - F * F * a * a * sinAngle * sinAngle);
+    double delta = f1 * f1 - f0 * f2;
+    if (delta >= 0)
+    {
+      if (fabs(f2) > GW_EPSILON)
+      {
+        t = (-f1 - sqrt(delta)) / f2;
+        if (t < u || b * (t - u) / t < a * cosAngle || a / cosAngle < b * (t - u) / t)
+        {
+          t = (-f1 + sqrt(delta)) / f2;
+        }
+      }
+      else if (f1 != 0)
+      {
+        t = -f0 / f1;
+      }
+    }
+
+    // Use the update from both vertices only if it is upwind
+    if (u < t && a * cosAngle < b * (t - u) / t && b * (t - u) / t < a / cosAngle)
+    {
+      return t + d1;
+    }
+    return std::min(b * F + d1, a * F + d2);
+  }
+
+  // Distance at a vertex computed from the current distances of its
+  // neighbors. Only reads shared state, so it may run on several threads.
+  double SolveVertex(GW::GW_Vertex* vertex)
+  {
+    double F = this->Weights.empty() ? 1.0 : this->Weights[vertex->GetID()];
+    double distance = vtkGeodesicInfinity;
+    for (GW::GW_FaceIterator it = vertex->BeginFaceIterator(); it != vertex->EndFaceIterator();
+         ++it)
+    {
+      GW::GW_Face* face = *it;
+      GW::GW_Vertex* vertex1 = face->GetNextVertex(*vertex);
+      GW::GW_Vertex* vertex2 = face->GetNextVertex(*vertex1);
+      double d1 = this->Distance[vertex1->GetID()];
+      double d2 = this->Distance[vertex2->GetID()];
+      if (d1 > d2)
+      {
+        std::swap(vertex1, vertex2);
+        std::swap(d1, d2);
+      }
+      if (d1 == vtkGeodesicInfinity)
+      {
+        continue;
+      }
+
+      GW::GW_Vector3D edge1 = vertex1->GetPosition() - vertex->GetPosition();
+      double b = edge1.Norm();
+      if (d2 == vtkGeodesicInfinity)
+      {
+        // only one point is a contributor
+        distance = std::min(distance, d1 + b * F);
+        continue;
+      }
+      GW::GW_Vector3D edge2 = vertex2->GetPosition() - vertex->GetPosition();
+      double a = edge2.Norm();
+      edge1 /= b;
+      edge2 /= a;
+      distance = std::min(distance, ComputeUpdate(d1, d2, a, b, edge1 * edge2, F));
+    }
+    return distance;
+  }
+
+  // Fast iterative method (Jeong and Whitaker). The vertices in 'converged'
+  // have their final distance. Their neighbors are activated, and the active
+  // vertices are updated by all threads at once until their distance stops
+  // changing, at which point they activate their own neighbors. Vertices
+  // farther than stopDistance (if positive) do not activate their neighbors.
+  void March(
+    vtkFastMarchingGeodesicDistance* filter, std::vector<vtkIdType> converged, double stopDistance)
+  {
+    GW::GW_GeodesicMesh* mesh = this->Mesh;
+    std::vector<vtkIdType> active;
+    std::vector<vtkIdType> next;
+    std::vector<vtkIdType> candidates;
+    std::vector<double> values;
+    std::vector<char> marked(this->Distance.size(), 0);
+
+    while (!converged.empty() || !active.empty())
+    {
+      // Gather the neighbors of the vertices that converged
+      vtkSMPThreadLocal<std::vector<vtkIdType> > localCandidates;
+      vtkSMPTools::For(0, static_cast<vtkIdType>(converged.size()),
+        [&](vtkIdType begin, vtkIdType end) {
+          std::vector<vtkIdType>& found = localCandidates.Local();
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            vtkIdType id = converged[i];
+            if (stopDistance > 0 && this->Distance[id] > stopDistance)
+            {
+              continue;
+            }
+            GW::GW_Vertex* vertex = mesh->GetVertex(static_cast<GW::GW_U32>(id));
+            for (GW::GW_VertexIterator it = vertex->BeginVertexIterator();
+                 it != vertex->EndVertexIterator(); ++it)
+            {
+              vtkIdType neighbor = (*it)->GetID();
+              if (!this->InActiveList[neighbor] && !this->Excluded[neighbor])
+              {
+                found.push_back(neighbor);
+              }
+            }
+          }
+        });
+      candidates.clear();
+      for (auto iter = localCandidates.begin(); iter != localCandidates.end(); ++iter)
+      {
+        for (vtkIdType id : *iter)
+        {
+          if (!marked[id])
+          {
+            marked[id] = 1;
+            candidates.push_back(id);
+          }
+        }
+      }
+      for (vtkIdType id : candidates)
+      {
+        marked[id] = 0;
+      }
+
+      // The candidates whose distance improves join the active list
+      values.resize(candidates.size());
+      vtkSMPTools::For(0, static_cast<vtkIdType>(candidates.size()),
+        [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            values[i] = this->SolveVertex(mesh->GetVertex(static_cast<GW::GW_U32>(candidates[i])));
+          }
+        });
+      for (size_t i = 0; i < candidates.size(); i++)
+      {
+        vtkIdType id = candidates[i];
+        if (values[i] * (1 + vtkGeodesicConvergenceTolerance) < this->Distance[id])
+        {
+          this->Distance[id] = values[i];
+          this->InActiveList[id] = 1;
+          active.push_back(id);
+        }
+      }
+
+      // Update the active vertices. The new distances are all computed before
+      // any is stored, so that the threads only read the distance field.
+      values.resize(active.size());
+      vtkSMPTools::For(0, static_cast<vtkIdType>(active.size()),
+        [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            values[i] = this->SolveVertex(mesh->GetVertex(static_cast<GW::GW_U32>(active[i])));
+          }
+        });
+      converged.clear();
+      next.clear();
+      for (size_t i = 0; i < active.size(); i++)
+      {
+        vtkIdType id = active[i];
+        double previous = this->Distance[id];
+        double distance = std::min(previous, values[i]);
+        this->Distance[id] = distance;
+        if (previous - distance <= vtkGeodesicConvergenceTolerance * distance)
+        {
+          this->InActiveList[id] = 0;
+          converged.push_back(id);
+        }
+        else
+        {
+          next.push_back(id);
+        }
+      }
+      active.swap(next);
+
+      filter->InvokeEvent(vtkFastMarchingGeodesicDistance::IterationEvent);
+    }
+  }
+
   GW::GW_GeodesicMesh* Mesh;
+
+  // State of the parallel solver: the distance field of the last execution,
+  // and what it was computed with, so that added seeds can update it.
+  std::vector<double> Distance;
+  std::vector<char> InActiveList;
+  std::vector<char> Excluded;
+  std::vector<double> Weights;
+  std::vector<vtkIdType> FieldSeeds;
+  vtkTimeStamp FieldTime;
+  float FieldDistanceStopCriterion;
+  vtkDataArray* FieldWeights;
+  vtkMTimeType FieldWeightsMTime;
+  vtkIdList* FieldExclusion;
+  vtkMTimeType FieldExclusionMTime;
 };
 
 //-----------------------------------------------------------------------------
@@ -144,6 +371,7 @@ vtkFastMarchingGeodesicDistance::vtkFastMarchingGeodesicDistance()
   this->DestinationVertexStopCriterion = NULL;
   this->ExclusionPointIds = NULL;
   this->PropagationWeights = NULL;
+  this->ParallelMarching = false;
   this->IterationIndex = 0;
   this->FastMarchingIterationEventResolution = 100;
 }
@@ -333,6 +561,16 @@ int vtkFastMarchingGeodesicDistance::Compute()
 {
   this->MaximumDistance = 0;
 
+  if (!this->Internals->Mesh)
+  {
+    return 0;
+  }
+
+  if (this->ParallelMarching)
+  {
+    return this->ComputeParallel();
+  }
+
   this->Internals->Mesh->SetUpFastMarching();
 
   // Do the fast marching
@@ -350,6 +588,126 @@ int vtkFastMarchingGeodesicDistance::Compute()
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+int vtkFastMarchingGeodesicDistance::ComputeParallel()
+{
+  vtkGeodesicMeshInternals* internals = this->Internals;
+  GW::GW_GeodesicMesh* mesh = internals->Mesh;
+  const vtkIdType n = mesh->GetNbrVertex();
+
+  // Sorted, so that they can be compared with the seeds of the last execution
+  std::vector<vtkIdType> seeds;
+  for (vtkIdType i = 0; this->Seeds && i < this->Seeds->GetNumberOfIds(); i++)
+  {
+    vtkIdType id = this->Seeds->GetId(i);
+    if (id >= 0 && id < n)
+    {
+      seeds.push_back(id);
+    }
+  }
+  std::sort(seeds.begin(), seeds.end());
+  seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+  vtkMTimeType weightsMTime = this->PropagationWeights ? this->PropagationWeights->GetMTime() : 0;
+  vtkMTimeType exclusionMTime = this->ExclusionPointIds ? this->ExclusionPointIds->GetMTime() : 0;
+
+  // Distances only decrease when seeds are added, so if nothing else changed
+  // the last field is a valid starting point and only the new seeds march.
+  bool incremental = internals->FieldTime > this->GeodesicMeshBuildTime &&
+    static_cast<vtkIdType>(internals->Distance.size()) == n &&
+    internals->FieldDistanceStopCriterion == this->DistanceStopCriterion &&
+    internals->FieldWeights == this->PropagationWeights &&
+    internals->FieldWeightsMTime == weightsMTime &&
+    internals->FieldExclusion == this->ExclusionPointIds &&
+    internals->FieldExclusionMTime == exclusionMTime &&
+    std::includes(
+      seeds.begin(), seeds.end(), internals->FieldSeeds.begin(), internals->FieldSeeds.end());
+
+  std::vector<vtkIdType> newSeeds;
+  if (incremental)
+  {
+    std::set_difference(seeds.begin(), seeds.end(), internals->FieldSeeds.begin(),
+      internals->FieldSeeds.end(), std::back_inserter(newSeeds));
+  }
+  else
+  {
+    internals->Distance.assign(n, vtkGeodesicInfinity);
+    internals->InActiveList.assign(n, 0);
+    internals->Excluded.assign(n, 0);
+    for (vtkIdType i = 0; this->ExclusionPointIds && i < this->ExclusionPointIds->GetNumberOfIds();
+         i++)
+    {
+      vtkIdType id = this->ExclusionPointIds->GetId(i);
+      if (id >= 0 && id < n)
+      {
+        internals->Excluded[id] = 1;
+      }
+    }
+    // Copied, since reading a vtkDataArray is not thread safe in general
+    internals->Weights.clear();
+    if (this->PropagationWeights && this->PropagationWeights->GetNumberOfTuples() == n)
+    {
+      internals->Weights.resize(n);
+      for (vtkIdType i = 0; i < n; i++)
+      {
+        internals->Weights[i] = this->PropagationWeights->GetTuple1(i);
+      }
+    }
+    newSeeds = seeds;
+  }
+
+  for (vtkIdType id : newSeeds)
+  {
+    internals->Distance[id] = 0;
+  }
+  internals->March(this, newSeeds, this->DistanceStopCriterion);
+
+  internals->FieldSeeds.swap(seeds);
+  internals->FieldDistanceStopCriterion = this->DistanceStopCriterion;
+  internals->FieldWeights = this->PropagationWeights;
+  internals->FieldWeightsMTime = weightsMTime;
+  internals->FieldExclusion = this->ExclusionPointIds;
+  internals->FieldExclusionMTime = exclusionMTime;
+  internals->FieldTime.Modified();
+
+  // The field converges as a whole, so the termination criteria are applied
+  // afterwards: vertices beyond the stop distance or farther than the closest
+  // destination vertex count as not visited.
+  double limit = vtkGeodesicInfinity;
+  if (this->DistanceStopCriterion > 0)
+  {
+    limit = this->DistanceStopCriterion;
+  }
+  for (vtkIdType i = 0; this->DestinationVertexStopCriterion &&
+       i < this->DestinationVertexStopCriterion->GetNumberOfIds();
+       i++)
+  {
+    vtkIdType id = this->DestinationVertexStopCriterion->GetId(i);
+    if (id >= 0 && id < n)
+    {
+      limit = std::min(limit, internals->Distance[id]);
+    }
+  }
+
+  // Store the field in the geodesic mesh, where CopyDistanceField and
+  // vtkFastMarchingGeodesicPath read it from.
+  vtkSMPTools::For(0, n, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      double distance = internals->Distance[i];
+      if (distance < vtkGeodesicInfinity && distance <= limit)
+      {
+        GW::GW_GeodesicVertex* vertex =
+          static_cast<GW::GW_GeodesicVertex*>(mesh->GetVertex(static_cast<GW::GW_U32>(i)));
+        vertex->SetDistance(distance);
+        vertex->SetState(GW::GW_GeodesicVertex::kDead);
+      }
+    }
+  });
+
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 void vtkFastMarchingGeodesicDistance::CopyDistanceField(vtkPolyData* pd)
 {
@@ -492,6 +850,7 @@ void vtkFastMarchingGeodesicDistance::PrintSelf(ostream& os, vtkIndent indent)
   {
     this->PropagationWeights->PrintSelf(os, indent.GetNextIndent());
   }
+  os << indent << "ParallelMarching: " << this->ParallelMarching << endl;
   os << indent
      << "FastMarchingIterationEventResolution: " << this->FastMarchingIterationEventResolution
      << endl;
@@ -60,6 +60,18 @@
 // propagate quickly in regions of low curvature and slow down in regions of
 // high curvature. Note that the propagation weights must be strictly positive.
 //
+// .SECTION Parallel marching
+// With ParallelMarching on, the distance field is computed by a multi-threaded
+// solver (fast iterative method, Jeong and Whitaker 2008) instead of the serial
+// fast marching of the toolkit. All seeds propagate concurrently: the vertices
+// of an active list are updated by all threads at once, and leave the list
+// when their distance converges. When the only change since the previous
+// execution is that seeds were added, the previous field is kept and only the
+// region that gets closer to the new seeds is recomputed, which is what makes
+// interactive seed placement on large meshes practical. Obtuse triangles are
+// not unfolded in this mode, so the distances may differ slightly from the
+// serial computation.
+//
 // .SECTION Miscellaneous
 // The filter reports IterationEvents. It does not report progress events,
 // since its not possible to pre-determine when the front might terminate.
@@ -139,6 +151,14 @@ public:
   virtual void SetPropagationWeights(vtkDataArray*);
   vtkGetObjectMacro(PropagationWeights, vtkDataArray);
 
+  // Description:
+  // Compute the distance field with the parallel solver described above,
+  // updating the previous field incrementally when seeds were only added.
+  // Off by default.
+  vtkSetMacro(ParallelMarching, bool);
+  vtkGetMacro(ParallelMarching, bool);
+  vtkBooleanMacro(ParallelMarching, bool);
+
   // Description:
   // Events invoked by the filter
 
@@ -162,6 +182,9 @@ protected:
   // Do the fast marching
   int Compute() override;
 
+  // Do the marching with the parallel solver
+  int ComputeParallel();
+
   // Add the seeds
   virtual void AddSeedsInternal();
 
@@ -198,6 +221,9 @@ protected:
   // Propagation, ie speed function weights
   vtkDataArray* PropagationWeights;
 
+  // Use the parallel solver
+  bool ParallelMarching;
+
   friend class vtkFastMarchingGeodesicPath;
   friend class vtkGeodesicMeshInternals;
   void* GetGeodesicMesh();
@@ -15,6 +15,7 @@
 
 #include "vtkLagrangianSeedHelper.h"
 
+#include "vtkAbstractCellLocator.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
@@ -23,6 +24,8 @@
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLagrangianBasicIntegrationModel.h"
@@ -30,10 +33,33 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 
+namespace
+{
+// Number of seeds located together when seeding in parallel. Each batch starts
+// with an empty cell cache, so results only depend on the seed ordering.
+const vtkIdType LAGRANGIAN_SEED_BATCH_SIZE = 1024;
+
+// Tolerance used when locating seeds in the flow datasets.
+const double LAGRANGIAN_SEED_TOLERANCE = 1.0e-8;
+
+enum SeedingStatus
+{
+  SEEDING_OK = 0,
+  SEEDING_MISSING_ARRAY = 1,
+  SEEDING_WRONG_COMPONENTS = 2
+};
+}
+
 vtkStandardNewMacro(vtkLagrangianSeedHelper);
 
 class vtkLagrangianSeedHelper::vtkInternals
@@ -62,6 +88,57 @@ public:
     std::string FlowArray;
   } ArrayVal;
   std::vector<ArrayVal> ArraysToGenerate;
+
+  // Flow datasets, and the locators used to find seeds in them when seeding in
+  // parallel. Locators are built once, then only queried concurrently.
+  std::vector<vtkSmartPointer<vtkDataSet> > FlowDataSets;
+  std::vector<vtkSmartPointer<vtkAbstractCellLocator> > FlowLocators;
+
+  void BuildFlowLocators()
+  {
+    this->FlowLocators.clear();
+    for (vtkDataSet* ds : this->FlowDataSets)
+    {
+      // Image data and rectilinear grids find their cells without a locator,
+      // as in the integration model.
+      vtkSmartPointer<vtkAbstractCellLocator> locator;
+      if (!vtkImageData::SafeDownCast(ds) && !vtkRectilinearGrid::SafeDownCast(ds))
+      {
+        locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+        locator->SetDataSet(ds);
+        locator->CacheCellBoundsOn();
+        locator->AutomaticOn();
+        locator->BuildLocator();
+      }
+      this->FlowLocators.push_back(locator);
+    }
+  }
+
+  // Find the cell containing x in the flow datasets, skipping duplicated ghost
+  // cells. Only the provided cell is modified, so this can be called
+  // concurrently with a cell per thread.
+  bool FindInFlow(
+    double* x, vtkGenericCell* cell, vtkDataSet*& dataset, vtkIdType& cellId, double* weights)
+  {
+    double pcoords[3];
+    int subId;
+    for (size_t iDs = 0; iDs < this->FlowDataSets.size(); iDs++)
+    {
+      dataset = this->FlowDataSets[iDs];
+      vtkAbstractCellLocator* locator = this->FlowLocators[iDs];
+      cellId = locator
+        ? locator->FindCell(x, LAGRANGIAN_SEED_TOLERANCE, cell, pcoords, weights)
+        : dataset->FindCell(
+            x, nullptr, cell, -1, LAGRANGIAN_SEED_TOLERANCE, subId, pcoords, weights);
+      vtkUnsignedCharArray* ghosts = dataset->GetCellGhostArray();
+      if (cellId >= 0 &&
+        !(ghosts && (ghosts->GetValue(cellId) & vtkDataSetAttributes::DUPLICATECELL)))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 //---------------------------------------------------------------------------
@@ -69,6 +146,7 @@ vtkLagrangianSeedHelper::vtkLagrangianSeedHelper()
 {
   this->Internals = new vtkInternals();
   this->SetNumberOfInputPorts(2);
+  this->ParallelSeeding = false;
 }
 
 //---------------------------------------------------------------------------
@@ -109,6 +187,8 @@ int vtkLagrangianSeedHelper::RequestData(
 
   // Clear previously setup flow
   this->IntegrationModel->ClearDataSets();
+  this->Internals->FlowDataSets.clear();
+  this->Internals->FlowLocators.clear();
 
   // Check flow dataset type
   vtkCompositeDataSet* hdFlow = vtkCompositeDataSet::SafeDownCast(flow);
@@ -125,6 +205,7 @@ int vtkLagrangianSeedHelper::RequestData(
       {
         // Add each leaf to the integration model
         this->IntegrationModel->AddDataSet(ds);
+        this->Internals->FlowDataSets.push_back(ds);
       }
     }
   }
@@ -132,6 +213,7 @@ int vtkLagrangianSeedHelper::RequestData(
   {
     // Add dataset to integration model
     this->IntegrationModel->AddDataSet(dsFlow);
+    this->Internals->FlowDataSets.push_back(dsFlow);
   }
   else
   {
@@ -160,6 +242,16 @@ int vtkLagrangianSeedHelper::RequestData(
         seedArray->FillComponent(j, arrayVal.Constants[j]);
       }
     }
+    else if (this->ParallelSeeding)
+    {
+      // Flow data, interpolated by batches of seeds
+      if (!this->GenerateFlowArrayInParallel(
+            output, seedArray, arrayVal.FlowFieldAssociation, arrayVal.FlowArray.c_str()))
+      {
+        seedArray->Delete();
+        return 0;
+      }
+    }
     else
     {
       // Flow data
@@ -240,6 +332,132 @@ int vtkLagrangianSeedHelper::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkLagrangianSeedHelper::GenerateFlowArrayInParallel(
+  vtkDataSet* output, vtkDataArray* seedArray, int association, const char* flowArrayName)
+{
+  const vtkIdType numberOfSeeds = output->GetNumberOfPoints();
+  const vtkIdType numberOfBatches =
+    (numberOfSeeds + LAGRANGIAN_SEED_BATCH_SIZE - 1) / LAGRANGIAN_SEED_BATCH_SIZE;
+  const int numberOfComponents = seedArray->GetNumberOfComponents();
+  const int weightsSize = this->IntegrationModel->GetWeightsSize();
+  const bool cellData = association == vtkDataObject::FIELD_ASSOCIATION_CELLS;
+  vtkInternals* internals = this->Internals;
+
+  // The integration model locators are not re-entrant, so seeds are located with
+  // locators of our own, built once for all the generated arrays. Their queries
+  // only modify the cell of the calling thread and need no lock.
+  if (internals->FlowLocators.size() != internals->FlowDataSets.size())
+  {
+    internals->BuildFlowLocators();
+  }
+  std::atomic<int> status(SEEDING_OK);
+
+  vtkSMPTools::For(0, numberOfBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    // The cached cell is only written once a seed has been located, as the
+    // locators overwrite the cell they are given with the candidates they try.
+    vtkNew<vtkGenericCell> cell;
+    vtkNew<vtkGenericCell> candidateCell;
+    std::vector<double> weights(std::max(weightsSize, 1));
+    std::vector<double> tuple(numberOfComponents, 0.);
+    const std::vector<double> zeros(numberOfComponents, 0.);
+    vtkSmartPointer<vtkDataArray> tmpArray;
+    double x[3], closest[3], pcoords[3], dist2;
+    int subId;
+
+    for (vtkIdType batch = beginBatch; batch < endBatch; batch++)
+    {
+      if (status != SEEDING_OK)
+      {
+        return;
+      }
+
+      // Per batch cache of the last located cell
+      vtkDataSet* cachedDataset = nullptr;
+      vtkDataArray* cachedFlowArray = nullptr;
+      vtkIdType cachedCellId = -1;
+
+      const vtkIdType begin = batch * LAGRANGIAN_SEED_BATCH_SIZE;
+      const vtkIdType end = std::min(begin + LAGRANGIAN_SEED_BATCH_SIZE, numberOfSeeds);
+      for (vtkIdType iPt = begin; iPt < end; iPt++)
+      {
+        output->GetPoint(iPt, x);
+        double* weightsPtr = weights.data();
+        bool found = cachedDataset &&
+          cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weightsPtr) == 1;
+        if (!found)
+        {
+          vtkDataSet* dataset;
+          vtkIdType cellId;
+          found = internals->FindInFlow(x, candidateCell, dataset, cellId, weightsPtr);
+          if (found)
+          {
+            if (dataset != cachedDataset)
+            {
+              cachedFlowArray = cellData
+                ? dataset->GetCellData()->GetArray(flowArrayName)
+                : dataset->GetPointData()->GetArray(flowArrayName);
+              if (!cachedFlowArray)
+              {
+                status = SEEDING_MISSING_ARRAY;
+                return;
+              }
+              if (cachedFlowArray->GetNumberOfComponents() != numberOfComponents)
+              {
+                status = SEEDING_WRONG_COMPONENTS;
+                return;
+              }
+            }
+            cachedDataset = dataset;
+            cachedCellId = cellId;
+            dataset->GetCell(cellId, cell);
+          }
+        }
+
+        if (!found)
+        {
+          // Default value is zero
+          seedArray->SetTuple(iPt, zeros.data());
+        }
+        else if (cellData)
+        {
+          // Cell data do not need interpolation
+          cachedFlowArray->GetTuple(cachedCellId, tuple.data());
+          seedArray->SetTuple(iPt, tuple.data());
+        }
+        else
+        {
+          // PointData need interpolation, in an array of the flow type as in serial
+          if (!tmpArray || tmpArray->GetDataType() != cachedFlowArray->GetDataType())
+          {
+            tmpArray.TakeReference(cachedFlowArray->NewInstance());
+            tmpArray->SetNumberOfComponents(numberOfComponents);
+            tmpArray->SetNumberOfTuples(1);
+          }
+          tmpArray->InterpolateTuple(0, cell->GetPointIds(), cachedFlowArray, weightsPtr);
+          tmpArray->GetTuple(0, tuple.data());
+          seedArray->SetTuple(iPt, tuple.data());
+        }
+      }
+    }
+  });
+
+  const char* location = cellData ? "cell" : "point";
+  switch (status.load())
+  {
+    case SEEDING_MISSING_ARRAY:
+      vtkErrorMacro(
+        "Could not find " << flowArrayName << " array in flow " << location << " data. Aborting");
+      return 0;
+    case SEEDING_WRONG_COMPONENTS:
+      vtkErrorMacro(<< flowArrayName << " " << location
+                    << " data flow array does not have the right number of components. Aborting");
+      return 0;
+    default:
+      return 1;
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkLagrangianSeedHelper::RequestDataObject(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -292,6 +510,7 @@ int vtkLagrangianSeedHelper::RequestDataObject(
 void vtkLagrangianSeedHelper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ParallelSeeding: " << this->ParallelSeeding << endl;
 }
 
 //----------------------------------------------------------------------------
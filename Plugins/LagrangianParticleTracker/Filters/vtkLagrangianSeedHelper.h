@@ -28,6 +28,9 @@
 #include "vtkLagrangianHelperBase.h"
 #include "vtkLagrangianParticleTrackerModule.h" // for export macro
 
+class vtkDataArray;
+class vtkDataSet;
+
 class VTKLAGRANGIANPARTICLETRACKER_EXPORT vtkLagrangianSeedHelper : public vtkLagrangianHelperBase
 {
 public:
@@ -67,6 +70,19 @@ public:
   void SetArrayToGenerate(int i, const char* arrayName, int type, int flowOrConstant,
     int numberOfComponents, const char* arrayValues) override;
 
+  //@{
+  /**
+   * Set/Get whether flow arrays are interpolated on seeds using multiple threads.
+   * Seeds are processed in fixed size batches, each batch keeping its own cache
+   * of the last located cell, so the generated values do not depend on the
+   * number of threads. Other seeds are located concurrently with static cell
+   * locators built for the flow datasets. Default is false.
+   */
+  vtkSetMacro(ParallelSeeding, bool);
+  vtkGetMacro(ParallelSeeding, bool);
+  vtkBooleanMacro(ParallelSeeding, bool);
+  //@}
+
 protected:
   vtkLagrangianSeedHelper();
   ~vtkLagrangianSeedHelper() override;
@@ -81,6 +97,16 @@ protected:
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Fill seedArray by interpolating the flowArrayName array, with the provided
+   * field association, at each point of output, using multiple threads.
+   * Return 1 on success, 0 otherwise.
+   */
+  virtual int GenerateFlowArrayInParallel(
+    vtkDataSet* output, vtkDataArray* seedArray, int association, const char* flowArrayName);
+
+  bool ParallelSeeding;
+
   class vtkInternals;
   vtkInternals* Internals;
 
@@ -0,0 +1,133 @@
+from paraview.simple import *
+from paraview import servermanager
+
+# Checks that the ParallelSeeding option of the Lagrangian Seed Helper
+# generates the same seed arrays as the serial seeding, for point and cell
+# flow arrays, on an image data flow, found without locator, and on an
+# unstructured flow, found with cell locators. Random seeds span several
+# batches and some of them are outside of the flow. Seeds alternating inside
+# and outside of a flow made of two overlapping datasets, one of them with
+# duplicated ghost cells, check that a seed is never taken from a cell the
+# locators tried for a previous seed outside of the flow.
+
+LoadDistributedPlugin("LagrangianParticleTracker", remote=False, ns=globals())
+
+NUMBER_OF_SEEDS = 20000
+RT_ARRAYS = ['PointRTData', '11', '0', '1', '0;RTData',
+             'CellRTData', '11', '0', '1', '1;RTData']
+VALUE_ARRAYS = ['PointValue', '11', '0', '1', '0;PointValue',
+                'CellValue', '11', '0', '1', '1;CellValue']
+
+
+def seed(flow, seeds, arrays, parallel):
+    helper = LagrangianSeedHelperWithCustomSeeds(Input=flow,
+                                                 SeedPointsSource=seeds)
+    # Arrays interpolated from the flow point data and taken from the flow
+    # cell data, as double arrays.
+    helper.ArrayToGenerate = arrays
+    helper.ParallelSeeding = parallel
+    output = servermanager.Fetch(helper)
+    Delete(helper)
+    return output
+
+
+def compare(name, flow, seeds, arrays, numInside=None):
+    expected = seed(flow, seeds, arrays, 0)
+    output = seed(flow, seeds, arrays, 1)
+    numSeeds = expected.GetNumberOfPoints()
+    assert numSeeds > 0 and output.GetNumberOfPoints() == numSeeds, name
+    for array in arrays[::5]:
+        values = output.GetPointData().GetArray(array)
+        reference = expected.GetPointData().GetArray(array)
+        numFound = 0
+        for i in range(numSeeds):
+            value = values.GetValue(i)
+            ref = reference.GetValue(i)
+            assert output.GetPoint(i) == expected.GetPoint(i), (name, i)
+            assert abs(value - ref) <= 1e-9 * max(1.0, abs(ref)), \
+                (name, array, i, value, ref)
+            numFound += 1 if ref != 0 else 0
+        print(name, array, numFound, "seeds in the flow")
+        if numInside is None:
+            assert 0 < numFound < numSeeds, (name, array)
+        else:
+            assert numFound == numInside, (name, array, numFound)
+
+
+# the random seeds are generated once, so that all the helpers use the same
+# points.
+randomSeeds = PointSource()
+randomSeeds.NumberOfPoints = NUMBER_OF_SEEDS
+randomSeeds.Radius = 14
+randomSeeds.UpdatePipeline()
+
+wavelet = Wavelet()
+flow = PointDatatoCellData(Input=wavelet)
+flow.PassPointData = 1
+compare("image data", flow, randomSeeds, RT_ARRAYS)
+compare("unstructured grid", Tetrahedralize(Input=flow), randomSeeds,
+        RT_ARRAYS)
+
+# Two grids of unit cubes along x, overlapping on the cubes at x in [3, 4],
+# which are duplicated ghost cells in the first grid. Each cube only holds the
+# tetrahedron at its lower corner, so the cube is the bounding box of the cell
+# but its upper corner is outside of the flow. The values of the second grid
+# are offset by 1000.
+twoGrids = ProgrammableSource()
+twoGrids.OutputDataSetType = 'vtkMultiBlockDataSet'
+twoGrids.Script = """
+def grid(first, last, offset, firstGhost):
+    ug = vtk.vtkUnstructuredGrid()
+    ug.Allocate(100)
+    points = vtk.vtkPoints()
+    pointValues = vtk.vtkDoubleArray()
+    pointValues.SetName("PointValue")
+    cellValues = vtk.vtkDoubleArray()
+    cellValues.SetName("CellValue")
+    ghosts = vtk.vtkUnsignedCharArray()
+    ghosts.SetName(vtk.vtkDataSetAttributes.GhostArrayName())
+    for k in range(3):
+        for j in range(3):
+            for i in range(first, last):
+                tet = vtk.vtkIdList()
+                for p in [(0, 0, 0), (1, 0, 0), (0, 1, 0), (0, 0, 1)]:
+                    x, y, z = i + p[0], j + p[1], k + p[2]
+                    tet.InsertNextId(points.InsertNextPoint(x, y, z))
+                    pointValues.InsertNextValue(offset + x + 10 * y + 100 * z)
+                ug.InsertNextCell(vtk.VTK_TETRA, tet)
+                cellValues.InsertNextValue(offset + ug.GetNumberOfCells())
+                ghosts.InsertNextValue(
+                    vtk.vtkDataSetAttributes.DUPLICATECELL if i >= firstGhost else 0)
+    ug.SetPoints(points)
+    ug.GetPointData().AddArray(pointValues)
+    ug.GetCellData().AddArray(cellValues)
+    ug.GetCellData().AddArray(ghosts)
+    return ug
+
+output = self.GetOutputDataObject(0)
+output.SetNumberOfBlocks(2)
+output.SetBlock(0, grid(0, 4, 0, 3))
+output.SetBlock(1, grid(3, 7, 1000, 7))
+"""
+
+# A seed inside the tetrahedron of a cube, then a seed in the upper corner of
+# the next cube, outside of its tetrahedron, then a seed inside the
+# tetrahedron of that cube, and so on.
+points = []
+for k in range(3):
+    for j in range(3):
+        for i in range(7):
+            points.append((i + 0.2, j + 0.2, k + 0.1))
+            points.append((i + 1.7, j + 0.7, k + 0.7))
+alternatingSeeds = ProgrammableSource()
+alternatingSeeds.OutputDataSetType = 'vtkPolyData'
+alternatingSeeds.Script = """
+points = vtk.vtkPoints()
+for p in %r:
+    points.InsertNextPoint(p)
+self.GetPolyDataOutput().SetPoints(points)
+""" % points
+alternatingSeeds.UpdatePipeline()
+
+compare("alternating seeds", twoGrids, alternatingSeeds, VALUE_ARRAYS,
+        len(points) // 2)
@@ -23,6 +23,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -31,6 +32,10 @@
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+#include <algorithm>
+
+static const int TEMPORAL_RANGES_SKETCH_TAG = 28641;
+
 //=============================================================================
 //=============================================================================
 class vtkPTemporalRanges::vtkRangeTableReduction : public vtkTableAlgorithm
@@ -91,6 +96,7 @@ vtkPTemporalRanges::vtkPTemporalRanges()
 {
   this->Controller = NULL;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->NumberOfTimeStepGroups = 1;
 }
 
 vtkPTemporalRanges::~vtkPTemporalRanges()
@@ -103,6 +109,41 @@ void vtkPTemporalRanges::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "NumberOfTimeStepGroups: " << this->NumberOfTimeStepGroups << endl;
+}
+
+//-----------------------------------------------------------------------------
+int vtkPTemporalRanges::RequestUpdateExtent(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+
+  int numProcs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  int myProc = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  int numTimeSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+
+  // Never make more groups than processes or time steps.  Without time steps
+  // every group would read the same data, so there is a single group.
+  int numGroups = std::min(this->NumberOfTimeStepGroups, std::min(numProcs, numTimeSteps));
+  numGroups = std::max(numGroups, 1);
+  int group = myProc % numGroups;
+  this->TimeIndexOffset = group;
+  this->TimeIndexStride = numGroups;
+
+  if (!this->Superclass::RequestUpdateExtent(request, inputVector, outputVector))
+  {
+    return 0;
+  }
+
+  if (numGroups > 1)
+  {
+    // The processes of each group divide its time steps in pieces.
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), myProc / numGroups);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      (numProcs - group + numGroups - 1) / numGroups);
+  }
+
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -131,6 +172,28 @@ void vtkPTemporalRanges::Reduce(vtkTable* table)
     return;
   }
 
+  int myProc = this->Controller->GetLocalProcessId();
+  if (this->ComputeDistribution)
+  {
+    // Merge the percentile sketches of all processes on the root, which is
+    // where the reduced table ends up.
+    if (myProc == 0)
+    {
+      for (int p = 1; p < this->Controller->GetNumberOfProcesses(); p++)
+      {
+        vtkMultiProcessStream stream;
+        this->Controller->Receive(stream, p, TEMPORAL_RANGES_SKETCH_TAG);
+        this->UnmarshalDistribution(stream);
+      }
+    }
+    else
+    {
+      vtkMultiProcessStream stream;
+      this->MarshalDistribution(stream);
+      this->Controller->Send(stream, 0, TEMPORAL_RANGES_SKETCH_TAG);
+    }
+  }
+
   VTK_CREATE(vtkReductionFilter, reduceFilter);
   reduceFilter->SetController(this->Controller);
 
@@ -143,12 +206,14 @@ void vtkPTemporalRanges::Reduce(vtkTable* table)
   reduceFilter->SetInputData(copy);
   reduceFilter->Update();
 
-  if (this->Controller->GetLocalProcessId() == 0)
+  if (myProc == 0)
   {
     table->ShallowCopy(reduceFilter->GetOutput());
+    this->FinalizeDistribution(table);
   }
   else
   {
     table->Initialize();
   }
+  this->ResetDistribution();
 }
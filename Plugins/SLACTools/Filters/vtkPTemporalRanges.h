@@ -25,6 +25,11 @@
 // vtkPTemporalRanges works basically like its superclass, vtkTemporalRanges,
 // except that it works in a data parallel manner.
 //
+// With NumberOfTimeStepGroups larger than one, the processes are split into
+// groups that visit different time steps concurrently.  The partial results
+// of all processes are merged at the end, including the percentile sketches
+// when ComputeDistribution is on.
+//
 
 #ifndef vtkPTemporalRanges_h
 #define vtkPTemporalRanges_h
@@ -44,12 +49,29 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
+  // Description:
+  // Number of groups of processes that read different time steps
+  // concurrently.  Process p belongs to group p % NumberOfTimeStepGroups.
+  // Group g visits time steps g, g + NumberOfTimeStepGroups, ... and divides
+  // the pieces of each among its processes, so the pipeline iterates about
+  // NumberOfTimeStepGroups times fewer.  The input must be able to produce any
+  // piece of any time step on each process independently (a reader that
+  // communicates between processes cannot be used).  The default, 1, makes
+  // every process visit every time step.
+  vtkSetClampMacro(NumberOfTimeStepGroups, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTimeStepGroups, int);
+
 protected:
   vtkPTemporalRanges();
   ~vtkPTemporalRanges();
 
   vtkMultiProcessController* Controller;
 
+  int NumberOfTimeStepGroups;
+
+  virtual int RequestUpdateExtent(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
   virtual int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   virtual void Reduce(vtkTable* table);
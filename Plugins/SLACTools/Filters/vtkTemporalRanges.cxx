@@ -29,8 +29,11 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
@@ -40,7 +43,10 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <cmath>
+#include <map>
 #include <sstream>
+#include <string>
 #include <vector>
 
 //=============================================================================
@@ -51,34 +57,61 @@ const int MINIMUM_ROW = vtkTemporalRanges::MINIMUM_ROW;
 const int MAXIMUM_ROW = vtkTemporalRanges::MAXIMUM_ROW;
 const int COUNT_ROW = vtkTemporalRanges::COUNT_ROW;
 const int NUMBER_OF_ROWS = vtkTemporalRanges::NUMBER_OF_ROWS;
+const int STANDARD_DEVIATION_ROW = vtkTemporalRanges::STANDARD_DEVIATION_ROW;
+const int NUMBER_OF_DISTRIBUTION_ROWS = vtkTemporalRanges::NUMBER_OF_DISTRIBUTION_ROWS;
 
-inline void InitializeColumn(vtkDoubleArray* column)
+const int NUMBER_OF_PERCENTILES = 5;
+const int PERCENTILE_ROWS[NUMBER_OF_PERCENTILES] = { vtkTemporalRanges::PERCENTILE_5_ROW,
+  vtkTemporalRanges::PERCENTILE_25_ROW, vtkTemporalRanges::MEDIAN_ROW,
+  vtkTemporalRanges::PERCENTILE_75_ROW, vtkTemporalRanges::PERCENTILE_95_ROW };
+const double PERCENTILES[NUMBER_OF_PERCENTILES] = { 0.05, 0.25, 0.5, 0.75, 0.95 };
+
+inline void InitializeColumn(vtkDoubleArray* column, bool distribution = false)
 {
   column->SetNumberOfComponents(1);
-  column->SetNumberOfTuples(NUMBER_OF_ROWS);
+  column->SetNumberOfTuples(distribution ? NUMBER_OF_DISTRIBUTION_ROWS : NUMBER_OF_ROWS);
 
   column->SetValue(AVERAGE_ROW, 0.0);
   column->SetValue(MINIMUM_ROW, vtkTypeTraits<double>::Max());
   column->SetValue(MAXIMUM_ROW, vtkTypeTraits<double>::Min());
   column->SetValue(COUNT_ROW, 0.0);
-}
 
-inline void AccumulateValue(double value, vtkDoubleArray* column)
-{
-  if (!vtkMath::IsNan(value))
+  if (distribution)
   {
-    column->SetValue(AVERAGE_ROW, value + column->GetValue(AVERAGE_ROW));
-    column->SetValue(MINIMUM_ROW, std::min(column->GetValue(MINIMUM_ROW), value));
-    column->SetValue(MAXIMUM_ROW, std::max(column->GetValue(MAXIMUM_ROW), value));
-    column->SetValue(COUNT_ROW, column->GetValue(COUNT_ROW) + 1);
+    column->SetValue(STANDARD_DEVIATION_ROW, 0.0);
+    for (int i = 0; i < NUMBER_OF_PERCENTILES; i++)
+    {
+      column->SetValue(PERCENTILE_ROWS[i], vtkMath::Nan());
+    }
   }
 }
 
+inline bool HasDistribution(vtkDoubleArray* column)
+{
+  return column->GetNumberOfTuples() >= NUMBER_OF_DISTRIBUTION_ROWS;
+}
+
 inline void AccumulateColumn(vtkDoubleArray* source, vtkDoubleArray* target)
 {
   double targetCount = target->GetValue(COUNT_ROW);
   double sourceCount = source->GetValue(COUNT_ROW);
   double totalCount = targetCount + sourceCount;
+  if (HasDistribution(source) && HasDistribution(target) && (sourceCount > 0))
+  {
+    // Pairwise update of the sum of squared deviations (Chan et al.).  Must
+    // happen before the average of the target is replaced.
+    double sourceDeviation = source->GetValue(STANDARD_DEVIATION_ROW);
+    double sourceM2 = sourceCount * sourceDeviation * sourceDeviation;
+    double m2 = sourceM2;
+    if (targetCount > 0)
+    {
+      double targetDeviation = target->GetValue(STANDARD_DEVIATION_ROW);
+      double delta = source->GetValue(AVERAGE_ROW) - target->GetValue(AVERAGE_ROW);
+      m2 += targetCount * targetDeviation * targetDeviation +
+        delta * delta * targetCount * sourceCount / totalCount;
+    }
+    target->SetValue(STANDARD_DEVIATION_ROW, sqrt(m2 / totalCount));
+  }
   double targetTotal = targetCount * target->GetValue(AVERAGE_ROW);
   double sourceTotal = sourceCount * source->GetValue(AVERAGE_ROW);
   target->SetValue(AVERAGE_ROW, (targetTotal + sourceTotal) / totalCount);
@@ -88,9 +121,304 @@ inline void AccumulateColumn(vtkDoubleArray* source, vtkDoubleArray* target)
     MAXIMUM_ROW, std::max(source->GetValue(MAXIMUM_ROW), target->GetValue(MAXIMUM_ROW)));
   target->SetValue(COUNT_ROW, totalCount);
 }
+
+//-----------------------------------------------------------------------------
+// Descriptive statistics of one column over a range of tuples.  Partial
+// results of different threads are combined with Merge.
+struct Accumulator
+{
+  double Sum;
+  double Minimum;
+  double Maximum;
+  double Count;
+  double SquaredDeviation;
+
+  Accumulator()
+    : Sum(0.0)
+    , Minimum(vtkTypeTraits<double>::Max())
+    , Maximum(vtkTypeTraits<double>::Min())
+    , Count(0.0)
+    , SquaredDeviation(0.0)
+  {
+  }
+
+  void Add(double value)
+  {
+    if (!vtkMath::IsNan(value))
+    {
+      this->Sum += value;
+      this->Minimum = std::min(this->Minimum, value);
+      this->Maximum = std::max(this->Maximum, value);
+      this->Count += 1.0;
+    }
+  }
+
+  void Merge(const Accumulator& other)
+  {
+    this->Sum += other.Sum;
+    this->Minimum = std::min(this->Minimum, other.Minimum);
+    this->Maximum = std::max(this->Maximum, other.Maximum);
+    this->Count += other.Count;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Mergeable quantile sketch.  Values are counted in logarithmically spaced
+// buckets (ratio SKETCH_GAMMA between bucket bounds), so a quantile is
+// estimated within SKETCH_ACCURACY (relative) of the value at that rank.
+// Merging sketches just adds their counts, which is what lets threads, time
+// steps and processes be combined in any order.
+const double SKETCH_ACCURACY = 0.01;
+const double SKETCH_GAMMA = (1.0 + SKETCH_ACCURACY) / (1.0 - SKETCH_ACCURACY);
+const double SKETCH_LOG_GAMMA = std::log(SKETCH_GAMMA);
+const double SKETCH_MIN_MAGNITUDE = 1.0e-300;
+const int SKETCH_INFINITE_KEY = VTK_INT_MAX;
+
+class Sketch
+{
+public:
+  Sketch()
+    : ZeroCount(0.0)
+    , Count(0.0)
+  {
+  }
+
+  void Add(double value)
+  {
+    if (vtkMath::IsNan(value))
+    {
+      return;
+    }
+    this->Count += 1.0;
+    double magnitude = std::fabs(value);
+    if (magnitude < SKETCH_MIN_MAGNITUDE)
+    {
+      this->ZeroCount += 1.0;
+      return;
+    }
+    int key = SKETCH_INFINITE_KEY;
+    if (!vtkMath::IsInf(magnitude))
+    {
+      key = static_cast<int>(std::ceil(std::log(magnitude) / SKETCH_LOG_GAMMA));
+    }
+    (value > 0 ? this->Positive : this->Negative)[key] += 1.0;
+  }
+
+  void Merge(const Sketch& other)
+  {
+    this->ZeroCount += other.ZeroCount;
+    this->Count += other.Count;
+    for (auto& bucket : other.Positive)
+    {
+      this->Positive[bucket.first] += bucket.second;
+    }
+    for (auto& bucket : other.Negative)
+    {
+      this->Negative[bucket.first] += bucket.second;
+    }
+  }
+
+  double GetQuantile(double quantile) const
+  {
+    if (this->Count <= 0)
+    {
+      return vtkMath::Nan();
+    }
+    double rank = quantile * (this->Count - 1);
+    double seen = 0.0;
+    // The most negative values have the largest keys.
+    for (auto bucket = this->Negative.rbegin(); bucket != this->Negative.rend(); ++bucket)
+    {
+      seen += bucket->second;
+      if (seen > rank)
+      {
+        return -GetBucketValue(bucket->first);
+      }
+    }
+    seen += this->ZeroCount;
+    if (seen > rank)
+    {
+      return 0.0;
+    }
+    for (auto& bucket : this->Positive)
+    {
+      seen += bucket.second;
+      if (seen > rank)
+      {
+        return GetBucketValue(bucket.first);
+      }
+    }
+    return this->Positive.empty() ? 0.0 : GetBucketValue(this->Positive.rbegin()->first);
+  }
+
+  void Marshal(vtkMultiProcessStream& stream) const
+  {
+    stream << this->ZeroCount << this->Count;
+    stream << static_cast<int>(this->Positive.size());
+    for (auto& bucket : this->Positive)
+    {
+      stream << bucket.first << bucket.second;
+    }
+    stream << static_cast<int>(this->Negative.size());
+    for (auto& bucket : this->Negative)
+    {
+      stream << bucket.first << bucket.second;
+    }
+  }
+
+  // Merges the marshaled sketch into this one.
+  void Unmarshal(vtkMultiProcessStream& stream)
+  {
+    double zeroCount, count;
+    stream >> zeroCount >> count;
+    this->ZeroCount += zeroCount;
+    this->Count += count;
+    std::map<int, double>* buckets[2] = { &this->Positive, &this->Negative };
+    for (int sign = 0; sign < 2; sign++)
+    {
+      int numBuckets;
+      stream >> numBuckets;
+      for (int i = 0; i < numBuckets; i++)
+      {
+        int key;
+        double bucketCount;
+        stream >> key >> bucketCount;
+        (*buckets[sign])[key] += bucketCount;
+      }
+    }
+  }
+
+private:
+  static double GetBucketValue(int key)
+  {
+    if (key == SKETCH_INFINITE_KEY)
+    {
+      return vtkMath::Inf();
+    }
+    // Midpoint (in relative terms) of the bucket (gamma^(key-1), gamma^key].
+    return 2.0 * std::pow(SKETCH_GAMMA, key) / (SKETCH_GAMMA + 1.0);
+  }
+
+  std::map<int, double> Positive;
+  std::map<int, double> Negative;
+  double ZeroCount;
+  double Count;
+};
+
+//-----------------------------------------------------------------------------
+// Accumulates the tuples of a contiguous array with one column per component
+// and one for the magnitude of arrays with more than one component.  The
+// tuples are split among threads.  With distribution on, a second pass adds
+// the squared deviations from the mean and the values are added to sketches.
+template <typename T>
+void AccumulateTuples(const T* data, vtkIdType numTuples, int numComponents, bool distribution,
+  std::vector<Accumulator>& result, const std::vector<Sketch*>& sketches)
+{
+  size_t numColumns = result.size();
+
+  vtkSMPThreadLocal<std::vector<Accumulator> > localAccumulators;
+  vtkSMPThreadLocal<std::vector<Sketch> > localSketches;
+  vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<Accumulator>& accumulators = localAccumulators.Local();
+    accumulators.resize(numColumns);
+    std::vector<Sketch>& threadSketches = localSketches.Local();
+    threadSketches.resize(distribution ? numColumns : 0);
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const T* tuple = data + i * numComponents;
+      double mag = 0.0;
+      for (int j = 0; j < numComponents; j++)
+      {
+        double value = static_cast<double>(tuple[j]);
+        mag += value * value;
+        accumulators[j].Add(value);
+        if (distribution)
+        {
+          threadSketches[j].Add(value);
+        }
+      }
+      if (numComponents > 1)
+      {
+        mag = sqrt(mag);
+        accumulators[numComponents].Add(mag);
+        if (distribution)
+        {
+          threadSketches[numComponents].Add(mag);
+        }
+      }
+    }
+  });
+
+  for (auto& accumulators : localAccumulators)
+  {
+    for (size_t c = 0; c < numColumns; c++)
+    {
+      result[c].Merge(accumulators[c]);
+    }
+  }
+
+  if (!distribution)
+  {
+    return;
+  }
+
+  for (auto& threadSketches : localSketches)
+  {
+    for (size_t c = 0; c < numColumns; c++)
+    {
+      sketches[c]->Merge(threadSketches[c]);
+    }
+  }
+
+  std::vector<double> means(numColumns);
+  for (size_t c = 0; c < numColumns; c++)
+  {
+    means[c] = result[c].Sum / result[c].Count;
+  }
+  vtkSMPThreadLocal<std::vector<double> > localDeviations;
+  vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double>& deviations = localDeviations.Local();
+    deviations.resize(numColumns, 0.0);
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const T* tuple = data + i * numComponents;
+      double mag = 0.0;
+      for (int j = 0; j < numComponents; j++)
+      {
+        double value = static_cast<double>(tuple[j]);
+        mag += value * value;
+        if (!vtkMath::IsNan(value))
+        {
+          deviations[j] += (value - means[j]) * (value - means[j]);
+        }
+      }
+      if (numComponents > 1)
+      {
+        mag = sqrt(mag);
+        if (!vtkMath::IsNan(mag))
+        {
+          deviations[numComponents] +=
+            (mag - means[numComponents]) * (mag - means[numComponents]);
+        }
+      }
+    }
+  });
+  for (auto& deviations : localDeviations)
+  {
+    for (size_t c = 0; c < numColumns; c++)
+    {
+      result[c].SquaredDeviation += deviations[c];
+    }
+  }
+}
 };
 using namespace vtkTemporalRangesNamespace;
 
+//=============================================================================
+class vtkTemporalRanges::vtkSketchMap : public std::map<std::string, Sketch>
+{
+};
+
 //=============================================================================
 vtkStandardNewMacro(vtkTemporalRanges);
 
@@ -98,15 +426,22 @@ vtkStandardNewMacro(vtkTemporalRanges);
 vtkTemporalRanges::vtkTemporalRanges()
 {
   this->CurrentTimeIndex = 0;
+  this->TimeIndexOffset = 0;
+  this->TimeIndexStride = 1;
+  this->ComputeDistribution = false;
+  this->Sketches = new vtkSketchMap;
 }
 
 vtkTemporalRanges::~vtkTemporalRanges()
 {
+  delete this->Sketches;
 }
 
 void vtkTemporalRanges::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ComputeDistribution: " << this->ComputeDistribution << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -150,8 +485,10 @@ int vtkTemporalRanges::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   double* inTimes = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
   if (inTimes)
   {
-    inInfo->Set(
-      vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), inTimes[this->CurrentTimeIndex]);
+    int numTimeSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    int timeIndex = std::min(
+      this->TimeIndexOffset + this->CurrentTimeIndex * this->TimeIndexStride, numTimeSteps - 1);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), inTimes[timeIndex]);
   }
 
   return 1;
@@ -168,6 +505,7 @@ int vtkTemporalRanges::RequestData(
   {
     // First execution.  Initialize table.
     this->InitializeTable(output);
+    this->ResetDistribution();
   }
 
   vtkCompositeDataSet* compositeInput = vtkCompositeDataSet::GetData(inInfo);
@@ -190,7 +528,8 @@ int vtkTemporalRanges::RequestData(
 
   this->CurrentTimeIndex++;
 
-  if (this->CurrentTimeIndex < inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  int nextTimeIndex = this->TimeIndexOffset + this->CurrentTimeIndex * this->TimeIndexStride;
+  if (nextTimeIndex < inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
   {
     // There is still more to do.
     request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
@@ -199,6 +538,7 @@ int vtkTemporalRanges::RequestData(
   {
     // We are done.  Finish up.
     request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+    this->FinalizeDistribution(output);
     this->CurrentTimeIndex = 0;
   }
 
@@ -213,13 +553,24 @@ void vtkTemporalRanges::InitializeTable(vtkTable* output)
   VTK_CREATE(vtkStringArray, rangeName);
   rangeName->SetName("Range Name");
   rangeName->SetNumberOfComponents(1);
-  rangeName->SetNumberOfTuples(NUMBER_OF_ROWS);
+  rangeName->SetNumberOfTuples(
+    this->ComputeDistribution ? NUMBER_OF_DISTRIBUTION_ROWS : NUMBER_OF_ROWS);
 
   rangeName->SetValue(AVERAGE_ROW, "Average");
   rangeName->SetValue(MINIMUM_ROW, "Minimum");
   rangeName->SetValue(MAXIMUM_ROW, "Maximum");
   rangeName->SetValue(COUNT_ROW, "Count");
 
+  if (this->ComputeDistribution)
+  {
+    rangeName->SetValue(STANDARD_DEVIATION_ROW, "Standard Deviation");
+    rangeName->SetValue(vtkTemporalRanges::PERCENTILE_5_ROW, "5th Percentile");
+    rangeName->SetValue(vtkTemporalRanges::PERCENTILE_25_ROW, "25th Percentile");
+    rangeName->SetValue(vtkTemporalRanges::MEDIAN_ROW, "Median");
+    rangeName->SetValue(vtkTemporalRanges::PERCENTILE_75_ROW, "75th Percentile");
+    rangeName->SetValue(vtkTemporalRanges::PERCENTILE_95_ROW, "95th Percentile");
+  }
+
   output->AddColumn(rangeName);
 }
 
@@ -269,55 +620,70 @@ void vtkTemporalRanges::AccumulateArray(vtkDataArray* field, vtkTable* output)
 {
   int numComponents = field->GetNumberOfComponents();
   vtkIdType numTuples = field->GetNumberOfTuples();
-  vtkDoubleArray* magnitudeColumn = NULL;
-  std::vector<vtkDoubleArray*> componentColumns(numComponents);
-  VTK_CREATE(vtkDoubleArray, magnitudeAccumulate);
-  std::vector<vtkSmartPointer<vtkDoubleArray> > componentAccumulate(numComponents);
+
+  // One column per component followed by the magnitude, or just one column for
+  // scalars.
+  std::vector<vtkDoubleArray*> columns;
   if (numComponents > 1)
   {
-    magnitudeColumn = this->GetColumn(output, field->GetName(), -1);
-    InitializeColumn(magnitudeAccumulate);
     for (int i = 0; i < numComponents; i++)
     {
-      componentColumns[i] = this->GetColumn(output, field->GetName(), i);
-      componentAccumulate[i] = vtkSmartPointer<vtkDoubleArray>::New();
-      InitializeColumn(componentAccumulate[i]);
+      columns.push_back(this->GetColumn(output, field->GetName(), i));
     }
+    columns.push_back(this->GetColumn(output, field->GetName(), -1));
   }
   else
   {
-    componentColumns[0] = this->GetColumn(output, field->GetName());
-    componentAccumulate[0] = vtkSmartPointer<vtkDoubleArray>::New();
-    InitializeColumn(componentAccumulate[0]);
+    columns.push_back(this->GetColumn(output, field->GetName()));
   }
 
-  for (vtkIdType i = 0; i < numTuples; i++)
+  std::vector<Sketch*> sketches(columns.size(), NULL);
+  if (this->ComputeDistribution)
   {
-    double mag = 0.0;
-    for (int j = 0; j < numComponents; j++)
-    {
-      double value = field->GetComponent(i, j);
-      mag += value * value;
-      AccumulateValue(value, componentAccumulate[j]);
-    }
-    if (magnitudeColumn)
+    for (size_t c = 0; c < columns.size(); c++)
     {
-      mag = sqrt(mag);
-      AccumulateValue(mag, magnitudeAccumulate);
+      sketches[c] = &(*this->Sketches)[columns[c]->GetName()];
     }
   }
 
-  for (int j = 0; j < numComponents; j++)
+  // The accumulation kernels read contiguous memory directly.  Arrays with any
+  // other layout are converted first.
+  vtkSmartPointer<vtkDataArray> values = field;
+  if (!field->HasStandardMemoryLayout())
   {
-    componentAccumulate[j]->SetValue(AVERAGE_ROW, (componentAccumulate[j]->GetValue(AVERAGE_ROW) /
-                                                    componentAccumulate[j]->GetValue(COUNT_ROW)));
-    AccumulateColumn(componentAccumulate[j], componentColumns[j]);
+    values = vtkSmartPointer<vtkDoubleArray>::New();
+    values->DeepCopy(field);
   }
-  if (magnitudeColumn)
+
+  std::vector<Accumulator> accumulators(columns.size());
+  switch (values->GetDataType())
   {
-    magnitudeAccumulate->SetValue(AVERAGE_ROW,
-      (magnitudeAccumulate->GetValue(AVERAGE_ROW) / magnitudeAccumulate->GetValue(COUNT_ROW)));
-    AccumulateColumn(magnitudeAccumulate, magnitudeColumn);
+    vtkTemplateMacro(AccumulateTuples(static_cast<const VTK_TT*>(values->GetVoidPointer(0)),
+      numTuples, numComponents, this->ComputeDistribution, accumulators, sketches));
+    default:
+      vtkWarningMacro(<< "Unsupported array type: " << values->GetClassName());
+      return;
+  }
+
+  for (size_t c = 0; c < columns.size(); c++)
+  {
+    const Accumulator& accumulator = accumulators[c];
+    if (accumulator.Count <= 0)
+    {
+      continue;
+    }
+    VTK_CREATE(vtkDoubleArray, accumulate);
+    InitializeColumn(accumulate, this->ComputeDistribution);
+    accumulate->SetValue(AVERAGE_ROW, accumulator.Sum / accumulator.Count);
+    accumulate->SetValue(MINIMUM_ROW, accumulator.Minimum);
+    accumulate->SetValue(MAXIMUM_ROW, accumulator.Maximum);
+    accumulate->SetValue(COUNT_ROW, accumulator.Count);
+    if (this->ComputeDistribution)
+    {
+      accumulate->SetValue(
+        STANDARD_DEVIATION_ROW, sqrt(accumulator.SquaredDeviation / accumulator.Count));
+    }
+    AccumulateColumn(accumulate, columns[c]);
   }
 }
 
@@ -364,10 +730,63 @@ vtkDoubleArray* vtkTemporalRanges::GetColumn(vtkTable* table, const char* name)
     }
     array = vtkDoubleArray::New();
     array->SetName(name);
-    InitializeColumn(array);
+    InitializeColumn(array, this->ComputeDistribution);
     table->AddColumn(array);
     array->Delete(); // Reference held by table.
   }
 
   return array;
 }
+
+//-----------------------------------------------------------------------------
+void vtkTemporalRanges::ResetDistribution()
+{
+  this->Sketches->clear();
+}
+
+//-----------------------------------------------------------------------------
+void vtkTemporalRanges::MarshalDistribution(vtkMultiProcessStream& stream)
+{
+  stream << static_cast<int>(this->Sketches->size());
+  for (auto& sketch : *this->Sketches)
+  {
+    stream << sketch.first;
+    sketch.second.Marshal(stream);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkTemporalRanges::UnmarshalDistribution(vtkMultiProcessStream& stream)
+{
+  int numSketches;
+  stream >> numSketches;
+  for (int i = 0; i < numSketches; i++)
+  {
+    std::string name;
+    stream >> name;
+    (*this->Sketches)[name].Unmarshal(stream);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkTemporalRanges::FinalizeDistribution(vtkTable* output)
+{
+  if (!this->ComputeDistribution)
+  {
+    return;
+  }
+
+  for (auto& sketch : *this->Sketches)
+  {
+    vtkDoubleArray* column =
+      vtkDoubleArray::SafeDownCast(output->GetColumnByName(sketch.first.c_str()));
+    if (!column || !HasDistribution(column))
+    {
+      continue;
+    }
+    for (int i = 0; i < NUMBER_OF_PERCENTILES; i++)
+    {
+      column->SetValue(PERCENTILE_ROWS[i], sketch.second.GetQuantile(PERCENTILES[i]));
+    }
+  }
+}
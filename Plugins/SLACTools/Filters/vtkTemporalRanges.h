@@ -31,6 +31,13 @@
 // and time, it will also give a single statistics over all blocks in a data
 // set.
 //
+// When ComputeDistribution is on, the table has additional rows for the
+// standard deviation and for the 5th, 25th, 50th, 75th and 95th percentiles.
+// The standard deviation is accumulated online (pairwise updates of the sum of
+// squared deviations), so no time step is visited twice.  Percentiles come
+// from a mergeable sketch that counts values in logarithmically spaced
+// buckets; they are within 1% (relative) of a value of the data at that rank.
+//
 
 #ifndef vtkTemporalRanges_h
 #define vtkTemporalRanges_h
@@ -42,6 +49,7 @@ class vtkCompositeDataSet;
 class vtkDataSet;
 class vtkDoubleArray;
 class vtkFieldData;
+class vtkMultiProcessStream;
 
 class VTKSLACFILTERS_EXPORT vtkTemporalRanges : public vtkTableAlgorithm
 {
@@ -59,12 +67,41 @@ public:
     NUMBER_OF_ROWS
   };
 
+  // Description:
+  // Rows that are added to the output when ComputeDistribution is on.
+  enum
+  {
+    STANDARD_DEVIATION_ROW = NUMBER_OF_ROWS,
+    PERCENTILE_5_ROW,
+    PERCENTILE_25_ROW,
+    MEDIAN_ROW,
+    PERCENTILE_75_ROW,
+    PERCENTILE_95_ROW,
+    NUMBER_OF_DISTRIBUTION_ROWS
+  };
+
+  // Description:
+  // When on, the standard deviation and percentiles of each field are also
+  // computed.  Off by default.
+  vtkGetMacro(ComputeDistribution, bool);
+  vtkSetMacro(ComputeDistribution, bool);
+  vtkBooleanMacro(ComputeDistribution, bool);
+
 protected:
   vtkTemporalRanges();
   ~vtkTemporalRanges();
 
   int CurrentTimeIndex;
 
+  // Description:
+  // The time steps visited are TimeIndexOffset + i*TimeIndexStride.  The
+  // defaults (0 and 1) visit all of them.  Subclasses change these to divide
+  // the time steps among groups of processes.
+  int TimeIndexOffset;
+  int TimeIndexStride;
+
+  bool ComputeDistribution;
+
   virtual int FillInputPortInformation(int port, vtkInformation* info) override;
 
   virtual int RequestInformation(
@@ -87,9 +124,21 @@ protected:
   virtual vtkDoubleArray* GetColumn(vtkTable* table, const char* name, int component);
   virtual vtkDoubleArray* GetColumn(vtkTable* table, const char* name);
 
+  // Description:
+  // Manage the percentile sketches kept for each column when
+  // ComputeDistribution is on.  Unmarshaled sketches are merged with the local
+  // ones, and FinalizeDistribution writes the percentile rows of the output.
+  virtual void ResetDistribution();
+  virtual void MarshalDistribution(vtkMultiProcessStream& stream);
+  virtual void UnmarshalDistribution(vtkMultiProcessStream& stream);
+  virtual void FinalizeDistribution(vtkTable* output);
+
 private:
   vtkTemporalRanges(const vtkTemporalRanges&) = delete;
   void operator=(const vtkTemporalRanges&) = delete;
+
+  class vtkSketchMap;
+  vtkSketchMap* Sketches;
 };
 
 #endif // vtkTemporalRanges_h
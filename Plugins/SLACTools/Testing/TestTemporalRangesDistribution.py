@@ -0,0 +1,86 @@
+from paraview.simple import *
+from paraview import servermanager
+import math
+
+# Checks the distribution rows of the Temporal Ranges filter against the exact
+# statistics of a small temporal source: the standard deviation must match
+# the population standard deviation over all points and time steps and each
+# percentile must be within 1% of the value at its rank. The time steps are
+# processed by one group, then by several groups when run on more than one
+# process.
+
+LoadDistributedPlugin("SLACTools", remote=False, ns=globals())
+
+NUMBER_OF_POINTS = 200
+NUMBER_OF_TIME_STEPS = 10
+
+# negative and positive values of different magnitudes.
+VALUE = "(i - 60) * 0.25 * (1.0 + 0.3 * t) + math.sin(0.1 * i * (t + 1))"
+
+src = ProgrammableSource()
+src.OutputDataSetType = 'vtkPolyData'
+src.ScriptRequestInformation = """
+executive = self.GetExecutive()
+outInfo = self.GetOutputInformation(0)
+outInfo.Remove(executive.TIME_STEPS())
+outInfo.Remove(executive.TIME_RANGE())
+for t in range(%d):
+    outInfo.Append(executive.TIME_STEPS(), t)
+outInfo.Append(executive.TIME_RANGE(), 0)
+outInfo.Append(executive.TIME_RANGE(), %d)
+outInfo.Set(vtk.vtkAlgorithm.CAN_HANDLE_PIECE_REQUEST(), 1)
+""" % (NUMBER_OF_TIME_STEPS, NUMBER_OF_TIME_STEPS - 1)
+src.Script = """
+import math
+executive = self.GetExecutive()
+outInfo = self.GetOutputInformation(0)
+piece = outInfo.Get(executive.UPDATE_PIECE_NUMBER())
+numPieces = outInfo.Get(executive.UPDATE_NUMBER_OF_PIECES())
+t = int(round(outInfo.Get(executive.UPDATE_TIME_STEP()))) \\
+    if outInfo.Has(executive.UPDATE_TIME_STEP()) else 0
+begin = %d * piece // numPieces
+end = %d * (piece + 1) // numPieces
+output = self.GetPolyDataOutput()
+points = vtk.vtkPoints()
+values = vtk.vtkDoubleArray()
+values.SetName("Values")
+for i in range(begin, end):
+    points.InsertNextPoint(i, 0, 0)
+    values.InsertNextValue(%s)
+output.SetPoints(points)
+output.GetPointData().AddArray(values)
+output.GetInformation().Set(output.DATA_TIME_STEP(), t)
+""" % (NUMBER_OF_POINTS, NUMBER_OF_POINTS, VALUE)
+
+values = sorted(eval(VALUE) for i in range(NUMBER_OF_POINTS)
+                for t in range(NUMBER_OF_TIME_STEPS))
+count = len(values)
+mean = sum(values) / count
+deviation = math.sqrt(sum((v - mean) ** 2 for v in values) / count)
+percentiles = {
+    "5th Percentile": 0.05,
+    "25th Percentile": 0.25,
+    "Median": 0.5,
+    "75th Percentile": 0.75,
+    "95th Percentile": 0.95,
+}
+
+for groups in [1, 2, 3]:
+    ranges = TemporalRanges(Input=src)
+    ranges.ComputeDistribution = 1
+    ranges.NumberOfTimeStepGroups = groups
+    table = servermanager.Fetch(ranges, 0)
+    Delete(ranges)
+
+    names = table.GetColumnByName("Range Name")
+    column = table.GetColumnByName("Values")
+    rows = dict((names.GetValue(r), column.GetValue(r)) for r in range(table.GetNumberOfRows()))
+    print(groups, rows)
+
+    assert rows["Count"] == count, groups
+    assert abs(rows["Average"] - mean) <= 1e-9 * max(1.0, abs(mean)), groups
+    assert rows["Minimum"] == values[0] and rows["Maximum"] == values[-1], groups
+    assert abs(rows["Standard Deviation"] - deviation) <= 1e-9 * deviation, groups
+    for name, quantile in percentiles.items():
+        expected = values[int(math.floor(quantile * (count - 1)))]
+        assert abs(rows[name] - expected) <= 0.01 * abs(expected) + 1e-12, (groups, name)
@@ -47,6 +47,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
 
 #include "CosmoHaloFinder.h"
 
@@ -63,6 +66,7 @@ CosmoHaloFinder::CosmoHaloFinder()
 {
 
   nmin = 1;
+  nthreads = 1;
 }
 
 /****************************************************************************/
@@ -290,6 +294,12 @@ void CosmoHaloFinder::Writing()
 /****************************************************************************/
 void CosmoHaloFinder::Finding()
 {
+  int numThreads = nthreads > 0 ? nthreads : (int)thread::hardware_concurrency();
+  if (numThreads > 1 && nmin < 2 && !periodic && npart > 1) {
+    ThreadedFinding();
+    return;
+  }
+
   //
   // REORDER particles based on spatial locality
   //
@@ -622,4 +632,227 @@ void CosmoHaloFinder::Merge(
   return;
 }
 
+/****************************************************************************/
+namespace {
+
+// Runs work(t) for t in [0, numThreads), the calling thread taking t = 0.
+template <typename Work>
+void RunThreads(int numThreads, Work work)
+{
+  vector<thread> threads;
+  for (int t = 1; t < numThreads; t++)
+    threads.push_back(thread(work, t));
+  work(0);
+  for (size_t t = 0; t < threads.size(); t++)
+    threads[t].join();
+}
+
+// Root of the set containing x, halving the path on the way.  Parents only
+// ever point at lower indices so the forest stays acyclic under races.
+int FindRoot(atomic<int>* parent, int x)
+{
+  while (true) {
+    int p = parent[x].load();
+    if (p == x)
+      return x;
+    int gp = parent[p].load();
+    if (gp != p)
+      parent[x].compare_exchange_weak(p, gp);
+    x = gp;
+  }
+}
+
+// Joins the sets of a and b, hanging the higher root below the lower one so
+// that every root is the lowest particle index of its halo.
+void Union(atomic<int>* parent, int a, int b)
+{
+  while (true) {
+    a = FindRoot(parent, a);
+    b = FindRoot(parent, b);
+    if (a == b)
+      return;
+    if (a < b)
+      swap(a, b);
+    int expected = a;
+    if (parent[a].compare_exchange_strong(expected, b))
+      return;
+  }
+}
+
+} // END anonymous namespace
+
+/****************************************************************************/
+void CosmoHaloFinder::ThreadedFinding()
+{
+  int numThreads = nthreads > 0 ? nthreads : (int)thread::hardware_concurrency();
+
+  //
+  // BOUNDS of the particles, one partial box per thread
+  //
+  vector<POSVEL_T> lo(numThreads * numDataDims), hi(numThreads * numDataDims);
+  RunThreads(numThreads, [&](int t) {
+    int first = (int)((long long)npart * t / numThreads);
+    int last = (int)((long long)npart * (t + 1) / numThreads);
+    for (int dim = 0; dim < numDataDims; dim++) {
+      POSVEL_T l = data[dim][0], h = data[dim][0];
+      for (int i = first; i < last; i++) {
+        l = min(l, data[dim][i]);
+        h = max(h, data[dim][i]);
+      }
+      lo[t * numDataDims + dim] = l;
+      hi[t * numDataDims + dim] = h;
+    }
+  });
+
+  POSVEL_T lb[numDataDims], ub[numDataDims];
+  for (int dim = 0; dim < numDataDims; dim++) {
+    lb[dim] = lo[dim];
+    ub[dim] = hi[dim];
+    for (int t = 1; t < numThreads; t++) {
+      lb[dim] = min(lb[dim], lo[t * numDataDims + dim]);
+      ub[dim] = max(ub[dim], hi[t * numDataDims + dim]);
+    }
+  }
+
+  //
+  // CELL LIST with cells at least bb wide so friends share or neighbor a cell,
+  // widened as needed to keep the number of cells near the number of particles.
+  // The counts are clamped in double before the cast, so that a small bb in a
+  // large box cannot overflow them
+  //
+  double maxCells = min(2.0 * npart + 8.0, (double)numeric_limits<int>::max() - 1.0);
+  double cellSize = bb > 0 ? bb : 1.0;
+  int dims[numDataDims];
+  while (true) {
+    double numCells = 1.0;
+    for (int dim = 0; dim < numDataDims; dim++) {
+      dims[dim] = (int)min((double)(ub[dim] - lb[dim]) / cellSize, maxCells) + 1;
+      numCells *= dims[dim];
+    }
+    if (numCells <= maxCells)
+      break;
+    cellSize *= 1.25;
+  }
+  int numCells = dims[0] * dims[1] * dims[2];
+
+  vector<int> cellOf(npart), cellStart(numCells + 1), cellParticles(npart);
+  vector<atomic<int> > fill(numCells);
+  for (int c = 0; c < numCells; c++)
+    fill[c].store(0);
+
+  RunThreads(numThreads, [&](int t) {
+    int first = (int)((long long)npart * t / numThreads);
+    int last = (int)((long long)npart * (t + 1) / numThreads);
+    for (int i = first; i < last; i++) {
+      int cell[numDataDims];
+      for (int dim = 0; dim < numDataDims; dim++)
+        cell[dim] = min((int)((data[dim][i] - lb[dim]) / cellSize), dims[dim] - 1);
+      cellOf[i] = (cell[2] * dims[1] + cell[1]) * dims[0] + cell[0];
+      fill[cellOf[i]].fetch_add(1);
+    }
+  });
+
+  cellStart[0] = 0;
+  for (int c = 0; c < numCells; c++) {
+    cellStart[c + 1] = cellStart[c] + fill[c].load();
+    fill[c].store(cellStart[c]);
+  }
+
+  RunThreads(numThreads, [&](int t) {
+    int first = (int)((long long)npart * t / numThreads);
+    int last = (int)((long long)npart * (t + 1) / numThreads);
+    for (int i = first; i < last; i++)
+      cellParticles[fill[cellOf[i]].fetch_add(1)] = i;
+  });
+
+  //
+  // FIND HALOS by linking friends in each cell and its forward neighbors
+  //
+  vector<atomic<int> > parent(npart);
+  RunThreads(numThreads, [&](int t) {
+    int first = (int)((long long)npart * t / numThreads);
+    int last = (int)((long long)npart * (t + 1) / numThreads);
+    for (int i = first; i < last; i++)
+      parent[i].store(i);
+  });
+
+  // Half of the 26 neighbors so that each pair of cells is visited once
+  int stencil[13][numDataDims];
+  int numStencil = 0;
+  for (int dz = 0; dz <= 1; dz++)
+    for (int dy = -1; dy <= 1; dy++)
+      for (int dx = -1; dx <= 1; dx++)
+        if (dz > 0 || dy > 0 || (dy == 0 && dx > 0)) {
+          stencil[numStencil][0] = dx;
+          stencil[numStencil][1] = dy;
+          stencil[numStencil][2] = dz;
+          numStencil++;
+        }
+
+  const int chunk = 64;
+  atomic<int> nextCell(0);
+  RunThreads(numThreads, [&](int) {
+    int first;
+    while ((first = nextCell.fetch_add(chunk)) < numCells) {
+      int last = min(first + chunk, numCells);
+      for (int c = first; c < last; c++) {
+        int cx = c % dims[0];
+        int cy = (c / dims[0]) % dims[1];
+        int cz = c / (dims[0] * dims[1]);
+
+        for (int s = -1; s < numStencil; s++) {
+          int nc = c;
+          if (s >= 0) {
+            int nx = cx + stencil[s][0];
+            int ny = cy + stencil[s][1];
+            int nz = cz + stencil[s][2];
+            if (nx < 0 || nx >= dims[0] || ny < 0 || ny >= dims[1] || nz >= dims[2])
+              continue;
+            nc = (nz * dims[1] + ny) * dims[0] + nx;
+          }
+
+          for (int a = cellStart[c]; a < cellStart[c + 1]; a++) {
+            int ii = cellParticles[a];
+            for (int b = (s < 0 ? a + 1 : cellStart[nc]); b < cellStart[nc + 1]; b++) {
+              int jj = cellParticles[b];
+
+              POSVEL_T xdist = fabs(data[dataX][jj] - data[dataX][ii]);
+              POSVEL_T ydist = fabs(data[dataY][jj] - data[dataY][ii]);
+              POSVEL_T zdist = fabs(data[dataZ][jj] - data[dataZ][ii]);
+
+              if ((xdist<bb) && (ydist<bb) && (zdist<bb)) {
+                POSVEL_T dist = xdist*xdist + ydist*ydist + zdist*zdist;
+                if (dist < bb*bb)
+                  Union(&parent[0], ii, jj);
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+
+  //
+  // HALO LISTS in the layout of myFOF(): ht holds the lowest index of the
+  // halo, halo[] the head of its list for that index and -1 elsewhere
+  //
+  RunThreads(numThreads, [&](int t) {
+    int first = (int)((long long)npart * t / numThreads);
+    int last = (int)((long long)npart * (t + 1) / numThreads);
+    for (int i = first; i < last; i++) {
+      ht[i] = FindRoot(&parent[0], i);
+      halo[i] = -1;
+    }
+  });
+
+  for (int i = npart - 1; i >= 0; i--) {
+    int root = ht[i];
+    nextp[i] = halo[root];
+    halo[root] = i;
+  }
+
+  // done!
+  return;
+}
+
 } // END namespace cosmotk
@@ -109,6 +109,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 #include <vector>
 
+#include "vtkCosmoHaloFinderModule.h"
+
 #include "Definition.h"
 
 #define numDataDims 3
@@ -137,7 +139,7 @@ public:
 
 /****************************************************************************/
 
-class CosmoHaloFinder
+class VTKCOSMOHALOFINDER_EXPORT CosmoHaloFinder
 {
 public:
   // create a finder
@@ -194,6 +196,9 @@ public:
   int nmin;
   int pmin;
   bool periodic;
+  // number of threads used by Finding(); non-periodic finds with nmin < 2
+  // link particles on a cell list from several threads when this exceeds 1
+  int nthreads;
   const char *infile;
   const char *outfile;
   const char *textmode;
@@ -232,6 +237,11 @@ private:
   // Recurses through the k-d tree merging particles to create halos
   void myFOF(int, int, int);
   void Merge(int, int, int, int, int);
+
+  // Links particles within bb of each other on a uniform cell list using
+  // nthreads threads and a concurrent union-find.  Produces the same halos
+  // and halo tags as myFOF(), only the order within the halo lists differs.
+  void ThreadedFinding();
 };
 
 } // END cosmotk namespace
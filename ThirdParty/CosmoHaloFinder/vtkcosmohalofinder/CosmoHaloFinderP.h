@@ -107,6 +107,9 @@ public:
                                 // which define a single halo
         int nmin = 1);          // The minimum number of neighbors for linking
 
+  // Threads used by the serial halo finder on this processor, 0 for all cores
+  void setNumberOfThreads(int n)    { this->haloFinder.nthreads = n; }
+
   // Execute the serial halo finder for this processor
   void executeHaloFinder();
 
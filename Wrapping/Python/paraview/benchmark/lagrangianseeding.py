@@ -0,0 +1,113 @@
+'''
+Seeding benchmark for the LagrangianParticleTracker plugin.
+
+A point cloud of seeds is generated inside a wavelet flow and the Lagrangian
+Seed Helper interpolates the flow RTData array on every seed, first serially,
+then with ParallelSeeding enabled for each requested number of threads. The
+number of seeded particles per second is reported for each configuration,
+with the speedup over the serial seeding and the parallel efficiency, i.e. the
+speedup per thread. The seeds are random points, so consecutive seeds seldom
+fall in the same cell and most of them are located in the flow locators.
+
+The thread count is changed with vtkSMPTools in the local process, so this
+benchmark must run in builtin mode, e.g. with pvpython or pvbatch. Some SMP
+backends can only be initialized once; the number of threads actually used is
+reported for each configuration.
+'''
+
+from __future__ import print_function
+import datetime as dt
+import sys
+from paraview import servermanager
+from paraview.simple import *
+
+
+def __time_seeding(helper, nrepeats):
+    algo = helper.GetClientSideObject()
+    best = None
+    for i in range(nrepeats):
+        algo.Modified()
+        t0 = dt.datetime.now()
+        algo.Update()
+        t = (dt.datetime.now() - t0).total_seconds()
+        best = t if best is None else min(best, t)
+    return best
+
+
+def run(filename=None, num_seeds=1000000, dimension=100,
+        thread_counts=(1, 2, 4, 8), nrepeats=3):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. Each configuration is run nrepeats times and
+    the fastest run is reported.
+    '''
+    from vtkmodules.vtkCommonCore import vtkSMPTools
+
+    # Turn off progress printing
+    servermanager.SetProgressPrintingEnabled(0)
+    LoadDistributedPlugin('LagrangianParticleTracker', remote=False,
+                          ns=globals())
+
+    print('Generating wavelet flow and %d seeds' % num_seeds)
+    wavelet = Wavelet()
+    d2 = dimension//2
+    wavelet.WholeExtent = [-d2, d2, -d2, d2, -d2, d2]
+    seeds = PointSource()
+    seeds.NumberOfPoints = num_seeds
+    seeds.Radius = d2
+    helper = LagrangianSeedHelperWithCustomSeeds(Input=wavelet,
+                                                 SeedPointsSource=seeds)
+    # Interpolate RTData point data on the seeds as a double array
+    helper.ArrayToGenerate = ['SeedRTData', '11', '0', '1', '0;RTData']
+    wavelet.UpdatePipeline()
+    seeds.UpdatePipeline()
+
+    results = []
+    helper.ParallelSeeding = 0
+    helper.UpdatePipeline()
+    serial = __time_seeding(helper, nrepeats)
+    print('serial: %g secs, %g particles/sec' % (serial, num_seeds/serial))
+    results.append(('serial', 1, num_seeds/serial, 1.0, 1.0))
+
+    helper.ParallelSeeding = 1
+    for n in thread_counts:
+        vtkSMPTools.Initialize(n)
+        nthreads = vtkSMPTools.GetEstimatedNumberOfThreads()
+        t = __time_seeding(helper, nrepeats)
+        speedup = serial/t
+        print('parallel, %d requested threads, %d used: %g secs, %g particles/sec'
+              ', speedup %.2f, efficiency %.2f'
+              % (n, nthreads, t, num_seeds/t, speedup, speedup/nthreads))
+        results.append(('parallel', nthreads, num_seeds/t, speedup,
+                        speedup/nthreads))
+
+    if filename:
+        f = open(filename, "w")
+    else:
+        f = sys.stdout
+    print('mode, threads, particles/sec, speedup, efficiency', file=f)
+    for i in results:
+        print('"%s", %d, %g, %.3f, %.3f' % i, file=f)
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark Lagrangian particle seeding')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the results to')
+    parser.add_argument('-n', '--seeds', default=1000000, type=int,
+                        help='Number of seeds')
+    parser.add_argument('-d', '--dimension', default=100, type=int,
+                        help='The dimension of each side of the cubic flow')
+    parser.add_argument('-t', '--threads', default=[1, 2, 4, 8],
+                        type=lambda s: [int(x) for x in s.split(',')],
+                        help='Comma separated numbers of threads to use')
+    parser.add_argument('-r', '--repeats', default=3, type=int,
+                        help='Number of runs for each configuration')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, num_seeds=args.seeds, dimension=args.dimension,
+        thread_counts=args.threads, nrepeats=args.repeats)
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
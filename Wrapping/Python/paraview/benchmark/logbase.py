@@ -75,6 +75,72 @@ def maximize_logs () :
     prop.SetElements1(1000000)
     tl.UpdateVTKObjects()
 
+def enable_event_tracing(enable=True, buffer_capacity=None) :
+    """
+    Convenience method to start (or stop) recording scoped events with
+    vtkPVEventTracer on all processes. The events can then be saved with
+    dump_chrome_trace().
+    """
+    pm = paraview.servermanager.vtkProcessModule.GetProcessModule()
+    if pm == None:
+        return
+
+    pxm = paraview.servermanager.ProxyManager()
+    tracer = pxm.NewProxy("misc", "EventTracer")
+    if buffer_capacity is not None:
+        tracer.GetProperty("BufferCapacity").SetElements1(buffer_capacity)
+    tracer.GetProperty("Enable").SetElements1(1 if enable else 0)
+    tracer.UpdateVTKObjects()
+
+def get_chrome_trace_events() :
+    """
+    Gathers the events recorded by vtkPVEventTracer on all processes and
+    returns them as a list of Chrome trace events. Each process gets its own
+    "pid", in the order client, render server ranks, data server ranks.
+    """
+    import json
+
+    pm = paraview.servermanager.vtkProcessModule.GetProcessModule()
+    if pm == None:
+        return []
+
+    session = paraview.servermanager.ActiveConnection.Session
+    if pm.GetProcessTypeAsInt() == pm.PROCESS_BATCH:
+        components = [session.CLIENT_AND_SERVERS]
+    elif session.GetRenderClientMode() == session.RENDERING_UNIFIED:
+        components = [session.CLIENT, session.SERVERS]
+    else:
+        components = [session.CLIENT, session.RENDER_SERVER, session.DATA_SERVER]
+
+    events = []
+    pid = 0
+    for component in components:
+        timerInfo = paraview.servermanager.vtkPVTimerInformation()
+        timerInfo.SetChromeTrace(True)
+        session.GatherInformation(component, timerInfo, 0)
+        for i in range(timerInfo.GetNumberOfLogs()):
+            log = timerInfo.GetLog(i)
+            if not log:
+                continue
+            # the processes report their rank as pid, which is not unique
+            # across process types.
+            for event in json.loads("[" + log + "]"):
+                event["pid"] = pid
+                events.append(event)
+            pid += 1
+    return events
+
+def dump_chrome_trace(filename) :
+    """
+    Saves the events recorded by vtkPVEventTracer on all processes in the
+    Chrome trace event format. The file can be loaded in chrome://tracing or
+    https://ui.perfetto.dev.
+    """
+    import json
+    with open(filename, "w") as f:
+        json.dump({"traceEvents": get_chrome_trace_events(),
+                   "displayTimeUnit": "ns"}, f)
+
 def get_memuse() :
     pm = paraview.servermanager.vtkProcessModule.GetProcessModule()
     session = servermanager.ProxyManager().GetSessionProxyManager().GetSession()
@@ -15,6 +15,7 @@ from vtkmodules.numpy_interface.algorithms import *
     # -- this will import vtkMultiProcessController and vtkMPI4PyCommunicator
 
 from paraview.vtk import vtkDoubleArray, vtkSelectionNode, vtkSelection, vtkStreamingDemandDrivenPipeline
+from vtkmodules.vtkCommonSystem import vtkTimerLog
 from paraview.modules import vtkPVClientServerCorePython
 
 import sys
@@ -131,15 +132,18 @@ def cellContainsPoint(inputs, locations):
 
     return output.CellData.GetArray('vtkInsidedness')
 
-def compute(inputs, expression, ns=None):
+def compute(inputs, expression, ns=None, points=None):
     #  build the locals environment used to eval the expression.
     mylocals = dict()
     if ns:
         mylocals.update(ns)
     mylocals["inputs"] = inputs
-    try:
-        mylocals["points"] = inputs[0].Points
-    except AttributeError: pass
+    if points is not None:
+        mylocals["points"] = points
+    else:
+        try:
+            mylocals["points"] = inputs[0].Points
+        except AttributeError: pass
 
     finalRet = None
     for subEx in expression.split(' and '):
@@ -151,6 +155,119 @@ def compute(inputs, expression, ns=None):
 
     return finalRet
 
+def get_expression_names(expression):
+    """Returns the set of names referenced by the expression, as evaluated by
+    `compute`, or None if the expression cannot be compiled."""
+    import types
+    names = set()
+    try:
+        codes = [compile(subEx, "<expression>", "eval") for subEx in expression.split(' and ')]
+    except SyntaxError:
+        return None
+    while codes:
+        code = codes.pop()
+        names.update(code.co_names)
+        codes.extend(c for c in code.co_consts if isinstance(c, types.CodeType))
+    return names
+
+def _all_ranks(flag, controller=None):
+    """Returns True if `flag` is True on all ranks."""
+    if controller is None and vtkMultiProcessController is not None:
+        controller = vtkMultiProcessController.GetGlobalController()
+    if controller and controller.IsA("vtkMPIController") and controller.GetNumberOfProcesses() > 1:
+        from mpi4py import MPI
+        comm = vtkMPI4PyCommunicator.ConvertToPython(controller.GetCommunicator())
+        return comm.allreduce(bool(flag), op=MPI.LAND)
+    return bool(flag)
+
+def _concatenate(arrays, association):
+    """Concatenates per-block arrays into a single contiguous VTKArray. Returns
+    None if the arrays are not available on all blocks or have different
+    numbers of components."""
+    if not arrays or any(a is dsa.NoneArray or a is None for a in arrays):
+        return None
+    if len(set(a.shape[1:] for a in arrays)) != 1:
+        return None
+    result = dsa.VTKArray(np.concatenate(arrays))
+    result.Association = association
+    return result
+
+def _get_number_of_tuples(block, association):
+    if association == dsa.ArrayAssociation.POINT:
+        return block.GetNumberOfPoints()
+    if association == dsa.ArrayAssociation.CELL:
+        return block.GetNumberOfCells()
+    return None
+
+def execute_batched(self, inputs, output, variables, expression):
+    """Evaluates the expression once on arrays concatenated across the blocks
+    of the first input, which must be a composite dataset, and splits the
+    result back into the blocks of the output. Returns False, without
+    touching the output, if the expression must be evaluated on composite
+    arrays instead. The decision is made consistently across all ranks."""
+    association = self.GetArrayAssociation()
+    names = get_expression_names(expression)
+    blocks = list(inputs[0])
+    outblocks = list(output)
+
+    # expressions using the inputs or per-block reductions need the
+    # composite arrays.
+    usable = names is not None and "inputs" not in names and \
+        not any(name.endswith("_per_block") for name in names) and \
+        len(blocks) == len(outblocks) and \
+        association in (dsa.ArrayAssociation.POINT, dsa.ArrayAssociation.CELL)
+
+    vtkTimerLog.MarkStartEvent("PythonCalculator: Concatenate Arrays")
+    batched = dict(variables)
+    points = None
+    if usable:
+        for name in names:
+            value = variables.get(name)
+            if isinstance(value, dsa.VTKCompositeDataArray):
+                batched[name] = _concatenate(value.Arrays, association)
+                usable = usable and batched[name] is not None
+        if usable and "points" in names:
+            points = _concatenate([getattr(b, "Points", None) for b in blocks],
+                dsa.ArrayAssociation.POINT)
+            usable = points is not None
+    vtkTimerLog.MarkEndEvent("PythonCalculator: Concatenate Arrays")
+    if not _all_ranks(usable):
+        return False
+
+    vtkTimerLog.MarkStartEvent("PythonCalculator: Evaluate")
+    try:
+        retVal = compute(inputs, expression, ns=batched, points=points)
+        ok = True
+    except Exception:
+        retVal = None
+        ok = False
+    vtkTimerLog.MarkEndEvent("PythonCalculator: Evaluate")
+
+    # results must be scalars or have one value per tuple.
+    resultAssociation = getattr(retVal, "Association", association)
+    sizes = [_get_number_of_tuples(b, resultAssociation) for b in blocks]
+    isArray = isinstance(retVal, np.ndarray) and retVal.ndim > 0
+    if isArray and (None in sizes or retVal.shape[0] != sum(sizes)):
+        ok = False
+    if not _all_ranks(ok):
+        return False
+    if retVal is None:
+        return True
+
+    vtkTimerLog.MarkStartEvent("PythonCalculator: Split Result")
+    if isArray:
+        # the per-block arrays are views on the contiguous result.
+        retVal = np.ascontiguousarray(retVal)
+        offset = 0
+        for outblock, size in zip(outblocks, sizes):
+            outblock.GetAttributes(resultAssociation).append(
+                retVal[offset:offset + size], self.GetArrayName())
+            offset += size
+    else:
+        output.GetAttributes(resultAssociation).append(retVal, self.GetArrayName())
+    vtkTimerLog.MarkEndEvent("PythonCalculator: Split Result")
+    return True
+
 def get_data_time(self, do, ininfo):
     dinfo = do.GetInformation()
     if dinfo and dinfo.Has(do.DATA_TIME_STEP()):
@@ -200,6 +317,10 @@ def execute(self, expression):
                        "t_value": inputs[0].t_value,
                        "time_index": inputs[0].time_index,
                        "t_index": inputs[0].t_index })
+    if self.GetBatchCompositeArrays() and isinstance(inputs[0], dsa.CompositeDataSet) and \
+        execute_batched(self, inputs, output, variables, expression):
+        return
+
     retVal = compute(inputs, expression, ns=variables)
     if retVal is not None:
         if hasattr(retVal, "Association"):
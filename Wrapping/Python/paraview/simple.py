@@ -2295,6 +2295,47 @@ def _get_proxymodules_to_import(connection):
     else:
         return []
 
+def _get_deferred_proxies(connection):
+    """
+    used in _add_functions to get the (module, group, name, function name) of
+    the proxies of plugins whose loading was deferred (see
+    vtkPVPluginTracker::SetLazyLoadPlugins). The proxies of a remote server are
+    all known since the server loads its deferred plugins for its clients.
+    """
+    if not connection or not connection.Modules or connection.IsRemote():
+        return []
+    modules = connection.Modules
+    groups = { "sources" : modules.sources, "filters" : modules.filters,
+               "writers" : modules.writers, "animation" : modules.animation }
+    tracker = servermanager.vtkPVPluginTracker.GetInstance()
+    proxies = []
+    for cc in range(tracker.GetNumberOfDeferredProxies()):
+        group = tracker.GetDeferredProxyGroup(cc)
+        key = servermanager._make_name_valid(tracker.GetDeferredProxyLabel(cc))
+        if group in groups and key:
+            proxies.append((groups[group], group, tracker.GetDeferredProxyName(cc), key))
+    return proxies
+
+def _create_deferred_func(key, module, group, name, g, skipRegisteration=False):
+    "Internal function."
+
+    def CreateDeferredObject(*input, **params):
+        """This function loads the plugin providing the proxy, then creates
+        the proxy as the function replacing this one does."""
+        # Requesting the definition loads the plugin.
+        pdm = servermanager.ProxyManager().GetProxyDefinitionManager()
+        if not pdm.HasDefinition(group, name):
+            raise RuntimeError ("Could not load the plugin providing %s." % key)
+        if not key in module.__dict__:
+            servermanager.updateModules(servermanager.ActiveConnection.Modules)
+        if g.get(key) is CreateDeferredObject:
+            _remove_deferred_functions(g)
+            _add_functions(g)
+        return _create_func(key, module, skipRegisteration)(*input, **params)
+
+    CreateDeferredObject.DeferredProxy = (group, name)
+    return CreateDeferredObject
+
 def _add_functions(g):
     if not servermanager.ActiveConnection:
         return
@@ -2312,6 +2353,13 @@ def _add_functions(g):
                     g[key] = _create_func(key, m, skipRegisteration)
                     exec ("g[key].__doc__ = _create_doc(m.%s.__doc__, g[key].__doc__)" % key)
 
+    # Proxies of deferred plugins are not in the modules until the plugin is
+    # loaded, which the function does on first use.
+    for m, group, name, key in _get_deferred_proxies(servermanager.ActiveConnection):
+        if not key in g and _func_name_valid(key):
+            skipRegisteration = m is activeModule.writers
+            g[key] = _create_deferred_func(key, m, group, name, g, skipRegisteration)
+
 # -----------------------------------------------------------------------------
 
 def _get_generated_proxies():
@@ -2334,6 +2382,11 @@ def _remove_functions(g):
             if not isinstance(cl, str) and key in g:
                 g.pop(key)
                 #print "remove %s function" % key
+    _remove_deferred_functions(g)
+
+def _remove_deferred_functions(g):
+    for key in [key for key in g.keys() if hasattr(g[key], "DeferredProxy")]:
+        g.pop(key)
 
 # -----------------------------------------------------------------------------
 